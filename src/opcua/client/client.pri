@@ -6,7 +6,20 @@ PUBLIC_HEADERS += \
     client/qopcuanode.h \
     client/qopcuatype.h \
     client/qopcuamonitoredevent.h \
-    client/qopcuamonitoredvalue.h
+    client/qopcuamonitoredvalue.h \
+    client/qopcuadatachangenotification.h \
+    client/qopcuamonitoringparameters.h \
+    client/qopcuasubscriptionparameters.h \
+    client/qopcuaeventfilter.h \
+    client/qopcuamonitoringstatistics.h \
+    client/qopcuaaggregation.h \
+    client/qopcuatypedmonitoredvalue.h \
+    client/qopcuamultidimensionalarray.h \
+    client/qopcuavariant.h \
+    client/qopcuastructuredvalue.h \
+    client/qopcuareconnectpolicy.h \
+    client/qopcuamethodcall.h \
+    client/qopcuapreparedmethod.h
 
 SOURCES += \
     client/qopcuaclient.cpp \
@@ -22,15 +35,26 @@ SOURCES += \
     client/qopcuasubscriptionprivate.cpp \
     client/qopcuamonitoredvalueprivate.cpp \
     client/qopcuasubscriptionimpl.cpp \
-    client/qopcuabackend.cpp
+    client/qopcuabackend.cpp \
+    client/qopcuavalueaggregator.cpp \
+    client/qopcuamultidimensionalarray.cpp \
+    client/qopcuavariant.cpp \
+    client/qopcuastructuredvalue.cpp \
+    client/qopcuastringcache.cpp \
+    client/qopcuapreparedmethod.cpp
 
 HEADERS += \
     client/qopcuaclient_p.h \
     client/qopcuaclientimpl_p.h \
     client/qopcuanode_p.h \
     client/qopcuanodeimpl_p.h \
+    client/qopcuapreparedmethod_p.h \
     client/qopcuamonitoredevent_p.h \
     client/qopcuamonitoredvalue_p.h \
     client/qopcuasubscription_p.h \
     client/qopcuasubscriptionimpl_p.h \
-    client/qopcuabackend_p.h
+    client/qopcuabackend_p.h \
+    client/qopcuaringbuffer_p.h \
+    client/qopcuastringcache_p.h \
+    client/qopcuamonitoringcounters_p.h \
+    client/qopcuavalueaggregator_p.h
@@ -0,0 +1,94 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAAGGREGATION_H
+#define QOPCUAAGGREGATION_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qmetatype.h>
+#include <QtCore/qvariant.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QOpcUaAggregationWindow {
+    enum class Type {
+        None,
+        Tumbling,
+        Sliding
+    };
+    Type type;
+    // Length of the window in milliseconds
+    int length;
+    // Milliseconds between two aggregates of a sliding window, ignored for tumbling windows
+    int step;
+    QOpcUaAggregationWindow()
+        : type(Type::None)
+        , length(0)
+        , step(0)
+    {}
+    QOpcUaAggregationWindow(Type p_type, int p_length, int p_step = 0)
+        : type(p_type)
+        , length(p_length)
+        , step(p_step)
+    {}
+};
+
+struct QOpcUaAggregateValue {
+    double minimum;
+    double maximum;
+    double average;
+    QVariant last;
+    quint32 count;
+    quint32 numericCount;
+    QDateTime windowStart;
+    QDateTime windowEnd;
+    QOpcUaAggregateValue()
+        : minimum(0)
+        , maximum(0)
+        , average(0)
+        , count(0)
+        , numericCount(0)
+    {}
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QOpcUaAggregationWindow)
+Q_DECLARE_METATYPE(QOpcUaAggregateValue)
+
+#endif // QOPCUAAGGREGATION_H
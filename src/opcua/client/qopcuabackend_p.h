@@ -79,6 +79,11 @@ Q_SIGNALS:
                                 QOpcUaClient::ClientError error);
     void attributesRead(uintptr_t handle, QVector<QOpcUaReadResult> attributes, QOpcUa::UaStatusCode serviceResult);
     void attributeWritten(uintptr_t hande, QOpcUaNode::NodeAttribute attribute, QVariant value, QOpcUa::UaStatusCode statusCode);
+    void endpointSelected(QUrl url);
+    void standbyChanged(QUrl url);
+    void methodsCalled(quint32 requestId, QVector<QOpcUaMethodCallResult> results, QOpcUa::UaStatusCode serviceResult);
+    void methodPrepared(QString methodId, QOpcUa::UaStatusCode statusCode,
+                        QVector<QOpcUaMethodArgument> inputArguments, QVector<QOpcUaMethodArgument> outputArguments);
 
 private:
     Q_DISABLE_COPY(QOpcUaBackend)
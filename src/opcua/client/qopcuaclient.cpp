@@ -81,6 +81,9 @@ Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA)
            The client is connected to a server.
     \value Closing
            The client has been connected and requests a disconnect from the server.
+    \value Reconnecting
+           The connection to the server has been lost and the client tries to restore it
+           according to its reconnect policy.
 */
 
 /*!
@@ -100,6 +103,20 @@ Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA)
            An unknown error occurred.
 */
 
+/*!
+    \enum QOpcUaClient::ArrayRepresentation
+
+    This enum type specifies how array values are returned by reads and
+    data change notifications.
+
+    \value VariantList
+           Arrays are returned as a QVariantList with one QVariant per element.
+    \value TypedVector
+           Arrays of numeric types are returned as a contiguous QVector of the
+           matching C++ type, e.g. QVector<double> for an array of Double.
+           All other arrays are still returned as QVariantList.
+*/
+
 /*!
     \property QOpcUaClient::error
     \brief Specifies the current error state of the client.
@@ -122,6 +139,68 @@ Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA)
     This signal is emitted when a connection has been closed following to a close request.
 */
 
+/*!
+    \fn QOpcUaClient::reconnected()
+
+    This signal is emitted when a lost connection has been restored by the reconnect policy.
+    Nodes and subscriptions created before the connection was lost can be used again.
+
+    \sa setReconnectPolicy()
+*/
+
+/*!
+    \fn QOpcUaClient::methodsCalled(quint32 requestId, QVector<QOpcUaMethodCallResult> results, QOpcUa::UaStatusCode serviceResult)
+
+    This signal is emitted when the method calls of the request \a requestId returned
+    by callMethods() have finished. \a results contains one result per call in the
+    order of the calls. \a serviceResult is the status of the Call service, the
+    results are only valid if it is \c Good.
+
+    \sa callMethods()
+*/
+
+/*!
+    \class QOpcUaMethodCall
+    \inmodule QtOpcUa
+
+    \brief A single method call of a batch passed to QOpcUaClient::callMethods().
+
+    \c objectId is the node id of the object or object type the method is called on,
+    \c methodId the node id of the method. \c arguments contains the input arguments
+    with their types.
+
+    \sa QOpcUaMethodCallResult
+*/
+
+/*!
+    \class QOpcUaMethodCallResult
+    \inmodule QtOpcUa
+
+    \brief The result of a single method call of a batch.
+
+    \c statusCode is the result of the call. \c inputArgumentResults contains the
+    status of each input argument if the server rejected some of them, e.g.
+    \c BadTypeMismatch, it is empty otherwise. \c outputArguments contains the
+    values returned by the method.
+
+    \sa QOpcUaClient::methodsCalled()
+*/
+
+/*!
+    \class QOpcUaReconnectPolicy
+    \inmodule QtOpcUa
+
+    \brief The policy for restoring a lost connection to the server.
+
+    \c enabled turns the automatic reconnect on. \c initialDelay and \c maximumDelay are
+    the delays before the first and the latest attempts in milliseconds, the delay grows
+    by \c backoffFactor per failed attempt. \c jitter is the fraction of the delay which
+    is randomly cut off, between 0 and 1. \c maximumAttempts limits the number of
+    attempts, 0 means no limit.
+
+    \sa QOpcUaClient::setReconnectPolicy()
+*/
+
 /*!
     \internal QOpcUaClientImpl is an opaque type (as seen from the public API).
     This prevents users of the public API to use this constructor (eventhough
@@ -142,7 +221,12 @@ QOpcUaClient::~QOpcUaClient()
 
 /*!
     Connects to the OPC UA endpoint given in \a url.
-    \sa disconnectFromEndpoint()
+
+    The connection is established in the background, state() changes to
+    \l Connected or back to \l Disconnected when it is done. Calling
+    disconnectFromEndpoint() in the meantime cancels the connect.
+
+    \sa disconnectFromEndpoint(), setConnectTimeout()
 */
 void QOpcUaClient::connectToEndpoint(const QUrl &url)
 {
@@ -150,6 +234,26 @@ void QOpcUaClient::connectToEndpoint(const QUrl &url)
     d->connectToEndpoint(url);
 }
 
+/*!
+    Connects to the first responsive server of \a urls.
+
+    All candidates are asked for their endpoints in parallel and the client
+    connects to the first one which answers, e.g. to the servers of a
+    redundant server set or to the same server over different networks.
+    url() returns the selected candidate once the client is connected.
+    Candidates which do not answer within connectTimeout() are skipped.
+
+    Backends which can not query several servers at once connect to the
+    first candidate.
+
+    \sa connectToEndpoint()
+*/
+void QOpcUaClient::connectToAnyEndpoint(const QVector<QUrl> &urls)
+{
+    Q_D(QOpcUaClient);
+    d->connectToAnyEndpoint(urls);
+}
+
 /*!
     Connects to an endpoint given by \a url using the highest security level
     supported by client and server.
@@ -168,7 +272,7 @@ void QOpcUaClient::secureConnectToEndpoint(const QUrl &url)
 }
 
 /*!
-    Disconnects from the server.
+    Disconnects from the server. A connect which is still in progress is canceled.
     \sa connectToEndpoint()
 */
 void QOpcUaClient::disconnectFromEndpoint()
@@ -187,6 +291,33 @@ QUrl QOpcUaClient::url() const
     return d->m_url;
 }
 
+/*!
+    Sets the deadline for establishing a connection to \a msecs milliseconds.
+
+    The deadline applies to connectToEndpoint(), to connectToAnyEndpoint() as a
+    whole, including the selection of the server, and to each attempt of the
+    reconnect policy.
+    Requests on an established connection are not affected.
+
+    The default is \c 0, which uses the default timeout of the backend.
+*/
+void QOpcUaClient::setConnectTimeout(int msecs)
+{
+    Q_D(QOpcUaClient);
+    d->m_impl->m_connectTimeout.store(qMax(0, msecs));
+}
+
+/*!
+    Returns the deadline for establishing a connection in milliseconds.
+
+    \sa setConnectTimeout()
+*/
+int QOpcUaClient::connectTimeout() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_impl->m_connectTimeout.load();
+}
+
 QOpcUaClient::ClientState QOpcUaClient::state() const
 {
     Q_D(const QOpcUaClient);
@@ -241,6 +372,156 @@ QString QOpcUaClient::backend() const
     return d_func()->m_impl->backend();
 }
 
+/*!
+    Sets the representation of array values delivered by this client to \a representation.
+
+    With \l TypedVector, numeric arrays are copied into a single QVector<T>
+    instead of boxing every element into its own QVariant. This saves one
+    allocation per element and is much faster for large arrays.
+    Writing a numeric QVector<T> is supported regardless of this setting.
+
+    The default is \l VariantList. Backends which do not support typed arrays
+    keep returning QVariantList.
+*/
+void QOpcUaClient::setArrayRepresentation(QOpcUaClient::ArrayRepresentation representation)
+{
+    Q_D(QOpcUaClient);
+    d->m_impl->m_arrayRepresentation.store(representation);
+}
+
+/*!
+    Returns the representation of array values delivered by this client.
+
+    \sa setArrayRepresentation()
+*/
+QOpcUaClient::ArrayRepresentation QOpcUaClient::arrayRepresentation() const
+{
+    Q_D(const QOpcUaClient);
+    return static_cast<QOpcUaClient::ArrayRepresentation>(d->m_impl->m_arrayRepresentation.load());
+}
+
+/*!
+    Enables interning of the strings delivered by data change and event
+    notifications and limits the intern table to \a entries strings.
+
+    Status texts, enumeration names and other values which are published
+    over and over are then decoded once and shared between all notifications
+    carrying the same UTF-8 bytes. When the table is full, the least recently
+    used string is dropped. Long strings are never interned.
+
+    The default is \c 0, which disables interning. Backends which do not
+    support interning ignore this setting.
+*/
+void QOpcUaClient::setStringCacheSize(int entries)
+{
+    Q_D(QOpcUaClient);
+    d->m_impl->m_stringCacheSize.store(qMax(0, entries));
+}
+
+/*!
+    Returns the maximum number of strings interned for notifications of this client.
+
+    \sa setStringCacheSize()
+*/
+int QOpcUaClient::stringCacheSize() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_impl->m_stringCacheSize.load();
+}
+
+/*!
+    Sets the policy for restoring a lost connection to \a policy.
+
+    When the connection drops, the client changes to \l Reconnecting and retries
+    after \c initialDelay milliseconds. Each failed attempt multiplies the delay by
+    \c backoffFactor up to \c maximumDelay. The delay is shortened by a random
+    part of up to \c jitter times its length, so clients which lost the
+    connection at the same time do not reconnect in lockstep. After
+    \c maximumAttempts failed attempts the client gives up and is disconnected,
+    \c 0 retries until disconnectFromEndpoint() is called.
+
+    A new secure channel is opened for every attempt and the existing session is
+    activated on it. Only if the server has discarded the session, a new one is
+    created. Nodes, their cached attributes and all monitored values stay valid,
+    subscriptions are transferred or recreated with their monitored items. The
+    client emits reconnected() instead of connected() when it is back.
+
+    By default the policy is disabled and a single immediate attempt is made.
+    Backends which do not support reconnecting ignore the policy.
+
+    \sa QOpcUaReconnectPolicy
+*/
+void QOpcUaClient::setReconnectPolicy(const QOpcUaReconnectPolicy &policy)
+{
+    Q_D(QOpcUaClient);
+    d->m_impl->setReconnectPolicy(policy);
+}
+
+/*!
+    Returns the policy for restoring a lost connection.
+
+    \sa setReconnectPolicy()
+*/
+QOpcUaReconnectPolicy QOpcUaClient::reconnectPolicy() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_impl->reconnectPolicy();
+}
+
+/*!
+    Enables a hot standby session on a redundant server if \a enabled is \c true.
+
+    The client then keeps a second session on a standby server. The candidates
+    are the other servers passed to connectToAnyEndpoint() and the servers of a
+    non-transparent redundant server set, which the connected server lists in
+    the ServerUriArray of its ServerRedundancy object. All subscriptions and
+    monitored items are mirrored to the standby session with publishing and
+    monitoring disabled.
+
+    When the connection to the current server is lost, the client switches to
+    the standby server by enabling publishing and the monitoring modes of the
+    mirrored items instead of creating them from scratch. The client goes
+    through \l Reconnecting and emits reconnected(), url() returns the
+    standby server afterwards. The reconnect policy is only used if no
+    standby session is available.
+
+    The default is \c false. Backends which do not support redundancy ignore
+    this setting.
+
+    \sa setReconnectPolicy(), standbyUrl()
+*/
+void QOpcUaClient::setHotStandby(bool enabled)
+{
+    Q_D(QOpcUaClient);
+    d->m_impl->m_hotStandby.store(enabled ? 1 : 0);
+}
+
+/*!
+    Returns \c true if the client keeps a hot standby session on a redundant server.
+
+    \sa setHotStandby()
+*/
+bool QOpcUaClient::hotStandby() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_impl->m_hotStandby.load() != 0;
+}
+
+/*!
+    Returns the URL of the server the hot standby session is connected to.
+
+    The URL is set once the subscriptions of the current session have been
+    mirrored on the standby server. An empty URL is returned if there is no
+    standby session, for example right after a switch to the standby server.
+
+    \sa setHotStandby()
+*/
+QUrl QOpcUaClient::standbyUrl() const
+{
+    Q_D(const QOpcUaClient);
+    return d->m_standbyUrl;
+}
+
 /*!
     Creates a subscription with \a interval milliseconds publishing period
     on the server and returns a QOpcUaSubscription object for it. The
@@ -258,4 +539,66 @@ QOpcUaSubscription *QOpcUaClient::createSubscription(quint32 interval)
     return d_func()->m_impl->createSubscription(interval);
 }
 
+/*!
+    Calls the methods of \a calls with a single Call service request.
+
+    The calls are sent in the background and do not block the caller. Requests
+    are processed in order, so batches issued one after another are pipelined
+    on the connection. Batches exceeding the server's limit of methods per call
+    are split into several requests. The results are delivered with the
+    methodsCalled() signal.
+
+    Returns the id of the request which is passed to methodsCalled(), or 0 if the
+    client is not connected, \a calls is empty or the backend does not support
+    batched method calls.
+
+    \sa QOpcUaNode::call()
+*/
+quint32 QOpcUaClient::callMethods(const QVector<QOpcUaMethodCall> &calls)
+{
+    Q_D(QOpcUaClient);
+    if (state() != QOpcUaClient::Connected || calls.isEmpty())
+        return 0;
+
+    const quint32 requestId = d->m_nextMethodCallId;
+    if (!d->m_impl->callMethods(requestId, calls))
+        return 0;
+
+    // 0 marks a failed request, it is skipped when the ids wrap around
+    if (++d->m_nextMethodCallId == 0)
+        d->m_nextMethodCallId = 1;
+    return requestId;
+}
+
+/*!
+    Returns a QOpcUaPreparedMethod for the method \a methodId of the object
+    \a objectId and starts resolving its arguments. The caller becomes the
+    owner of the prepared method.
+
+    QOpcUaPreparedMethod::prepared() is emitted once the arguments are known or
+    could not be resolved. It is never emitted before this function returns,
+    even for cached arguments or a backend without support for prepared
+    methods, so it can be connected to after the call.
+
+    The arguments are resolved with a single browse and a single read, which
+    are shared by all methods prepared at the same time. They are cached for
+    the session, preparing the same method again, e.g. for another object of
+    the same type, does not need any requests.
+
+    For this method to work the client needs to be connected to the server.
+    A null pointer is returned on error.
+
+    \sa callMethods()
+*/
+QOpcUaPreparedMethod *QOpcUaClient::prepareMethod(const QString &objectId, const QString &methodId)
+{
+    Q_D(QOpcUaClient);
+    if (state() != QOpcUaClient::Connected)
+        return nullptr;
+
+    QOpcUaPreparedMethod *method = new QOpcUaPreparedMethod(d->m_impl.data(), this, objectId, methodId);
+    d->m_impl->prepareMethod(methodId);
+    return method;
+}
+
 QT_END_NAMESPACE
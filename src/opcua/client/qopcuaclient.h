@@ -38,11 +38,15 @@
 #define QOPCUACLIENT_H
 
 #include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuamethodcall.h>
 #include <QtOpcUa/qopcuanode.h>
+#include <QtOpcUa/qopcuapreparedmethod.h>
+#include <QtOpcUa/qopcuareconnectpolicy.h>
 #include <QtOpcUa/qopcuasubscription.h>
 
 #include <QtCore/qobject.h>
 #include <QtCore/qurl.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -61,7 +65,8 @@ public:
         Disconnected,
         Connecting,
         Connected,
-        Closing
+        Closing,
+        Reconnecting
     };
     Q_ENUM(ClientState)
 
@@ -74,29 +79,56 @@ public:
     };
     Q_ENUM(ClientError)
 
+    enum ArrayRepresentation {
+        VariantList,
+        TypedVector
+    };
+    Q_ENUM(ArrayRepresentation)
+
     explicit QOpcUaClient(QOpcUaClientImpl *impl, QObject *parent = nullptr);
     ~QOpcUaClient();
 
     Q_INVOKABLE void connectToEndpoint(const QUrl &url);
+    Q_INVOKABLE void connectToAnyEndpoint(const QVector<QUrl> &urls);
     Q_INVOKABLE void secureConnectToEndpoint(const QUrl &url);
     Q_INVOKABLE void disconnectFromEndpoint();
     QOpcUaNode *node(const QString &nodeId);
 
     QOpcUaSubscription *createSubscription(quint32 interval);
+    quint32 callMethods(const QVector<QOpcUaMethodCall> &calls);
+    QOpcUaPreparedMethod *prepareMethod(const QString &objectId, const QString &methodId);
 
     QUrl url() const;
 
+    void setConnectTimeout(int msecs);
+    int connectTimeout() const;
+
     ClientState state() const;
     ClientError error() const;
 
     bool isSecureConnectionSupported() const;
     QString backend() const;
 
+    void setArrayRepresentation(ArrayRepresentation representation);
+    ArrayRepresentation arrayRepresentation() const;
+
+    void setStringCacheSize(int entries);
+    int stringCacheSize() const;
+
+    void setReconnectPolicy(const QOpcUaReconnectPolicy &policy);
+    QOpcUaReconnectPolicy reconnectPolicy() const;
+
+    void setHotStandby(bool enabled);
+    bool hotStandby() const;
+    QUrl standbyUrl() const;
+
 Q_SIGNALS:
     void connected();
     void disconnected();
+    void reconnected();
     void stateChanged(ClientState state);
     void errorChanged(ClientError error);
+    void methodsCalled(quint32 requestId, QVector<QOpcUaMethodCallResult> results, QOpcUa::UaStatusCode serviceResult);
 
 private:
     Q_DISABLE_COPY(QOpcUaClient)
@@ -106,5 +138,6 @@ QT_END_NAMESPACE
 
 Q_DECLARE_METATYPE(QOpcUaClient::ClientState)
 Q_DECLARE_METATYPE(QOpcUaClient::ClientError)
+Q_DECLARE_METATYPE(QOpcUaClient::ArrayRepresentation)
 
 #endif // QOPCUACLIENT_H
@@ -67,6 +67,7 @@ public:
     ~QOpcUaClientPrivate() override;
 
     void connectToEndpoint(const QUrl &url);
+    void connectToAnyEndpoint(const QVector<QUrl> &urls);
     void secureConnectToEndpoint(const QUrl &url);
     void disconnectFromEndpoint();
 
@@ -74,6 +75,8 @@ public:
     QOpcUaClient::ClientState m_state;
     QOpcUaClient::ClientError m_error;
     QUrl m_url;
+    QUrl m_standbyUrl;
+    quint32 m_nextMethodCallId;
 
     bool checkAndSetUrl(const QUrl &url);
     void setStateAndError(QOpcUaClient::ClientState state,
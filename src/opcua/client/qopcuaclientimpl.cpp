@@ -41,6 +41,11 @@ QT_BEGIN_NAMESPACE
 
 QOpcUaClientImpl::QOpcUaClientImpl(QObject *parent)
     : QObject(parent)
+    , m_arrayRepresentation(QOpcUaClient::VariantList)
+    , m_stringCacheSize(0)
+    , m_connectTimeout(0)
+    , m_hotStandby(0)
+    , m_connectCanceled(0)
 {}
 
 QOpcUaClientImpl::~QOpcUaClientImpl()
@@ -56,10 +61,49 @@ void QOpcUaClientImpl::unregisterNode(QPointer<QOpcUaNodeImpl> obj)
     m_handles.remove(reinterpret_cast<uintptr_t>(obj.data()));
 }
 
+// Backends which can not select a server connect to the first candidate
+void QOpcUaClientImpl::connectToAnyEndpoint(const QVector<QUrl> &urls)
+{
+    connectToEndpoint(urls.first());
+}
+
+// Backends without batched method calls reject them, QOpcUaNode::call() is used instead
+bool QOpcUaClientImpl::callMethods(quint32 requestId, const QVector<QOpcUaMethodCall> &calls)
+{
+    Q_UNUSED(requestId);
+    Q_UNUSED(calls);
+    return false;
+}
+
+// Backends which can not resolve method arguments report every method as not supported
+void QOpcUaClientImpl::prepareMethod(const QString &methodId)
+{
+    QMetaObject::invokeMethod(this, [this, methodId]() {
+        emit methodPrepared(methodId, QOpcUa::UaStatusCode::BadNotSupported,
+                            QVector<QOpcUaMethodArgument>(), QVector<QOpcUaMethodArgument>());
+    }, Qt::QueuedConnection);
+}
+
+QOpcUaReconnectPolicy QOpcUaClientImpl::reconnectPolicy() const
+{
+    QMutexLocker locker(&m_reconnectPolicyMutex);
+    return m_reconnectPolicy;
+}
+
+void QOpcUaClientImpl::setReconnectPolicy(const QOpcUaReconnectPolicy &policy)
+{
+    QMutexLocker locker(&m_reconnectPolicyMutex);
+    m_reconnectPolicy = policy;
+}
+
 void QOpcUaClientImpl::connectBackendWithClient(QOpcUaBackend *backend)
 {
     connect(backend, &QOpcUaBackend::attributesRead, this, &QOpcUaClientImpl::handleAttributesRead);
     connect(backend, &QOpcUaBackend::stateAndOrErrorChanged, this, &QOpcUaClientImpl::stateAndOrErrorChanged);
+    connect(backend, &QOpcUaBackend::endpointSelected, this, &QOpcUaClientImpl::endpointSelected);
+    connect(backend, &QOpcUaBackend::standbyChanged, this, &QOpcUaClientImpl::standbyChanged);
+    connect(backend, &QOpcUaBackend::methodsCalled, this, &QOpcUaClientImpl::methodsCalled);
+    connect(backend, &QOpcUaBackend::methodPrepared, this, &QOpcUaClientImpl::methodPrepared);
     connect(backend, &QOpcUaBackend::attributeWritten, this, &QOpcUaClientImpl::handleAttributeWritten);
 }
 
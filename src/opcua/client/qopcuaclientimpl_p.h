@@ -52,6 +52,8 @@
 #include <QtOpcUa/qopcuaglobal.h>
 #include <private/qopcuanodeimpl_p.h>
 
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qpointer.h>
 #include <QtCore/qset.h>
@@ -72,6 +74,7 @@ public:
     virtual ~QOpcUaClientImpl();
 
     virtual void connectToEndpoint(const QUrl &url) = 0;
+    virtual void connectToAnyEndpoint(const QVector<QUrl> &urls);
     virtual void secureConnectToEndpoint(const QUrl &url) = 0;
     virtual void disconnectFromEndpoint() = 0;
     virtual QOpcUaNode *node(const QString &nodeId) = 0;
@@ -84,8 +87,25 @@ public:
     void connectBackendWithClient(QOpcUaBackend *backend);
 
     virtual QOpcUaSubscription *createSubscription(quint32 interval) = 0;
+    virtual bool callMethods(quint32 requestId, const QVector<QOpcUaMethodCall> &calls);
+    // methodPrepared() must not be emitted before prepareMethod() has returned
+    virtual void prepareMethod(const QString &methodId);
+
+    // Called from the backend thread when the connection is lost
+    QOpcUaReconnectPolicy reconnectPolicy() const;
+    void setReconnectPolicy(const QOpcUaReconnectPolicy &policy);
 
     QOpcUaClient *m_client;
+    // Read from the backend thread, see QOpcUaClient::setArrayRepresentation()
+    QAtomicInt m_arrayRepresentation;
+    // Read from the backend thread, see QOpcUaClient::setStringCacheSize()
+    QAtomicInt m_stringCacheSize;
+    // Read from the backend thread, see QOpcUaClient::setConnectTimeout()
+    QAtomicInt m_connectTimeout;
+    // Read from the backend thread, see QOpcUaClient::setHotStandby()
+    QAtomicInt m_hotStandby;
+    // Set when a connect in progress is canceled, reset for every connect
+    QAtomicInt m_connectCanceled;
 
 private Q_SLOTS:
     void handleAttributesRead(uintptr_t handle, QVector<QOpcUaReadResult> attr, QOpcUa::UaStatusCode serviceResult);
@@ -94,11 +114,18 @@ private Q_SLOTS:
 signals:
     void connected();
     void disconnected();
+    void endpointSelected(const QUrl &url);
+    void standbyChanged(const QUrl &url);
+    void methodsCalled(quint32 requestId, QVector<QOpcUaMethodCallResult> results, QOpcUa::UaStatusCode serviceResult);
+    void methodPrepared(const QString &methodId, QOpcUa::UaStatusCode statusCode,
+                        QVector<QOpcUaMethodArgument> inputArguments, QVector<QOpcUaMethodArgument> outputArguments);
     void stateAndOrErrorChanged(QOpcUaClient::ClientState state,
                                 QOpcUaClient::ClientError error);
 private:
     Q_DISABLE_COPY(QOpcUaClientImpl)
     QHash<uintptr_t, QPointer<QOpcUaNodeImpl>> m_handles;
+    mutable QMutex m_reconnectPolicyMutex;
+    QOpcUaReconnectPolicy m_reconnectPolicy;
 };
 
 inline uint qHash(const QPointer<QOpcUaNodeImpl>& n)
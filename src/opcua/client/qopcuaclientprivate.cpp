@@ -47,6 +47,7 @@ QOpcUaClientPrivate::QOpcUaClientPrivate(QOpcUaClientImpl *impl, QOpcUaClient *p
     , m_impl(impl)
     , m_state(QOpcUaClient::Disconnected)
     , m_error(QOpcUaClient::NoError)
+    , m_nextMethodCallId(1)
     , q_ptr(parent)
 {
     // callback from client implementation
@@ -54,6 +55,17 @@ QOpcUaClientPrivate::QOpcUaClientPrivate(QOpcUaClientImpl *impl, QOpcUaClient *p
                     [this](QOpcUaClient::ClientState state, QOpcUaClient::ClientError error) {
         setStateAndError(state, error);
     });
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::endpointSelected, [this](const QUrl &url) {
+        m_url = url;
+    });
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::standbyChanged, [this](const QUrl &url) {
+        m_standbyUrl = url;
+    });
+    QObject::connect(m_impl.data(), &QOpcUaClientImpl::methodsCalled,
+                     [this](quint32 requestId, QVector<QOpcUaMethodCallResult> results, QOpcUa::UaStatusCode serviceResult) {
+        Q_Q(QOpcUaClient);
+        emit q->methodsCalled(requestId, results, serviceResult);
+    });
 }
 
 QOpcUaClientPrivate::~QOpcUaClientPrivate()
@@ -65,12 +77,32 @@ void QOpcUaClientPrivate::connectToEndpoint(const QUrl &url)
     bool result = checkAndSetUrl(url);
     if (result) {
         setStateAndError(QOpcUaClient::Connecting);
+        m_impl->m_connectCanceled.store(0);
         m_impl->connectToEndpoint(url);
     } else {
         setStateAndError(QOpcUaClient::Disconnected, QOpcUaClient::InvalidUrl);
     }
 }
 
+void QOpcUaClientPrivate::connectToAnyEndpoint(const QVector<QUrl> &urls)
+{
+    QVector<QUrl> candidates;
+    for (const QUrl &url : urls) {
+        if (checkAndSetUrl(url))
+            candidates.push_back(url);
+    }
+
+    if (candidates.isEmpty()) {
+        setStateAndError(QOpcUaClient::Disconnected, QOpcUaClient::InvalidUrl);
+        return;
+    }
+
+    m_url = candidates.first();
+    setStateAndError(QOpcUaClient::Connecting);
+    m_impl->m_connectCanceled.store(0);
+    m_impl->connectToAnyEndpoint(candidates);
+}
+
 void QOpcUaClientPrivate::secureConnectToEndpoint(const QUrl &url)
 {
     if (!m_impl->isSecureConnectionSupported()) {
@@ -90,7 +122,15 @@ void QOpcUaClientPrivate::secureConnectToEndpoint(const QUrl &url)
 
 void QOpcUaClientPrivate::disconnectFromEndpoint()
 {
-    if (m_state != QOpcUaClient::Connected) {
+    if (m_state == QOpcUaClient::Connecting) {
+        // The backend checks the flag between the steps of the connect and gives up
+        m_impl->m_connectCanceled.store(1);
+        setStateAndError(QOpcUaClient::Closing);
+        m_impl->disconnectFromEndpoint();
+        return;
+    }
+
+    if (m_state != QOpcUaClient::Connected && m_state != QOpcUaClient::Reconnecting) {
         qCWarning(QT_OPCUA, "Closing a connection without being connected.");
         return;
     }
@@ -119,6 +159,7 @@ void QOpcUaClientPrivate::setStateAndError(QOpcUaClient::ClientState state,
     bool stateChanged = false;
     bool errorOccurred = false;
 
+    const bool reconnected = m_state == QOpcUaClient::Reconnecting && state == QOpcUaClient::Connected;
     if (m_state != state) {
         m_state = state;
         stateChanged = true;
@@ -133,7 +174,9 @@ void QOpcUaClientPrivate::setStateAndError(QOpcUaClient::ClientState state,
     if (stateChanged) {
         emit q->stateChanged(m_state);
 
-        if (m_state == QOpcUaClient::Connected)
+        if (reconnected)
+            emit q->reconnected();
+        else if (m_state == QOpcUaClient::Connected)
             emit q->connected();
         else if (m_state == QOpcUaClient::Disconnected)
             emit q->disconnected();
@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAEVENTFILTER_H
+#define QOPCUAEVENTFILTER_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuanode.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qmetatype.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QOpcUaSimpleAttributeOperand {
+    QString typeId;
+    QVector<QOpcUa::QQualifiedName> browsePath;
+    QOpcUaNode::NodeAttribute attributeId;
+    explicit QOpcUaSimpleAttributeOperand(const QVector<QOpcUa::QQualifiedName> &p_browsePath = QVector<QOpcUa::QQualifiedName>(),
+                                          const QString &p_typeId = QStringLiteral("ns=0;i=2041"))
+        : typeId(p_typeId)
+        , browsePath(p_browsePath)
+        , attributeId(QOpcUaNode::NodeAttribute::Value)
+    {}
+    explicit QOpcUaSimpleAttributeOperand(const QString &p_browseName, quint16 p_namespaceIndex = 0)
+        : typeId(QStringLiteral("ns=0;i=2041"))
+        , browsePath({QOpcUa::QQualifiedName(p_namespaceIndex, p_browseName)})
+        , attributeId(QOpcUaNode::NodeAttribute::Value)
+    {}
+};
+
+struct QOpcUaContentFilterElement {
+    enum class FilterOperator : quint32 {
+        Equals = 0,
+        IsNull = 1,
+        GreaterThan = 2,
+        LessThan = 3,
+        GreaterThanOrEqual = 4,
+        LessThanOrEqual = 5,
+        Like = 6,
+        Not = 7,
+        Between = 8,
+        InList = 9,
+        And = 10,
+        Or = 11,
+        Cast = 12,
+        InView = 13,
+        OfType = 14,
+        RelatedTo = 15,
+        BitwiseAnd = 16,
+        BitwiseOr = 17
+    };
+
+    // Refers to another element of the same where clause by its index
+    struct ElementOperand {
+        quint32 index;
+        explicit ElementOperand(quint32 p_index = 0)
+            : index(p_index)
+        {}
+    };
+
+    FilterOperator filterOperator;
+    QVector<QVariant> operands;
+    explicit QOpcUaContentFilterElement(FilterOperator p_filterOperator = FilterOperator::Equals,
+                                        const QVector<QVariant> &p_operands = QVector<QVariant>())
+        : filterOperator(p_filterOperator)
+        , operands(p_operands)
+    {}
+};
+
+struct QOpcUaEventFilter {
+    QVector<QOpcUaSimpleAttributeOperand> selectClauses;
+    QVector<QOpcUaContentFilterElement> whereClause;
+    QOpcUaEventFilter() {}
+    explicit QOpcUaEventFilter(const QVector<QOpcUaSimpleAttributeOperand> &p_selectClauses,
+                               const QVector<QOpcUaContentFilterElement> &p_whereClause = QVector<QOpcUaContentFilterElement>())
+        : selectClauses(p_selectClauses)
+        , whereClause(p_whereClause)
+    {}
+
+    static QOpcUaEventFilter defaultFilter()
+    {
+        return QOpcUaEventFilter({QOpcUaSimpleAttributeOperand(QStringLiteral("Message")),
+                                  QOpcUaSimpleAttributeOperand(QStringLiteral("SourceName")),
+                                  QOpcUaSimpleAttributeOperand(QStringLiteral("Severity"))});
+    }
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QOpcUaSimpleAttributeOperand)
+Q_DECLARE_METATYPE(QOpcUaContentFilterElement)
+Q_DECLARE_METATYPE(QOpcUaContentFilterElement::ElementOperand)
+Q_DECLARE_METATYPE(QOpcUaEventFilter)
+
+#endif // QOPCUAEVENTFILTER_H
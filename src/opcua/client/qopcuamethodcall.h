@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAMETHODCALL_H
+#define QOPCUAMETHODCALL_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qmetatype.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QOpcUaMethodCall {
+    QString objectId;
+    QString methodId;
+    QVector<QOpcUa::TypedVariant> arguments;
+    QOpcUaMethodCall() {}
+    QOpcUaMethodCall(const QString &p_objectId, const QString &p_methodId,
+                     const QVector<QOpcUa::TypedVariant> &p_arguments = QVector<QOpcUa::TypedVariant>())
+        : objectId(p_objectId)
+        , methodId(p_methodId)
+        , arguments(p_arguments)
+    {}
+};
+
+struct QOpcUaMethodCallResult {
+    QOpcUa::UaStatusCode statusCode;
+    QVector<QOpcUa::UaStatusCode> inputArgumentResults;
+    QVector<QVariant> outputArguments;
+    QOpcUaMethodCallResult()
+        : statusCode(QOpcUa::UaStatusCode::Good)
+    {}
+};
+
+struct QOpcUaMethodArgument {
+    QString name;
+    QOpcUa::Types type;
+    qint32 valueRank;
+    QVector<quint32> arrayDimensions;
+    QOpcUaMethodArgument()
+        : type(QOpcUa::Undefined)
+        , valueRank(-1)
+    {}
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QOpcUaMethodCall)
+Q_DECLARE_METATYPE(QOpcUaMethodCallResult)
+Q_DECLARE_METATYPE(QOpcUaMethodArgument)
+
+#endif // QOPCUAMETHODCALL_H
@@ -38,6 +38,8 @@
 #include "qopcuasubscription.h"
 #include <private/qopcuamonitoredevent_p.h>
 
+#include <QtCore/qmetaobject.h>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -45,7 +47,16 @@ QT_BEGIN_NAMESPACE
  */
 QOpcUaMonitoredEvent::QOpcUaMonitoredEvent(QOpcUaNode *node, QOpcUaSubscription *subscription, QObject *parent)
     : QObject(*new QOpcUaMonitoredEventPrivate(node, subscription), parent)
-{}
+{
+    // Batches are delivered with a single queued invocation and fanned out on the receiving thread
+    connect(this, &QOpcUaMonitoredEvent::newEvents, this, [this](const QVector<QVector<QVariant>> &events) {
+        static const QMetaMethod newEventSignal = QMetaMethod::fromSignal(&QOpcUaMonitoredEvent::newEvent);
+        if (!isSignalConnected(newEventSignal))
+            return;
+        for (const QVector<QVariant> &event : events)
+            emit newEvent(event);
+    });
+}
 
 /*!
     Destroys this event monitor instance. This will automatically
@@ -64,6 +75,26 @@ QOpcUaNode &QOpcUaMonitoredEvent::node()
     return *d_func()->m_node;
 }
 
+/*!
+    Returns the event filter used for this event monitor.
+*/
+QOpcUaEventFilter QOpcUaMonitoredEvent::filter() const
+{
+    return d_func()->m_filter;
+}
+
+/*!
+    Returns \c Good while the monitored item of this event monitor exists on the server,
+    otherwise the status with which it could not be created again after the subscription
+    was lost. The backend retries on the next reconnect.
+
+    \sa QOpcUaMonitoredValue::status()
+*/
+QOpcUa::UaStatusCode QOpcUaMonitoredEvent::status() const
+{
+    return static_cast<QOpcUa::UaStatusCode>(d_func()->m_status.load());
+}
+
 /*!
     \class QOpcUaMonitoredEvent
     \inmodule QtOpcUa
@@ -82,10 +113,22 @@ QOpcUaNode &QOpcUaMonitoredEvent::node()
     \fn void QOpcUaMonitoredEvent::newEvent(QVector<QVariant> val) const
     This signal is emitted when a new event is received by a data change
     subscription.
-    The QVector \a val currently contains three QVariants holding the values of the
-    first three event fields.
+    The QVector \a val contains one QVariant for each select clause of filter().
     \warning When using the FreeOPCUA backend, no signal is emitted as the
     internal implementation of events does not call the callback method.
 */
 
+/*!
+    \fn void QOpcUaMonitoredEvent::statusChanged(QOpcUa::UaStatusCode status) const
+    This signal is emitted when the monitored item of this event monitor is lost or
+    restored. \a status is the new status().
+*/
+
+/*!
+    \fn void QOpcUaMonitoredEvent::newEvents(QVector<QVector<QVariant>> events) const
+    This signal is emitted once for all \a events received in a single publish response.
+    Consumers which handle high event rates should connect to this signal instead of
+    newEvent(), which is emitted for each event of the batch afterwards.
+*/
+
 QT_END_NAMESPACE
@@ -37,6 +37,7 @@
 #ifndef QOPCUAMONITOREDEVENT_H
 #define QOPCUAMONITOREDEVENT_H
 
+#include <QtOpcUa/qopcuaeventfilter.h>
 #include <QtOpcUa/qopcuaglobal.h>
 #include <QtOpcUa/qopcuanode.h>
 
@@ -60,9 +61,13 @@ public:
     QOpcUaMonitoredEvent(QOpcUaNode *node, QOpcUaSubscription *subscription, QObject *parent = nullptr);
     ~QOpcUaMonitoredEvent() override;
     QOpcUaNode &node();
+    QOpcUaEventFilter filter() const;
+    QOpcUa::UaStatusCode status() const;
 
 Q_SIGNALS:
     void newEvent(QVector<QVariant> value) const;
+    void newEvents(QVector<QVector<QVariant>> events) const;
+    void statusChanged(QOpcUa::UaStatusCode status) const;
 private:
     Q_DISABLE_COPY(QOpcUaMonitoredEvent)
 };
@@ -53,6 +53,7 @@
 #include <QtOpcUa/qopcuanode.h>
 
 #include <private/qobject_p.h>
+#include <QtCore/qatomic.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qvector.h>
 
@@ -69,8 +70,13 @@ public:
     ~QOpcUaMonitoredEventPrivate() override;
 
     bool triggerNewEvent(const QVector<QVariant> &val);
+    bool triggerNewEvents(const QVector<QVector<QVariant>> &events);
+    void setStatus(QOpcUa::UaStatusCode status);
     QOpcUaNode *m_node;
     QOpcUaSubscription *m_subscription;
+    QOpcUaEventFilter m_filter;
+    // Written on the backend thread, Good while the monitored item exists on the server
+    QAtomicInteger<quint32> m_status;
 };
 
 QT_END_NAMESPACE
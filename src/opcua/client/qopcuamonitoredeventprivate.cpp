@@ -42,6 +42,7 @@ QT_BEGIN_NAMESPACE
 QOpcUaMonitoredEventPrivate::QOpcUaMonitoredEventPrivate(QOpcUaNode *node, QOpcUaSubscription *subscription)
     : m_node(node)
     , m_subscription(subscription)
+    , m_status(static_cast<quint32>(QOpcUa::UaStatusCode::Good))
 {
 }
 
@@ -51,12 +52,24 @@ QOpcUaMonitoredEventPrivate::~QOpcUaMonitoredEventPrivate()
 
 bool QOpcUaMonitoredEventPrivate::triggerNewEvent(const QVector<QVariant> &val)
 {
-    static const int meta = qRegisterMetaType<QVector<QVariant>>();
+    return triggerNewEvents(QVector<QVector<QVariant>>{val});
+}
+
+bool QOpcUaMonitoredEventPrivate::triggerNewEvents(const QVector<QVector<QVariant>> &events)
+{
+    static const int meta = qRegisterMetaType<QVector<QVector<QVariant>>>();
     Q_UNUSED(meta);
 
     // explicitly use invoke to force the signal to be emitted on the main thread
     // even if the plugin triggered this from a worker thread
-    return QMetaObject::invokeMethod(q_func(), "newEvent", Qt::AutoConnection, Q_ARG(QVector<QVariant>, val));
+    return QMetaObject::invokeMethod(q_func(), "newEvents", Qt::AutoConnection, Q_ARG(QVector<QVector<QVariant>>, events));
+}
+
+// Called by the backend when the monitored item could or could not be created on the server
+void QOpcUaMonitoredEventPrivate::setStatus(QOpcUa::UaStatusCode status)
+{
+    if (m_status.fetchAndStoreRelaxed(static_cast<quint32>(status)) != static_cast<quint32>(status))
+        QMetaObject::invokeMethod(q_func(), "statusChanged", Qt::AutoConnection, Q_ARG(QOpcUa::UaStatusCode, status));
 }
 
 QT_END_NAMESPACE
@@ -36,6 +36,7 @@
 
 #include "qopcuamonitoredvalue.h"
 #include "qopcuasubscription.h"
+#include "qopcuatypedmonitoredvalue.h"
 #include <private/qopcuamonitoredvalue_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -54,6 +55,27 @@ QT_BEGIN_NAMESPACE
     Deletion causes the monitored items to be unsubscribed from the server.
 */
 
+/*!
+    \class QOpcUaAggregationWindow
+    \inmodule QtOpcUa
+
+    \brief Configures the client side aggregation of a QOpcUaMonitoredValue.
+
+    \c length is the length of the window in milliseconds. \c step is the time
+    between two aggregates of a sliding window and defaults to \c length.
+*/
+
+/*!
+    \class QOpcUaAggregateValue
+    \inmodule QtOpcUa
+
+    \brief The aggregate of the data changes of a QOpcUaMonitoredValue in one window.
+
+    \c minimum, \c maximum and \c average are calculated from the \c numericCount
+    values which can be converted to double, \c count is the number of all data
+    changes in the window and \c last is the most recent value.
+*/
+
 /*!
     \fn void QOpcUaMonitoredValue::valueChanged(QVariant val) const
 
@@ -61,6 +83,68 @@ QT_BEGIN_NAMESPACE
     arrives. \a val contains the new value.
  */
 
+/*!
+    \fn void QOpcUaMonitoredValue::statusChanged(QOpcUa::UaStatusCode status) const
+
+    This signal is emitted when the monitored item of this value monitor is lost or
+    restored, for example because it could not be created again after a reconnect.
+    \a status is the new status().
+ */
+
+/*!
+    \fn void QOpcUaMonitoredValue::aggregateChanged(QOpcUaAggregateValue aggregate) const
+
+    This signal is emitted at the end of each aggregation window which contained at
+    least one data change. \a aggregate contains minimum, maximum and average of the
+    numeric values, the last value and the number of data changes in the window.
+
+    \sa setAggregationWindow()
+ */
+
+/*!
+    \class QOpcUaValueSink
+    \inmodule QtOpcUa
+
+    \brief Receives the data changes of a QOpcUaMonitoredValue as a native type.
+
+    A sink is passed to QOpcUaSubscription::addValue() and replaces the
+    QOpcUaMonitoredValue::valueChanged() signal. All functions are called on the
+    backend thread. If the type reported by elementType() and isArray() matches the
+    type sent by the server, the backend passes a pointer to the value in setValue()
+    without creating a QVariant. Otherwise setVariant() is called.
+*/
+
+/*!
+    Destroys the sink.
+*/
+QOpcUaValueSink::~QOpcUaValueSink()
+{
+}
+
+/*!
+    \class QOpcUaTypedMonitoredValue
+    \inmodule QtOpcUa
+
+    \brief A value monitor which delivers the value as \c T instead of a QVariant.
+
+    \c T is a numeric type or bool, or a QVector of them. The open62541 backend writes
+    scalars and arrays of the matching OPC UA type directly into \c T, arrays are
+    copied with a single memcpy. Other values are converted from a QVariant.
+
+    The callback is called with every changed value. If a context object is given, it
+    is queued to the thread of the context object, otherwise it is called on the
+    backend thread. Once the context object has been deleted, values are dropped.
+    Since moc does not support templates, there is no signal.
+
+    \code
+    QOpcUaTypedMonitoredValue<double> temperature(subscription, node, this,
+        [this](double value, QOpcUa::UaStatusCode) { updateTemperature(value); });
+    \endcode
+
+    A typed value monitor can not be shared with other value monitors of the same node,
+    the value it receives is its own.
+*/
+
 QOpcUaMonitoredValue::QOpcUaMonitoredValue(QOpcUaNode *node, QOpcUaSubscription *subscription, QObject *parent)
     : QObject(*new QOpcUaMonitoredValuePrivate(node, subscription), parent)
 {
@@ -83,4 +167,75 @@ QOpcUaNode &QOpcUaMonitoredValue::node()
     return *d_func()->m_node;
 }
 
+/*!
+    Returns the monitoring parameters of this value monitor. Sampling interval and
+    queue size contain the values revised by the server.
+*/
+QOpcUaMonitoringParameters QOpcUaMonitoredValue::monitoringParameters() const
+{
+    return d_func()->parameters();
+}
+
+/*!
+    Returns the counters of this value monitor. They can be queried at any time,
+    for example to check if queue size and sampling interval suit the change rate
+    of the node.
+
+    \c notifications counts the data changes received, \c suppressedNotifications
+    those which did not emit valueChanged() because the value did not change.
+    \c overflows counts the data changes for which the server reported that the
+    queue of the monitored item overflowed, \c conversionFailures those which
+    could not be converted to a QVariant. \c sequenceGaps is always 0, it is only
+    counted per subscription.
+
+    \sa QOpcUaSubscription::statistics()
+*/
+QOpcUaMonitoringStatistics QOpcUaMonitoredValue::statistics() const
+{
+    return d_func()->m_counters.statistics();
+}
+
+/*!
+    Returns \c Good while the monitored item of this value monitor exists on the server.
+    If the backend could not create it again after the subscription was lost, the status
+    of the failed request is returned and no values are received. The backend retries
+    on the next reconnect.
+
+    \sa statusChanged()
+*/
+QOpcUa::UaStatusCode QOpcUaMonitoredValue::status() const
+{
+    return static_cast<QOpcUa::UaStatusCode>(d_func()->m_status.load());
+}
+
+/*!
+    Reduces the data changes of this value monitor to one aggregate per \a window.
+    The data changes are collected on the backend thread and only aggregateChanged()
+    is emitted, valueChanged() and the notification buffer of the subscription are
+    bypassed. The load on the thread of this object is bounded by the window rate,
+    independent of how often the value changes on the server.
+
+    A tumbling window emits one aggregate for each \c length milliseconds, a sliding
+    window emits an aggregate of the last \c length milliseconds every \c step
+    milliseconds. Windows are closed in the publish cycle of the subscription, so the
+    publishing interval should be shorter than the window.
+
+    A window of type QOpcUaAggregationWindow::Type::None disables the aggregation,
+    the collected data changes are discarded.
+*/
+void QOpcUaMonitoredValue::setAggregationWindow(const QOpcUaAggregationWindow &window)
+{
+    d_func()->setAggregationWindow(window);
+}
+
+/*!
+    Returns the aggregation window of this value monitor.
+
+    \sa setAggregationWindow()
+*/
+QOpcUaAggregationWindow QOpcUaMonitoredValue::aggregationWindow() const
+{
+    return d_func()->m_aggregationWindow;
+}
+
 QT_END_NAMESPACE
@@ -38,6 +38,9 @@
 #define QOPCUAMONITOREDVALUE_H
 
 #include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuaaggregation.h>
+#include <QtOpcUa/qopcuamonitoringparameters.h>
+#include <QtOpcUa/qopcuamonitoringstatistics.h>
 #include <QtOpcUa/qopcuanode.h>
 
 #include <QtCore/qvariant.h>
@@ -58,9 +61,17 @@ public:
     QOpcUaMonitoredValue(QOpcUaNode *node, QOpcUaSubscription *subscription, QObject *parent = nullptr);
     ~QOpcUaMonitoredValue() override;
     QOpcUaNode &node();
+    QOpcUaMonitoringParameters monitoringParameters() const;
+    QOpcUaMonitoringStatistics statistics() const;
+    QOpcUa::UaStatusCode status() const;
+
+    void setAggregationWindow(const QOpcUaAggregationWindow &window);
+    QOpcUaAggregationWindow aggregationWindow() const;
 
 Q_SIGNALS:
     void valueChanged(QVariant val) const;
+    void aggregateChanged(QOpcUaAggregateValue aggregate) const;
+    void statusChanged(QOpcUa::UaStatusCode status) const;
 private:
     Q_DISABLE_COPY(QOpcUaMonitoredValue)
 };
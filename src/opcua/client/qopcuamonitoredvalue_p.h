@@ -51,14 +51,21 @@
 #include <QtOpcUa/qopcuaglobal.h>
 #include <QtOpcUa/qopcuamonitoredvalue.h>
 #include <QtOpcUa/qopcuanode.h>
+#include <private/qopcuamonitoringcounters_p.h>
+#include <private/qopcuavalueaggregator_p.h>
 
 #include <private/qobject_p.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qscopedpointer.h>
 #include <QtCore/qvariant.h>
 
 QT_BEGIN_NAMESPACE
 
 class QOpcUaSubscriptionImpl;
 class QOpcUaSubscription;
+class QOpcUaValueSink;
 
 class Q_OPCUA_EXPORT QOpcUaMonitoredValuePrivate : public QObjectPrivate
 {
@@ -67,10 +74,41 @@ public:
     QOpcUaMonitoredValuePrivate(QOpcUaNode *node, QOpcUaSubscription *subscription);
     ~QOpcUaMonitoredValuePrivate() override;
 
-    void triggerValueChanged(const QVariant &val);
+    void triggerValueChanged(const QVariant &val,
+                             QOpcUa::UaStatusCode statusCode = QOpcUa::UaStatusCode::Good,
+                             const QDateTime &sourceTimestamp = QDateTime(),
+                             const QDateTime &serverTimestamp = QDateTime());
+    void triggerTypedValue(const void *value, QOpcUa::UaStatusCode statusCode);
+    bool wantsRawValue() const;
+    void triggerRawValue(const QByteArray &encodedValue, quint32 clientHandle, QOpcUa::UaStatusCode statusCode,
+                         const QDateTime &sourceTimestamp, const QDateTime &serverTimestamp);
+    void reportOverflow();
+    void reportConversionFailure();
+    void setAggregationWindow(const QOpcUaAggregationWindow &window);
+    void flushAggregation(qint64 now);
+    void emitAggregates(const QVector<QOpcUaAggregateValue> &aggregates);
+    void countSuppressed();
+    void setStatus(QOpcUa::UaStatusCode status);
+    void setParameters(const QOpcUaMonitoringParameters &parameters);
+    QOpcUaMonitoringParameters parameters() const;
+
     QOpcUaNode *m_node;
     QOpcUaSubscription *m_subscription;
     QVariant m_currentValue;
+    // Revised by the backend thread, read on the owning thread
+    mutable QMutex m_parametersMutex;
+    QOpcUaMonitoringParameters m_parameters;
+    QOpcUaMonitoringCounters m_counters;
+    // Written on the backend thread, Good while the monitored item exists on the server
+    QAtomicInteger<quint32> m_status;
+    // Set before the value is added to the backend, receives the values instead of valueChanged()
+    QOpcUaValueSink *m_sink;
+
+    // The aggregator is used on the backend thread and replaced on the owning thread
+    QMutex m_aggregationMutex;
+    QScopedPointer<QOpcUaValueAggregator> m_aggregator;
+    QOpcUaAggregationWindow m_aggregationWindow;
+    QAtomicInt m_aggregating;
 };
 
 QT_END_NAMESPACE
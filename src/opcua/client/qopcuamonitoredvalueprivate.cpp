@@ -34,7 +34,9 @@
 **
 ****************************************************************************/
 
+#include <QtOpcUa/qopcuatypedmonitoredvalue.h>
 #include <private/qopcuamonitoredvalue_p.h>
+#include <private/qopcuasubscription_p.h>
 #include <private/qopcuasubscriptionimpl_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -44,6 +46,8 @@ QOpcUaMonitoredValuePrivate::QOpcUaMonitoredValuePrivate(QOpcUaNode *node, QOpcU
     , m_subscription(subscription)
     // TODO: is it useful to initialize a monitored item with a potentially uninitialized value?
     , m_currentValue(node->attribute(QOpcUaNode::NodeAttribute::Value))
+    , m_status(static_cast<quint32>(QOpcUa::UaStatusCode::Good))
+    , m_sink(nullptr)
 {
 }
 
@@ -51,14 +55,165 @@ QOpcUaMonitoredValuePrivate::~QOpcUaMonitoredValuePrivate()
 {
 }
 
-void QOpcUaMonitoredValuePrivate::triggerValueChanged(const QVariant &val)
+void QOpcUaMonitoredValuePrivate::triggerValueChanged(const QVariant &val, QOpcUa::UaStatusCode statusCode,
+                                                      const QDateTime &sourceTimestamp, const QDateTime &serverTimestamp)
 {
+    m_counters.notifications.fetchAndAddRelaxed(1);
+    if (m_subscription)
+        m_subscription->d_func()->m_counters.notifications.fetchAndAddRelaxed(1);
+
+    // Typed value monitors convert the value themselves
+    if (m_sink) {
+        if (!m_sink->setVariant(val, statusCode))
+            countSuppressed();
+        return;
+    }
+
+    // Only the aggregates are delivered if an aggregation window is set
+    if (m_aggregating.loadAcquire()) {
+        QMutexLocker locker(&m_aggregationMutex);
+        if (m_aggregator) {
+            const qint64 now = QDateTime::currentMSecsSinceEpoch();
+            // Close the windows which ended before this data change arrived
+            QVector<QOpcUaAggregateValue> aggregates;
+            m_aggregator->flush(now, &aggregates);
+            m_aggregator->addSample(val, now);
+            locker.unlock();
+            emitAggregates(aggregates);
+            return;
+        }
+    }
+
+    // Polling consumers get every notification without going through the event loop
+    if (m_subscription && m_subscription->d_func()->hasNotificationBuffer()) {
+        QOpcUaDataChangeNotification notification;
+        notification.monitoredValue = q_func();
+        notification.value = val;
+        notification.statusCode = statusCode;
+        notification.sourceTimestamp = sourceTimestamp;
+        notification.serverTimestamp = serverTimestamp;
+        m_subscription->d_func()->enqueueNotification(std::move(notification));
+        return;
+    }
+
     // explicitly use invoke to force the signal to be emitted on the main thread
     // even if the plugin triggered this from a worker thread
     if (val != m_currentValue) {
         m_currentValue = val;
         QMetaObject::invokeMethod(q_func(), "valueChanged", Qt::AutoConnection, Q_ARG(QVariant, val));
+    } else {
+        countSuppressed();
+    }
+}
+
+bool QOpcUaMonitoredValuePrivate::wantsRawValue() const
+{
+    return m_subscription && m_subscription->d_func()->wantsRawValues();
+}
+
+void QOpcUaMonitoredValuePrivate::triggerRawValue(const QByteArray &encodedValue, quint32 clientHandle,
+                                                  QOpcUa::UaStatusCode statusCode,
+                                                  const QDateTime &sourceTimestamp, const QDateTime &serverTimestamp)
+{
+    m_counters.notifications.fetchAndAddRelaxed(1);
+    m_subscription->d_func()->m_counters.notifications.fetchAndAddRelaxed(1);
+
+    QOpcUaDataChangeNotification notification;
+    notification.monitoredValue = q_func();
+    notification.statusCode = statusCode;
+    notification.sourceTimestamp = sourceTimestamp;
+    notification.serverTimestamp = serverTimestamp;
+    notification.clientHandle = clientHandle;
+    notification.encodedValue = encodedValue;
+    m_subscription->d_func()->enqueueNotification(std::move(notification));
+}
+
+// Called by the backend if it could write the value directly into the type of m_sink
+void QOpcUaMonitoredValuePrivate::triggerTypedValue(const void *value, QOpcUa::UaStatusCode statusCode)
+{
+    m_counters.notifications.fetchAndAddRelaxed(1);
+    if (m_subscription)
+        m_subscription->d_func()->m_counters.notifications.fetchAndAddRelaxed(1);
+
+    if (!m_sink->setValue(value, statusCode))
+        countSuppressed();
+}
+
+void QOpcUaMonitoredValuePrivate::countSuppressed()
+{
+    m_counters.suppressedNotifications.fetchAndAddRelaxed(1);
+    if (m_subscription)
+        m_subscription->d_func()->m_counters.suppressedNotifications.fetchAndAddRelaxed(1);
+}
+
+// Called by the backend with the parameters revised by the server
+void QOpcUaMonitoredValuePrivate::setParameters(const QOpcUaMonitoringParameters &parameters)
+{
+    QMutexLocker locker(&m_parametersMutex);
+    m_parameters = parameters;
+}
+
+QOpcUaMonitoringParameters QOpcUaMonitoredValuePrivate::parameters() const
+{
+    QMutexLocker locker(&m_parametersMutex);
+    return m_parameters;
+}
+
+// Called by the backend when the monitored item could or could not be created on the server
+void QOpcUaMonitoredValuePrivate::setStatus(QOpcUa::UaStatusCode status)
+{
+    if (m_status.fetchAndStoreRelaxed(static_cast<quint32>(status)) != static_cast<quint32>(status))
+        QMetaObject::invokeMethod(q_func(), "statusChanged", Qt::AutoConnection, Q_ARG(QOpcUa::UaStatusCode, status));
+}
+
+// Called by the backend if the server reported that the queue of the monitored item overflowed
+void QOpcUaMonitoredValuePrivate::reportOverflow()
+{
+    m_counters.overflows.fetchAndAddRelaxed(1);
+    if (m_subscription)
+        m_subscription->d_func()->m_counters.overflows.fetchAndAddRelaxed(1);
+}
+
+void QOpcUaMonitoredValuePrivate::setAggregationWindow(const QOpcUaAggregationWindow &window)
+{
+    QMutexLocker locker(&m_aggregationMutex);
+    m_aggregationWindow = window;
+    if (window.type == QOpcUaAggregationWindow::Type::None)
+        m_aggregator.reset();
+    else
+        m_aggregator.reset(new QOpcUaValueAggregator(window, QDateTime::currentMSecsSinceEpoch()));
+    m_aggregating.storeRelease(m_aggregator ? 1 : 0);
+}
+
+// Called periodically by the backend to emit the aggregates of all windows ended before now
+void QOpcUaMonitoredValuePrivate::flushAggregation(qint64 now)
+{
+    if (!m_aggregating.loadAcquire())
+        return;
+
+    QVector<QOpcUaAggregateValue> aggregates;
+    {
+        QMutexLocker locker(&m_aggregationMutex);
+        if (!m_aggregator)
+            return;
+        m_aggregator->flush(now, &aggregates);
     }
+
+    emitAggregates(aggregates);
+}
+
+void QOpcUaMonitoredValuePrivate::emitAggregates(const QVector<QOpcUaAggregateValue> &aggregates)
+{
+    for (const QOpcUaAggregateValue &aggregate : aggregates)
+        QMetaObject::invokeMethod(q_func(), "aggregateChanged", Qt::AutoConnection, Q_ARG(QOpcUaAggregateValue, aggregate));
+}
+
+// Called by the backend if a data change could not be converted to a QVariant
+void QOpcUaMonitoredValuePrivate::reportConversionFailure()
+{
+    m_counters.conversionFailures.fetchAndAddRelaxed(1);
+    if (m_subscription)
+        m_subscription->d_func()->m_counters.conversionFailures.fetchAndAddRelaxed(1);
 }
 
 QT_END_NAMESPACE
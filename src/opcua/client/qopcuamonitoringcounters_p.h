@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAMONITORINGCOUNTERS_P_H
+#define QOPCUAMONITORINGCOUNTERS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuamonitoringstatistics.h>
+
+#include <QtCore/qatomic.h>
+
+QT_BEGIN_NAMESPACE
+
+// Incremented on the backend thread, read from any thread
+struct QOpcUaMonitoringCounters
+{
+    QAtomicInteger<quint64> notifications;
+    QAtomicInteger<quint64> overflows;
+    QAtomicInteger<quint64> suppressedNotifications;
+    QAtomicInteger<quint64> conversionFailures;
+    QAtomicInteger<quint64> sequenceGaps;
+
+    QOpcUaMonitoringCounters()
+        : notifications(0)
+        , overflows(0)
+        , suppressedNotifications(0)
+        , conversionFailures(0)
+        , sequenceGaps(0)
+    {}
+
+    QOpcUaMonitoringStatistics statistics() const
+    {
+        QOpcUaMonitoringStatistics result;
+        result.notifications = notifications.load();
+        result.overflows = overflows.load();
+        result.suppressedNotifications = suppressedNotifications.load();
+        result.conversionFailures = conversionFailures.load();
+        result.sequenceGaps = sequenceGaps.load();
+        return result;
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAMONITORINGCOUNTERS_P_H
@@ -0,0 +1,130 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAMONITORINGPARAMETERS_H
+#define QOPCUAMONITORINGPARAMETERS_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qmetatype.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QOpcUaMonitoringParameters {
+    enum class DataChangeTrigger : quint32 {
+        Status = 0,
+        StatusValue = 1,
+        StatusValueTimestamp = 2
+    };
+
+    enum class DeadbandType : quint32 {
+        None = 0,
+        Absolute = 1,
+        Percent = 2
+    };
+
+    struct DataChangeFilter {
+        DataChangeTrigger trigger;
+        DeadbandType deadbandType;
+        double deadbandValue;
+        DataChangeFilter(DataChangeTrigger p_trigger = DataChangeTrigger::StatusValue,
+                         DeadbandType p_deadbandType = DeadbandType::None, double p_deadbandValue = 0)
+            : trigger(p_trigger)
+            , deadbandType(p_deadbandType)
+            , deadbandValue(p_deadbandValue)
+        {}
+    };
+
+    struct AggregateConfiguration {
+        bool useServerCapabilitiesDefaults;
+        bool treatUncertainAsBad;
+        quint8 percentDataBad;
+        quint8 percentDataGood;
+        bool useSlopedExtrapolation;
+        AggregateConfiguration()
+            : useServerCapabilitiesDefaults(true)
+            , treatUncertainAsBad(true)
+            , percentDataBad(100)
+            , percentDataGood(100)
+            , useSlopedExtrapolation(false)
+        {}
+    };
+
+    struct AggregateFilter {
+        QString aggregateType;
+        QDateTime startTime;
+        double processingInterval;
+        AggregateConfiguration configuration;
+        AggregateFilter(const QString &p_aggregateType = QString(), double p_processingInterval = 0,
+                        const QDateTime &p_startTime = QDateTime())
+            : aggregateType(p_aggregateType)
+            , startTime(p_startTime)
+            , processingInterval(p_processingInterval)
+        {}
+    };
+
+    struct AggregateFilterResult {
+        QDateTime revisedStartTime;
+        double revisedProcessingInterval;
+        AggregateConfiguration revisedConfiguration;
+        AggregateFilterResult()
+            : revisedProcessingInterval(0)
+        {}
+    };
+
+    double samplingInterval;
+    quint32 queueSize;
+    bool discardOldest;
+    QVariant filter;
+    QVariant filterResult;
+    explicit QOpcUaMonitoringParameters(double p_samplingInterval = -1, quint32 p_queueSize = 1)
+        : samplingInterval(p_samplingInterval)
+        , queueSize(p_queueSize)
+        , discardOldest(true)
+    {}
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QOpcUaMonitoringParameters)
+Q_DECLARE_METATYPE(QOpcUaMonitoringParameters::DataChangeFilter)
+Q_DECLARE_METATYPE(QOpcUaMonitoringParameters::AggregateFilter)
+Q_DECLARE_METATYPE(QOpcUaMonitoringParameters::AggregateFilterResult)
+
+#endif // QOPCUAMONITORINGPARAMETERS_H
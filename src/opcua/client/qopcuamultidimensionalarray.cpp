@@ -0,0 +1,321 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopcuamultidimensionalarray.h"
+
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaMultiDimensionalArray
+    \inmodule QtOpcUa
+
+    \brief A strided view on the elements of a multi-dimensional OPC UA array.
+
+    Values with more than one array dimension are returned as
+    QOpcUaMultiDimensionalArray instead of a flat QVariantList.
+    All elements are stored in one buffer, which is returned by data().
+    Numeric arrays use a QVector of the matching C++ type, for example
+    QVector<float> for a matrix of Float. All other arrays use a QVariantList.
+
+    The elements are stored in the OPC UA order, so the last dimension
+    varies fastest. The flat index of an element is offset() plus the
+    sum of each index multiplied with the stride of its dimension.
+
+    slice() returns a view of a part of the array which shares the buffer
+    with the original array, no elements are copied. compacted() copies the
+    elements of a view into a new buffer. A view can be written as is, it is
+    compacted by the backend.
+
+    To read or write only a part of an array on the server, pass a string
+    created by indexRange() to QOpcUaNode::readAttributeRange() or
+    QOpcUaNode::writeAttributeRange().
+*/
+
+/*!
+    \typedef QOpcUaMultiDimensionalArray::Range
+
+    The first and the last index of a range in one dimension. Both indices are inclusive.
+*/
+
+static int dataSize(const QVariant &data)
+{
+    if (data.type() == QVariant::List)
+        return data.toList().size();
+    if (data.canConvert<QSequentialIterable>())
+        return data.value<QSequentialIterable>().size();
+    return 0;
+}
+
+static QVector<quint32> rowMajorStrides(const QVector<quint32> &dimensions)
+{
+    QVector<quint32> strides(dimensions.size());
+    quint32 stride = 1;
+    for (int i = dimensions.size() - 1; i >= 0; --i) {
+        strides[i] = stride;
+        stride *= dimensions.at(i);
+    }
+    return strides;
+}
+
+template<typename T>
+static bool gatherVector(const QVariant &data, const QVector<int> &indices, QVariant *result)
+{
+    if (data.userType() != qMetaTypeId<QVector<T>>())
+        return false;
+
+    const QVector<T> source = data.value<QVector<T>>();
+    QVector<T> target;
+    target.reserve(indices.size());
+    for (int index : indices)
+        target.append(source.at(index));
+    *result = QVariant::fromValue(target);
+    return true;
+}
+
+static QVariant gather(const QVariant &data, const QVector<int> &indices)
+{
+    QVariant result;
+    if (gatherVector<bool>(data, indices, &result) || gatherVector<qint8>(data, indices, &result)
+            || gatherVector<quint8>(data, indices, &result) || gatherVector<qint16>(data, indices, &result)
+            || gatherVector<quint16>(data, indices, &result) || gatherVector<qint32>(data, indices, &result)
+            || gatherVector<quint32>(data, indices, &result) || gatherVector<qint64>(data, indices, &result)
+            || gatherVector<quint64>(data, indices, &result) || gatherVector<float>(data, indices, &result)
+            || gatherVector<double>(data, indices, &result))
+        return result;
+
+    QVariantList target;
+    target.reserve(indices.size());
+    if (data.type() == QVariant::List) {
+        const QVariantList source = data.toList();
+        for (int index : indices)
+            target.append(source.at(index));
+    } else {
+        const QSequentialIterable source = data.value<QSequentialIterable>();
+        for (int index : indices)
+            target.append(source.at(index));
+    }
+    return target;
+}
+
+/*!
+    Constructs an invalid array.
+*/
+QOpcUaMultiDimensionalArray::QOpcUaMultiDimensionalArray()
+    : m_offset(0)
+{}
+
+/*!
+    Constructs an array with the elements in \a data and the sizes in \a dimensions.
+
+    \a data must be a QVariantList or a QVector and contain at least as many
+    elements as the product of \a dimensions.
+*/
+QOpcUaMultiDimensionalArray::QOpcUaMultiDimensionalArray(const QVariant &data, const QVector<quint32> &dimensions)
+    : m_data(data)
+    , m_dimensions(dimensions)
+    , m_strides(rowMajorStrides(dimensions))
+    , m_offset(0)
+{}
+
+/*!
+    Returns \c true if the array has at least one dimension and the buffer contains all elements.
+*/
+bool QOpcUaMultiDimensionalArray::isValid() const
+{
+    if (m_dimensions.isEmpty())
+        return false;
+
+    // Index of the last element
+    quint64 last = m_offset;
+    for (int i = 0; i < m_dimensions.size(); ++i) {
+        if (m_dimensions.at(i) == 0)
+            return true;
+        last += quint64(m_dimensions.at(i) - 1) * m_strides.at(i);
+    }
+    return last < quint64(dataSize(m_data));
+}
+
+/*!
+    Returns \c true if data() contains exactly the elements of this array in the OPC UA order.
+    This is the case for arrays which are not a view created by slice().
+*/
+bool QOpcUaMultiDimensionalArray::isContiguous() const
+{
+    return m_offset == 0 && m_strides == rowMajorStrides(m_dimensions)
+            && elementCount() == quint32(dataSize(m_data));
+}
+
+/*!
+    Returns the buffer containing the elements of this array.
+    The buffer of a view may contain additional elements, see isContiguous().
+*/
+QVariant QOpcUaMultiDimensionalArray::data() const
+{
+    return m_data;
+}
+
+/*!
+    Returns the size of each dimension.
+*/
+QVector<quint32> QOpcUaMultiDimensionalArray::dimensions() const
+{
+    return m_dimensions;
+}
+
+/*!
+    Returns the distance in the buffer between two consecutive elements of each dimension.
+*/
+QVector<quint32> QOpcUaMultiDimensionalArray::strides() const
+{
+    return m_strides;
+}
+
+/*!
+    Returns the index of the first element of this array in the buffer.
+*/
+quint32 QOpcUaMultiDimensionalArray::offset() const
+{
+    return m_offset;
+}
+
+/*!
+    Returns the number of elements of this array.
+*/
+quint32 QOpcUaMultiDimensionalArray::elementCount() const
+{
+    if (m_dimensions.isEmpty())
+        return 0;
+
+    quint32 count = 1;
+    for (quint32 dimension : m_dimensions)
+        count *= dimension;
+    return count;
+}
+
+/*!
+    Returns the element at \a position, which must contain one index per dimension.
+    An invalid QVariant is returned if \a position is out of bounds.
+*/
+QVariant QOpcUaMultiDimensionalArray::value(const QVector<quint32> &position) const
+{
+    if (position.size() != m_dimensions.size() || !isValid())
+        return QVariant();
+
+    int index = m_offset;
+    for (int i = 0; i < position.size(); ++i) {
+        if (position.at(i) >= m_dimensions.at(i))
+            return QVariant();
+        index += position.at(i) * m_strides.at(i);
+    }
+
+    if (m_data.type() == QVariant::List)
+        return m_data.toList().at(index);
+    return m_data.value<QSequentialIterable>().at(index);
+}
+
+/*!
+    Returns a view of the elements in \a ranges which shares the buffer of this array.
+    Dimensions without a range in \a ranges are included completely.
+    An invalid array is returned if a range is out of bounds.
+*/
+QOpcUaMultiDimensionalArray QOpcUaMultiDimensionalArray::slice(const QVector<Range> &ranges) const
+{
+    if (ranges.size() > m_dimensions.size() || !isValid())
+        return QOpcUaMultiDimensionalArray();
+
+    QOpcUaMultiDimensionalArray view(*this);
+    for (int i = 0; i < ranges.size(); ++i) {
+        const Range &range = ranges.at(i);
+        if (range.first > range.second || range.second >= m_dimensions.at(i))
+            return QOpcUaMultiDimensionalArray();
+        view.m_offset += range.first * m_strides.at(i);
+        view.m_dimensions[i] = range.second - range.first + 1;
+    }
+    return view;
+}
+
+/*!
+    Returns a contiguous copy of this array.
+    If the array is already contiguous, the buffer is shared and no elements are copied.
+*/
+QOpcUaMultiDimensionalArray QOpcUaMultiDimensionalArray::compacted() const
+{
+    if (!isValid())
+        return QOpcUaMultiDimensionalArray();
+    if (isContiguous())
+        return *this;
+
+    QVector<int> indices;
+    indices.reserve(elementCount());
+    if (elementCount() > 0) {
+        QVector<quint32> position(m_dimensions.size(), 0);
+        for (;;) {
+            int index = m_offset;
+            for (int i = 0; i < position.size(); ++i)
+                index += position.at(i) * m_strides.at(i);
+            indices.append(index);
+
+            // Advance the last dimension first
+            int dimension = position.size() - 1;
+            while (dimension >= 0 && ++position[dimension] == m_dimensions.at(dimension))
+                position[dimension--] = 0;
+            if (dimension < 0)
+                break;
+        }
+    }
+
+    return QOpcUaMultiDimensionalArray(gather(m_data, indices), m_dimensions);
+}
+
+/*!
+    Returns the OPC UA IndexRange string for \a ranges, for example \c "1:2,0:3".
+*/
+QString QOpcUaMultiDimensionalArray::indexRange(const QVector<Range> &ranges)
+{
+    QStringList parts;
+    parts.reserve(ranges.size());
+    for (const Range &range : ranges) {
+        if (range.first == range.second)
+            parts.append(QString::number(range.first));
+        else
+            parts.append(QStringLiteral("%1:%2").arg(range.first).arg(range.second));
+    }
+    return parts.join(QLatin1Char(','));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAMULTIDIMENSIONALARRAY_H
+#define QOPCUAMULTIDIMENSIONALARRAY_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+
+#include <QtCore/qmetatype.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_OPCUA_EXPORT QOpcUaMultiDimensionalArray
+{
+public:
+    // First and last index of one dimension, both inclusive
+    typedef QPair<quint32, quint32> Range;
+
+    QOpcUaMultiDimensionalArray();
+    QOpcUaMultiDimensionalArray(const QVariant &data, const QVector<quint32> &dimensions);
+
+    bool isValid() const;
+    bool isContiguous() const;
+
+    QVariant data() const;
+    QVector<quint32> dimensions() const;
+    QVector<quint32> strides() const;
+    quint32 offset() const;
+    quint32 elementCount() const;
+
+    QVariant value(const QVector<quint32> &position) const;
+    QOpcUaMultiDimensionalArray slice(const QVector<Range> &ranges) const;
+    QOpcUaMultiDimensionalArray compacted() const;
+
+    static QString indexRange(const QVector<Range> &ranges);
+
+private:
+    QVariant m_data;
+    QVector<quint32> m_dimensions;
+    QVector<quint32> m_strides;
+    quint32 m_offset;
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QOpcUaMultiDimensionalArray)
+
+#endif // QOPCUAMULTIDIMENSIONALARRAY_H
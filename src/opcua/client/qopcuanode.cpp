@@ -162,6 +162,9 @@ bool QOpcUaNode::readAttributes(QOpcUaNode::NodeAttributes attributes)
 
     The value is only valid after the \l readFinished signal has been emitted.
     An empty QVariant is returned if there is no cached value for the attribute.
+
+    Backends may keep the values of a read in their native representation,
+    they are converted to QVariant on the first call of this function.
  */
 QVariant QOpcUaNode::attribute(QOpcUaNode::NodeAttribute attribute) const
 {
@@ -169,9 +172,34 @@ QVariant QOpcUaNode::attribute(QOpcUaNode::NodeAttribute attribute) const
     if (it == d_func()->m_nodeAttributes.constEnd())
         return QVariant();
 
+    if (it->lazyValue) {
+        it->attribute = it->lazyValue->toVariant();
+        it->lazyValue.reset();
+    }
     return it->attribute;
 }
 
+/*!
+    Returns the value of the attribute given in \a attribute together with its OPC UA type.
+
+    Unlike attribute(), the result keeps types apart which share a QVariant representation,
+    for example StatusCode and UInt32. Backends which keep the values of a read in their
+    native representation convert them without creating a QVariant.
+    An invalid QOpcUaVariant is returned if there is no cached value for the attribute.
+
+    \sa attribute()
+ */
+QOpcUaVariant QOpcUaNode::typedAttribute(QOpcUaNode::NodeAttribute attribute) const
+{
+    auto it = d_func()->m_nodeAttributes.constFind(attribute);
+    if (it == d_func()->m_nodeAttributes.constEnd())
+        return QOpcUaVariant();
+
+    if (it->lazyValue)
+        return it->lazyValue->toOpcUaVariant();
+    return QOpcUaVariant::fromQVariant(it->attribute);
+}
+
 /*!
     Returns the error code for the attribute given in \a attribute.
 
@@ -252,6 +280,17 @@ bool QOpcUaNode::writeAttribute(QOpcUaNode::NodeAttribute attribute, const QVari
     return d_func()->m_impl->writeAttribute(attribute, value, type);
 }
 
+/*!
+    \overload
+
+    Writes \a value to the attribute given in \a attribute using the type stored in \a value.
+    Returns true if the asynchronous call has been successfully dispatched.
+*/
+bool QOpcUaNode::writeAttribute(QOpcUaNode::NodeAttribute attribute, const QOpcUaVariant &value)
+{
+    return writeAttribute(attribute, value.toQVariant(), value.type());
+}
+
 /*!
     Executes a write operation for the attributes and values specified in \a toWrite.
     Returns true if the asynchronous call has been successfully dispatched.
@@ -268,6 +307,52 @@ bool QOpcUaNode::writeAttributes(const AttributeMap &toWrite, QOpcUa::Types valu
     return d_func()->m_impl->writeAttributes(toWrite, valueAttributeType);
 }
 
+/*!
+    Starts an asynchronous read operation for the elements in \a indexRange of the
+    array in \a attribute. Returns true if the asynchronous call has been successfully dispatched.
+
+    \a indexRange uses the OPC UA IndexRange syntax, one range per dimension separated by commas,
+    for example \c "1:2,0:3". QOpcUaMultiDimensionalArray::indexRange() creates such a string.
+    After the \l readFinished signal has been emitted, attribute() returns only the requested elements.
+*/
+bool QOpcUaNode::readAttributeRange(QOpcUaNode::NodeAttribute attribute, const QString &indexRange)
+{
+    if (d_func()->m_client.isNull() || d_func()->m_client->state() != QOpcUaClient::Connected)
+        return false;
+
+    return d_func()->m_impl->readAttributeRange(attribute, indexRange);
+}
+
+/*!
+    Writes \a value to the elements in \a indexRange of the array in \a attribute.
+    Returns true if the asynchronous call has been successfully dispatched.
+
+    \a value must contain exactly the elements of the range, either as a list, a QVector
+    or a QOpcUaMultiDimensionalArray. The \a type parameter is used like in writeAttribute().
+    As only a part of the attribute is written, the cached value of the attribute is cleared
+    when the \l attributeWritten signal is emitted.
+*/
+bool QOpcUaNode::writeAttributeRange(QOpcUaNode::NodeAttribute attribute, const QVariant &value,
+                                     const QString &indexRange, QOpcUa::Types type)
+{
+    if (d_func()->m_client.isNull() || d_func()->m_client->state() != QOpcUaClient::Connected)
+        return false;
+
+    return d_func()->m_impl->writeAttributeRange(attribute, value, indexRange, type);
+}
+
+/*!
+    \overload
+
+    Writes \a value to the elements in \a indexRange of the array in \a attribute
+    using the type stored in \a value.
+*/
+bool QOpcUaNode::writeAttributeRange(QOpcUaNode::NodeAttribute attribute, const QOpcUaVariant &value,
+                                     const QString &indexRange)
+{
+    return writeAttributeRange(attribute, value.toQVariant(), indexRange, value.type());
+}
+
 /*!
    QStringList filled with the node IDs of all child nodes of the OPC UA node.
 */
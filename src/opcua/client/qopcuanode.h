@@ -39,6 +39,7 @@
 
 #include <QtOpcUa/qopcuaglobal.h>
 #include <QtOpcUa/qopcuatype.h>
+#include <QtOpcUa/qopcuavariant.h>
 
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
@@ -115,9 +116,15 @@ public:
 
     bool readAttributes(QOpcUaNode::NodeAttributes attributes = mandatoryBaseAttributes());
     QVariant attribute(QOpcUaNode::NodeAttribute attribute) const;
+    QOpcUaVariant typedAttribute(QOpcUaNode::NodeAttribute attribute) const;
     QOpcUa::UaStatusCode attributeError(QOpcUaNode::NodeAttribute attribute) const;
     bool writeAttribute(QOpcUaNode::NodeAttribute attribute, const QVariant &value, QOpcUa::Types type = QOpcUa::Types::Undefined);
+    bool writeAttribute(QOpcUaNode::NodeAttribute attribute, const QOpcUaVariant &value);
     bool writeAttributes(const AttributeMap &toWrite, QOpcUa::Types valueAttributeType = QOpcUa::Types::Undefined);
+    bool readAttributeRange(QOpcUaNode::NodeAttribute attribute, const QString &indexRange);
+    bool writeAttributeRange(QOpcUaNode::NodeAttribute attribute, const QVariant &value,
+                             const QString &indexRange, QOpcUa::Types type = QOpcUa::Types::Undefined);
+    bool writeAttributeRange(QOpcUaNode::NodeAttribute attribute, const QOpcUaVariant &value, const QString &indexRange);
 
     QStringList childrenIds() const;
     QString nodeId() const;
@@ -73,9 +73,9 @@ public:
         {
             for (auto &entry : qAsConst(attr)) {
                 if (serviceResult == QOpcUa::UaStatusCode::Good)
-                    m_nodeAttributes[entry.attributeId] = { entry.value, entry.statusCode };
+                    m_nodeAttributes[entry.attributeId] = { entry.value, entry.statusCode, entry.lazyValue };
                 else
-                    m_nodeAttributes[entry.attributeId] = { QVariant(), serviceResult };
+                    m_nodeAttributes[entry.attributeId] = { QVariant(), serviceResult, QSharedPointer<QOpcUaLazyValue>() };
             }
 
             QOpcUaNode::NodeAttributes updatedAttributes;
@@ -89,8 +89,10 @@ public:
                 [this](QOpcUaNode::NodeAttribute attr, QVariant value, QOpcUa::UaStatusCode statusCode)
         {
             m_nodeAttributes[attr].statusCode = statusCode;
-            if (statusCode == QOpcUa::UaStatusCode::Good)
+            if (statusCode == QOpcUa::UaStatusCode::Good) {
                 m_nodeAttributes[attr].attribute = value;
+                m_nodeAttributes[attr].lazyValue.reset();
+            }
 
             emit q_func()->attributeWritten(attr, statusCode);
         });
@@ -106,8 +108,10 @@ public:
     QPointer<QOpcUaClient> m_client;
 
     struct AttributeWithStatus {
-        QVariant attribute;
+        // Converted from lazyValue on the first access
+        mutable QVariant attribute;
         QOpcUa::UaStatusCode statusCode;
+        mutable QSharedPointer<QOpcUaLazyValue> lazyValue;
     };
     QHash<QOpcUaNode::NodeAttribute, AttributeWithStatus> m_nodeAttributes;
 
@@ -46,4 +46,13 @@ QOpcUaNodeImpl::~QOpcUaNodeImpl()
 {
 }
 
+QOpcUaLazyValue::~QOpcUaLazyValue()
+{
+}
+
+QOpcUaVariant QOpcUaLazyValue::toOpcUaVariant() const
+{
+    return QOpcUaVariant::fromQVariant(toVariant());
+}
+
 QT_END_NAMESPACE
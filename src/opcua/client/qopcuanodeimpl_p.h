@@ -51,7 +51,9 @@
 #include <QtOpcUa/qopcuaglobal.h>
 #include <QtOpcUa/qopcuanode.h>
 #include <QtOpcUa/qopcuatype.h>
+#include <QtOpcUa/qopcuavariant.h>
 
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qvariant.h>
 
 QT_BEGIN_NAMESPACE
@@ -59,10 +61,22 @@ QT_BEGIN_NAMESPACE
 class QOpcUaMonitoredEvent;
 class QOpcUaMonitoredValue;
 
+// A value in the native representation of a backend, converted when the attribute is accessed
+class Q_OPCUA_EXPORT QOpcUaLazyValue
+{
+public:
+    virtual ~QOpcUaLazyValue();
+    virtual QVariant toVariant() const = 0;
+    // Backends override this to skip the intermediate QVariant
+    virtual QOpcUaVariant toOpcUaVariant() const;
+};
+
 struct QOpcUaReadResult {
     QOpcUaNode::NodeAttribute attributeId;
     QOpcUa::UaStatusCode statusCode;
     QVariant value;
+    // Set instead of value by backends which defer the conversion
+    QSharedPointer<QOpcUaLazyValue> lazyValue;
 };
 
 class Q_OPCUA_EXPORT QOpcUaNodeImpl : public QObject
@@ -78,6 +92,9 @@ public:
 
     virtual bool writeAttribute(QOpcUaNode::NodeAttribute attribute, const QVariant &value, QOpcUa::Types type) = 0;
     virtual bool writeAttributes(const QOpcUaNode::AttributeMap &toWrite, QOpcUa::Types valueAttributeType) = 0;
+    virtual bool readAttributeRange(QOpcUaNode::NodeAttribute attribute, const QString &indexRange) = 0;
+    virtual bool writeAttributeRange(QOpcUaNode::NodeAttribute attribute, const QVariant &value,
+                                     const QString &indexRange, QOpcUa::Types type) = 0;
 
     virtual QPair<double, double> readEuRange() const = 0;
     virtual QPair<QString, QString> readEui() const = 0;
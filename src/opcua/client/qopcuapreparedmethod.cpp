@@ -0,0 +1,189 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopcuapreparedmethod.h"
+#include <private/qopcuapreparedmethod_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaPreparedMethod
+    \inmodule QtOpcUa
+
+    \brief QOpcUaPreparedMethod calls a method with the argument types declared by the server.
+
+    A prepared method is created by QOpcUaClient::prepareMethod(). The client
+    resolves the InputArguments and OutputArguments properties of the method
+    in the background, prepared() is emitted when they are known. The
+    arguments of a method are only fetched once per session, all prepared
+    methods with the same method node share them.
+
+    Afterwards call() and methodCall() convert the arguments to the data types
+    declared by the server instead of deriving them from the QVariant types,
+    e.g. an \c int is sent as UInt16 if the method expects one. This avoids
+    \c BadTypeMismatch results without passing a type for each argument.
+    The results of call() are delivered with QOpcUaClient::methodsCalled().
+
+    \sa QOpcUaClient::callMethods()
+*/
+
+/*!
+    \class QOpcUaMethodArgument
+    \inmodule QtOpcUa
+
+    \brief The declaration of a method argument.
+
+    \c name is the name of the argument, \c type its data type or
+    QOpcUa::Undefined if the data type has no matching QOpcUa::Types value.
+    \c valueRank and \c arrayDimensions describe the dimensions of the
+    argument as for the ValueRank and ArrayDimensions attributes of a variable.
+
+    \sa QOpcUaPreparedMethod
+*/
+
+/*!
+    \fn QOpcUaPreparedMethod::prepared(QOpcUa::UaStatusCode statusCode)
+
+    This signal is emitted when the arguments of the method have been resolved.
+    The method is only prepared if \a statusCode is \c Good.
+*/
+
+/*!
+    \internal QOpcUaClientImpl is an opaque type (as seen from the public API).
+    Prepared methods are created by QOpcUaClient::prepareMethod().
+*/
+QOpcUaPreparedMethod::QOpcUaPreparedMethod(QOpcUaClientImpl *impl, QOpcUaClient *client, const QString &objectId,
+                                           const QString &methodId, QObject *parent)
+    : QObject(*new QOpcUaPreparedMethodPrivate(impl, client, objectId, methodId), parent)
+{
+}
+
+QOpcUaPreparedMethod::~QOpcUaPreparedMethod()
+{
+}
+
+/*!
+    Returns the node id of the object the method is called on.
+*/
+QString QOpcUaPreparedMethod::objectId() const
+{
+    Q_D(const QOpcUaPreparedMethod);
+    return d->m_objectId;
+}
+
+/*!
+    Returns the node id of the method.
+*/
+QString QOpcUaPreparedMethod::methodId() const
+{
+    Q_D(const QOpcUaPreparedMethod);
+    return d->m_methodId;
+}
+
+/*!
+    Returns \c true if the arguments of the method have been resolved.
+*/
+bool QOpcUaPreparedMethod::isPrepared() const
+{
+    Q_D(const QOpcUaPreparedMethod);
+    return d->m_prepared;
+}
+
+/*!
+    Returns the status of resolving the arguments. It is \c BadNotSupported
+    for backends which can not resolve method arguments.
+*/
+QOpcUa::UaStatusCode QOpcUaPreparedMethod::statusCode() const
+{
+    Q_D(const QOpcUaPreparedMethod);
+    return d->m_statusCode;
+}
+
+/*!
+    Returns the input arguments declared by the method, the list is empty
+    until the method has been prepared.
+*/
+QVector<QOpcUaMethodArgument> QOpcUaPreparedMethod::inputArguments() const
+{
+    Q_D(const QOpcUaPreparedMethod);
+    return d->m_inputArguments;
+}
+
+/*!
+    Returns the output arguments declared by the method, the list is empty
+    until the method has been prepared.
+*/
+QVector<QOpcUaMethodArgument> QOpcUaPreparedMethod::outputArguments() const
+{
+    Q_D(const QOpcUaPreparedMethod);
+    return d->m_outputArguments;
+}
+
+/*!
+    Returns a call of the method with \a arguments for QOpcUaClient::callMethods().
+
+    Each argument gets the data type of the corresponding input argument.
+    Arguments without a declaration and all arguments of a method which has
+    not been prepared get the type of their QVariant.
+*/
+QOpcUaMethodCall QOpcUaPreparedMethod::methodCall(const QVariantList &arguments) const
+{
+    Q_D(const QOpcUaPreparedMethod);
+    QOpcUaMethodCall call(d->m_objectId, d->m_methodId);
+    call.arguments.reserve(arguments.size());
+    for (int i = 0; i < arguments.size(); ++i) {
+        const QOpcUa::Types type = i < d->m_inputArguments.size() ? d->m_inputArguments.at(i).type : QOpcUa::Undefined;
+        call.arguments.push_back(QOpcUa::TypedVariant(arguments.at(i), type));
+    }
+    return call;
+}
+
+/*!
+    Calls the method with \a arguments and returns the id of the request,
+    see QOpcUaClient::callMethods(). Returns 0 if the call could not be sent.
+
+    Several calls are sent with a single request by passing the results of
+    methodCall() to QOpcUaClient::callMethods() instead.
+*/
+quint32 QOpcUaPreparedMethod::call(const QVariantList &arguments)
+{
+    Q_D(QOpcUaPreparedMethod);
+    if (!d->m_client)
+        return 0;
+    return d->m_client->callMethods({methodCall(arguments)});
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAPREPAREDMETHOD_H
+#define QOPCUAPREPAREDMETHOD_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuamethodcall.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qobject.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QOpcUaClient;
+class QOpcUaClientImpl;
+class QOpcUaPreparedMethodPrivate;
+
+class Q_OPCUA_EXPORT QOpcUaPreparedMethod : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QOpcUaPreparedMethod)
+
+public:
+    QOpcUaPreparedMethod(QOpcUaClientImpl *impl, QOpcUaClient *client, const QString &objectId,
+                         const QString &methodId, QObject *parent = nullptr);
+    ~QOpcUaPreparedMethod();
+
+    QString objectId() const;
+    QString methodId() const;
+
+    bool isPrepared() const;
+    QOpcUa::UaStatusCode statusCode() const;
+    QVector<QOpcUaMethodArgument> inputArguments() const;
+    QVector<QOpcUaMethodArgument> outputArguments() const;
+
+    QOpcUaMethodCall methodCall(const QVariantList &arguments = QVariantList()) const;
+    quint32 call(const QVariantList &arguments = QVariantList());
+
+Q_SIGNALS:
+    void prepared(QOpcUa::UaStatusCode statusCode);
+
+private:
+    Q_DISABLE_COPY(QOpcUaPreparedMethod)
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAPREPAREDMETHOD_H
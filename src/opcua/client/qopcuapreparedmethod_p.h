@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAPREPAREDMETHOD_P_H
+#define QOPCUAPREPAREDMETHOD_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaclient.h>
+#include <QtOpcUa/qopcuapreparedmethod.h>
+#include <private/qopcuaclientimpl_p.h>
+
+#include <private/qobject_p.h>
+#include <QtCore/qpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+class QOpcUaPreparedMethodPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QOpcUaPreparedMethod)
+
+public:
+    QOpcUaPreparedMethodPrivate(QOpcUaClientImpl *impl, QOpcUaClient *client, const QString &objectId,
+                                const QString &methodId)
+        : m_client(client)
+        , m_objectId(objectId)
+        , m_methodId(methodId)
+        , m_prepared(false)
+        , m_statusCode(QOpcUa::UaStatusCode::Good)
+    {
+        // The backend reports each method once per prepare request, all prepared methods listen
+        m_methodPreparedConnection = QObject::connect(impl, &QOpcUaClientImpl::methodPrepared,
+                [this](const QString &methodId, QOpcUa::UaStatusCode statusCode,
+                       QVector<QOpcUaMethodArgument> inputArguments, QVector<QOpcUaMethodArgument> outputArguments)
+        {
+            if (m_prepared || methodId != m_methodId)
+                return;
+
+            m_statusCode = statusCode;
+            if (statusCode == QOpcUa::UaStatusCode::Good) {
+                m_prepared = true;
+                m_inputArguments = inputArguments;
+                m_outputArguments = outputArguments;
+            }
+            QObject::disconnect(m_methodPreparedConnection);
+            emit q_func()->prepared(statusCode);
+        });
+    }
+
+    ~QOpcUaPreparedMethodPrivate()
+    {
+        QObject::disconnect(m_methodPreparedConnection);
+    }
+
+    QPointer<QOpcUaClient> m_client;
+    QString m_objectId;
+    QString m_methodId;
+    bool m_prepared;
+    QOpcUa::UaStatusCode m_statusCode;
+    QVector<QOpcUaMethodArgument> m_inputArguments;
+    QVector<QOpcUaMethodArgument> m_outputArguments;
+
+    QMetaObject::Connection m_methodPreparedConnection;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAPREPAREDMETHOD_P_H
@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUARINGBUFFER_P_H
+#define QOPCUARINGBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaglobal.h>
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qvector.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+// Bounded single producer / single consumer queue.
+// push() must only be called from one thread (the backend thread) and
+// takeAll() must only be called from one other thread (the consumer).
+// Neither side ever blocks, a full queue drops the new element and counts it.
+template <typename T>
+class QOpcUaSpscRingBuffer
+{
+public:
+    explicit QOpcUaSpscRingBuffer(int capacity)
+        : m_capacity(roundUpToPowerOfTwo(capacity))
+        , m_mask(m_capacity - 1)
+        , m_buffer(new T[m_capacity])
+        , m_head(0)
+        , m_tail(0)
+        , m_overflows(0)
+    {
+    }
+
+    bool push(T &&item, bool *wasEmpty = nullptr)
+    {
+        const quint32 head = m_head.load();
+        const quint32 tail = m_tail.loadAcquire();
+        if (head - tail >= m_capacity) {
+            m_overflows.fetchAndAddRelaxed(1);
+            return false;
+        }
+
+        m_buffer[head & m_mask] = std::move(item);
+        m_head.storeRelease(head + 1);
+        if (wasEmpty)
+            *wasEmpty = (head == tail);
+        return true;
+    }
+
+    int takeAll(QVector<T> *out, int maxCount = -1)
+    {
+        const quint32 tail = m_tail.load();
+        const quint32 head = m_head.loadAcquire();
+        quint32 available = head - tail;
+        if (maxCount >= 0 && available > quint32(maxCount))
+            available = quint32(maxCount);
+
+        out->reserve(out->size() + int(available));
+        for (quint32 i = 0; i < available; ++i)
+            out->append(std::move(m_buffer[(tail + i) & m_mask]));
+
+        m_tail.storeRelease(tail + available);
+        return int(available);
+    }
+
+    int size() const { return int(m_head.loadAcquire() - m_tail.loadAcquire()); }
+    int capacity() const { return int(m_capacity); }
+    quint64 overflowCount() const { return m_overflows.load(); }
+
+private:
+    static quint32 roundUpToPowerOfTwo(int value)
+    {
+        quint32 result = 1;
+        while (result < quint32(qMax(value, 1)))
+            result <<= 1;
+        return result;
+    }
+
+    const quint32 m_capacity;
+    const quint32 m_mask;
+    QScopedArrayPointer<T> m_buffer;
+
+    // Producer and consumer indices live on separate cache lines
+    alignas(64) QAtomicInteger<quint32> m_head;
+    alignas(64) QAtomicInteger<quint32> m_tail;
+    QAtomicInteger<quint64> m_overflows;
+
+    Q_DISABLE_COPY(QOpcUaSpscRingBuffer)
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUARINGBUFFER_P_H
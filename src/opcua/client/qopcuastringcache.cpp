@@ -0,0 +1,149 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopcuastringcache_p.h"
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+QOpcUaStringCache::QOpcUaStringCache(int capacity)
+    : m_capacity(qMax(capacity, 0))
+    , m_head(-1)
+    , m_tail(-1)
+{}
+
+void QOpcUaStringCache::setCapacity(int capacity)
+{
+    capacity = qMax(capacity, 0);
+    if (capacity == m_capacity)
+        return;
+
+    m_capacity = capacity;
+    if (m_capacity == 0) {
+        clear();
+        return;
+    }
+    while (size() > m_capacity)
+        evict();
+}
+
+void QOpcUaStringCache::clear()
+{
+    m_entries.clear();
+    m_free.clear();
+    m_index.clear();
+    m_head = m_tail = -1;
+}
+
+QString QOpcUaStringCache::fromUtf8(const char *data, int length)
+{
+    if (m_capacity == 0 || length > MaximumStringSize)
+        return QString::fromUtf8(data, length);
+
+    const uint hash = qHashBits(data, size_t(length));
+    for (auto it = m_index.constFind(hash); it != m_index.constEnd() && it.key() == hash; ++it) {
+        const Entry &entry = m_entries.at(it.value());
+        if (entry.utf8.size() == length && std::memcmp(entry.utf8.constData(), data, size_t(length)) == 0) {
+            const int index = it.value();
+            if (index != m_head) {
+                unlink(index);
+                pushFront(index);
+            }
+            return m_entries.at(index).string;
+        }
+    }
+
+    if (size() >= m_capacity)
+        evict();
+
+    int index;
+    if (!m_free.isEmpty()) {
+        index = m_free.takeLast();
+    } else {
+        index = m_entries.size();
+        m_entries.append(Entry());
+    }
+
+    Entry &entry = m_entries[index];
+    entry.utf8 = QByteArray(data, length);
+    entry.string = QString::fromUtf8(data, length);
+    entry.hash = hash;
+    m_index.insert(hash, index);
+    pushFront(index);
+    return entry.string;
+}
+
+void QOpcUaStringCache::unlink(int index)
+{
+    Entry &entry = m_entries[index];
+    if (entry.previous >= 0)
+        m_entries[entry.previous].next = entry.next;
+    else
+        m_head = entry.next;
+    if (entry.next >= 0)
+        m_entries[entry.next].previous = entry.previous;
+    else
+        m_tail = entry.previous;
+}
+
+void QOpcUaStringCache::pushFront(int index)
+{
+    Entry &entry = m_entries[index];
+    entry.previous = -1;
+    entry.next = m_head;
+    if (m_head >= 0)
+        m_entries[m_head].previous = index;
+    m_head = index;
+    if (m_tail < 0)
+        m_tail = index;
+}
+
+void QOpcUaStringCache::evict()
+{
+    const int index = m_tail;
+    if (index < 0)
+        return;
+
+    unlink(index);
+    Entry &entry = m_entries[index];
+    m_index.remove(entry.hash, index);
+    entry.utf8.clear();
+    entry.string.clear();
+    m_free.append(index);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUASTRINGCACHE_P_H
+#define QOPCUASTRINGCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaglobal.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+// Interns the strings decoded from UTF-8, recurring values share one QString and are
+// not decoded again. The least recently used string is dropped when the cache is full.
+// Not thread-safe, a cache must only be used by one thread.
+class Q_OPCUA_EXPORT QOpcUaStringCache
+{
+public:
+    // Longer strings are rarely repeated and are decoded without the cache
+    enum { MaximumStringSize = 256 };
+
+    explicit QOpcUaStringCache(int capacity = 0);
+
+    int capacity() const { return m_capacity; }
+    void setCapacity(int capacity);
+    int size() const { return m_entries.size() - m_free.size(); }
+    void clear();
+
+    QString fromUtf8(const char *data, int length);
+
+private:
+    struct Entry
+    {
+        QByteArray utf8;
+        QString string;
+        uint hash;
+        int previous;
+        int next;
+    };
+
+    void unlink(int index);
+    void pushFront(int index);
+    void evict();
+
+    int m_capacity;
+    QVector<Entry> m_entries;
+    QVector<int> m_free;
+    QMultiHash<uint, int> m_index;
+    // Most recently used entry first
+    int m_head;
+    int m_tail;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUASTRINGCACHE_P_H
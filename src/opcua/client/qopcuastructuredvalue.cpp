@@ -0,0 +1,171 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopcuastructuredvalue.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QOpcUaStructuredValue
+    \inmodule QtOpcUa
+
+    \brief The value of a structured DataType defined by the server.
+
+    Values of custom structures are sent as ExtensionObject. Backends which
+    support the type dictionary of the server decode them to a QOpcUaStructuredValue.
+    The fields are stored in the order of the structure definition and are accessed
+    by their index. The field names are shared by all values of a structure,
+    so decoding a value does not copy them.
+
+    Fields of a built-in type have the same representation as attribute values,
+    fields of a structured type are a QOpcUaStructuredValue and arrays are a QVariantList.
+    Optional fields which are not present are returned as an invalid QVariant.
+
+    \code
+    const QOpcUaStructuredValue vector = node->attribute(QOpcUaNode::NodeAttribute::Value).value<QOpcUaStructuredValue>();
+    const int x = vector.fieldIndex(QStringLiteral("X"));
+    for (...)
+        process(vector.field(x).toDouble());
+    \endcode
+*/
+
+/*!
+    Constructs an invalid structured value.
+*/
+QOpcUaStructuredValue::QOpcUaStructuredValue()
+{}
+
+/*!
+    Constructs a value of the structure \a typeName which has been encoded with the
+    encoding node \a encodingId. \a fields contains the value for each name in \a fieldNames.
+*/
+QOpcUaStructuredValue::QOpcUaStructuredValue(const QString &typeName, const QString &encodingId,
+                                             const QStringList &fieldNames, const QVector<QVariant> &fields)
+    : m_typeName(typeName)
+    , m_encodingId(encodingId)
+    , m_fieldNames(fieldNames)
+    , m_fields(fields)
+{}
+
+/*!
+    Returns \c true if the value has a type and a value for each field.
+*/
+bool QOpcUaStructuredValue::isValid() const
+{
+    return !m_typeName.isEmpty() && m_fields.size() == m_fieldNames.size();
+}
+
+/*!
+    Returns the name of the structure in the type dictionary of the server.
+*/
+QString QOpcUaStructuredValue::typeName() const
+{
+    return m_typeName;
+}
+
+/*!
+    Returns the node id of the encoding the value has been sent with.
+*/
+QString QOpcUaStructuredValue::encodingId() const
+{
+    return m_encodingId;
+}
+
+/*!
+    Returns the names of the fields in the order of the structure definition.
+*/
+QStringList QOpcUaStructuredValue::fieldNames() const
+{
+    return m_fieldNames;
+}
+
+/*!
+    Returns the values of all fields in the order of fieldNames().
+*/
+QVector<QVariant> QOpcUaStructuredValue::fields() const
+{
+    return m_fields;
+}
+
+/*!
+    Returns the number of fields.
+*/
+int QOpcUaStructuredValue::fieldCount() const
+{
+    return m_fields.size();
+}
+
+/*!
+    Returns the index of the field \a name or -1 if the structure has no such field.
+    Look up the index once and use it with field(int) for repeated accesses.
+*/
+int QOpcUaStructuredValue::fieldIndex(const QString &name) const
+{
+    return m_fieldNames.indexOf(name);
+}
+
+/*!
+    Returns the value of the field at \a index.
+*/
+QVariant QOpcUaStructuredValue::field(int index) const
+{
+    return m_fields.value(index);
+}
+
+/*!
+    Returns the value of the field \a name.
+*/
+QVariant QOpcUaStructuredValue::field(const QString &name) const
+{
+    return field(fieldIndex(name));
+}
+
+/*!
+    Returns \c true if \a other has the same type and field values.
+*/
+bool QOpcUaStructuredValue::operator==(const QOpcUaStructuredValue &other) const
+{
+    return m_typeName == other.m_typeName && m_encodingId == other.m_encodingId
+            && m_fieldNames == other.m_fieldNames && m_fields == other.m_fields;
+}
+
+/*!
+    \fn bool QOpcUaStructuredValue::operator!=(const QOpcUaStructuredValue &other) const
+
+    Returns \c true if \a other has a different type or different field values.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUASTRUCTUREDVALUE_H
+#define QOPCUASTRUCTUREDVALUE_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+
+#include <QtCore/qmetatype.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_OPCUA_EXPORT QOpcUaStructuredValue
+{
+public:
+    QOpcUaStructuredValue();
+    QOpcUaStructuredValue(const QString &typeName, const QString &encodingId,
+                          const QStringList &fieldNames, const QVector<QVariant> &fields);
+
+    bool isValid() const;
+
+    QString typeName() const;
+    QString encodingId() const;
+    QStringList fieldNames() const;
+    QVector<QVariant> fields() const;
+
+    int fieldCount() const;
+    int fieldIndex(const QString &name) const;
+    QVariant field(int index) const;
+    QVariant field(const QString &name) const;
+
+    bool operator==(const QOpcUaStructuredValue &other) const;
+    bool operator!=(const QOpcUaStructuredValue &other) const { return !(*this == other); }
+
+private:
+    QString m_typeName;
+    QString m_encodingId;
+    QStringList m_fieldNames;
+    QVector<QVariant> m_fields;
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QOpcUaStructuredValue)
+
+#endif // QOPCUASTRUCTUREDVALUE_H
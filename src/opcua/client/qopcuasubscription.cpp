@@ -46,6 +46,123 @@ QT_BEGIN_NAMESPACE
 
     \brief Enables the user to utilize the
     subscription mechanism in OPC UA for event subscriptions.
+
+    By default, data changes are delivered through the
+    QOpcUaMonitoredValue::valueChanged() signal. Consumers which prefer to poll,
+    for example a historian or a control loop running outside of the Qt event loop,
+    can call enableNotificationBuffer() before adding monitored values. The backend
+    thread then writes each data change into a lock-free single producer, single
+    consumer ring buffer which is drained with takeNotifications().
+
+    If the connection to the server is lost, the open62541 backend reconnects and keeps
+    existing subscriptions alive. Subscriptions are transferred to the new session if the
+    old session has expired and notifications sent during the outage are fetched with the
+    Republish service. Only if the server can not transfer a subscription, it is recreated
+    together with all its monitored values.
+
+    The open62541 backend shares server side resources between subscriptions. All
+    subscriptions with equal parameters use a single subscription on the server, and
+    monitored values for the same node with equal monitoring parameters share a single
+    monitored item. Each data change is converted once and delivered to every monitored
+    value of the item. A monitored value which joins an existing item immediately
+    receives the last known value. Operations which would affect other subscriptions,
+    for example modify(), setMonitoringMode() or setTriggering(), first move the
+    affected monitored values to server side resources of their own.
+*/
+
+/*!
+    \class QOpcUaDataChangeNotification
+    \inmodule QtOpcUa
+
+    \brief A data change notification taken from the notification buffer of a QOpcUaSubscription.
+
+    \c monitoredValue is the QOpcUaMonitoredValue the notification belongs to,
+    \c value is the new value and \c statusCode the status code reported by the server.
+    \c sourceTimestamp and \c serverTimestamp are invalid if the server or the backend
+    did not supply them.
+
+    In raw passthrough mode, \c value is invalid and \c encodedValue contains the value
+    as a Variant in OPC UA binary encoding instead. \c clientHandle is the client handle
+    of the monitored item on the server then.
+
+    \sa QOpcUaSubscription::setRawPassthrough()
+*/
+
+/*!
+    \class QOpcUaSubscriptionParameters
+    \inmodule QtOpcUa
+
+    \brief The parameters of a subscription as defined in OPC-UA part 4, 5.13.2.
+
+    \c publishingInterval is the publishing interval in milliseconds, \c lifetimeCount and
+    \c maxKeepAliveCount are counted in publishing intervals. \c maxNotificationsPerPublish
+    limits the number of notifications in a single publish response, 0 means no limit.
+    \c priority is the relative priority of the subscription.
+*/
+
+/*!
+    \class QOpcUaMonitoringParameters
+    \inmodule QtOpcUa
+
+    \brief The parameters of a monitored item as defined in OPC-UA part 4, 7.16.
+
+    \c samplingInterval is the sampling interval in milliseconds, -1 requests the publishing
+    interval of the subscription. \c queueSize is the size of the queue on the server and
+    \c discardOldest selects which value is discarded if the queue overflows.
+    \c filter is either invalid or contains a QOpcUaMonitoringParameters::DataChangeFilter
+    or a QOpcUaMonitoringParameters::AggregateFilter.
+
+    An AggregateFilter makes the server calculate an aggregate like average, minimum or
+    maximum for every \c processingInterval milliseconds instead of reporting each
+    sample. \c aggregateType is the node id of the aggregate function, for example
+    \c "ns=0;i=2342" for Average, \c "ns=0;i=2346" for Minimum and \c "ns=0;i=2347"
+    for Maximum. The server must support the aggregate, see the AggregateFunctions
+    folder of its ServerCapabilities.
+
+    In the revised parameters returned by QOpcUaMonitoredValue::monitoringParameters(),
+    \c filterResult contains a QOpcUaMonitoringParameters::AggregateFilterResult with
+    the start time, processing interval and aggregate configuration revised by the server.
+*/
+
+/*!
+    \class QOpcUaMonitoringStatistics
+    \inmodule QtOpcUa
+
+    \brief Counters which show whether a subscription keeps up with the server.
+
+    The counters are returned by QOpcUaMonitoredValue::statistics() and
+    QOpcUaSubscription::statistics().
+*/
+
+/*!
+    \class QOpcUaEventFilter
+    \inmodule QtOpcUa
+
+    \brief The filter of an event monitored item as defined in OPC-UA part 4, 7.17.3.
+
+    \c selectClauses lists the event fields which are returned for each event.
+    \c whereClause is a list of QOpcUaContentFilterElement which is evaluated by the
+    server, the first element is the root of the filter expression.
+*/
+
+/*!
+    \class QOpcUaSimpleAttributeOperand
+    \inmodule QtOpcUa
+
+    \brief Selects an attribute of an event field by the browse path relative to \c typeId.
+
+    The default \c typeId is BaseEventType.
+*/
+
+/*!
+    \class QOpcUaContentFilterElement
+    \inmodule QtOpcUa
+
+    \brief An element of a where clause as defined in OPC-UA part 4, 7.4.1.
+
+    Each operand is either a QOpcUaSimpleAttributeOperand, a
+    QOpcUaContentFilterElement::ElementOperand referring to another element of the
+    where clause, a QOpcUa::TypedVariant or any other QVariant used as a literal.
 */
 
 /*!
@@ -70,11 +187,27 @@ QOpcUaSubscription::~QOpcUaSubscription()
     Create an event monitor for \a node by adding it to this subscription object.
 
     Returns a QOpcUaMonitoredEvent which can be used to receive a signal when an
-    event occcurs.
+    event occcurs. The events contain the Message, SourceName and Severity fields.
 */
 QOpcUaMonitoredEvent *QOpcUaSubscription::addEvent(QOpcUaNode *node)
 {
-    return d_func()->m_impl->addEvent(node);
+    return d_func()->m_impl->addEvent(node, QOpcUaEventFilter::defaultFilter());
+}
+
+/*!
+    Create an event monitor for \a node which selects the event fields in the select
+    clauses of \a filter.
+
+    The where clause of \a filter is evaluated by the server, events which do not
+    match are never sent to the client. Each event is delivered as a QVector<QVariant>
+    holding one value per select clause in the same order.
+
+    \warning Where clauses are not supported by the FreeOPCUA backend, it returns \c nullptr
+    for a \a filter with a where clause
+*/
+QOpcUaMonitoredEvent *QOpcUaSubscription::addEvent(QOpcUaNode *node, const QOpcUaEventFilter &filter)
+{
+    return d_func()->m_impl->addEvent(node, filter);
 }
 
 /*!
@@ -85,7 +218,34 @@ QOpcUaMonitoredEvent *QOpcUaSubscription::addEvent(QOpcUaNode *node)
  */
 QOpcUaMonitoredValue *QOpcUaSubscription::addValue(QOpcUaNode *node)
 {
-    return d_func()->m_impl->addValue(node);
+    return d_func()->m_impl->addValue(node, QOpcUaMonitoringParameters(), nullptr);
+}
+
+/*!
+   Create a value monitor for \a node using the sampling interval, queue size and
+   filter in \a parameters.
+
+   The revised parameters returned by the server are available from
+   QOpcUaMonitoredValue::monitoringParameters().
+
+   \warning Only the default parameters are supported by the FreeOPCUA backend
+ */
+QOpcUaMonitoredValue *QOpcUaSubscription::addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters)
+{
+    return d_func()->m_impl->addValue(node, parameters, nullptr);
+}
+
+/*!
+   Create a value monitor for \a node which delivers its data changes to \a sink
+   instead of emitting QOpcUaMonitoredValue::valueChanged(). The sink must outlive
+   the returned value monitor.
+
+   Use QOpcUaTypedMonitoredValue instead of implementing a QOpcUaValueSink.
+ */
+QOpcUaMonitoredValue *QOpcUaSubscription::addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters,
+                                                   QOpcUaValueSink *sink)
+{
+    return d_func()->m_impl->addValue(node, parameters, sink);
 }
 
 /*!
@@ -104,4 +264,204 @@ void QOpcUaSubscription::removeValue(QOpcUaMonitoredValue *value)
     d_func()->m_impl->removeValue(value);
 }
 
+/*!
+    Returns the parameters of this subscription. After a successful call to modify(),
+    these are the values revised by the server.
+*/
+QOpcUaSubscriptionParameters QOpcUaSubscription::parameters() const
+{
+    return d_func()->m_parameters;
+}
+
+/*!
+    Changes publishing interval, keep-alive count, lifetime count, maximum number of
+    notifications per publish and priority of this subscription to \a parameters using
+    the ModifySubscription service.
+
+    The subscription and its monitored values are kept, so rates can be adapted at runtime
+    without recreating anything. Returns \c true on success; parameters() returns the values
+    revised by the server afterwards. On failure the subscription and all of its monitored
+    values keep their previous parameters.
+
+    \warning Currently not supported by the FreeOPCUA backend
+*/
+bool QOpcUaSubscription::modify(const QOpcUaSubscriptionParameters &parameters)
+{
+    Q_D(QOpcUaSubscription);
+    QOpcUaSubscriptionParameters revised = parameters;
+    if (!d->m_impl->modify(parameters, &revised))
+        return false;
+
+    d->m_parameters = revised;
+    d->m_interval = static_cast<quint32>(revised.publishingInterval);
+    return true;
+}
+
+/*!
+    Changes sampling interval, queue size and filter of all monitored values in \a values
+    to \a parameters using a single ModifyMonitoredItems service call.
+
+    If \a results is not null, it receives one status code per entry in \a values.
+    Returns \c true if the service call has been successful. The per item status codes
+    must still be checked.
+
+    \warning Currently not supported by the FreeOPCUA backend
+*/
+bool QOpcUaSubscription::modifyMonitoredValues(const QVector<QOpcUaMonitoredValue *> &values,
+                                               const QOpcUaMonitoringParameters &parameters,
+                                               QVector<QOpcUa::UaStatusCode> *results)
+{
+    if (values.isEmpty())
+        return false;
+    return d_func()->m_impl->modifyMonitoredValues(values, parameters, results);
+}
+
+/*!
+    Sets the monitoring mode of all monitored values in \a values to \a mode
+    using a single SetMonitoringMode service call.
+
+    This allows to temporarily disable thousands of monitored values, for example
+    when a screen is hidden, and to enable them again without deleting and recreating them.
+
+    If \a results is not null, it receives one status code per entry in \a values.
+    Returns \c true if the service call has been successful. The per item status codes
+    must still be checked.
+
+    \warning Currently not supported by the FreeOPCUA backend
+*/
+bool QOpcUaSubscription::setMonitoringMode(const QVector<QOpcUaMonitoredValue *> &values, QOpcUa::MonitoringMode mode,
+                                           QVector<QOpcUa::UaStatusCode> *results)
+{
+    if (values.isEmpty())
+        return false;
+    return d_func()->m_impl->setMonitoringMode(values, mode, results);
+}
+
+/*!
+    Adds triggering links from \a trigger to the monitored values in \a linksToAdd and
+    removes the links to the monitored values in \a linksToRemove using a single SetTriggering
+    service call.
+
+    Linked monitored values in \l QOpcUa::MonitoringMode::Sampling mode report their queued values
+    whenever \a trigger reports a data change.
+
+    If \a addResults or \a removeResults are not null, they receive one status code per entry
+    in \a linksToAdd and \a linksToRemove. Returns \c true if the service call has been successful.
+
+    \warning Currently not supported by the FreeOPCUA backend
+*/
+bool QOpcUaSubscription::setTriggering(QOpcUaMonitoredValue *trigger, const QVector<QOpcUaMonitoredValue *> &linksToAdd,
+                                       const QVector<QOpcUaMonitoredValue *> &linksToRemove,
+                                       QVector<QOpcUa::UaStatusCode> *addResults,
+                                       QVector<QOpcUa::UaStatusCode> *removeResults)
+{
+    if (!trigger || (linksToAdd.isEmpty() && linksToRemove.isEmpty()))
+        return false;
+    return d_func()->m_impl->setTriggering(trigger, linksToAdd, linksToRemove, addResults, removeResults);
+}
+
+/*!
+    Enables the notification buffer of this subscription with room for at least
+    \a capacity notifications. The capacity is rounded up to the next power of two.
+
+    While the buffer is enabled, data changes of all monitored values in this subscription
+    are no longer emitted as QOpcUaMonitoredValue::valueChanged() but written into the buffer
+    by the backend thread. If the buffer is full, new notifications are dropped and counted,
+    see notificationBufferOverflows(). The backend never blocks on a full buffer.
+
+    \a wakeUp is invoked on the backend thread whenever a notification is written into an empty
+    buffer. It must return quickly, typically by signalling a condition variable or a semaphore.
+
+    The buffer must be enabled before the first monitored value is added and can not be
+    disabled afterwards. Returns \c true on success and \c false if the buffer was already enabled.
+
+    \sa takeNotifications()
+*/
+bool QOpcUaSubscription::enableNotificationBuffer(int capacity, const std::function<void()> &wakeUp)
+{
+    Q_D(QOpcUaSubscription);
+    if (d->hasNotificationBuffer() || capacity <= 0)
+        return false;
+
+    d->m_notificationWakeUp = wakeUp;
+    d->m_notificationBuffer.storeRelease(new QOpcUaSubscriptionPrivate::NotificationBuffer(capacity));
+    return true;
+}
+
+/*!
+    Returns \c true if the notification buffer has been enabled for this subscription.
+*/
+bool QOpcUaSubscription::hasNotificationBuffer() const
+{
+    return d_func()->hasNotificationBuffer();
+}
+
+/*!
+    Moves up to \a maxCount buffered notifications to the end of \a notifications.
+    If \a maxCount is negative, all available notifications are taken.
+
+    Returns the number of notifications which have been taken. This function must only
+    be called from one thread at a time.
+
+    \sa enableNotificationBuffer()
+*/
+int QOpcUaSubscription::takeNotifications(QVector<QOpcUaDataChangeNotification> *notifications, int maxCount)
+{
+    QOpcUaSubscriptionPrivate::NotificationBuffer *buffer = d_func()->m_notificationBuffer.loadAcquire();
+    if (!buffer || !notifications)
+        return 0;
+    return buffer->takeAll(notifications, maxCount);
+}
+
+/*!
+    Returns the number of notifications which have been dropped because the
+    notification buffer was full.
+*/
+quint64 QOpcUaSubscription::notificationBufferOverflows() const
+{
+    QOpcUaSubscriptionPrivate::NotificationBuffer *buffer = d_func()->m_notificationBuffer.loadAcquire();
+    return buffer ? buffer->overflowCount() : 0;
+}
+
+/*!
+    Enables or disables the raw passthrough mode of this subscription according to \a enabled.
+
+    In raw passthrough mode, the values of data change notifications are not converted
+    to QVariant. The notifications in the notification buffer contain the value in
+    OPC UA binary encoding and the client handle of the monitored item instead, which
+    allows forwarding them to another OPC UA system without decoding and encoding them again.
+    Aggregation windows and typed value monitors are bypassed in this mode.
+
+    The mode only takes effect while the notification buffer is enabled and is only
+    supported by the open62541 backend.
+
+    \sa enableNotificationBuffer(), QOpcUaDataChangeNotification
+*/
+void QOpcUaSubscription::setRawPassthrough(bool enabled)
+{
+    d_func()->m_rawPassthrough.storeRelease(enabled ? 1 : 0);
+}
+
+/*!
+    Returns \c true if the raw passthrough mode is enabled.
+
+    \sa setRawPassthrough()
+*/
+bool QOpcUaSubscription::isRawPassthrough() const
+{
+    return d_func()->m_rawPassthrough.loadAcquire() != 0;
+}
+
+/*!
+    Returns the counters of all monitored values of this subscription, summed up.
+    \c sequenceGaps counts the publish responses in which the server skipped
+    sequence numbers, which means that notifications of this subscription were lost.
+
+    \sa QOpcUaMonitoredValue::statistics()
+*/
+QOpcUaMonitoringStatistics QOpcUaSubscription::statistics() const
+{
+    return d_func()->m_counters.statistics();
+}
+
 QT_END_NAMESPACE
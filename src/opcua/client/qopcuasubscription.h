@@ -38,8 +38,17 @@
 #define QOPCUASUBSCRIPTION_H
 
 #include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuadatachangenotification.h>
+#include <QtOpcUa/qopcuaeventfilter.h>
+#include <QtOpcUa/qopcuamonitoringparameters.h>
+#include <QtOpcUa/qopcuamonitoringstatistics.h>
+#include <QtOpcUa/qopcuasubscriptionparameters.h>
+#include <QtOpcUa/qopcuatype.h>
 
 #include <QtCore/qobject.h>
+#include <QtCore/qvector.h>
+
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -48,20 +57,48 @@ class QOpcUaMonitoredValue;
 class QOpcUaNode;
 class QOpcUaSubscriptionImpl;
 class QOpcUaSubscriptionPrivate;
+class QOpcUaValueSink;
 
 class Q_OPCUA_EXPORT QOpcUaSubscription : public QObject
 {
     Q_OBJECT
-    Q_DECLARE_PRIVATE(QOpcUaSubscription)
+
 public:
+    Q_DECLARE_PRIVATE(QOpcUaSubscription)
+
     QOpcUaSubscription(QOpcUaSubscriptionImpl *impl, quint32 interval, QObject *parent = nullptr);
     ~QOpcUaSubscription() override;
 
     QOpcUaMonitoredEvent *addEvent(QOpcUaNode *node);
+    QOpcUaMonitoredEvent *addEvent(QOpcUaNode *node, const QOpcUaEventFilter &filter);
     void removeEvent(QOpcUaMonitoredEvent *e);
 
     QOpcUaMonitoredValue *addValue(QOpcUaNode *node);
+    QOpcUaMonitoredValue *addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters);
+    QOpcUaMonitoredValue *addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters, QOpcUaValueSink *sink);
     void removeValue(QOpcUaMonitoredValue *value);
+
+    QOpcUaSubscriptionParameters parameters() const;
+    bool modify(const QOpcUaSubscriptionParameters &parameters);
+    bool modifyMonitoredValues(const QVector<QOpcUaMonitoredValue *> &values, const QOpcUaMonitoringParameters &parameters,
+                               QVector<QOpcUa::UaStatusCode> *results = nullptr);
+
+    bool setMonitoringMode(const QVector<QOpcUaMonitoredValue *> &values, QOpcUa::MonitoringMode mode,
+                           QVector<QOpcUa::UaStatusCode> *results = nullptr);
+    bool setTriggering(QOpcUaMonitoredValue *trigger, const QVector<QOpcUaMonitoredValue *> &linksToAdd,
+                       const QVector<QOpcUaMonitoredValue *> &linksToRemove = QVector<QOpcUaMonitoredValue *>(),
+                       QVector<QOpcUa::UaStatusCode> *addResults = nullptr,
+                       QVector<QOpcUa::UaStatusCode> *removeResults = nullptr);
+
+    bool enableNotificationBuffer(int capacity, const std::function<void()> &wakeUp = std::function<void()>());
+    bool hasNotificationBuffer() const;
+    int takeNotifications(QVector<QOpcUaDataChangeNotification> *notifications, int maxCount = -1);
+    quint64 notificationBufferOverflows() const;
+    void setRawPassthrough(bool enabled);
+    bool isRawPassthrough() const;
+
+    QOpcUaMonitoringStatistics statistics() const;
+
 private:
     Q_DISABLE_COPY(QOpcUaSubscription)
 };
@@ -50,11 +50,16 @@
 
 #include <QtOpcUa/qopcuaglobal.h>
 #include <QtOpcUa/qopcuasubscription.h>
+#include <private/qopcuamonitoringcounters_p.h>
+#include <private/qopcuaringbuffer_p.h>
 #include <private/qopcuasubscriptionimpl_p.h>
 
 #include <private/qobject_p.h>
+#include <QtCore/qatomic.h>
 #include <QtCore/qscopedpointer.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 class Q_OPCUA_EXPORT QOpcUaSubscriptionPrivate : public QObjectPrivate
@@ -65,8 +70,23 @@ public:
     QOpcUaSubscriptionPrivate(QOpcUaSubscriptionImpl *impl, quint32 interval);
     ~QOpcUaSubscriptionPrivate();
 
+    typedef QOpcUaSpscRingBuffer<QOpcUaDataChangeNotification> NotificationBuffer;
+
+    bool hasNotificationBuffer() const { return m_notificationBuffer.loadAcquire() != nullptr; }
+    bool wantsRawValues() const { return m_rawPassthrough.loadAcquire() && hasNotificationBuffer(); }
+    void enqueueNotification(QOpcUaDataChangeNotification &&notification);
+
     QScopedPointer<QOpcUaSubscriptionImpl> m_impl;
     quint32 m_interval;
+    QOpcUaSubscriptionParameters m_parameters;
+
+    // Written once by the owning thread, read by the backend thread
+    QAtomicPointer<NotificationBuffer> m_notificationBuffer;
+    std::function<void()> m_notificationWakeUp;
+    QAtomicInt m_rawPassthrough;
+
+    // Sum of the counters of all monitored values plus the sequence gaps
+    QOpcUaMonitoringCounters m_counters;
 };
 
 QT_END_NAMESPACE
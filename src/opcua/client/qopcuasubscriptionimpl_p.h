@@ -48,13 +48,20 @@
 // We mean it.
 //
 
+#include <QtOpcUa/qopcuaeventfilter.h>
 #include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuamonitoringparameters.h>
+#include <QtOpcUa/qopcuasubscriptionparameters.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
 class QOpcUaMonitoredEvent;
 class QOpcUaMonitoredValue;
 class QOpcUaNode;
+class QOpcUaValueSink;
 
 class Q_OPCUA_EXPORT QOpcUaSubscriptionImpl
 {
@@ -62,10 +69,23 @@ public:
     QOpcUaSubscriptionImpl();
     virtual ~QOpcUaSubscriptionImpl();
 
-    virtual QOpcUaMonitoredEvent *addEvent(QOpcUaNode *node) = 0;
+    virtual QOpcUaMonitoredEvent *addEvent(QOpcUaNode *node, const QOpcUaEventFilter &filter) = 0;
     virtual void removeEvent(QOpcUaMonitoredEvent *event) = 0;
-    virtual QOpcUaMonitoredValue *addValue(QOpcUaNode *node) = 0;
+    virtual QOpcUaMonitoredValue *addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters,
+                                           QOpcUaValueSink *sink) = 0;
     virtual void removeValue(QOpcUaMonitoredValue *value) = 0;
+
+    virtual bool modify(const QOpcUaSubscriptionParameters &parameters, QOpcUaSubscriptionParameters *revised) = 0;
+    virtual bool modifyMonitoredValues(const QVector<QOpcUaMonitoredValue *> &values,
+                                       const QOpcUaMonitoringParameters &parameters,
+                                       QVector<QOpcUa::UaStatusCode> *results) = 0;
+
+    virtual bool setMonitoringMode(const QVector<QOpcUaMonitoredValue *> &values, QOpcUa::MonitoringMode mode,
+                                   QVector<QOpcUa::UaStatusCode> *results) = 0;
+    virtual bool setTriggering(QOpcUaMonitoredValue *trigger, const QVector<QOpcUaMonitoredValue *> &linksToAdd,
+                               const QVector<QOpcUaMonitoredValue *> &linksToRemove,
+                               QVector<QOpcUa::UaStatusCode> *addResults,
+                               QVector<QOpcUa::UaStatusCode> *removeResults) = 0;
 };
 
 QT_END_NAMESPACE
@@ -41,13 +41,29 @@ QT_BEGIN_NAMESPACE
 QOpcUaSubscriptionPrivate::QOpcUaSubscriptionPrivate(QOpcUaSubscriptionImpl *impl, quint32 interval)
     : m_impl(impl)
     , m_interval(interval)
+    , m_parameters(interval)
+    , m_notificationBuffer(nullptr)
+    , m_rawPassthrough(0)
 {
 
 }
 
 QOpcUaSubscriptionPrivate::~QOpcUaSubscriptionPrivate()
 {
+    // Make sure the backend has stopped delivering before the buffer goes away
+    m_impl.reset();
+    delete m_notificationBuffer.loadAcquire();
+}
+
+void QOpcUaSubscriptionPrivate::enqueueNotification(QOpcUaDataChangeNotification &&notification)
+{
+    NotificationBuffer *buffer = m_notificationBuffer.loadAcquire();
+    if (!buffer)
+        return;
 
+    bool wasEmpty = false;
+    if (buffer->push(std::move(notification), &wasEmpty) && wasEmpty && m_notificationWakeUp)
+        m_notificationWakeUp();
 }
 
 QT_END_NAMESPACE
@@ -324,6 +324,17 @@ QT_BEGIN_NAMESPACE
     \value UnspecifiedError Any error that is not categorized. The detailed status code must be checked.
 */
 
+/*!
+    \enum QOpcUa::MonitoringMode
+
+    This enum contains the monitoring modes of a monitored item as defined in OPC-UA part 4, 5.12.1.3.
+
+    \value Disabled The item is neither sampled nor reported.
+    \value Sampling The item is sampled and queued on the server, but notifications are only sent if
+                    the item is linked to a triggering item which reports a change.
+    \value Reporting The item is sampled and its notifications are reported. This is the default.
+*/
+
 /*!
     This method can be used to check if a call has successfully finished.
 
@@ -318,6 +318,13 @@ enum class ErrorCategory {
 };
 Q_ENUM_NS(ErrorCategory)
 
+enum class MonitoringMode : quint32 {
+    Disabled = 0,
+    Sampling = 1,
+    Reporting = 2
+};
+Q_ENUM_NS(MonitoringMode)
+
 Q_OPCUA_EXPORT bool isSuccessStatus(QOpcUa::UaStatusCode statusCode);
 Q_OPCUA_EXPORT QOpcUa::ErrorCategory errorCategory(QOpcUa::UaStatusCode statusCode);
 
@@ -358,6 +365,7 @@ struct QLocalizedText {
 Q_DECLARE_TYPEINFO(QOpcUa::Types, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(QOpcUa::UaStatusCode, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(QOpcUa::ErrorCategory, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(QOpcUa::MonitoringMode, Q_PRIMITIVE_TYPE);
 
 QT_END_NAMESPACE
 
@@ -367,5 +375,6 @@ Q_DECLARE_METATYPE(QOpcUa::QQualifiedName)
 Q_DECLARE_METATYPE(QOpcUa::QLocalizedText)
 Q_DECLARE_METATYPE(QOpcUa::UaStatusCode)
 Q_DECLARE_METATYPE(QOpcUa::ErrorCategory)
+Q_DECLARE_METATYPE(QOpcUa::MonitoringMode)
 
 #endif // QOPCUATYPE
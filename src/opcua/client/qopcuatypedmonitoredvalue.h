@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUATYPEDMONITOREDVALUE_H
+#define QOPCUATYPEDMONITOREDVALUE_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuamonitoredvalue.h>
+#include <QtOpcUa/qopcuamonitoringparameters.h>
+#include <QtOpcUa/qopcuasubscription.h>
+#include <QtOpcUa/qopcuatype.h>
+#include <QtOpcUa/qopcuavariant.h>
+
+#include <QtCore/qmetatype.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+#include <functional>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+// Receives the data changes of a monitored value as a native type instead of a QVariant.
+// All functions are called on the backend thread.
+class Q_OPCUA_EXPORT QOpcUaValueSink
+{
+public:
+    virtual ~QOpcUaValueSink();
+
+    // QMetaType id of the value, or of the elements for arrays
+    virtual int elementType() const = 0;
+    virtual bool isArray() const = 0;
+
+    // value points to a T for scalars and to a QVector<T> for arrays.
+    // Returns false if the value did not change and was not delivered.
+    virtual bool setValue(const void *value, QOpcUa::UaStatusCode statusCode) = 0;
+    // Used if the backend can not write the native type directly
+    virtual bool setVariant(const QVariant &value, QOpcUa::UaStatusCode statusCode) = 0;
+};
+
+template <typename T>
+struct QOpcUaValueTypeTraits
+{
+    static const bool isArray = false;
+    static int elementType() { return qMetaTypeId<T>(); }
+    static bool fromVariant(const QVariant &value, T *target)
+    {
+        if (!value.canConvert<T>())
+            return false;
+        *target = value.value<T>();
+        return true;
+    }
+};
+
+template <typename T>
+struct QOpcUaValueTypeTraits<QVector<T>>
+{
+    static const bool isArray = true;
+    static int elementType() { return qMetaTypeId<T>(); }
+    static bool fromVariant(const QVariant &value, QVector<T> *target)
+    {
+        if (value.userType() == qMetaTypeId<QVector<T>>()) {
+            *target = value.value<QVector<T>>();
+            return true;
+        }
+        if (value.type() != QVariant::List)
+            return false;
+
+        const QVariantList list = value.toList();
+        target->clear();
+        target->reserve(list.size());
+        for (const QVariant &element : list) {
+            if (!element.canConvert<T>())
+                return false;
+            target->push_back(element.value<T>());
+        }
+        return true;
+    }
+};
+
+// Delivers values of any type, backends write the QOpcUaVariant directly if they support it
+template <>
+struct QOpcUaValueTypeTraits<QOpcUaVariant>
+{
+    static const bool isArray = false;
+    static int elementType() { return qMetaTypeId<QOpcUaVariant>(); }
+    static bool fromVariant(const QVariant &value, QOpcUaVariant *target)
+    {
+        *target = QOpcUaVariant::fromQVariant(value);
+        return target->isValid();
+    }
+};
+
+template <typename T>
+class QOpcUaTypedMonitoredValue : public QOpcUaValueSink
+{
+public:
+    typedef std::function<void(const T &value, QOpcUa::UaStatusCode statusCode)> Callback;
+
+    QOpcUaTypedMonitoredValue(QOpcUaSubscription *subscription, QOpcUaNode *node, QObject *context,
+                              const Callback &callback,
+                              const QOpcUaMonitoringParameters &parameters = QOpcUaMonitoringParameters())
+        : m_context(context)
+        , m_hasContext(context != nullptr)
+        , m_callback(std::make_shared<Callback>(callback))
+        , m_hasValue(false)
+        , m_lastValue()
+        , m_lastStatusCode(QOpcUa::UaStatusCode::Good)
+    {
+        m_monitoredValue.reset(subscription->addValue(node, parameters, this));
+    }
+
+    ~QOpcUaTypedMonitoredValue() override
+    {
+        // Stop the delivery before the sink goes away
+        m_monitoredValue.reset();
+    }
+
+    bool isValid() const { return !m_monitoredValue.isNull(); }
+    QOpcUaMonitoredValue *monitoredValue() const { return m_monitoredValue.data(); }
+
+    int elementType() const override { return QOpcUaValueTypeTraits<T>::elementType(); }
+    bool isArray() const override { return QOpcUaValueTypeTraits<T>::isArray; }
+
+    bool setValue(const void *value, QOpcUa::UaStatusCode statusCode) override
+    {
+        return deliver(*static_cast<const T *>(value), statusCode);
+    }
+
+    bool setVariant(const QVariant &value, QOpcUa::UaStatusCode statusCode) override
+    {
+        T converted;
+        if (!QOpcUaValueTypeTraits<T>::fromVariant(value, &converted))
+            return false;
+        return deliver(converted, statusCode);
+    }
+
+private:
+    bool deliver(const T &value, QOpcUa::UaStatusCode statusCode)
+    {
+        // A deleted context drops the value, the callback must not run on the backend thread instead
+        QObject *context = m_context.data();
+        if (m_hasContext && !context)
+            return false;
+
+        if (m_hasValue && m_lastStatusCode == statusCode && m_lastValue == value)
+            return false;
+        m_hasValue = true;
+        m_lastValue = value;
+        m_lastStatusCode = statusCode;
+
+        if (!context) {
+            (*m_callback)(value, statusCode);
+            return true;
+        }
+
+        // The callback is shared, so a queued call stays valid after this object is deleted
+        const std::shared_ptr<Callback> callback = m_callback;
+        QMetaObject::invokeMethod(context, [callback, value, statusCode]() { (*callback)(value, statusCode); },
+                                  Qt::QueuedConnection);
+        return true;
+    }
+
+    QPointer<QObject> m_context;
+    const bool m_hasContext;
+    std::shared_ptr<Callback> m_callback;
+    QScopedPointer<QOpcUaMonitoredValue> m_monitoredValue;
+    // Only accessed on the backend thread
+    bool m_hasValue;
+    T m_lastValue;
+    QOpcUa::UaStatusCode m_lastStatusCode;
+
+    Q_DISABLE_COPY(QOpcUaTypedMonitoredValue)
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUATYPEDMONITOREDVALUE_H
@@ -0,0 +1,160 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/qopcuavalueaggregator_p.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+QOpcUaValueAggregator::QOpcUaValueAggregator(const QOpcUaAggregationWindow &window, qint64 now)
+    : m_window(window)
+    , m_windowStart(now)
+{
+    m_window.length = qMax(1, m_window.length);
+    if (m_window.step <= 0)
+        m_window.step = m_window.length;
+    m_nextEmit = now + (m_window.type == QOpcUaAggregationWindow::Type::Sliding ? m_window.step : m_window.length);
+    resetTumbling();
+}
+
+void QOpcUaValueAggregator::addSample(const QVariant &value, qint64 now)
+{
+    m_last = value;
+    bool numeric = false;
+    const double d = value.toDouble(&numeric);
+
+    if (m_window.type == QOpcUaAggregationWindow::Type::Sliding) {
+        m_samples.push_back(Sample{now, d, numeric});
+        return;
+    }
+
+    ++m_count;
+    if (numeric) {
+        ++m_numericCount;
+        m_minimum = qMin(m_minimum, d);
+        m_maximum = qMax(m_maximum, d);
+        m_sum += d;
+    }
+}
+
+void QOpcUaValueAggregator::flush(qint64 now, QVector<QOpcUaAggregateValue> *aggregates)
+{
+    if (m_window.type == QOpcUaAggregationWindow::Type::Sliding)
+        flushSliding(now, aggregates);
+    else
+        flushTumbling(now, aggregates);
+}
+
+void QOpcUaValueAggregator::flushTumbling(qint64 now, QVector<QOpcUaAggregateValue> *aggregates)
+{
+    if (now < m_nextEmit)
+        return;
+
+    // Samples are not timestamped, all of them belong to the window which ended first
+    if (m_count > 0) {
+        QOpcUaAggregateValue aggregate;
+        aggregate.count = m_count;
+        aggregate.numericCount = m_numericCount;
+        if (m_numericCount > 0) {
+            aggregate.minimum = m_minimum;
+            aggregate.maximum = m_maximum;
+            aggregate.average = m_sum / m_numericCount;
+        }
+        aggregate.last = m_last;
+        aggregate.windowStart = QDateTime::fromMSecsSinceEpoch(m_windowStart, Qt::UTC);
+        aggregate.windowEnd = QDateTime::fromMSecsSinceEpoch(m_nextEmit, Qt::UTC);
+        aggregates->push_back(aggregate);
+    }
+
+    // Windows without samples are skipped, the windows stay aligned to the first one
+    const qint64 elapsedWindows = (now - m_windowStart) / m_window.length;
+    m_windowStart += elapsedWindows * m_window.length;
+    m_nextEmit = m_windowStart + m_window.length;
+    resetTumbling();
+}
+
+void QOpcUaValueAggregator::flushSliding(qint64 now, QVector<QOpcUaAggregateValue> *aggregates)
+{
+    if (now < m_nextEmit)
+        return;
+
+    // Only the most recent window is reported if the flush was late
+    const qint64 windowEnd = now;
+    const qint64 windowStart = windowEnd - m_window.length;
+    while (!m_samples.empty() && m_samples.front().time < windowStart)
+        m_samples.pop_front();
+
+    if (!m_samples.empty()) {
+        QOpcUaAggregateValue aggregate;
+        double sum = 0;
+        aggregate.minimum = std::numeric_limits<double>::max();
+        aggregate.maximum = std::numeric_limits<double>::lowest();
+        for (const Sample &sample : m_samples) {
+            ++aggregate.count;
+            if (!sample.numeric)
+                continue;
+            ++aggregate.numericCount;
+            aggregate.minimum = qMin(aggregate.minimum, sample.value);
+            aggregate.maximum = qMax(aggregate.maximum, sample.value);
+            sum += sample.value;
+        }
+        if (aggregate.numericCount > 0) {
+            aggregate.average = sum / aggregate.numericCount;
+        } else {
+            aggregate.minimum = 0;
+            aggregate.maximum = 0;
+        }
+        aggregate.last = m_last;
+        aggregate.windowStart = QDateTime::fromMSecsSinceEpoch(windowStart, Qt::UTC);
+        aggregate.windowEnd = QDateTime::fromMSecsSinceEpoch(windowEnd, Qt::UTC);
+        aggregates->push_back(aggregate);
+    }
+
+    const qint64 elapsedSteps = (now - m_nextEmit) / m_window.step + 1;
+    m_nextEmit += elapsedSteps * m_window.step;
+}
+
+void QOpcUaValueAggregator::resetTumbling()
+{
+    m_count = 0;
+    m_numericCount = 0;
+    m_minimum = std::numeric_limits<double>::max();
+    m_maximum = std::numeric_limits<double>::lowest();
+    m_sum = 0;
+}
+
+QT_END_NAMESPACE
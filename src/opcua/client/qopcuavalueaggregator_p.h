@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAVALUEAGGREGATOR_P_H
+#define QOPCUAVALUEAGGREGATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaaggregation.h>
+
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+#include <deque>
+
+QT_BEGIN_NAMESPACE
+
+// Reduces the data changes of a monitored value to one aggregate per window.
+// Only used on the backend thread, times are milliseconds since the epoch.
+class QOpcUaValueAggregator
+{
+public:
+    QOpcUaValueAggregator(const QOpcUaAggregationWindow &window, qint64 now);
+
+    void addSample(const QVariant &value, qint64 now);
+    // Appends the aggregates of all windows which have ended before now
+    void flush(qint64 now, QVector<QOpcUaAggregateValue> *aggregates);
+
+    const QOpcUaAggregationWindow &window() const { return m_window; }
+
+private:
+    struct Sample {
+        qint64 time;
+        double value;
+        bool numeric;
+    };
+
+    void flushTumbling(qint64 now, QVector<QOpcUaAggregateValue> *aggregates);
+    void flushSliding(qint64 now, QVector<QOpcUaAggregateValue> *aggregates);
+    void resetTumbling();
+
+    QOpcUaAggregationWindow m_window;
+    qint64 m_windowStart;
+    qint64 m_nextEmit;
+    QVariant m_last;
+
+    // Running values of the current tumbling window
+    quint32 m_count;
+    quint32 m_numericCount;
+    double m_minimum;
+    double m_maximum;
+    double m_sum;
+
+    // Samples inside the current sliding window
+    std::deque<Sample> m_samples;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAVALUEAGGREGATOR_P_H
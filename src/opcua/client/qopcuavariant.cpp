@@ -0,0 +1,652 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopcuavariant.h"
+#include <private/qopcuatypemapping_p.h>
+
+#include <QtCore/qloggingcategory.h>
+
+#include <cstring>
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA)
+
+/*!
+    \class QOpcUaVariant
+    \inmodule QtOpcUa
+
+    \brief A compact value of an OPC UA built-in type.
+
+    QOpcUaVariant stores a scalar or an array of one of the types in
+    QOpcUa::Types together with its type. Unlike QVariant it keeps types
+    apart which share a Qt representation, for example StatusCode and
+    UInt32 or NodeId and String.
+
+    All scalars are stored inside the object without a heap allocation
+    and without a meta type lookup. Arrays are stored as an implicitly
+    shared QVector of the element type, copying an array only increments
+    a reference count. Moving a QOpcUaVariant never allocates.
+
+    \code
+    QOpcUaVariant status(QOpcUa::UaStatusCode::BadInternalError);
+    node->writeAttribute(QOpcUaNode::NodeAttribute::Value, status);
+
+    QOpcUaVariant samples(QVector<double>({1.0, 2.0, 3.0}));
+    QVector<double> data = samples.array<double>();
+    \endcode
+
+    The elements of an array are accessed with array(), scalars with value().
+    Both return the stored data without a conversion if the requested C++ type
+    is the storage type of the value, value() falls back to a conversion
+    with QVariant otherwise.
+*/
+
+namespace {
+
+// The C++ type stored for every type, arrays are stored as QVector of it
+template<QOpcUa::Types> struct Storage;
+
+#define Q_OPCUA_VARIANT_STORAGE(TYPE, CPPTYPE) \
+    template<> struct Storage<QOpcUa::TYPE> { typedef CPPTYPE Type; };
+
+Q_OPCUA_VARIANT_STORAGE(Boolean, bool)
+Q_OPCUA_VARIANT_STORAGE(Int32, qint32)
+Q_OPCUA_VARIANT_STORAGE(UInt32, quint32)
+Q_OPCUA_VARIANT_STORAGE(Double, double)
+Q_OPCUA_VARIANT_STORAGE(Float, float)
+Q_OPCUA_VARIANT_STORAGE(String, QString)
+Q_OPCUA_VARIANT_STORAGE(LocalizedText, QOpcUa::QLocalizedText)
+Q_OPCUA_VARIANT_STORAGE(DateTime, QDateTime)
+Q_OPCUA_VARIANT_STORAGE(UInt16, quint16)
+Q_OPCUA_VARIANT_STORAGE(Int16, qint16)
+Q_OPCUA_VARIANT_STORAGE(UInt64, quint64)
+Q_OPCUA_VARIANT_STORAGE(Int64, qint64)
+Q_OPCUA_VARIANT_STORAGE(Byte, quint8)
+Q_OPCUA_VARIANT_STORAGE(SByte, qint8)
+Q_OPCUA_VARIANT_STORAGE(ByteString, QByteArray)
+Q_OPCUA_VARIANT_STORAGE(XmlElement, QString)
+Q_OPCUA_VARIANT_STORAGE(NodeId, QString)
+Q_OPCUA_VARIANT_STORAGE(Guid, QUuid)
+Q_OPCUA_VARIANT_STORAGE(QualifiedName, QOpcUa::QQualifiedName)
+Q_OPCUA_VARIANT_STORAGE(StatusCode, QOpcUa::UaStatusCode)
+
+#undef Q_OPCUA_VARIANT_STORAGE
+
+struct Operations
+{
+    // The type which has the same storage, for example QOpcUa::String for QOpcUa::NodeId
+    QOpcUa::Types storageType;
+    int (*metaType)();
+    void (*copy)(void *target, const void *source);
+    void (*destroy)(void *data);
+    bool (*equals)(const void *left, const void *right);
+    int (*length)(const void *data);
+    QVariant (*toQVariant)(const void *data);
+    // Constructs the storage in target if the value can be converted
+    bool (*fromQVariant)(void *target, const QVariant &value);
+};
+
+template<typename S>
+static QVariant elementToQVariant(const S &value, int metaType)
+{
+    if (metaType == QMetaType::UnknownType)
+        return QVariant::fromValue(value);
+    return QVariant(metaType, &value);
+}
+
+template<typename S>
+static bool elementFromQVariant(const QVariant &value, S *target)
+{
+    if (!value.canConvert<S>())
+        return false;
+    *target = value.value<S>();
+    return true;
+}
+
+template<>
+bool elementFromQVariant<QOpcUa::UaStatusCode>(const QVariant &value, QOpcUa::UaStatusCode *target)
+{
+    if (value.userType() == qMetaTypeId<QOpcUa::UaStatusCode>()) {
+        *target = value.value<QOpcUa::UaStatusCode>();
+        return true;
+    }
+    bool ok = false;
+    const quint32 code = value.toUInt(&ok);
+    if (ok)
+        *target = static_cast<QOpcUa::UaStatusCode>(code);
+    return ok;
+}
+
+template<QOpcUa::Types T>
+struct ScalarEntry
+{
+    typedef typename Storage<T>::Type S;
+    Q_STATIC_ASSERT(sizeof(S) <= sizeof(quint64) * 2);
+
+    static int metaType() { return qMetaTypeId<S>(); }
+    static void copy(void *target, const void *source) { new (target) S(*static_cast<const S *>(source)); }
+    static void destroy(void *data) { static_cast<S *>(data)->~S(); }
+    static bool equals(const void *left, const void *right) { return *static_cast<const S *>(left) == *static_cast<const S *>(right); }
+    static int length(const void *) { return 0; }
+
+    static QVariant toQVariant(const void *data)
+    {
+        return elementToQVariant(*static_cast<const S *>(data), QOpcUaTypeMapping::toMetaType(T));
+    }
+
+    static bool fromQVariant(void *target, const QVariant &value)
+    {
+        S converted = S();
+        if (!elementFromQVariant(value, &converted))
+            return false;
+        new (target) S(std::move(converted));
+        return true;
+    }
+
+    static constexpr Operations value()
+    {
+        return Operations{ QtPrivate::QOpcUaVariantType<S>::type, &metaType, &copy, &destroy, &equals, &length,
+                           &toQVariant, &fromQVariant };
+    }
+};
+
+template<QOpcUa::Types T>
+struct ArrayEntry
+{
+    typedef typename Storage<T>::Type S;
+    typedef QVector<S> V;
+
+    static int metaType() { return qMetaTypeId<V>(); }
+    static void copy(void *target, const void *source) { new (target) V(*static_cast<const V *>(source)); }
+    static void destroy(void *data) { static_cast<V *>(data)->~V(); }
+    static bool equals(const void *left, const void *right) { return *static_cast<const V *>(left) == *static_cast<const V *>(right); }
+    static int length(const void *data) { return static_cast<const V *>(data)->size(); }
+
+    static QVariant toQVariant(const void *data)
+    {
+        const V &array = *static_cast<const V *>(data);
+        const int metaType = QOpcUaTypeMapping::toMetaType(T);
+        QVariantList list;
+        list.reserve(array.size());
+        for (const S &element : array)
+            list.append(elementToQVariant(element, metaType));
+        return list;
+    }
+
+    static bool fromQVariant(void *target, const QVariant &value)
+    {
+        if (value.userType() == qMetaTypeId<V>()) {
+            new (target) V(value.value<V>());
+            return true;
+        }
+        if (value.type() != QVariant::List)
+            return false;
+
+        const QVariantList list = value.toList();
+        V array(list.size());
+        for (int i = 0; i < list.size(); ++i) {
+            if (!elementFromQVariant(list.at(i), &array[i]))
+                return false;
+        }
+        new (target) V(std::move(array));
+        return true;
+    }
+
+    static constexpr Operations value()
+    {
+        return Operations{ QtPrivate::QOpcUaVariantType<S>::type, &metaType, &copy, &destroy, &equals, &length,
+                           &toQVariant, &fromQVariant };
+    }
+};
+
+constexpr auto scalarOperations = QOpcUaTypeMapping::valueTable<ScalarEntry, Operations>();
+constexpr auto arrayOperations = QOpcUaTypeMapping::valueTable<ArrayEntry, Operations>();
+
+const Operations *operations(quint32 type, bool array)
+{
+    const QOpcUa::Types t = static_cast<QOpcUa::Types>(type);
+    return array ? arrayOperations.at(t) : scalarOperations.at(t);
+}
+
+// Determines the type of a QVariant which has not been created with an explicit type
+QOpcUa::Types typeOf(const QVariant &value, bool *isArray)
+{
+    *isArray = false;
+    QVariant element = value;
+
+    if (value.type() == QVariant::List) {
+        const QVariantList list = value.toList();
+        if (list.isEmpty())
+            return QOpcUa::Undefined;
+        *isArray = true;
+        element = list.first();
+    } else {
+        for (int i = 0; i < QOpcUaTypeMapping::TypeCount; ++i) {
+            if (arrayOperations.values[i].metaType() == value.userType()) {
+                *isArray = true;
+                return static_cast<QOpcUa::Types>(i);
+            }
+        }
+    }
+
+    const QOpcUa::Types type = QOpcUaTypeMapping::fromMetaType(element.userType());
+    if (type != QOpcUa::Undefined)
+        return type;
+    for (int i = 0; i < QOpcUaTypeMapping::TypeCount; ++i) {
+        if (scalarOperations.values[i].metaType() == element.userType())
+            return static_cast<QOpcUa::Types>(i);
+    }
+    return QOpcUa::Undefined;
+}
+
+}
+
+/*!
+    Constructs an invalid QOpcUaVariant.
+*/
+QOpcUaVariant::QOpcUaVariant() Q_DECL_NOTHROW
+    : m_type(QOpcUa::Undefined)
+    , m_isArray(false)
+{
+    m_data.buffer[0] = m_data.buffer[1] = 0;
+}
+
+#define Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(CPPTYPE, MEMBER, TYPE) \
+    QOpcUaVariant::QOpcUaVariant(CPPTYPE value) \
+        : m_type(QOpcUa::TYPE) \
+        , m_isArray(false) \
+    { \
+        m_data.buffer[0] = m_data.buffer[1] = 0; \
+        m_data.MEMBER = value; \
+    }
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(bool value)
+
+    Constructs a Boolean with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(bool, b, Boolean)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(qint8 value)
+
+    Constructs an SByte with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(qint8, i8, SByte)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(quint8 value)
+
+    Constructs a Byte with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(quint8, u8, Byte)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(qint16 value)
+
+    Constructs an Int16 with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(qint16, i16, Int16)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(quint16 value)
+
+    Constructs a UInt16 with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(quint16, u16, UInt16)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(qint32 value)
+
+    Constructs an Int32 with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(qint32, i32, Int32)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(quint32 value)
+
+    Constructs a UInt32 with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(quint32, u32, UInt32)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(qint64 value)
+
+    Constructs an Int64 with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(qint64, i64, Int64)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(quint64 value)
+
+    Constructs a UInt64 with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(quint64, u64, UInt64)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(float value)
+
+    Constructs a Float with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(float, f, Float)
+
+/*!
+    \fn QOpcUaVariant::QOpcUaVariant(double value)
+
+    Constructs a Double with \a value.
+*/
+Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR(double, d, Double)
+
+#undef Q_OPCUA_VARIANT_NUMERIC_CONSTRUCTOR
+
+/*!
+    Constructs a value of \a type from the string \a value.
+    \a type must be QOpcUa::String, QOpcUa::NodeId or QOpcUa::XmlElement.
+*/
+QOpcUaVariant::QOpcUaVariant(const QString &value, QOpcUa::Types type)
+    : QOpcUaVariant()
+{
+    const Operations *ops = operations(type, false);
+    if (!ops || ops->storageType != QOpcUa::String) {
+        qCWarning(QT_OPCUA) << "A string can't be stored as" << type;
+        return;
+    }
+    new (&m_data) QString(value);
+    m_type = type;
+}
+
+/*!
+    Constructs a ByteString with \a value.
+*/
+QOpcUaVariant::QOpcUaVariant(const QByteArray &value)
+    : m_type(QOpcUa::ByteString)
+    , m_isArray(false)
+{
+    new (&m_data) QByteArray(value);
+}
+
+/*!
+    Constructs a DateTime with \a value.
+*/
+QOpcUaVariant::QOpcUaVariant(const QDateTime &value)
+    : m_type(QOpcUa::DateTime)
+    , m_isArray(false)
+{
+    new (&m_data) QDateTime(value);
+}
+
+/*!
+    Constructs a Guid with \a value.
+*/
+QOpcUaVariant::QOpcUaVariant(const QUuid &value)
+    : m_type(QOpcUa::Guid)
+    , m_isArray(false)
+{
+    new (&m_data) QUuid(value);
+}
+
+/*!
+    Constructs a LocalizedText with \a value.
+*/
+QOpcUaVariant::QOpcUaVariant(const QOpcUa::QLocalizedText &value)
+    : m_type(QOpcUa::LocalizedText)
+    , m_isArray(false)
+{
+    new (&m_data) QOpcUa::QLocalizedText(value);
+}
+
+/*!
+    Constructs a QualifiedName with \a value.
+*/
+QOpcUaVariant::QOpcUaVariant(const QOpcUa::QQualifiedName &value)
+    : m_type(QOpcUa::QualifiedName)
+    , m_isArray(false)
+{
+    new (&m_data) QOpcUa::QQualifiedName(value);
+}
+
+/*!
+    Constructs a StatusCode with \a value.
+*/
+QOpcUaVariant::QOpcUaVariant(QOpcUa::UaStatusCode value)
+    : m_type(QOpcUa::StatusCode)
+    , m_isArray(false)
+{
+    m_data.buffer[0] = m_data.buffer[1] = 0;
+    new (&m_data) QOpcUa::UaStatusCode(value);
+}
+
+/*!
+    \fn template<typename T> QOpcUaVariant::QOpcUaVariant(const QVector<T> &array, QOpcUa::Types type)
+
+    Constructs an array of \a type with the elements of \a array. The array shares
+    the buffer of the vector. \a type defaults to the type stored as \c T and
+    must have the same storage type, for example QOpcUa::NodeId for a QVector<QString>.
+*/
+
+/*!
+    Constructs a copy of \a other. Arrays share their buffer with \a other.
+*/
+QOpcUaVariant::QOpcUaVariant(const QOpcUaVariant &other)
+    : m_type(other.m_type)
+    , m_isArray(other.m_isArray)
+{
+    if (isValid())
+        operations(m_type, m_isArray)->copy(&m_data, &other.m_data);
+    else
+        m_data.buffer[0] = m_data.buffer[1] = 0;
+}
+
+/*!
+    Move-constructs a QOpcUaVariant from \a other, which is invalid afterwards.
+*/
+QOpcUaVariant::QOpcUaVariant(QOpcUaVariant &&other) Q_DECL_NOTHROW
+    : m_type(other.m_type)
+    , m_isArray(other.m_isArray)
+    , m_data(other.m_data)
+{
+    other.m_type = QOpcUa::Undefined;
+    other.m_isArray = false;
+}
+
+/*!
+    Destroys the QOpcUaVariant.
+*/
+QOpcUaVariant::~QOpcUaVariant()
+{
+    clear();
+}
+
+/*!
+    Assigns \a other to this QOpcUaVariant.
+*/
+QOpcUaVariant &QOpcUaVariant::operator=(const QOpcUaVariant &other)
+{
+    QOpcUaVariant copy(other);
+    swap(copy);
+    return *this;
+}
+
+/*!
+    Move-assigns \a other to this QOpcUaVariant.
+*/
+QOpcUaVariant &QOpcUaVariant::operator=(QOpcUaVariant &&other) Q_DECL_NOTHROW
+{
+    QOpcUaVariant moved(std::move(other));
+    swap(moved);
+    return *this;
+}
+
+/*!
+    Swaps this QOpcUaVariant with \a other.
+*/
+void QOpcUaVariant::swap(QOpcUaVariant &other) Q_DECL_NOTHROW
+{
+    qSwap(m_type, other.m_type);
+    qSwap(m_isArray, other.m_isArray);
+    qSwap(m_data, other.m_data);
+}
+
+/*!
+    Returns \c true if \a other has the same type and value.
+*/
+bool QOpcUaVariant::operator==(const QOpcUaVariant &other) const
+{
+    if (m_type != other.m_type || m_isArray != other.m_isArray)
+        return false;
+    return !isValid() || operations(m_type, m_isArray)->equals(&m_data, &other.m_data);
+}
+
+/*!
+    \fn bool QOpcUaVariant::operator!=(const QOpcUaVariant &other) const
+
+    Returns \c true if \a other has a different type or value.
+*/
+
+/*!
+    \fn bool QOpcUaVariant::isValid() const
+
+    Returns \c true if a value is stored.
+*/
+
+/*!
+    \fn QOpcUa::Types QOpcUaVariant::type() const
+
+    Returns the type of the value or of the elements of an array.
+*/
+
+/*!
+    \fn bool QOpcUaVariant::isArray() const
+
+    Returns \c true if the value is an array.
+*/
+
+/*!
+    Returns the number of elements of an array, 0 for scalars.
+*/
+int QOpcUaVariant::arrayLength() const
+{
+    return isValid() ? operations(m_type, m_isArray)->length(&m_data) : 0;
+}
+
+/*!
+    \fn template<typename T> T QOpcUaVariant::value() const
+
+    Returns the scalar value as \c T. The stored value is returned directly if
+    \c T is its storage type, otherwise it is converted using QVariant.
+*/
+
+/*!
+    \fn template<typename T> QVector<T> QOpcUaVariant::array() const
+
+    Returns the elements of an array whose storage type is \c T, the vector
+    shares its buffer with the QOpcUaVariant. An empty vector is returned
+    for scalars and arrays of other types.
+*/
+
+/*!
+    Returns the value as QVariant in the representation used by QOpcUaNode::attribute().
+    Arrays are returned as QVariantList.
+*/
+QVariant QOpcUaVariant::toQVariant() const
+{
+    if (!isValid())
+        return QVariant();
+    return operations(m_type, m_isArray)->toQVariant(&m_data);
+}
+
+/*!
+    Converts \a value to a QOpcUaVariant of \a type. If \a type is QOpcUa::Undefined,
+    the type is derived from the type of \a value. QVariantList and QVector values
+    are converted to arrays.
+
+    An invalid QOpcUaVariant is returned if \a value can't be converted.
+*/
+QOpcUaVariant QOpcUaVariant::fromQVariant(const QVariant &value, QOpcUa::Types type)
+{
+    if (value.userType() == qMetaTypeId<QOpcUaVariant>())
+        return value.value<QOpcUaVariant>();
+
+    bool isArray = false;
+    const QOpcUa::Types detectedType = typeOf(value, &isArray);
+    if (type == QOpcUa::Undefined)
+        type = detectedType;
+
+    QOpcUaVariant result;
+    const Operations *ops = operations(type, false);
+    if (!ops)
+        return result;
+    isArray = value.type() == QVariant::List || value.userType() == arrayOperations.at(type)->metaType();
+    if (isArray)
+        ops = arrayOperations.at(type);
+    if (!ops->fromQVariant(&result.m_data, value))
+        return result;
+    result.m_type = type;
+    result.m_isArray = isArray;
+    return result;
+}
+
+const void *QOpcUaVariant::constData(QOpcUa::Types storageType, bool array) const
+{
+    if (!isValid() || array != m_isArray || operations(m_type, m_isArray)->storageType != storageType)
+        return nullptr;
+    return &m_data;
+}
+
+void QOpcUaVariant::initArray(const void *array, QOpcUa::Types storageType, QOpcUa::Types type)
+{
+    m_data.buffer[0] = m_data.buffer[1] = 0;
+    const Operations *ops = operations(type, true);
+    if (!ops || ops->storageType != storageType) {
+        qCWarning(QT_OPCUA) << "An array of" << storageType << "can't be stored as" << type;
+        return;
+    }
+    ops->copy(&m_data, array);
+    m_type = type;
+    m_isArray = true;
+}
+
+void QOpcUaVariant::clear()
+{
+    if (isValid())
+        operations(m_type, m_isArray)->destroy(&m_data);
+    m_type = QOpcUa::Undefined;
+    m_isArray = false;
+}
+
+QT_END_NAMESPACE
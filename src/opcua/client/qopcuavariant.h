@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAVARIANT_H
+#define QOPCUAVARIANT_H
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qmetatype.h>
+#include <QtCore/qstring.h>
+#include <QtCore/quuid.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+// The type which is stored in a QOpcUaVariant for a C++ type
+template<typename T> struct QOpcUaVariantType { static const QOpcUa::Types type = QOpcUa::Undefined; };
+#define Q_OPCUA_VARIANT_TYPE(CPPTYPE, TYPE) \
+    template<> struct QOpcUaVariantType<CPPTYPE> { static const QOpcUa::Types type = QOpcUa::TYPE; };
+Q_OPCUA_VARIANT_TYPE(bool, Boolean)
+Q_OPCUA_VARIANT_TYPE(qint8, SByte)
+Q_OPCUA_VARIANT_TYPE(quint8, Byte)
+Q_OPCUA_VARIANT_TYPE(qint16, Int16)
+Q_OPCUA_VARIANT_TYPE(quint16, UInt16)
+Q_OPCUA_VARIANT_TYPE(qint32, Int32)
+Q_OPCUA_VARIANT_TYPE(quint32, UInt32)
+Q_OPCUA_VARIANT_TYPE(qint64, Int64)
+Q_OPCUA_VARIANT_TYPE(quint64, UInt64)
+Q_OPCUA_VARIANT_TYPE(float, Float)
+Q_OPCUA_VARIANT_TYPE(double, Double)
+Q_OPCUA_VARIANT_TYPE(QString, String)
+Q_OPCUA_VARIANT_TYPE(QByteArray, ByteString)
+Q_OPCUA_VARIANT_TYPE(QDateTime, DateTime)
+Q_OPCUA_VARIANT_TYPE(QUuid, Guid)
+Q_OPCUA_VARIANT_TYPE(QOpcUa::QLocalizedText, LocalizedText)
+Q_OPCUA_VARIANT_TYPE(QOpcUa::QQualifiedName, QualifiedName)
+Q_OPCUA_VARIANT_TYPE(QOpcUa::UaStatusCode, StatusCode)
+#undef Q_OPCUA_VARIANT_TYPE
+}
+
+class Q_OPCUA_EXPORT QOpcUaVariant
+{
+public:
+    QOpcUaVariant() Q_DECL_NOTHROW;
+    explicit QOpcUaVariant(bool value);
+    explicit QOpcUaVariant(qint8 value);
+    explicit QOpcUaVariant(quint8 value);
+    explicit QOpcUaVariant(qint16 value);
+    explicit QOpcUaVariant(quint16 value);
+    explicit QOpcUaVariant(qint32 value);
+    explicit QOpcUaVariant(quint32 value);
+    explicit QOpcUaVariant(qint64 value);
+    explicit QOpcUaVariant(quint64 value);
+    explicit QOpcUaVariant(float value);
+    explicit QOpcUaVariant(double value);
+    explicit QOpcUaVariant(const QString &value, QOpcUa::Types type = QOpcUa::String);
+    explicit QOpcUaVariant(const QByteArray &value);
+    explicit QOpcUaVariant(const QDateTime &value);
+    explicit QOpcUaVariant(const QUuid &value);
+    explicit QOpcUaVariant(const QOpcUa::QLocalizedText &value);
+    explicit QOpcUaVariant(const QOpcUa::QQualifiedName &value);
+    explicit QOpcUaVariant(QOpcUa::UaStatusCode value);
+
+    // The array shares the buffer of the vector
+    template<typename T>
+    explicit QOpcUaVariant(const QVector<T> &array, QOpcUa::Types type = QtPrivate::QOpcUaVariantType<T>::type)
+        : m_type(QOpcUa::Undefined)
+        , m_isArray(false)
+    {
+        Q_STATIC_ASSERT_X(QtPrivate::QOpcUaVariantType<T>::type != QOpcUa::Undefined,
+                          "QOpcUaVariant can only store arrays of OPC UA built-in types");
+        initArray(&array, QtPrivate::QOpcUaVariantType<T>::type, type);
+    }
+
+    QOpcUaVariant(const QOpcUaVariant &other);
+    QOpcUaVariant(QOpcUaVariant &&other) Q_DECL_NOTHROW;
+    ~QOpcUaVariant();
+
+    QOpcUaVariant &operator=(const QOpcUaVariant &other);
+    QOpcUaVariant &operator=(QOpcUaVariant &&other) Q_DECL_NOTHROW;
+    void swap(QOpcUaVariant &other) Q_DECL_NOTHROW;
+
+    bool operator==(const QOpcUaVariant &other) const;
+    bool operator!=(const QOpcUaVariant &other) const { return !(*this == other); }
+
+    bool isValid() const { return m_type != QOpcUa::Undefined; }
+    QOpcUa::Types type() const { return static_cast<QOpcUa::Types>(m_type); }
+    bool isArray() const { return m_isArray; }
+    int arrayLength() const;
+
+    template<typename T>
+    T value() const
+    {
+        if (const T *data = static_cast<const T *>(constData(QtPrivate::QOpcUaVariantType<T>::type, false)))
+            return *data;
+        return toQVariant().value<T>();
+    }
+
+    template<typename T>
+    QVector<T> array() const
+    {
+        if (const QVector<T> *data = static_cast<const QVector<T> *>(constData(QtPrivate::QOpcUaVariantType<T>::type, true)))
+            return *data;
+        return QVector<T>();
+    }
+
+    QVariant toQVariant() const;
+    static QOpcUaVariant fromQVariant(const QVariant &value, QOpcUa::Types type = QOpcUa::Undefined);
+
+private:
+    const void *constData(QOpcUa::Types storageType, bool array) const;
+    void initArray(const void *array, QOpcUa::Types storageType, QOpcUa::Types type);
+    void clear();
+
+    quint32 m_type;
+    bool m_isArray;
+    // Holds numeric scalars directly, all other types are constructed in place.
+    // All stored types are relocatable, so a move is a plain copy of the bytes.
+    union Data {
+        bool b;
+        qint8 i8;
+        quint8 u8;
+        qint16 i16;
+        quint16 u16;
+        qint32 i32;
+        quint32 u32;
+        qint64 i64;
+        quint64 u64;
+        float f;
+        double d;
+        quint64 buffer[2];
+    } m_data;
+};
+
+Q_DECLARE_SHARED(QOpcUaVariant)
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QOpcUaVariant)
+
+#endif // QOPCUAVARIANT_H
@@ -6,5 +6,10 @@ PUBLIC_HEADERS += \
 
 SOURCES += \
     core/qopcuaprovider.cpp \
-    core/qopcuaplugin.cpp
+    core/qopcuaplugin.cpp \
+    core/qopcuaarraykernels.cpp
+
+HEADERS += \
+    core/qopcuaarraykernels_p.h \
+    core/qopcuatypemapping_p.h
 
@@ -0,0 +1,309 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopcuaarraykernels_p.h"
+
+#include <QtCore/private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QOpcUaArrayKernels {
+
+static const qint64 TicksPerMSec = 10000;
+
+static inline qint64 tickToMSec(qint64 tick, qint64 epochTicks)
+{
+    return (tick - epochTicks) / TicksPerMSec;
+}
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+// AVX2 has neither a packed 64 bit division nor conversions between int64 and double.
+// The quotient is estimated in double precision and corrected with exact integer arithmetic.
+QT_FUNCTION_TARGET(AVX2)
+static int ticksToMSecsAvx2(const qint64 *ticks, qint64 *msecs, int count, qint64 epochTicks)
+{
+    // Exact int64 to double conversion for the full range (3 * 2^67 and 3 * 2^67 + 2^52)
+    const __m256d highMagic = _mm256_set1_pd(442721857769029238784.);
+    const __m256d highBias = _mm256_set1_pd(442726361368656609280.);
+    const __m256d lowMagic = _mm256_set1_pd(4503599627370496.); // 2^52
+    // Double to int64 conversion, valid for |x| < 2^51 (2^52 + 2^51)
+    const __m256d roundMagic = _mm256_set1_pd(6755399441055744.);
+    const __m256d scale = _mm256_set1_pd(1.0 / TicksPerMSec);
+    const __m256i epoch = _mm256_set1_epi64x(epochTicks);
+    const __m256i divisor = _mm256_set1_epi64x(TicksPerMSec);
+    const __m256i divisorMinusOne = _mm256_set1_epi64x(TicksPerMSec - 1);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i zero = _mm256_setzero_si256();
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i t = _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ticks + i)), epoch);
+
+        __m256i high = _mm256_srai_epi32(t, 16);
+        high = _mm256_blend_epi16(high, zero, 0x33);
+        high = _mm256_add_epi64(high, _mm256_castpd_si256(highMagic));
+        const __m256i low = _mm256_blend_epi16(t, _mm256_castpd_si256(lowMagic), 0x88);
+        const __m256d value = _mm256_add_pd(_mm256_sub_pd(_mm256_castsi256_pd(high), highBias), _mm256_castsi256_pd(low));
+
+        // Rounded estimate, off by at most one
+        const __m256d estimate = _mm256_add_pd(_mm256_mul_pd(value, scale), roundMagic);
+        __m256i q = _mm256_sub_epi64(_mm256_castpd_si256(estimate), _mm256_castpd_si256(roundMagic));
+
+        // q * 10000 = q * (8192 + 1024 + 512 + 256 + 16)
+        __m256i product = _mm256_slli_epi64(q, 13);
+        product = _mm256_add_epi64(product, _mm256_slli_epi64(q, 10));
+        product = _mm256_add_epi64(product, _mm256_slli_epi64(q, 9));
+        product = _mm256_add_epi64(product, _mm256_slli_epi64(q, 8));
+        product = _mm256_add_epi64(product, _mm256_slli_epi64(q, 4));
+        __m256i remainder = _mm256_sub_epi64(t, product);
+
+        // Correct the estimate to the floor of the quotient
+        const __m256i tooLarge = _mm256_cmpgt_epi64(zero, remainder);
+        q = _mm256_add_epi64(q, tooLarge);
+        remainder = _mm256_add_epi64(remainder, _mm256_and_si256(tooLarge, divisor));
+        const __m256i tooSmall = _mm256_cmpgt_epi64(remainder, divisorMinusOne);
+        q = _mm256_sub_epi64(q, tooSmall);
+        remainder = _mm256_sub_epi64(remainder, _mm256_and_si256(tooSmall, divisor));
+
+        // Round negative values towards zero like the integer division does
+        const __m256i negative = _mm256_cmpgt_epi64(zero, t);
+        const __m256i inexact = _mm256_xor_si256(_mm256_cmpeq_epi64(remainder, zero), _mm256_set1_epi64x(-1));
+        q = _mm256_add_epi64(q, _mm256_and_si256(_mm256_and_si256(negative, inexact), one));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(msecs + i), q);
+    }
+    return i;
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static int floatToDoubleAvx2(const float *src, double *dst, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+    return i;
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static int doubleToFloatAvx2(const double *src, float *dst, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+    return i;
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static int unpackBooleansAvx2(const quint8 *src, bool *dst, int count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        const __m256i isZero = _mm256_cmpeq_epi8(bytes, zero);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_andnot_si256(isZero, one));
+    }
+    return i;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(SSE2)
+// All ones in the 64 bit lanes holding a negative value. SSE2 has no 64 bit comparisons,
+// the sign of the high half is spread over the whole lane instead.
+QT_FUNCTION_TARGET(SSE2)
+static inline __m128i negativeMaskSse2(__m128i value)
+{
+    return _mm_srai_epi32(_mm_shuffle_epi32(value, _MM_SHUFFLE(3, 3, 1, 1)), 31);
+}
+
+// Same estimate and correction as the AVX2 kernel, the int64 to double conversion is split
+// into the signed high and the unsigned low 32 bits of each lane.
+QT_FUNCTION_TARGET(SSE2)
+static int ticksToMSecsSse2(const qint64 *ticks, qint64 *msecs, int count, qint64 epochTicks)
+{
+    const __m128d twoPow32 = _mm_set1_pd(4294967296.);
+    const __m128d lowMagic = _mm_set1_pd(4503599627370496.); // 2^52
+    const __m128i lowMask = _mm_set_epi32(0, -1, 0, -1);
+    // Double to int64 conversion, valid for |x| < 2^51 (2^52 + 2^51)
+    const __m128d roundMagic = _mm_set1_pd(6755399441055744.);
+    const __m128d scale = _mm_set1_pd(1.0 / TicksPerMSec);
+    const __m128i epoch = _mm_set1_epi64x(epochTicks);
+    const __m128i divisor = _mm_set1_epi64x(TicksPerMSec);
+    const __m128i one = _mm_set1_epi64x(1);
+    const __m128i zero = _mm_setzero_si128();
+
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128i t = _mm_sub_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ticks + i)), epoch);
+
+        const __m128d high = _mm_cvtepi32_pd(_mm_shuffle_epi32(t, _MM_SHUFFLE(3, 1, 3, 1)));
+        const __m128i lowBits = _mm_or_si128(_mm_and_si128(t, lowMask), _mm_castpd_si128(lowMagic));
+        const __m128d low = _mm_sub_pd(_mm_castsi128_pd(lowBits), lowMagic);
+        const __m128d value = _mm_add_pd(_mm_mul_pd(high, twoPow32), low);
+
+        // Rounded estimate, off by at most one
+        const __m128d estimate = _mm_add_pd(_mm_mul_pd(value, scale), roundMagic);
+        __m128i q = _mm_sub_epi64(_mm_castpd_si128(estimate), _mm_castpd_si128(roundMagic));
+
+        // q * 10000 = q * (8192 + 1024 + 512 + 256 + 16)
+        __m128i product = _mm_slli_epi64(q, 13);
+        product = _mm_add_epi64(product, _mm_slli_epi64(q, 10));
+        product = _mm_add_epi64(product, _mm_slli_epi64(q, 9));
+        product = _mm_add_epi64(product, _mm_slli_epi64(q, 8));
+        product = _mm_add_epi64(product, _mm_slli_epi64(q, 4));
+        __m128i remainder = _mm_sub_epi64(t, product);
+
+        // Correct the estimate to the floor of the quotient
+        const __m128i tooLarge = negativeMaskSse2(remainder);
+        q = _mm_add_epi64(q, tooLarge);
+        remainder = _mm_add_epi64(remainder, _mm_and_si128(tooLarge, divisor));
+        const __m128i tooSmall = _mm_xor_si128(negativeMaskSse2(_mm_sub_epi64(remainder, divisor)), _mm_set1_epi32(-1));
+        q = _mm_sub_epi64(q, tooSmall);
+        remainder = _mm_sub_epi64(remainder, _mm_and_si128(tooSmall, divisor));
+
+        // Round negative values towards zero like the integer division does
+        __m128i exact = _mm_cmpeq_epi32(remainder, zero);
+        exact = _mm_and_si128(exact, _mm_shuffle_epi32(exact, _MM_SHUFFLE(2, 3, 0, 1)));
+        q = _mm_add_epi64(q, _mm_and_si128(_mm_andnot_si128(exact, negativeMaskSse2(t)), one));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(msecs + i), q);
+    }
+    return i;
+}
+
+QT_FUNCTION_TARGET(SSE2)
+static int floatToDoubleSse2(const float *src, double *dst, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 values = _mm_loadu_ps(src + i);
+        _mm_storeu_pd(dst + i, _mm_cvtps_pd(values));
+        _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(values, values)));
+    }
+    return i;
+}
+
+QT_FUNCTION_TARGET(SSE2)
+static int doubleToFloatSse2(const double *src, float *dst, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 low = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        const __m128 high = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        _mm_storeu_ps(dst + i, _mm_movelh_ps(low, high));
+    }
+    return i;
+}
+
+QT_FUNCTION_TARGET(SSE2)
+static int unpackBooleansSse2(const quint8 *src, bool *dst, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i isZero = _mm_cmpeq_epi8(bytes, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_andnot_si128(isZero, one));
+    }
+    return i;
+}
+#endif
+
+void ticksToMSecs(const qint64 *ticks, qint64 *msecs, int count, qint64 epochTicks)
+{
+    int i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        i = ticksToMSecsAvx2(ticks, msecs, count, epochTicks);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(SSE2)
+    if (qCpuHasFeature(SSE2))
+        i += ticksToMSecsSse2(ticks + i, msecs + i, count - i, epochTicks);
+#endif
+    for (; i < count; ++i)
+        msecs[i] = tickToMSec(ticks[i], epochTicks);
+}
+
+void floatToDouble(const float *src, double *dst, int count)
+{
+    int i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        i = floatToDoubleAvx2(src, dst, count);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(SSE2)
+    if (qCpuHasFeature(SSE2))
+        i += floatToDoubleSse2(src + i, dst + i, count - i);
+#endif
+    for (; i < count; ++i)
+        dst[i] = src[i];
+}
+
+void doubleToFloat(const double *src, float *dst, int count)
+{
+    int i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        i = doubleToFloatAvx2(src, dst, count);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(SSE2)
+    if (qCpuHasFeature(SSE2))
+        i += doubleToFloatSse2(src + i, dst + i, count - i);
+#endif
+    for (; i < count; ++i)
+        dst[i] = static_cast<float>(src[i]);
+}
+
+void unpackBooleans(const quint8 *src, bool *dst, int count)
+{
+    int i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        i = unpackBooleansAvx2(src, dst, count);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(SSE2)
+    if (qCpuHasFeature(SSE2))
+        i += unpackBooleansSse2(src + i, dst + i, count - i);
+#endif
+    for (; i < count; ++i)
+        dst[i] = src[i] != 0;
+}
+
+}
+
+QT_END_NAMESPACE
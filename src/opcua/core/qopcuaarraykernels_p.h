@@ -0,0 +1,74 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUAARRAYKERNELS_P_H
+#define QOPCUAARRAYKERNELS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+// Bulk conversions shared by the value converters of all backends.
+// Each kernel picks the widest instruction set supported by the CPU at runtime.
+namespace QOpcUaArrayKernels {
+    // OPC UA DateTime ticks (100 ns) between 1601-01-01 and 1970-01-01
+    constexpr qint64 UnixEpochTicks = 116444736000000000LL;
+
+    // Converts DateTime ticks to milliseconds, rounding towards zero like an integer division.
+    // epochTicks is subtracted first, pass UnixEpochTicks for ticks counted from 1601.
+    Q_OPCUA_EXPORT void ticksToMSecs(const qint64 *ticks, qint64 *msecs, int count, qint64 epochTicks = 0);
+
+    Q_OPCUA_EXPORT void floatToDouble(const float *src, double *dst, int count);
+    Q_OPCUA_EXPORT void doubleToFloat(const double *src, float *dst, int count);
+
+    // Turns one byte booleans with any non zero value into valid bools
+    Q_OPCUA_EXPORT void unpackBooleans(const quint8 *src, bool *dst, int count);
+}
+
+QT_END_NAMESPACE
+
+#endif // QOPCUAARRAYKERNELS_P_H
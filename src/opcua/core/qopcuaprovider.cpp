@@ -36,9 +36,18 @@
 
 #include "qopcuaplugin.h"
 #include "qopcuaprovider.h"
+#include <QtOpcUa/qopcuaaggregation.h>
 #include <QtOpcUa/qopcuaclient.h>
+#include <QtOpcUa/qopcuaeventfilter.h>
+#include <QtOpcUa/qopcuamethodcall.h>
+#include <QtOpcUa/qopcuamonitoringparameters.h>
+#include <QtOpcUa/qopcuamultidimensionalarray.h>
 #include <QtOpcUa/qopcuanode.h>
+#include <QtOpcUa/qopcuareconnectpolicy.h>
+#include <QtOpcUa/qopcuastructuredvalue.h>
+#include <QtOpcUa/qopcuasubscriptionparameters.h>
 #include <QtOpcUa/qopcuatype.h>
+#include <QtOpcUa/qopcuavariant.h>
 #include <private/qopcuanodeimpl_p.h>
 
 #include <private/qfactoryloader_p.h>
@@ -107,6 +116,20 @@ QOpcUaProvider::QOpcUaProvider(QObject *parent)
     qRegisterMetaType<QOpcUa::Types>();
     qRegisterMetaType<QOpcUa::TypedVariant>();
     qRegisterMetaType<QOpcUa::UaStatusCode>();
+    qRegisterMetaType<QOpcUa::MonitoringMode>();
+    qRegisterMetaType<QOpcUaSubscriptionParameters>();
+    qRegisterMetaType<QOpcUaReconnectPolicy>();
+    qRegisterMetaType<QVector<QUrl>>();
+    qRegisterMetaType<QOpcUaMethodCall>();
+    qRegisterMetaType<QVector<QOpcUaMethodCall>>();
+    qRegisterMetaType<QOpcUaMethodCallResult>();
+    qRegisterMetaType<QVector<QOpcUaMethodCallResult>>();
+    qRegisterMetaType<QOpcUaMethodArgument>();
+    qRegisterMetaType<QVector<QOpcUaMethodArgument>>();
+    qRegisterMetaType<QOpcUaMonitoringParameters>();
+    qRegisterMetaType<QOpcUaEventFilter>();
+    qRegisterMetaType<QOpcUaAggregationWindow>();
+    qRegisterMetaType<QOpcUaAggregateValue>();
     qRegisterMetaType<QOpcUaNode::NodeClass>();
     qRegisterMetaType<QOpcUa::QQualifiedName>();
     qRegisterMetaType<QOpcUaNode::NodeAttribute>();
@@ -115,6 +138,10 @@ QOpcUaProvider::QOpcUaProvider(QObject *parent)
     qRegisterMetaType<QVector<QOpcUaReadResult>>();
     qRegisterMetaType<QOpcUaClient::ClientState>();
     qRegisterMetaType<QOpcUaClient::ClientError>();
+    qRegisterMetaType<QOpcUaClient::ArrayRepresentation>();
+    qRegisterMetaType<QOpcUaMultiDimensionalArray>();
+    qRegisterMetaType<QOpcUaVariant>();
+    qRegisterMetaType<QOpcUaStructuredValue>();
     qRegisterMetaType<uintptr_t>("uintptr_t");
 }
 
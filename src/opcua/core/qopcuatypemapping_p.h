@@ -0,0 +1,260 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPCUATYPEMAPPING_P_H
+#define QOPCUATYPEMAPPING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtOpcUa/qopcuaglobal.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qmetatype.h>
+
+QT_BEGIN_NAMESPACE
+
+// Compile time lookup tables between QOpcUa::Types, QMetaType ids and the type indices
+// of the backends. The value converters of all backends are generated from these tables,
+// so the mappings can't drift apart and every lookup is a single array access.
+namespace QOpcUaTypeMapping {
+    constexpr int TypeCount = QOpcUa::StatusCode + 1;
+    constexpr int NoMapping = -1;
+
+    template<int... I> struct IndexSequence {};
+    template<int N, int... I> struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+    template<int... I> struct MakeIndexSequence<0, I...> { typedef IndexSequence<I...> Type; };
+
+    // Numeric ids of the built-in types in namespace 0 (OPC UA part 6), ordered like QOpcUa::Types.
+    // freeopcua uses these ids as its variant types.
+    constexpr int builtinTypeIds[TypeCount] = {
+        1,  // Boolean
+        6,  // Int32
+        7,  // UInt32
+        11, // Double
+        10, // Float
+        12, // String
+        21, // LocalizedText
+        13, // DateTime
+        5,  // UInt16
+        4,  // Int16
+        9,  // UInt64
+        8,  // Int64
+        3,  // Byte
+        2,  // SByte
+        15, // ByteString
+        16, // XmlElement
+        17, // NodeId
+        14, // Guid
+        20, // QualifiedName
+        19  // StatusCode
+    };
+
+    // Built-in meta type used for scalar values, types without one are stored with QVariant::fromValue().
+    // The mapping is not one to one: XmlElement and NodeId are stored as QString and StatusCode as
+    // uint, fromMetaType() returns String and UInt32 for them. The type is only kept where it is
+    // passed along explicitly, e.g. by QOpcUa::TypedVariant.
+    constexpr int metaTypes[TypeCount] = {
+        QMetaType::Bool,
+        QMetaType::Int,
+        QMetaType::UInt,
+        QMetaType::Double,
+        QMetaType::Float,
+        QMetaType::QString,
+        NoMapping, // QOpcUa::QLocalizedText
+        QMetaType::QDateTime,
+        QMetaType::UShort,
+        QMetaType::Short,
+        QMetaType::ULongLong,
+        QMetaType::LongLong,
+        QMetaType::UChar,
+        QMetaType::SChar,
+        QMetaType::QByteArray,
+        QMetaType::QString,
+        QMetaType::QString,
+        QMetaType::QUuid,
+        NoMapping, // QOpcUa::QQualifiedName
+        QMetaType::UInt
+    };
+
+    template<int N>
+    struct TypeTable
+    {
+        QOpcUa::Types types[N];
+
+        QOpcUa::Types at(int index) const
+        {
+            return index >= 0 && index < N ? types[index] : QOpcUa::Undefined;
+        }
+    };
+
+    template<typename Function>
+    struct DispatchTable
+    {
+        Function functions[TypeCount];
+
+        Function at(QOpcUa::Types type) const
+        {
+            return static_cast<quint32>(type) < static_cast<quint32>(TypeCount) ? functions[type] : nullptr;
+        }
+    };
+
+    template<typename Value>
+    struct ValueTable
+    {
+        Value values[TypeCount];
+
+        const Value *at(QOpcUa::Types type) const
+        {
+            return static_cast<quint32>(type) < static_cast<quint32>(TypeCount) ? &values[type] : nullptr;
+        }
+    };
+
+    // The first type wins if several types share a value, e.g. QString maps to QOpcUa::String
+    constexpr QOpcUa::Types lookupType(const int *forward, int value, int type = 0)
+    {
+        return type >= TypeCount ? QOpcUa::Undefined
+                                 : forward[type] == value ? static_cast<QOpcUa::Types>(type)
+                                                          : lookupType(forward, value, type + 1);
+    }
+
+    constexpr int maximumValue(const int *forward, int type = 0, int maximum = 0)
+    {
+        return type >= TypeCount ? maximum
+                                 : maximumValue(forward, type + 1, forward[type] > maximum ? forward[type] : maximum);
+    }
+
+    template<int N, int... I>
+    constexpr TypeTable<N> makeInverseTable(const int *forward, IndexSequence<I...>)
+    {
+        return TypeTable<N>{{ lookupType(forward, I)... }};
+    }
+
+    // Inverts a table indexed by QOpcUa::Types, entries with NoMapping are left out
+    template<int N>
+    constexpr TypeTable<N> inverseTable(const int *forward)
+    {
+        return makeInverseTable<N>(forward, typename MakeIndexSequence<N>::Type());
+    }
+
+    // Entry<T>::convert is instantiated for every type and stored at index T
+    template<template<QOpcUa::Types> class Entry, typename Function, int... I>
+    constexpr DispatchTable<Function> makeDispatchTable(IndexSequence<I...>)
+    {
+        return DispatchTable<Function>{{ &Entry<static_cast<QOpcUa::Types>(I)>::convert... }};
+    }
+
+    template<template<QOpcUa::Types> class Entry, typename Function>
+    constexpr DispatchTable<Function> dispatchTable()
+    {
+        return makeDispatchTable<Entry, Function>(typename MakeIndexSequence<TypeCount>::Type());
+    }
+
+    // Entry<T>::value() is evaluated for every type and stored at index T
+    template<template<QOpcUa::Types> class Entry, typename Value, int... I>
+    constexpr ValueTable<Value> makeValueTable(IndexSequence<I...>)
+    {
+        return ValueTable<Value>{{ Entry<static_cast<QOpcUa::Types>(I)>::value()... }};
+    }
+
+    template<template<QOpcUa::Types> class Entry, typename Value>
+    constexpr ValueTable<Value> valueTable()
+    {
+        return makeValueTable<Entry, Value>(typename MakeIndexSequence<TypeCount>::Type());
+    }
+
+    constexpr TypeTable<maximumValue(builtinTypeIds) + 1> builtinTypeIdTable = inverseTable<maximumValue(builtinTypeIds) + 1>(builtinTypeIds);
+    constexpr TypeTable<maximumValue(metaTypes) + 1> metaTypeTable = inverseTable<maximumValue(metaTypes) + 1>(metaTypes);
+
+    // Types whose meta type belongs to an earlier type, see metaTypes
+    constexpr bool sharesMetaType(int type)
+    {
+        return type == QOpcUa::XmlElement || type == QOpcUa::NodeId || type == QOpcUa::StatusCode;
+    }
+
+    // True if every mapped type except the shared ones is found again by the inverse lookup
+    constexpr bool roundTrips(const int *forward, bool (*shared)(int), int type = 0)
+    {
+        return type >= TypeCount
+                || ((forward[type] == NoMapping || shared(type) || lookupType(forward, forward[type]) == type)
+                    && roundTrips(forward, shared, type + 1));
+    }
+
+    constexpr bool sharesNothing(int) { return false; }
+
+    static_assert(roundTrips(builtinTypeIds, sharesNothing), "Every type needs a built-in type id of its own");
+    static_assert(roundTrips(metaTypes, sharesMetaType), "Only the types listed in sharesMetaType() may share a meta type");
+    static_assert(lookupType(metaTypes, metaTypes[QOpcUa::XmlElement]) == QOpcUa::String, "XmlElement values are read back as String");
+    static_assert(lookupType(metaTypes, metaTypes[QOpcUa::NodeId]) == QOpcUa::String, "NodeId values are read back as String");
+    static_assert(lookupType(metaTypes, metaTypes[QOpcUa::StatusCode]) == QOpcUa::UInt32, "StatusCode values are read back as UInt32");
+
+    inline QOpcUa::Types fromBuiltinTypeId(int id)
+    {
+        return builtinTypeIdTable.at(id);
+    }
+
+    inline int toBuiltinTypeId(QOpcUa::Types type)
+    {
+        return static_cast<quint32>(type) < static_cast<quint32>(TypeCount) ? builtinTypeIds[type] : 0;
+    }
+
+    // Returns the type used for values of a built-in meta type
+    inline QOpcUa::Types fromMetaType(int metaType)
+    {
+        if (metaType == QMetaType::Char)
+            return QOpcUa::SByte;
+        return metaTypeTable.at(metaType);
+    }
+
+    inline int toMetaType(QOpcUa::Types type)
+    {
+        if (static_cast<quint32>(type) >= static_cast<quint32>(TypeCount) || metaTypes[type] == NoMapping)
+            return QMetaType::UnknownType;
+        return metaTypes[type];
+    }
+}
+
+QT_END_NAMESPACE
+
+#endif // QOPCUATYPEMAPPING_P_H
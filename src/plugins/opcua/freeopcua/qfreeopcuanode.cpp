@@ -70,7 +70,8 @@ bool QFreeOpcUaNode::readAttributes(QOpcUaNode::NodeAttributes attr)
                                      Qt::QueuedConnection,
                                      Q_ARG(uintptr_t, reinterpret_cast<uintptr_t>(this)),
                                      Q_ARG(OpcUa::NodeId, m_node.GetId()),
-                                     Q_ARG(QOpcUaNode::NodeAttributes, attr));
+                                     Q_ARG(QOpcUaNode::NodeAttributes, attr),
+                                     Q_ARG(QString, QString()));
 }
 
 QStringList QFreeOpcUaNode::childrenIds() const
@@ -106,7 +107,8 @@ bool QFreeOpcUaNode::writeAttribute(QOpcUaNode::NodeAttribute attribute, const Q
                                      Q_ARG(OpcUa::Node, m_node),
                                      Q_ARG(QOpcUaNode::NodeAttribute, attribute),
                                      Q_ARG(QVariant, value),
-                                     Q_ARG(QOpcUa::Types, type));
+                                     Q_ARG(QOpcUa::Types, type),
+                                     Q_ARG(QString, QString()));
 }
 
 bool QFreeOpcUaNode::writeAttributes(const QOpcUaNode::AttributeMap &toWrite, QOpcUa::Types valueAttributeType)
@@ -119,6 +121,29 @@ bool QFreeOpcUaNode::writeAttributes(const QOpcUaNode::AttributeMap &toWrite, QO
                                      Q_ARG(QOpcUa::Types, valueAttributeType));
 }
 
+bool QFreeOpcUaNode::readAttributeRange(QOpcUaNode::NodeAttribute attribute, const QString &indexRange)
+{
+    return QMetaObject::invokeMethod(m_client->m_opcuaWorker, "readAttributes",
+                                     Qt::QueuedConnection,
+                                     Q_ARG(uintptr_t, reinterpret_cast<uintptr_t>(this)),
+                                     Q_ARG(OpcUa::NodeId, m_node.GetId()),
+                                     Q_ARG(QOpcUaNode::NodeAttributes, attribute),
+                                     Q_ARG(QString, indexRange));
+}
+
+bool QFreeOpcUaNode::writeAttributeRange(QOpcUaNode::NodeAttribute attribute, const QVariant &value,
+                                         const QString &indexRange, QOpcUa::Types type)
+{
+    return QMetaObject::invokeMethod(m_client->m_opcuaWorker, "writeAttribute",
+                                     Qt::QueuedConnection,
+                                     Q_ARG(uintptr_t, reinterpret_cast<uintptr_t>(this)),
+                                     Q_ARG(OpcUa::Node, m_node),
+                                     Q_ARG(QOpcUaNode::NodeAttribute, attribute),
+                                     Q_ARG(QVariant, value),
+                                     Q_ARG(QOpcUa::Types, type),
+                                     Q_ARG(QString, indexRange));
+}
+
 bool QFreeOpcUaNode::call(const QString &methodNodeId,
                             QVector<QOpcUa::TypedVariant> *args, QVector<QVariant> *ret)
 {
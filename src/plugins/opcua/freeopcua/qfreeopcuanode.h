@@ -66,6 +66,9 @@ public:
 
     bool writeAttribute(QOpcUaNode::NodeAttribute attribute, const QVariant &value, QOpcUa::Types type) override;
     bool writeAttributes(const QOpcUaNode::AttributeMap &toWrite, QOpcUa::Types valueAttributeType) override;
+    bool readAttributeRange(QOpcUaNode::NodeAttribute attribute, const QString &indexRange) override;
+    bool writeAttributeRange(QOpcUaNode::NodeAttribute attribute, const QVariant &value,
+                             const QString &indexRange, QOpcUa::Types type) override;
     bool call(const QString &methodNodeId,
               QVector<QOpcUa::TypedVariant> *args = nullptr, QVector<QVariant> *ret = nullptr) override;
     QPair<QString, QString> readEui() const override;
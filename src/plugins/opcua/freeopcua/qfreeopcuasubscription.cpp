@@ -99,11 +99,15 @@ void QFreeOpcUaSubscription::DataChange(quint32 handle, const OpcUa::Node &node,
     }
 }
 
-QOpcUaMonitoredValue *QFreeOpcUaSubscription::addValue(QOpcUaNode *node)
+QOpcUaMonitoredValue *QFreeOpcUaSubscription::addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters,
+                                                      QOpcUaValueSink *sink)
 {
     if (!m_subscription)
         return nullptr;
 
+    if (parameters.samplingInterval >= 0 || parameters.queueSize != 1 || parameters.filter.isValid())
+        qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA) << "Monitoring parameters are not supported by the freeopcua backend, using defaults";
+
     try {
         // Only add a monitored item if the node has a value attribute
         QFreeOpcUaNode *nnode = static_cast<QFreeOpcUaNode *>(node->d_func()->m_impl.data());
@@ -113,6 +117,8 @@ QOpcUaMonitoredValue *QFreeOpcUaSubscription::addValue(QOpcUaNode *node)
         if (m_subscription) {
             uint32_t handle = m_subscription->SubscribeDataChange(m_client->GetNode(node->nodeId().toStdString()));
             QOpcUaMonitoredValue *monitoredValue = new QOpcUaMonitoredValue(node, m_qsubscription);
+            // The freeopcua values are always converted to a QVariant first
+            monitoredValue->d_func()->m_sink = sink;
             m_dataChangeHandles[handle] = monitoredValue;
             return monitoredValue;
         }
@@ -131,36 +137,66 @@ void QFreeOpcUaSubscription::Event(quint32 handle, const OpcUa::Event &event)
     }
 
     try {
+        QOpcUaMonitoredEvent *me = *it;
+        const QVector<QOpcUaSimpleAttributeOperand> &selectClauses = me->d_func()->m_filter.selectClauses;
+
         QVector<QVariant> val;
-        val.reserve(3);
+        val.reserve(selectClauses.size());
 
-        val.push_back(QVariant(QString::fromStdString(event.Message.Text)));
-        val.push_back(QVariant(QString::fromStdString(event.SourceName)));
-        val.push_back(QVariant(event.Severity));
+        for (const QOpcUaSimpleAttributeOperand &clause : selectClauses) {
+            // freeopcua moves the fields of BaseEventType into members of OpcUa::Event
+            const QString name = clause.browsePath.size() == 1 ? clause.browsePath.first().name : QString();
+            if (name == QLatin1String("Message")) {
+                val.push_back(QVariant(QString::fromStdString(event.Message.Text)));
+            } else if (name == QLatin1String("SourceName")) {
+                val.push_back(QVariant(QString::fromStdString(event.SourceName)));
+            } else if (name == QLatin1String("Severity")) {
+                val.push_back(QVariant(event.Severity));
+            } else {
+                std::vector<OpcUa::QualifiedName> path;
+                path.reserve(clause.browsePath.size());
+                for (const QOpcUa::QQualifiedName &element : clause.browsePath)
+                    path.push_back(OpcUa::QualifiedName(element.name.toStdString(), element.namespaceIndex));
+                val.push_back(QFreeOpcUaValueConverter::toQVariant(event.GetValue(path)));
+            }
+        }
 
-        QOpcUaMonitoredEvent *me = *it;
         me->d_func()->triggerNewEvent(val);
     } catch (const std::exception &ex) {
         qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Caught: %s", ex.what());
     }
 }
 
-QOpcUaMonitoredEvent *QFreeOpcUaSubscription::addEvent(QOpcUaNode *node)
+QOpcUaMonitoredEvent *QFreeOpcUaSubscription::addEvent(QOpcUaNode *node, const QOpcUaEventFilter &filter)
 {
     // Note: Callback is not called due to some error in the event implementation in freeopcua
     if (!m_subscription)
         return nullptr;
 
+    // Ignoring the where clause would deliver events the caller asked to filter out
+    if (!filter.whereClause.isEmpty()) {
+        qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA) << "Where clauses are not supported by the freeopcua backend";
+        return nullptr;
+    }
+
     try {
         QFreeOpcUaNode *nnode = static_cast<QFreeOpcUaNode *>(node->d_func()->m_impl.data());
         if (nnode->m_node.GetAttribute(OpcUa::AttributeId::EventNotifier).Status != OpcUa::StatusCode::Good)
             return nullptr;
 
-        OpcUa::Node serverNode = m_client->GetNode(OpcUa::ObjectId::Server);
-        OpcUa::Node typeNode = m_client->GetNode(node->nodeId().toStdString());
+        OpcUa::EventFilter eventFilter;
+        for (const QOpcUaSimpleAttributeOperand &clause : filter.selectClauses) {
+            OpcUa::SimpleAttributeOperand operand;
+            operand.TypeId = OpcUa::ToNodeId(clause.typeId.toStdString());
+            operand.Attribute = QFreeOpcUaValueConverter::toUaAttributeId(clause.attributeId);
+            for (const QOpcUa::QQualifiedName &element : clause.browsePath)
+                operand.BrowsePath.push_back(OpcUa::QualifiedName(element.name.toStdString(), element.namespaceIndex));
+            eventFilter.SelectClauses.push_back(operand);
+        }
 
-        uint32_t handle = m_subscription->SubscribeEvents(serverNode, typeNode);
+        uint32_t handle = m_subscription->SubscribeEvents(nnode->m_node, eventFilter);
         QOpcUaMonitoredEvent *monitoredEvent = new QOpcUaMonitoredEvent(node, m_qsubscription);
+        monitoredEvent->d_func()->m_filter = filter;
         m_eventHandles[handle] = monitoredEvent;
         return monitoredEvent;
     } catch (const std::exception &ex) {
@@ -203,4 +239,47 @@ void QFreeOpcUaSubscription::removeValue(QOpcUaMonitoredValue *value)
     }
 }
 
+bool QFreeOpcUaSubscription::setMonitoringMode(const QVector<QOpcUaMonitoredValue *> &values, QOpcUa::MonitoringMode mode,
+                                               QVector<QOpcUa::UaStatusCode> *results)
+{
+    Q_UNUSED(mode);
+    qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA) << "SetMonitoringMode is not supported by the freeopcua backend";
+    if (results)
+        results->fill(QOpcUa::UaStatusCode::BadServiceUnsupported, values.size());
+    return false;
+}
+
+bool QFreeOpcUaSubscription::setTriggering(QOpcUaMonitoredValue *trigger, const QVector<QOpcUaMonitoredValue *> &linksToAdd,
+                                           const QVector<QOpcUaMonitoredValue *> &linksToRemove,
+                                           QVector<QOpcUa::UaStatusCode> *addResults,
+                                           QVector<QOpcUa::UaStatusCode> *removeResults)
+{
+    Q_UNUSED(trigger);
+    qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA) << "SetTriggering is not supported by the freeopcua backend";
+    if (addResults)
+        addResults->fill(QOpcUa::UaStatusCode::BadServiceUnsupported, linksToAdd.size());
+    if (removeResults)
+        removeResults->fill(QOpcUa::UaStatusCode::BadServiceUnsupported, linksToRemove.size());
+    return false;
+}
+
+bool QFreeOpcUaSubscription::modify(const QOpcUaSubscriptionParameters &parameters, QOpcUaSubscriptionParameters *revised)
+{
+    Q_UNUSED(parameters);
+    Q_UNUSED(revised);
+    qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA) << "ModifySubscription is not supported by the freeopcua backend";
+    return false;
+}
+
+bool QFreeOpcUaSubscription::modifyMonitoredValues(const QVector<QOpcUaMonitoredValue *> &values,
+                                                   const QOpcUaMonitoringParameters &parameters,
+                                                   QVector<QOpcUa::UaStatusCode> *results)
+{
+    Q_UNUSED(parameters);
+    qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA) << "ModifyMonitoredItems is not supported by the freeopcua backend";
+    if (results)
+        results->fill(QOpcUa::UaStatusCode::BadServiceUnsupported, values.size());
+    return false;
+}
+
 QT_END_NAMESPACE
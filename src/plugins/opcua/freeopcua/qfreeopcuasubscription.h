@@ -65,11 +65,22 @@ public:
                     OpcUa::AttributeId attr) override;
     void Event(quint32 handle, const OpcUa::Event &event) override;
 
-    QOpcUaMonitoredEvent *addEvent(QOpcUaNode *node) override;
+    QOpcUaMonitoredEvent *addEvent(QOpcUaNode *node, const QOpcUaEventFilter &filter) override;
     void removeEvent(QOpcUaMonitoredEvent *event) override;
-    QOpcUaMonitoredValue *addValue(QOpcUaNode *node) override;
+    QOpcUaMonitoredValue *addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters,
+                                   QOpcUaValueSink *sink) override;
     void removeValue(QOpcUaMonitoredValue *value) override;
 
+    bool setMonitoringMode(const QVector<QOpcUaMonitoredValue *> &values, QOpcUa::MonitoringMode mode,
+                           QVector<QOpcUa::UaStatusCode> *results) override;
+    bool setTriggering(QOpcUaMonitoredValue *trigger, const QVector<QOpcUaMonitoredValue *> &linksToAdd,
+                       const QVector<QOpcUaMonitoredValue *> &linksToRemove,
+                       QVector<QOpcUa::UaStatusCode> *addResults,
+                       QVector<QOpcUa::UaStatusCode> *removeResults) override;
+    bool modify(const QOpcUaSubscriptionParameters &parameters, QOpcUaSubscriptionParameters *revised) override;
+    bool modifyMonitoredValues(const QVector<QOpcUaMonitoredValue *> &values, const QOpcUaMonitoringParameters &parameters,
+                               QVector<QOpcUa::UaStatusCode> *results) override;
+
     OpcUa::UaClient *m_client;
     QOpcUaSubscription *m_qsubscription;
     OpcUa::Subscription::SharedPtr m_subscription;
@@ -35,12 +35,16 @@
 ****************************************************************************/
 
 #include "qfreeopcuavalueconverter.h"
+#include <QtOpcUa/qopcuamultidimensionalarray.h>
+#include <private/qopcuaarraykernels_p.h>
+#include <private/qopcuatypemapping_p.h>
 
 #include <QtCore/qdatetime.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qmetaobject.h>
 #include <QtCore/qregularexpression.h>
 #include <QtCore/quuid.h>
+#include <QtCore/qvarlengtharray.h>
 
 #include <vector>
 
@@ -52,150 +56,170 @@ Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_FREEOPCUA)
 
 namespace QFreeOpcUaValueConverter {
 
-QVariant toQVariant(const OpcUa::Variant &variant)
+// The timestamps of an array are converted in one pass, only the QDateTime construction remains per element
+static QVariant dateTimeArrayToQVariant(const OpcUa::Variant &variant)
 {
-    // Null variant, return empty QVariant
-    if (!variant.IsScalar() && !variant.IsArray()) {
-        return QVariant();
-    }
-
-    switch (variant.Type()) {
-    case OpcUa::VariantType::NUL:
-        return QVariant::fromValue(static_cast<QObject *>(0));
-
-    case OpcUa::VariantType::BOOLEAN:
-        return arrayToQVariant<bool, bool>(variant);
-
-    case OpcUa::VariantType::SBYTE:
-        return arrayToQVariant<qint8, qint8>(variant, QMetaType::SChar);
-
-    case OpcUa::VariantType::BYTE:
-        return arrayToQVariant<quint8, quint8>(variant, QMetaType::UChar);
-
-    case OpcUa::VariantType::INT16:
-        return arrayToQVariant<qint16, qint16>(variant, QMetaType::Short);
-
-    case OpcUa::VariantType::UINT16:
-        return arrayToQVariant<quint16, quint16>(variant, QMetaType::UShort);
-
-    case OpcUa::VariantType::INT32:
-        return arrayToQVariant<qint32, qint32>(variant, QMetaType::Int);
-
-    case OpcUa::VariantType::UINT32:
-        return arrayToQVariant<quint32, quint32>(variant, QMetaType::UInt);
+    if (!variant.IsArray())
+        return arrayToQVariant<QDateTime, OpcUa::DateTime>(variant, QMetaType::QDateTime);
 
-    case OpcUa::VariantType::INT64:
-        return arrayToQVariant<int64_t, int64_t>(variant, QMetaType::LongLong);
+    const std::vector<OpcUa::DateTime> dateTimes = variant.As<std::vector<OpcUa::DateTime>>();
+    const int size = static_cast<int>(dateTimes.size());
+    QVarLengthArray<qint64, 64> ticks(size);
+    for (int i = 0; i < size; ++i)
+        ticks[i] = dateTimes[i].Value;
+    QVarLengthArray<qint64, 64> msecs(size);
+    QOpcUaArrayKernels::ticksToMSecs(ticks.constData(), msecs.data(), size, QOpcUaArrayKernels::UnixEpochTicks);
+
+    QVariantList list;
+    list.reserve(size);
+    for (qint64 msec : qAsConst(msecs))
+        list.append(QDateTime::fromMSecsSinceEpoch(msec));
+    return list;
+}
 
-    case OpcUa::VariantType::UINT64:
-        return arrayToQVariant<uint64_t, uint64_t>(variant, QMetaType::ULongLong);
+// The Qt and freeopcua representation of every type, the converters are generated from these.
+// freeopcua uses the built-in type ids as variant types.
+template<QOpcUa::Types> struct TypeTraits;
+
+#define Q_FREEOPCUA_TYPE_TRAITS(TYPE, QTTYPE, UATYPE, VARIANTTYPE) \
+    template<> struct TypeTraits<QOpcUa::TYPE> \
+    { \
+        Q_STATIC_ASSERT(static_cast<int>(OpcUa::VariantType::VARIANTTYPE) == QOpcUaTypeMapping::builtinTypeIds[QOpcUa::TYPE]); \
+        typedef QTTYPE QtType; \
+        typedef UATYPE UaType; \
+    };
+
+Q_FREEOPCUA_TYPE_TRAITS(Boolean, bool, bool, BOOLEAN)
+Q_FREEOPCUA_TYPE_TRAITS(Int32, qint32, int32_t, INT32)
+Q_FREEOPCUA_TYPE_TRAITS(UInt32, quint32, uint32_t, UINT32)
+Q_FREEOPCUA_TYPE_TRAITS(Double, double, double, DOUBLE)
+Q_FREEOPCUA_TYPE_TRAITS(Float, float, float, FLOAT)
+Q_FREEOPCUA_TYPE_TRAITS(String, QString, std::string, STRING)
+Q_FREEOPCUA_TYPE_TRAITS(LocalizedText, QOpcUa::QLocalizedText, OpcUa::LocalizedText, LOCALIZED_TEXT)
+Q_FREEOPCUA_TYPE_TRAITS(DateTime, QDateTime, OpcUa::DateTime, DATE_TIME)
+Q_FREEOPCUA_TYPE_TRAITS(UInt16, quint16, uint16_t, UINT16)
+Q_FREEOPCUA_TYPE_TRAITS(Int16, qint16, int16_t, INT16)
+Q_FREEOPCUA_TYPE_TRAITS(UInt64, quint64, uint64_t, UINT64)
+Q_FREEOPCUA_TYPE_TRAITS(Int64, qint64, int64_t, INT64)
+Q_FREEOPCUA_TYPE_TRAITS(Byte, quint8, uint8_t, BYTE)
+Q_FREEOPCUA_TYPE_TRAITS(SByte, qint8, int8_t, SBYTE)
+Q_FREEOPCUA_TYPE_TRAITS(ByteString, QByteArray, OpcUa::ByteString, BYTE_STRING)
+Q_FREEOPCUA_TYPE_TRAITS(NodeId, QString, OpcUa::NodeId, NODE_Id)
+Q_FREEOPCUA_TYPE_TRAITS(Guid, QUuid, OpcUa::Guid, GUId)
+Q_FREEOPCUA_TYPE_TRAITS(QualifiedName, QOpcUa::QQualifiedName, OpcUa::QualifiedName, QUALIFIED_NAME)
+Q_FREEOPCUA_TYPE_TRAITS(StatusCode, QOpcUa::UaStatusCode, OpcUa::StatusCode, STATUS_CODE)
+
+#undef Q_FREEOPCUA_TYPE_TRAITS
+
+typedef QVariant (*ToQVariantFunction)(const OpcUa::Variant &);
+typedef OpcUa::Variant (*FromQVariantFunction)(const QVariant &);
+
+template<QOpcUa::Types T>
+struct ToQVariantEntry
+{
+    static QVariant convert(const OpcUa::Variant &variant)
+    {
+        return arrayToQVariant<typename TypeTraits<T>::QtType, typename TypeTraits<T>::UaType>(
+                    variant, static_cast<QMetaType::Type>(QOpcUaTypeMapping::toMetaType(T)));
+    }
+};
 
-    case OpcUa::VariantType::FLOAT:
-        return arrayToQVariant<float, float>(variant, QMetaType::Float);
+template<>
+struct ToQVariantEntry<QOpcUa::DateTime>
+{
+    static QVariant convert(const OpcUa::Variant &variant)
+    {
+        return dateTimeArrayToQVariant(variant);
+    }
+};
 
-    case OpcUa::VariantType::DOUBLE:
-        return arrayToQVariant<double, double>(variant, QMetaType::Double);
+template<>
+struct ToQVariantEntry<QOpcUa::XmlElement>
+{
+    static QVariant convert(const OpcUa::Variant &)
+    {
+        qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Type XMLElement is not yet supported in FreeOPCUA");
+        return QVariant();
+    }
+};
 
-    case OpcUa::VariantType::STRING:
-        return arrayToQVariant<QString, std::string>(variant, QMetaType::QString);
+template<QOpcUa::Types T>
+struct FromQVariantEntry
+{
+    static OpcUa::Variant convert(const QVariant &variant)
+    {
+        return arrayFromQVariant<typename TypeTraits<T>::UaType, typename TypeTraits<T>::QtType>(variant);
+    }
+};
 
-    case OpcUa::VariantType::DATE_TIME:
-        return arrayToQVariant<QDateTime, OpcUa::DateTime>(variant, QMetaType::QDateTime);
+template<>
+struct FromQVariantEntry<QOpcUa::XmlElement>
+{
+    static OpcUa::Variant convert(const QVariant &)
+    {
+        qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Type XMLElement is not yet supported in FreeOPCUA");
+        return OpcUa::Variant();
+    }
+};
 
-    case OpcUa::VariantType::BYTE_STRING:
-        return arrayToQVariant<QByteArray, OpcUa::ByteString>(variant, QMetaType::QByteArray);
+static constexpr auto toQVariantTable =
+        QOpcUaTypeMapping::dispatchTable<ToQVariantEntry, ToQVariantFunction>();
+static constexpr auto fromQVariantTable =
+        QOpcUaTypeMapping::dispatchTable<FromQVariantEntry, FromQVariantFunction>();
 
-    case OpcUa::VariantType::LOCALIZED_TEXT:
-        return arrayToQVariant<QOpcUa::QLocalizedText, OpcUa::LocalizedText>(variant);
+static QVariant elementsToQVariant(const OpcUa::Variant &variant);
 
-    case OpcUa::VariantType::NODE_Id:
-        return arrayToQVariant<QString, OpcUa::NodeId>(variant, QMetaType::QString);
+QVariant toQVariant(const OpcUa::Variant &variant)
+{
+    const QVariant elements = elementsToQVariant(variant);
+    if (!variant.IsArray() || variant.Dimensions.size() < 2 || elements.type() != QVariant::List)
+        return elements;
+
+    QVector<quint32> dimensions;
+    dimensions.reserve(static_cast<int>(variant.Dimensions.size()));
+    for (uint32_t dimension : variant.Dimensions)
+        dimensions.append(dimension);
+    return QVariant::fromValue(QOpcUaMultiDimensionalArray(elements, dimensions));
+}
 
-    case OpcUa::VariantType::XML_ELEMENT:
-        qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Type XMLElement is not yet supported in FreeOPCUA");
+static QVariant elementsToQVariant(const OpcUa::Variant &variant)
+{
+    // Null variant, return empty QVariant
+    if (!variant.IsScalar() && !variant.IsArray()) {
         return QVariant();
+    }
 
-    case OpcUa::VariantType::GUId:
-        return arrayToQVariant<QUuid, OpcUa::Guid>(variant, QMetaType::QUuid);
-
-    case OpcUa::VariantType::QUALIFIED_NAME:
-        return arrayToQVariant<QOpcUa::QQualifiedName, OpcUa::QualifiedName>(variant);
-
-    case OpcUa::VariantType::STATUS_CODE:
-        return arrayToQVariant<QOpcUa::UaStatusCode, OpcUa::StatusCode>(variant);
+    if (variant.Type() == OpcUa::VariantType::NUL)
+        return QVariant::fromValue(static_cast<QObject *>(0));
 
-    default:
+    const QOpcUa::Types type = QOpcUaTypeMapping::fromBuiltinTypeId(static_cast<int>(variant.Type()));
+    if (type == QOpcUa::Undefined) {
         qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Variant type is not yet supported: %d", static_cast<int>(variant.Type()));
         return QVariant();
     }
+
+    return toQVariantTable.at(type)(variant);
 }
 
 OpcUa::Variant toTypedVariant(const QVariant &variant, QOpcUa::Types type)
 {
-    switch (type) {
-    case QOpcUa::Boolean:
-        return arrayFromQVariant<bool>(variant);
-
-    case QOpcUa::Byte:
-        return arrayFromQVariant<uint8_t>(variant);
-
-    case QOpcUa::DateTime:
-        return arrayFromQVariant<OpcUa::DateTime>(variant);
-    case QOpcUa::Double:
-        return arrayFromQVariant<double>(variant);
-
-    case QOpcUa::Float:
-        return arrayFromQVariant<float>(variant);
-
-    case QOpcUa::Int16:
-        return arrayFromQVariant<int16_t>(variant);
-
-    case QOpcUa::Int32:
-        return arrayFromQVariant<int32_t>(variant);
-
-    case QOpcUa::Int64:
-        return arrayFromQVariant<int64_t>(variant);
-
-    case QOpcUa::SByte:
-        return arrayFromQVariant<int8_t>(variant);
-
-    case QOpcUa::String:
-        return arrayFromQVariant<std::string>(variant);
-
-    case QOpcUa::UInt16:
-        return arrayFromQVariant<uint16_t>(variant);
-
-    case QOpcUa::UInt32:
-        return arrayFromQVariant<uint32_t>(variant);
-
-    case QOpcUa::UInt64:
-        return arrayFromQVariant<uint64_t>(variant);
-
-    case QOpcUa::LocalizedText:
-        return arrayFromQVariant<OpcUa::LocalizedText>(variant);
-
-    case QOpcUa::ByteString:
-        return arrayFromQVariant<OpcUa::ByteString>(variant);
-
-    case QOpcUa::NodeId:
-        return arrayFromQVariant<OpcUa::NodeId>(variant);
-
-    case QOpcUa::XmlElement:
-        qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Type XMLElement is not yet supported in FreeOPCUA");
-        return OpcUa::Variant();
-
-    case QOpcUa::Guid:
-        return arrayFromQVariant<OpcUa::Guid>(variant);
-
-    case QOpcUa::QualifiedName:
-        return arrayFromQVariant<OpcUa::QualifiedName>(variant);
-
-    case QOpcUa::StatusCode:
-        return arrayFromQVariant<OpcUa::StatusCode, QOpcUa::UaStatusCode>(variant);
+    if (variant.userType() == qMetaTypeId<QOpcUaMultiDimensionalArray>()) {
+        const QOpcUaMultiDimensionalArray array = variant.value<QOpcUaMultiDimensionalArray>().compacted();
+        if (!array.isValid()) {
+            qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Invalid multi-dimensional array");
+            return OpcUa::Variant();
+        }
+        OpcUa::Variant result = toTypedVariant(array.data().value<QVariantList>(), type);
+        const QVector<quint32> dimensions = array.dimensions();
+        result.Dimensions.assign(dimensions.cbegin(), dimensions.cend());
+        return result;
+    }
 
-    default:
+    const FromQVariantFunction convert = fromQVariantTable.at(type);
+    if (!convert)
         return toVariant(variant);
-    }
+
+    return convert(variant);
 }
 
 QString nodeIdToString(const OpcUa::NodeId &id)
@@ -223,21 +247,17 @@ QString nodeIdToString(const OpcUa::NodeId &id)
 
 OpcUa::Variant toVariant(const QVariant &variant)
 {
-    switch (variant.type()) {
-    case QMetaType::Bool:
-        return arrayFromQVariant<bool>(variant);
-    case QMetaType::Int:
-        return arrayFromQVariant<qint32>(variant);
-    case QMetaType::UInt:
-        return arrayFromQVariant<quint32>(variant);
-    case QMetaType::Double:
-        return arrayFromQVariant<double>(variant);
-    case QMetaType::QString:
-        return arrayFromQVariant<std::string>(variant);
-    default:
-        qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Variant type is not yet supported: %d", variant.type());
+    // Lists are converted to arrays of the type of their first element
+    const QVariantList list = variant.type() == QVariant::List ? variant.toList() : QVariantList();
+    const QVariant first = list.isEmpty() ? variant : list.first();
+
+    const QOpcUa::Types type = QOpcUaTypeMapping::fromMetaType(first.type());
+    if (type == QOpcUa::Undefined) {
+        qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Variant type is not yet supported: %d", first.type());
         return OpcUa::Variant();
     }
+
+    return toTypedVariant(variant, type);
 }
 
 template<typename UATYPE, typename QTTYPE>
@@ -260,19 +280,19 @@ UATYPE scalarFromQVariant(const QVariant &var)
 }
 
 template<>
-std::string scalarFromQVariant(const QVariant &var)
+std::string scalarFromQVariant<std::string, QString>(const QVariant &var)
 {
     return var.toString().toStdString();
 }
 
 template<>
-OpcUa::DateTime scalarFromQVariant(const QVariant &var)
+OpcUa::DateTime scalarFromQVariant<OpcUa::DateTime, QDateTime>(const QVariant &var)
 {
     return OpcUa::DateTime::FromTimeT(var.value<QDateTime>().toTime_t());
 }
 
 template<>
-OpcUa::ByteString scalarFromQVariant(const QVariant &var)
+OpcUa::ByteString scalarFromQVariant<OpcUa::ByteString, QByteArray>(const QVariant &var)
 {
     const QByteArray arr = var.toByteArray();
     const char *start = arr.data();
@@ -282,14 +302,14 @@ OpcUa::ByteString scalarFromQVariant(const QVariant &var)
 }
 
 template<>
-OpcUa::LocalizedText scalarFromQVariant(const QVariant &var)
+OpcUa::LocalizedText scalarFromQVariant<OpcUa::LocalizedText, QOpcUa::QLocalizedText>(const QVariant &var)
 {
     const QOpcUa::QLocalizedText lt = var.value<QOpcUa::QLocalizedText>();
     return OpcUa::LocalizedText(lt.text.toStdString(), lt.locale.toStdString());
 }
 
 template<>
-OpcUa::NodeId scalarFromQVariant(const QVariant &var)
+OpcUa::NodeId scalarFromQVariant<OpcUa::NodeId, QString>(const QVariant &var)
 {
     try {
         return OpcUa::ToNodeId(var.toString().toStdString());
@@ -300,7 +320,7 @@ OpcUa::NodeId scalarFromQVariant(const QVariant &var)
 }
 
 template<>
-OpcUa::Guid scalarFromQVariant(const QVariant &var)
+OpcUa::Guid scalarFromQVariant<OpcUa::Guid, QUuid>(const QVariant &var)
 {
     OpcUa::Guid temp;
     const QUuid uuid = var.toUuid();
@@ -312,7 +332,7 @@ OpcUa::Guid scalarFromQVariant(const QVariant &var)
 }
 
 template<>
-OpcUa::QualifiedName scalarFromQVariant(const QVariant &var)
+OpcUa::QualifiedName scalarFromQVariant<OpcUa::QualifiedName, QOpcUa::QQualifiedName>(const QVariant &var)
 {
     OpcUa::QualifiedName temp;
     const QOpcUa::QQualifiedName qn = var.value<QOpcUa::QQualifiedName>();
@@ -361,7 +381,10 @@ QString scalarUaToQt<QString, std::string>(const std::string &data)
 template<>
 QDateTime scalarUaToQt<QDateTime, OpcUa::DateTime>(const OpcUa::DateTime &data)
 {
-    return QDateTime::fromTime_t(OpcUa::DateTime::ToTimeT(data));
+    const qint64 ticks = data.Value;
+    qint64 msecs = 0;
+    QOpcUaArrayKernels::ticksToMSecs(&ticks, &msecs, 1, QOpcUaArrayKernels::UnixEpochTicks);
+    return QDateTime::fromMSecsSinceEpoch(msecs);
 }
 
 template<>
@@ -102,7 +102,24 @@ void QFreeOpcUaWorker::asyncDisconnectFromEndpoint()
     emit m_client->stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::UnknownError);
 }
 
-void QFreeOpcUaWorker::readAttributes(uintptr_t handle, OpcUa::NodeId id, QOpcUaNode::NodeAttributes attr)
+// Takes the value out of a read response, it is converted when the attribute is accessed
+class QFreeOpcUaLazyValue : public QOpcUaLazyValue
+{
+public:
+    explicit QFreeOpcUaLazyValue(OpcUa::Variant &&value)
+        : m_value(std::move(value))
+    {}
+
+    QVariant toVariant() const override
+    {
+        return QFreeOpcUaValueConverter::toQVariant(m_value);
+    }
+
+private:
+    OpcUa::Variant m_value;
+};
+
+void QFreeOpcUaWorker::readAttributes(uintptr_t handle, OpcUa::NodeId id, QOpcUaNode::NodeAttributes attr, QString indexRange)
 {
     QVector<QOpcUaReadResult> vec;
 
@@ -110,6 +127,7 @@ void QFreeOpcUaWorker::readAttributes(uintptr_t handle, OpcUa::NodeId id, QOpcUa
         OpcUa::ReadParameters params;
         OpcUa::ReadValueId attribute;
         attribute.NodeId = id;
+        attribute.IndexRange = indexRange.toStdString();
 
         qt_forEachAttribute(attr, [&](QOpcUaNode::NodeAttribute attr) {
             attribute.AttributeId = QFreeOpcUaValueConverter::toUaAttributeId(attr);
@@ -123,9 +141,8 @@ void QFreeOpcUaWorker::readAttributes(uintptr_t handle, OpcUa::NodeId id, QOpcUa
 
         for (size_t i = 0; i < res.size(); ++i) {
             vec[i].statusCode = static_cast<QOpcUa::UaStatusCode>(res[i].Status);
-            if (res[i].Status == OpcUa::StatusCode::Good) {
-                vec[i].value = QFreeOpcUaValueConverter::toQVariant(res[i].Value);
-            }
+            if (res[i].Status == OpcUa::StatusCode::Good)
+                vec[i].lazyValue.reset(new QFreeOpcUaLazyValue(std::move(res[i].Value)));
         }
 
         emit attributesRead(handle, vec, QOpcUa::UaStatusCode::Good);
@@ -135,7 +152,8 @@ void QFreeOpcUaWorker::readAttributes(uintptr_t handle, OpcUa::NodeId id, QOpcUa
     }
 }
 
-void QFreeOpcUaWorker::writeAttribute(uintptr_t handle, OpcUa::Node node, QOpcUaNode::NodeAttribute attr, QVariant value, QOpcUa::Types type)
+void QFreeOpcUaWorker::writeAttribute(uintptr_t handle, OpcUa::Node node, QOpcUaNode::NodeAttribute attr, QVariant value, QOpcUa::Types type,
+                                      QString indexRange)
 {
     std::vector<OpcUa::StatusCode> res;
 
@@ -147,12 +165,17 @@ void QFreeOpcUaWorker::writeAttribute(uintptr_t handle, OpcUa::Node node, QOpcUa
         OpcUa::WriteValue val;
         val.NodeId = node.GetId();
         val.AttributeId = QFreeOpcUaValueConverter::toUaAttributeId(attr);
+        val.NumericRange = indexRange.toStdString();
         val.Value = OpcUa::DataValue(toWrite);
         std::vector<OpcUa::WriteValue> req;
         req.push_back(val);
 
         res = node.GetServices()->Attributes()->Write(req);
 
+        // Only a part of the attribute has been written, the cached value is outdated
+        if (!indexRange.isEmpty())
+            value = QVariant();
+
         emit attributeWritten(handle, attr, res[0] == OpcUa::StatusCode::Good ? value : QVariant(), static_cast<QOpcUa::UaStatusCode>(res[0]));
     } catch (const std::exception &ex) {
         qCWarning(QT_OPCUA_PLUGINS_FREEOPCUA, "Could not write value to node: %s: %s", OpcUa::ToString(node.GetId()).c_str(), ex.what());
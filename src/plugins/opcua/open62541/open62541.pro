@@ -9,21 +9,27 @@ QMAKE_USE_PRIVATE += open62541
 win32: LIBS += open62541.lib ws2_32.lib
 
 HEADERS += \
+    qopen62541arena.h \
     qopen62541backend.h \
     qopen62541client.h \
+    qopen62541lazyvalue.h \
     qopen62541node.h \
     qopen62541plugin.h \
     qopen62541subscription.h \
+    qopen62541typedictionary.h \
     qopen62541valueconverter.h \
     qopen62541.h \
     qopen62541utils.h
 
 SOURCES += \
+    qopen62541arena.cpp \
     qopen62541backend.cpp \
     qopen62541client.cpp \
+    qopen62541lazyvalue.cpp \
     qopen62541node.cpp \
     qopen62541plugin.cpp \
     qopen62541subscription.cpp \
+    qopen62541typedictionary.cpp \
     qopen62541valueconverter.cpp \
     qopen62541utils.cpp
 
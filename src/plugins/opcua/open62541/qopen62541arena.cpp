@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopen62541arena.h"
+
+#include <cstdlib>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+static const size_t arenaAlignment = alignof(std::max_align_t);
+
+QOpen62541Arena::QOpen62541Arena()
+    : m_current(m_inline)
+    , m_remaining(InlineSize)
+    , m_nextChunkSize(MinimumChunkSize)
+{
+}
+
+QOpen62541Arena::~QOpen62541Arena()
+{
+    for (void *chunk : m_chunks)
+        std::free(chunk);
+}
+
+// Returns zero initialized memory which stays valid until the arena is destroyed
+void *QOpen62541Arena::allocate(size_t size)
+{
+    size = (size + arenaAlignment - 1) & ~(arenaAlignment - 1);
+
+    if (size > m_remaining) {
+        // Large blocks get a chunk of their own so the current chunk can still be used up
+        if (size > m_nextChunkSize / 2) {
+            void *block = std::calloc(1, size);
+            if (!block)
+                return nullptr;
+            m_chunks.push_back(block);
+            return block;
+        }
+
+        void *chunk = std::malloc(m_nextChunkSize);
+        if (!chunk)
+            return nullptr;
+        m_chunks.push_back(chunk);
+        m_current = static_cast<char *>(chunk);
+        m_remaining = m_nextChunkSize;
+        m_nextChunkSize *= 2;
+    }
+
+    void *result = m_current;
+    m_current += size;
+    m_remaining -= size;
+    std::memset(result, 0, size);
+    return result;
+}
+
+// Counterpart of UA_Array_new(), empty arrays are represented by the sentinel like in open62541
+void *QOpen62541Arena::allocateArray(size_t count, const UA_DataType *type)
+{
+    if (count == 0)
+        return UA_EMPTY_ARRAY_SENTINEL;
+    return allocate(count * type->memSize);
+}
+
+UA_String QOpen62541Arena::string(const QString &value)
+{
+    const QByteArray utf8 = value.toUtf8();
+    return byteString(utf8.constData(), utf8.size());
+}
+
+UA_ByteString QOpen62541Arena::byteString(const QByteArray &value)
+{
+    return byteString(value.constData(), value.size());
+}
+
+UA_ByteString QOpen62541Arena::byteString(const char *data, size_t length)
+{
+    UA_ByteString result;
+    UA_ByteString_init(&result);
+    if (length == 0) {
+        result.data = static_cast<UA_Byte *>(UA_EMPTY_ARRAY_SENTINEL);
+        return result;
+    }
+    result.data = static_cast<UA_Byte *>(allocate(length));
+    if (result.data) {
+        std::memcpy(result.data, data, length);
+        result.length = length;
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,79 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPEN62541ARENA_H
+#define QOPEN62541ARENA_H
+
+#include "qopen62541.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+
+#include <cstddef>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+// Bump allocator for the temporary open62541 structures of one service call.
+// Everything allocated from the arena is released at once when it is destroyed,
+// structures pointing into the arena must never be cleaned up with deleteMembers.
+class QOpen62541Arena
+{
+public:
+    QOpen62541Arena();
+    ~QOpen62541Arena();
+
+    void *allocate(size_t size);
+    void *allocateArray(size_t count, const UA_DataType *type);
+    UA_String string(const QString &value);
+    UA_ByteString byteString(const QByteArray &value);
+    UA_ByteString byteString(const char *data, size_t length);
+
+private:
+    Q_DISABLE_COPY(QOpen62541Arena)
+
+    enum { InlineSize = 1024, MinimumChunkSize = 4096 };
+
+    alignas(std::max_align_t) char m_inline[InlineSize];
+    char *m_current;
+    size_t m_remaining;
+    size_t m_nextChunkSize;
+    std::vector<void *> m_chunks;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPEN62541ARENA_H
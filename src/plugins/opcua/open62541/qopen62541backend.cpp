@@ -34,15 +34,31 @@
 **
 ****************************************************************************/
 
+#include "qopen62541arena.h"
 #include "qopen62541backend.h"
+#include "qopen62541lazyvalue.h"
 #include "qopen62541node.h"
+#include "qopen62541subscription.h"
+#include "qopen62541typedictionary.h"
+#include "qopen62541utils.h"
 #include "qopen62541valueconverter.h"
 #include <private/qopcuaclient_p.h>
+#include <private/qopcuamonitoredevent_p.h>
+#include <private/qopcuamonitoredvalue_p.h>
 
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdeadlinetimer.h>
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qrunnable.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qurl.h>
 #include <QtCore/quuid.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <cmath>
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -58,23 +74,264 @@ struct UaLocalizedTextMemberDeleter
     static void cleanup(UA_LocalizedText *p) { UA_LocalizedText_deleteMembers(p); }
 };
 
+// Copies per operation results of a batched service call. If the service call itself
+// failed, every operation is reported with the service result.
+static QOpcUa::UaStatusCode copyOperationResults(const UA_ResponseHeader &header, const UA_StatusCode *results,
+                                                 size_t resultsSize, int expectedSize,
+                                                 QVector<QOpcUa::UaStatusCode> *target)
+{
+    const QOpcUa::UaStatusCode serviceResult = static_cast<QOpcUa::UaStatusCode>(header.serviceResult);
+    if (!target)
+        return serviceResult;
+
+    target->clear();
+    target->reserve(expectedSize);
+    for (int i = 0; i < expectedSize; ++i) {
+        if (serviceResult == QOpcUa::UaStatusCode::Good && size_t(i) < resultsSize)
+            target->push_back(static_cast<QOpcUa::UaStatusCode>(results[i]));
+        else
+            target->push_back(serviceResult == QOpcUa::UaStatusCode::Good ? QOpcUa::UaStatusCode::BadUnexpectedError : serviceResult);
+    }
+    return serviceResult;
+}
+
+static void toUaMonitoringParameters(const QOpcUaMonitoringParameters &parameters, UA_UInt32 clientHandle,
+                                     UA_MonitoringParameters *target)
+{
+    UA_MonitoringParameters_init(target);
+    target->clientHandle = clientHandle;
+    target->samplingInterval = parameters.samplingInterval;
+    target->queueSize = parameters.queueSize;
+    target->discardOldest = parameters.discardOldest;
+
+    if (parameters.filter.userType() == qMetaTypeId<QOpcUaMonitoringParameters::DataChangeFilter>()) {
+        const auto filter = parameters.filter.value<QOpcUaMonitoringParameters::DataChangeFilter>();
+        UA_DataChangeFilter *uaFilter = UA_DataChangeFilter_new();
+        uaFilter->trigger = static_cast<UA_DataChangeTrigger>(filter.trigger);
+        uaFilter->deadbandType = static_cast<UA_UInt32>(filter.deadbandType);
+        uaFilter->deadbandValue = filter.deadbandValue;
+        // Owned by the request, freed with its members
+        target->filter.encoding = UA_EXTENSIONOBJECT_DECODED;
+        target->filter.content.decoded.type = &UA_TYPES[UA_TYPES_DATACHANGEFILTER];
+        target->filter.content.decoded.data = uaFilter;
+    } else if (parameters.filter.userType() == qMetaTypeId<QOpcUaMonitoringParameters::AggregateFilter>()) {
+        const auto filter = parameters.filter.value<QOpcUaMonitoringParameters::AggregateFilter>();
+        UA_AggregateFilter *uaFilter = UA_AggregateFilter_new();
+        uaFilter->startTime = QOpen62541ValueConverter::toUaDateTime(filter.startTime);
+        uaFilter->aggregateType = Open62541Utils::nodeIdFromQString(filter.aggregateType);
+        uaFilter->processingInterval = filter.processingInterval;
+        UA_AggregateConfiguration &configuration = uaFilter->aggregateConfiguration;
+        configuration.useServerCapabilitiesDefaults = filter.configuration.useServerCapabilitiesDefaults;
+        configuration.treatUncertainAsBad = filter.configuration.treatUncertainAsBad;
+        configuration.percentDataBad = filter.configuration.percentDataBad;
+        configuration.percentDataGood = filter.configuration.percentDataGood;
+        configuration.useSlopedExtrapolation = filter.configuration.useSlopedExtrapolation;
+        target->filter.encoding = UA_EXTENSIONOBJECT_DECODED;
+        target->filter.content.decoded.type = &UA_TYPES[UA_TYPES_AGGREGATEFILTER];
+        target->filter.content.decoded.data = uaFilter;
+    } else if (parameters.filter.isValid()) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Unsupported monitoring filter type:" << parameters.filter.typeName();
+    }
+}
+
+// Stores the values revised by the server for a created or modified monitored item
+static void setRevisedParameters(const QOpcUaMonitoringParameters &requested, double revisedSamplingInterval,
+                                 UA_UInt32 revisedQueueSize, const UA_ExtensionObject &filterResult,
+                                 QOpcUaMonitoringParameters *target)
+{
+    *target = requested;
+    target->samplingInterval = revisedSamplingInterval;
+    target->queueSize = revisedQueueSize;
+    target->filterResult = QVariant();
+
+    if ((filterResult.encoding == UA_EXTENSIONOBJECT_DECODED || filterResult.encoding == UA_EXTENSIONOBJECT_DECODED_NODELETE)
+            && filterResult.content.decoded.type == &UA_TYPES[UA_TYPES_AGGREGATEFILTERRESULT]) {
+        const auto uaResult = static_cast<const UA_AggregateFilterResult *>(filterResult.content.decoded.data);
+        QOpcUaMonitoringParameters::AggregateFilterResult result;
+        result.revisedStartTime = QOpen62541ValueConverter::toQDateTime(&uaResult->revisedStartTime);
+        result.revisedProcessingInterval = uaResult->revisedProcessingInterval;
+        const UA_AggregateConfiguration &configuration = uaResult->revisedAggregateConfiguration;
+        result.revisedConfiguration.useServerCapabilitiesDefaults = configuration.useServerCapabilitiesDefaults;
+        result.revisedConfiguration.treatUncertainAsBad = configuration.treatUncertainAsBad;
+        result.revisedConfiguration.percentDataBad = configuration.percentDataBad;
+        result.revisedConfiguration.percentDataGood = configuration.percentDataGood;
+        result.revisedConfiguration.useSlopedExtrapolation = configuration.useSlopedExtrapolation;
+        target->filterResult = QVariant::fromValue(result);
+    }
+}
+
+static void toUaSimpleAttributeOperand(const QOpcUaSimpleAttributeOperand &operand, UA_SimpleAttributeOperand *target)
+{
+    UA_SimpleAttributeOperand_init(target);
+    target->typeDefinitionId = Open62541Utils::nodeIdFromQString(operand.typeId);
+    target->attributeId = QOpen62541ValueConverter::toUaAttributeId(operand.attributeId);
+    if (operand.browsePath.isEmpty())
+        return;
+
+    target->browsePath = static_cast<UA_QualifiedName *>(UA_Array_new(operand.browsePath.size(), &UA_TYPES[UA_TYPES_QUALIFIEDNAME]));
+    target->browsePathSize = operand.browsePath.size();
+    for (int i = 0; i < operand.browsePath.size(); ++i) {
+        const QOpcUa::QQualifiedName &name = operand.browsePath.at(i);
+        target->browsePath[i] = UA_QUALIFIEDNAME_ALLOC(name.namespaceIndex, name.name.toUtf8().constData());
+    }
+}
+
+// Packs a where clause operand into an extension object owned by target
+static void toUaFilterOperand(const QVariant &operand, UA_ExtensionObject *target)
+{
+    UA_ExtensionObject_init(target);
+    target->encoding = UA_EXTENSIONOBJECT_DECODED;
+
+    if (operand.userType() == qMetaTypeId<QOpcUaSimpleAttributeOperand>()) {
+        UA_SimpleAttributeOperand *simple = UA_SimpleAttributeOperand_new();
+        toUaSimpleAttributeOperand(operand.value<QOpcUaSimpleAttributeOperand>(), simple);
+        target->content.decoded.type = &UA_TYPES[UA_TYPES_SIMPLEATTRIBUTEOPERAND];
+        target->content.decoded.data = simple;
+    } else if (operand.userType() == qMetaTypeId<QOpcUaContentFilterElement::ElementOperand>()) {
+        UA_ElementOperand *element = UA_ElementOperand_new();
+        element->index = operand.value<QOpcUaContentFilterElement::ElementOperand>().index;
+        target->content.decoded.type = &UA_TYPES[UA_TYPES_ELEMENTOPERAND];
+        target->content.decoded.data = element;
+    } else {
+        UA_LiteralOperand *literal = UA_LiteralOperand_new();
+        if (operand.userType() == qMetaTypeId<QOpcUa::TypedVariant>()) {
+            const QOpcUa::TypedVariant typed = operand.value<QOpcUa::TypedVariant>();
+            literal->value = QOpen62541ValueConverter::toOpen62541Variant(typed.first, typed.second);
+        } else {
+            literal->value = QOpen62541ValueConverter::toOpen62541Variant(operand, QOpcUa::Undefined);
+        }
+        target->content.decoded.type = &UA_TYPES[UA_TYPES_LITERALOPERAND];
+        target->content.decoded.data = literal;
+    }
+}
+
+static UA_EventFilter *toUaEventFilter(const QOpcUaEventFilter &filter)
+{
+    UA_EventFilter *uaFilter = UA_EventFilter_new();
+
+    if (!filter.selectClauses.isEmpty()) {
+        uaFilter->selectClauses = static_cast<UA_SimpleAttributeOperand *>(
+                    UA_Array_new(filter.selectClauses.size(), &UA_TYPES[UA_TYPES_SIMPLEATTRIBUTEOPERAND]));
+        uaFilter->selectClausesSize = filter.selectClauses.size();
+        for (int i = 0; i < filter.selectClauses.size(); ++i)
+            toUaSimpleAttributeOperand(filter.selectClauses.at(i), &uaFilter->selectClauses[i]);
+    }
+
+    if (!filter.whereClause.isEmpty()) {
+        UA_ContentFilter &where = uaFilter->whereClause;
+        where.elements = static_cast<UA_ContentFilterElement *>(
+                    UA_Array_new(filter.whereClause.size(), &UA_TYPES[UA_TYPES_CONTENTFILTERELEMENT]));
+        where.elementsSize = filter.whereClause.size();
+        for (int i = 0; i < filter.whereClause.size(); ++i) {
+            const QOpcUaContentFilterElement &element = filter.whereClause.at(i);
+            where.elements[i].filterOperator = static_cast<UA_FilterOperator>(element.filterOperator);
+            if (element.operands.isEmpty())
+                continue;
+            where.elements[i].filterOperands = static_cast<UA_ExtensionObject *>(
+                        UA_Array_new(element.operands.size(), &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]));
+            where.elements[i].filterOperandsSize = element.operands.size();
+            for (int j = 0; j < element.operands.size(); ++j)
+                toUaFilterOperand(element.operands.at(j), &where.elements[i].filterOperands[j]);
+        }
+    }
+
+    return uaFilter;
+}
+
+// Tells the value and event monitors of item whether it exists on the server
+static void reportItemStatus(const QOpen62541MonitoredItem *item, UA_StatusCode status)
+{
+    for (QOpcUaMonitoredValue *value : item->values)
+        value->d_func()->setStatus(static_cast<QOpcUa::UaStatusCode>(status));
+    if (item->event)
+        item->event->d_func()->setStatus(static_cast<QOpcUa::UaStatusCode>(status));
+}
+
+static void toUaItemCreateRequest(const QOpen62541MonitoredItem *item, UA_MonitoredItemCreateRequest *target)
+{
+    UA_MonitoredItemCreateRequest_init(target);
+    target->itemToMonitor.nodeId = Open62541Utils::nodeIdFromQString(item->nodeId);
+    target->monitoringMode = static_cast<UA_MonitoringMode>(item->monitoringMode);
+
+    if (!item->event) {
+        target->itemToMonitor.attributeId = UA_ATTRIBUTEID_VALUE;
+        toUaMonitoringParameters(item->parameters, item->clientHandle, &target->requestedParameters);
+        return;
+    }
+
+    target->itemToMonitor.attributeId = UA_ATTRIBUTEID_EVENTNOTIFIER;
+    UA_MonitoringParameters &parameters = target->requestedParameters;
+    parameters.clientHandle = item->clientHandle;
+    parameters.samplingInterval = 0;
+    // Let the server choose a queue size suitable for bursts of events
+    parameters.queueSize = 0;
+    parameters.discardOldest = true;
+    parameters.filter.encoding = UA_EXTENSIONOBJECT_DECODED;
+    parameters.filter.content.decoded.type = &UA_TYPES[UA_TYPES_EVENTFILTER];
+    parameters.filter.content.decoded.data = toUaEventFilter(item->eventFilter);
+}
+
+// The standby session is mirrored and kept alive at this interval
+static const int StandbyInterval = 5000;
+// Delay before the standby candidates are tried again if none could be reached
+static const int StandbyRetryInterval = 30000;
+
+// The standby subscriptions get no publish requests, their lifetime has to last for a few
+// standby intervals until keepStandbyAlive() resets it
+static UA_UInt32 standbyLifetimeCount(const QOpcUaSubscriptionParameters &parameters)
+{
+    const double cycles = 3.0 * StandbyInterval / qMax(1.0, parameters.publishingInterval);
+    return qMax(parameters.lifetimeCount, UA_UInt32(std::ceil(cycles)));
+}
+
+// Upper bound of the messages fetched by Republish if the server does not report which
+// sequence numbers are available, retransmission queues are much shorter in practice
+static const int MaximumRetransmissions = 100;
+
+static bool isConnectionError(UA_StatusCode code)
+{
+    switch (code) {
+    case UA_STATUSCODE_BADCONNECTIONCLOSED:
+    case UA_STATUSCODE_BADSECURECHANNELCLOSED:
+    case UA_STATUSCODE_BADSECURECHANNELIDINVALID:
+    case UA_STATUSCODE_BADSESSIONCLOSED:
+    case UA_STATUSCODE_BADSESSIONIDINVALID:
+    case UA_STATUSCODE_BADCOMMUNICATIONERROR:
+    case UA_STATUSCODE_BADSERVERNOTCONNECTED:
+        return true;
+    default:
+        return false;
+    }
+}
+
 Open62541AsyncBackend::Open62541AsyncBackend(QOpen62541Client *parent)
     : QOpcUaBackend()
     , m_clientImpl(parent)
     , m_uaclient(nullptr)
     , m_subscriptionTimer(nullptr)
+    , m_reconnectTimer(nullptr)
+    , m_standbyTimer(nullptr)
+    , m_probePool(new QThreadPool(this))
+    , m_reconnectAttempts(0)
+    , m_standbyClient(nullptr)
+    , m_typeDictionaryLoaded(false)
+    , m_maximumMethodsPerCall(0)
+    , m_maximumMethodsPerCallLoaded(false)
 {
 }
 
-void Open62541AsyncBackend::readAttributes(uintptr_t handle, UA_NodeId id, QOpcUaNode::NodeAttributes attr)
+void Open62541AsyncBackend::readAttributes(uintptr_t handle, UA_NodeId id, QOpcUaNode::NodeAttributes attr, QString indexRange)
 {
     UA_ReadRequest req;
     UA_ReadRequest_init(&req);
     QVector<UA_ReadValueId> valueIds;
 
+    QByteArray range = indexRange.toUtf8();
     UA_ReadValueId readId;
     UA_ReadValueId_init(&readId);
     readId.nodeId = id;
+    if (!range.isEmpty())
+        readId.indexRange = Open62541Utils::borrowString(range);
 
     QVector<QOpcUaReadResult> vec;
 
@@ -88,36 +345,65 @@ void Open62541AsyncBackend::readAttributes(uintptr_t handle, UA_NodeId id, QOpcU
 
     UA_ReadResponse res;
     UA_ReadResponse_init(&res);
-    req.nodesToRead = valueIds.data();
-    req.nodesToReadSize = valueIds.size();
+    Open62541Utils::borrowArray(&req.nodesToReadSize, &req.nodesToRead, valueIds);
 
     res = UA_Client_Service_read(m_uaclient, req);
 
+    QSharedPointer<const QOpen62541TypeDictionary> types;
     for (size_t i = 0; i < res.resultsSize; ++i) {
         if (res.results[i].hasStatus)
             vec[i].statusCode = static_cast<QOpcUa::UaStatusCode>(res.results[i].status);
         else
             vec[i].statusCode = QOpcUa::UaStatusCode::Good;
-        if (res.results[i].hasValue && res.results[i].value.data)
-                vec[i].value = QOpen62541ValueConverter::toQVariant(res.results[i].value);
+        if (res.results[i].hasValue && res.results[i].value.data) {
+            if (!types && QOpen62541ValueConverter::hasEncodedStructure(res.results[i].value))
+                types = typeDictionary();
+            vec[i].lazyValue.reset(new QOpen62541LazyValue(&res.results[i].value, typedArrays(), types));
+        }
     }
     emit attributesRead(handle, vec, static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult));
+    checkConnection(res.responseHeader.serviceResult);
     UA_ReadResponse_deleteMembers(&res);
     UA_NodeId_deleteMembers(&id);
 }
 
-void Open62541AsyncBackend::writeAttribute(uintptr_t handle, UA_NodeId id, QOpcUaNode::NodeAttribute attrId, QVariant value, QOpcUa::Types type)
+void Open62541AsyncBackend::writeAttribute(uintptr_t handle, UA_NodeId id, QOpcUaNode::NodeAttribute attrId, QVariant value, QOpcUa::Types type,
+                                           QString indexRange)
 {
     if (type == QOpcUa::Types::Undefined && attrId != QOpcUaNode::NodeAttribute::Value)
         type = attributeIdToTypeId(attrId);
-    UA_Variant temp = QOpen62541ValueConverter::toOpen62541Variant(value, type);
-    UA_StatusCode res = __UA_Client_writeAttribute(m_uaclient, &id,
-                                                   QOpen62541ValueConverter::toUaAttributeId(attrId),
-                                                   &temp,
-                                                   &UA_TYPES[UA_TYPES_VARIANT]);
-    UA_Variant_deleteMembers(&temp);
+
+    // All temporary request structures are allocated from the arena
+    QOpen62541Arena arena;
+
+    UA_StatusCode res;
+    if (indexRange.isEmpty()) {
+        UA_Variant temp = QOpen62541ValueConverter::toOpen62541Variant(value, type, &arena);
+        res = __UA_Client_writeAttribute(m_uaclient, &id,
+                                         QOpen62541ValueConverter::toUaAttributeId(attrId),
+                                         &temp,
+                                         &UA_TYPES[UA_TYPES_VARIANT]);
+    } else {
+        // A range can only be written with the write service, the attribute helper has no index range
+        UA_WriteRequest req;
+        UA_WriteRequest_init(&req);
+        req.nodesToWriteSize = 1;
+        req.nodesToWrite = static_cast<UA_WriteValue *>(arena.allocateArray(req.nodesToWriteSize, &UA_TYPES[UA_TYPES_WRITEVALUE]));
+        req.nodesToWrite->nodeId = id;
+        req.nodesToWrite->attributeId = QOpen62541ValueConverter::toUaAttributeId(attrId);
+        req.nodesToWrite->indexRange = arena.string(indexRange);
+        req.nodesToWrite->value.hasValue = true;
+        req.nodesToWrite->value.value = QOpen62541ValueConverter::toOpen62541Variant(value, type, &arena);
+
+        UA_WriteResponse response = UA_Client_Service_write(m_uaclient, req);
+        res = response.resultsSize > 0 ? response.results[0] : response.responseHeader.serviceResult;
+        UA_WriteResponse_deleteMembers(&response);
+        // Only a part of the attribute has been written, the cached value is outdated
+        value = QVariant();
+    }
 
     emit attributeWritten(handle, attrId, res == UA_STATUSCODE_GOOD ? value : QVariant(), static_cast<QOpcUa::UaStatusCode>(res));
+    checkConnection(res);
     UA_NodeId_deleteMembers(&id);
 }
 
@@ -129,17 +415,18 @@ void Open62541AsyncBackend::writeAttributes(uintptr_t handle, UA_NodeId id, QOpc
         return;
     }
 
+    // The request is allocated from the arena and borrows the node id
+    QOpen62541Arena arena;
     UA_WriteRequest req;
     UA_WriteRequest_init(&req);
     req.nodesToWriteSize = toWrite.size();
-    req.nodesToWrite = static_cast<UA_WriteValue *>(UA_Array_new(req.nodesToWriteSize, &UA_TYPES[UA_TYPES_WRITEVALUE]));
+    req.nodesToWrite = static_cast<UA_WriteValue *>(arena.allocateArray(req.nodesToWriteSize, &UA_TYPES[UA_TYPES_WRITEVALUE]));
     size_t index = 0;
     for (auto it = toWrite.begin(); it != toWrite.end(); ++it, ++index) {
-        UA_WriteValue_init(&(req.nodesToWrite[index]));
         req.nodesToWrite[index].attributeId = QOpen62541ValueConverter::toUaAttributeId(it.key());
-        UA_NodeId_copy(&id, &(req.nodesToWrite[index].nodeId));
+        req.nodesToWrite[index].nodeId = id;
         QOpcUa::Types type = it.key() == QOpcUaNode::NodeAttribute::Value ? valueAttributeType : attributeIdToTypeId(it.key());
-        req.nodesToWrite[index].value.value = QOpen62541ValueConverter::toOpen62541Variant(it.value(), type);
+        req.nodesToWrite[index].value.value = QOpen62541ValueConverter::toOpen62541Variant(it.value(), type, &arena);
     }
     UA_WriteResponse res = UA_Client_Service_write(m_uaclient, req);
 
@@ -150,7 +437,7 @@ void Open62541AsyncBackend::writeAttributes(uintptr_t handle, UA_NodeId id, QOpc
         emit attributeWritten(handle, it.key(), it.value(), status);
     }
 
-    UA_WriteRequest_deleteMembers(&req);
+    checkConnection(res.responseHeader.serviceResult);
     UA_WriteResponse_deleteMembers(&res);
     UA_NodeId_deleteMembers(&id);
 }
@@ -198,6 +485,107 @@ static UA_StatusCode nodeIter(UA_NodeId childId, UA_Boolean isInverse, UA_NodeId
     return UA_STATUSCODE_GOOD;
 }
 
+// Calls all methods of a batch with as few Call requests as the operation limits of the server allow
+void Open62541AsyncBackend::callMethods(quint32 requestId, QVector<QOpcUaMethodCall> calls)
+{
+    QVector<QOpcUaMethodCallResult> results(calls.size());
+    UA_StatusCode serviceResult = m_uaclient ? UA_STATUSCODE_GOOD : UA_STATUSCODE_BADSERVERNOTCONNECTED;
+
+    const UA_UInt32 limit = serviceResult == UA_STATUSCODE_GOOD ? maximumMethodsPerCall() : 0;
+    int first = 0;
+    while (first < calls.size() && serviceResult == UA_STATUSCODE_GOOD) {
+        const int count = limit ? int(qMin<UA_UInt32>(limit, calls.size() - first)) : calls.size() - first;
+        serviceResult = callMethodBatch(calls, first, count, &results);
+        if (serviceResult == UA_STATUSCODE_GOOD)
+            first += count;
+    }
+
+    // Calls of a failed request and the ones not sent afterwards get the service result
+    for (int i = first; i < calls.size(); ++i)
+        results[i].statusCode = static_cast<QOpcUa::UaStatusCode>(serviceResult);
+
+    emit methodsCalled(requestId, results, static_cast<QOpcUa::UaStatusCode>(serviceResult));
+    checkConnection(serviceResult);
+}
+
+UA_UInt32 Open62541AsyncBackend::maximumMethodsPerCall()
+{
+    if (m_maximumMethodsPerCallLoaded)
+        return m_maximumMethodsPerCall;
+
+    UA_Variant limit;
+    UA_Variant_init(&limit);
+    const UA_StatusCode ret = UA_Client_readValueAttribute(m_uaclient,
+            UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERMETHODCALL), &limit);
+    // Servers without operation limits have no such node, the calls are sent in one request then
+    m_maximumMethodsPerCall = 0;
+    if (ret == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&limit, &UA_TYPES[UA_TYPES_UINT32]))
+        m_maximumMethodsPerCall = *static_cast<UA_UInt32 *>(limit.data);
+    m_maximumMethodsPerCallLoaded = !isConnectionError(ret);
+    UA_Variant_deleteMembers(&limit);
+    return m_maximumMethodsPerCall;
+}
+
+// Sends calls[first] to calls[first + count - 1] with one Call request and stores their results
+UA_StatusCode Open62541AsyncBackend::callMethodBatch(const QVector<QOpcUaMethodCall> &calls, int first, int count,
+                                                     QVector<QOpcUaMethodCallResult> *results)
+{
+    // The arguments are allocated from the arena, only the node ids have to be cleaned up
+    QOpen62541Arena arena;
+    QVector<UA_NodeId> nodeIds;
+    nodeIds.reserve(2 * count);
+
+    UA_CallRequest req;
+    UA_CallRequest_init(&req);
+    req.methodsToCallSize = count;
+    req.methodsToCall = static_cast<UA_CallMethodRequest *>(arena.allocateArray(count, &UA_TYPES[UA_TYPES_CALLMETHODREQUEST]));
+    for (int i = 0; i < count; ++i) {
+        const QOpcUaMethodCall &call = calls.at(first + i);
+        UA_CallMethodRequest *method = &req.methodsToCall[i];
+        method->objectId = Open62541Utils::nodeIdFromQString(call.objectId);
+        method->methodId = Open62541Utils::nodeIdFromQString(call.methodId);
+        nodeIds << method->objectId << method->methodId;
+        method->inputArgumentsSize = call.arguments.size();
+        method->inputArguments = static_cast<UA_Variant *>(arena.allocateArray(call.arguments.size(), &UA_TYPES[UA_TYPES_VARIANT]));
+        for (int j = 0; j < call.arguments.size(); ++j) {
+            const QOpcUa::TypedVariant &argument = call.arguments.at(j);
+            method->inputArguments[j] = QOpen62541ValueConverter::toOpen62541Variant(argument.first, argument.second, &arena);
+        }
+    }
+
+    UA_CallResponse res;
+    UA_CallResponse_init(&res);
+    __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_CALLREQUEST],
+                        &res, &UA_TYPES[UA_TYPES_CALLRESPONSE]);
+
+    const UA_StatusCode serviceResult = res.responseHeader.serviceResult;
+    QSharedPointer<const QOpen62541TypeDictionary> types;
+    for (int i = 0; serviceResult == UA_STATUSCODE_GOOD && i < count; ++i) {
+        QOpcUaMethodCallResult &result = (*results)[first + i];
+        if (size_t(i) >= res.resultsSize) {
+            result.statusCode = QOpcUa::UaStatusCode::BadUnexpectedError;
+            continue;
+        }
+        const UA_CallMethodResult &methodResult = res.results[i];
+        result.statusCode = static_cast<QOpcUa::UaStatusCode>(methodResult.statusCode);
+        result.inputArgumentResults.reserve(methodResult.inputArgumentResultsSize);
+        for (size_t j = 0; j < methodResult.inputArgumentResultsSize; ++j)
+            result.inputArgumentResults.push_back(static_cast<QOpcUa::UaStatusCode>(methodResult.inputArgumentResults[j]));
+        result.outputArguments.reserve(methodResult.outputArgumentsSize);
+        for (size_t j = 0; j < methodResult.outputArgumentsSize; ++j) {
+            if (!types && QOpen62541ValueConverter::hasEncodedStructure(methodResult.outputArguments[j]))
+                types = typeDictionary();
+            result.outputArguments.push_back(QOpen62541ValueConverter::toQVariant(methodResult.outputArguments[j], typedArrays(),
+                                                                                   types.data()));
+        }
+    }
+
+    UA_CallResponse_deleteMembers(&res);
+    for (UA_NodeId &nodeId : nodeIds)
+        UA_NodeId_deleteMembers(&nodeId);
+    return serviceResult;
+}
+
 QStringList Open62541AsyncBackend::childrenIds(const UA_NodeId *parentNode)
 {
     QStringList result;
@@ -208,104 +596,2111 @@ QStringList Open62541AsyncBackend::childrenIds(const UA_NodeId *parentNode)
     return result;
 }
 
-UA_UInt32 Open62541AsyncBackend::createSubscription(int interval)
+static bool sameParameters(const QOpcUaSubscriptionParameters &a, const QOpcUaSubscriptionParameters &b)
 {
-    UA_UInt32 result;
-    UA_SubscriptionSettings settings = UA_SubscriptionSettings_default;
-    settings.requestedPublishingInterval = interval;
-    UA_StatusCode ret = UA_Client_Subscriptions_new(m_uaclient, settings, &result);
-    if (ret != UA_STATUSCODE_GOOD)
-        return 0;
-    return result;
+    return a.publishingInterval == b.publishingInterval
+            && a.lifetimeCount == b.lifetimeCount
+            && a.maxKeepAliveCount == b.maxKeepAliveCount
+            && a.maxNotificationsPerPublish == b.maxNotificationsPerPublish
+            && a.priority == b.priority;
 }
 
-void Open62541AsyncBackend::deleteSubscription(UA_UInt32 id)
+// Writes the results of the operations at the indexes in known into target
+static void scatterResults(const QVector<int> &known, const QVector<QOpcUa::UaStatusCode> &results,
+                           QVector<QOpcUa::UaStatusCode> *target)
 {
-    UA_StatusCode ret = UA_Client_Subscriptions_remove(m_uaclient, id);
-    if (ret != UA_STATUSCODE_GOOD)
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "QOpcUa::Open62541: Could not remove subscription";
+    for (int i = 0; i < known.size() && i < results.size(); ++i)
+        (*target)[known.at(i)] = results.at(i);
 }
 
-void Open62541AsyncBackend::connectToEndpoint(const QUrl &url)
+void Open62541AsyncBackend::attachSubscription(QOpen62541Subscription *subscription)
 {
-    m_uaclient = UA_Client_new(UA_ClientConfig_default);
-    UA_StatusCode ret;
+    if (subscription->m_native)
+        return;
 
-    if (url.userName().length()) {
-        QUrl temp = url;
-        const QString userName = temp.userName();
-        const QString password = temp.password();
-        temp.setPassword(QString());
-        temp.setUserName(QString());
-        ret = UA_Client_connect_username(m_uaclient, temp.toString().toUtf8().constData(), userName.toUtf8().constData(), password.toUtf8().constData());
-    } else {
-        ret = UA_Client_connect(m_uaclient, url.toString().toUtf8().constData());
+    QOpen62541NativeSubscription *native = acquireNativeSubscription(subscription->m_parameters, nullptr);
+    if (!native)
+        return;
+
+    subscription->m_native = native;
+    subscription->m_parameters = native->m_parameters;
+}
+
+void Open62541AsyncBackend::detachSubscription(QOpen62541Subscription *subscription)
+{
+    QOpen62541NativeSubscription *native = subscription->m_native;
+    if (!native)
+        return;
+
+    const QList<QOpcUaMonitoredValue *> values = native->m_valueItems.keys();
+    for (QOpcUaMonitoredValue *value : values) {
+        if (value->d_func()->m_subscription == subscription->m_qsubscription)
+            releaseValue(native, value);
+    }
+    const QList<QOpcUaMonitoredEvent *> events = native->m_eventItems.keys();
+    for (QOpcUaMonitoredEvent *event : events) {
+        if (event->d_func()->m_subscription == subscription->m_qsubscription)
+            releaseEvent(native, event);
+    }
+
+    subscription->m_native = nullptr;
+    releaseNativeSubscription(native);
+}
+
+QOpcUa::UaStatusCode Open62541AsyncBackend::modifySubscription(QOpen62541Subscription *subscription,
+                                                               QOpcUaSubscriptionParameters parameters)
+{
+    QOpen62541NativeSubscription *native = subscription->m_native;
+    if (!m_uaclient)
+        return QOpcUa::UaStatusCode::BadServerNotConnected;
+    if (!native)
+        return QOpcUa::UaStatusCode::BadNothingToDo;
+
+    QOpen62541NativeSubscription *existing = findNativeSubscription(parameters);
+    if (existing == native)
+        return QOpcUa::UaStatusCode::Good;
+
+    if (native->m_refCount == 1 && !existing) {
+        // Not shared with other QOpcUaSubscriptions, modify it in place
+        UA_ModifySubscriptionRequest req;
+        UA_ModifySubscriptionRequest_init(&req);
+        req.subscriptionId = native->m_subscriptionId;
+        req.requestedPublishingInterval = parameters.publishingInterval;
+        req.requestedLifetimeCount = parameters.lifetimeCount;
+        req.requestedMaxKeepAliveCount = parameters.maxKeepAliveCount;
+        req.maxNotificationsPerPublish = parameters.maxNotificationsPerPublish;
+        req.priority = parameters.priority;
+
+        UA_ModifySubscriptionResponse res;
+        UA_ModifySubscriptionResponse_init(&res);
+        __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_MODIFYSUBSCRIPTIONREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_MODIFYSUBSCRIPTIONRESPONSE]);
+
+        const QOpcUa::UaStatusCode serviceResult = static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
+        if (serviceResult == QOpcUa::UaStatusCode::Good) {
+            native->m_requestedParameters = parameters;
+            parameters.publishingInterval = res.revisedPublishingInterval;
+            parameters.lifetimeCount = res.revisedLifetimeCount;
+            parameters.maxKeepAliveCount = res.revisedMaxKeepAliveCount;
+            native->m_parameters = parameters;
+            subscription->m_parameters = parameters;
+            updatePublishTimer();
+        } else {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "ModifySubscription failed:" << serviceResult;
+        }
+
+        UA_ModifySubscriptionResponse_deleteMembers(&res);
+        return serviceResult;
     }
 
+    // Copy on write: the other QOpcUaSubscriptions keep the shared native subscription,
+    // this one moves its monitored items to a native subscription with the new parameters.
+    UA_StatusCode ret = UA_STATUSCODE_GOOD;
+    QOpen62541NativeSubscription *target = acquireNativeSubscription(parameters, &ret);
+    if (!target)
+        return static_cast<QOpcUa::UaStatusCode>(ret);
+
+    ret = moveItems(subscription, native, target);
     if (ret != UA_STATUSCODE_GOOD) {
-        UA_Client_delete(m_uaclient);
-        m_uaclient = nullptr;
-        QOpcUaClient::ClientError error = ret == UA_STATUSCODE_BADUSERACCESSDENIED ? QOpcUaClient::AccessDenied : QOpcUaClient::UnknownError;
-        emit m_clientImpl->stateAndOrErrorChanged(QOpcUaClient::Disconnected, error);
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541, "Open62541: Failed to connect.");
+        // The items stay in the shared native subscription
+        releaseNativeSubscription(target);
+        return static_cast<QOpcUa::UaStatusCode>(ret);
+    }
+
+    subscription->m_native = target;
+    subscription->m_parameters = target->m_parameters;
+    releaseNativeSubscription(native);
+    return QOpcUa::UaStatusCode::Good;
+}
+
+bool Open62541AsyncBackend::addMonitoredValue(QOpen62541Subscription *subscription, QOpcUaMonitoredValue *value,
+                                              QString nodeId, QOpcUaMonitoringParameters parameters)
+{
+    QOpen62541NativeSubscription *native = subscription->m_native;
+    if (!m_uaclient || !native)
+        return false;
+
+    // Typed value monitors get the value in their own type and never share an item
+    const bool typed = value->d_func()->m_sink != nullptr;
+    QOpen62541MonitoredItem *item = typed ? nullptr : native->findShareableItem(nodeId, parameters);
+    if (item) {
+        item->values.push_back(value);
+        native->m_valueItems.insert(value, item);
+        value->d_func()->setParameters(item->revisedParameters);
+        // The item does not report its current value again, hand over the last one
+        if (item->hasValue) {
+            const QOpcUaDataChangeNotification &last = item->lastValue;
+            value->d_func()->triggerValueChanged(last.value, last.statusCode, last.sourceTimestamp, last.serverTimestamp);
+        }
+        return true;
+    }
+
+    item = native->addItem(nodeId);
+    item->parameters = parameters;
+    item->exclusive = typed;
+
+    QVector<UA_StatusCode> results;
+    createMonitoredItems(native, {item}, &results);
+    if (results.value(0, UA_STATUSCODE_BADUNEXPECTEDERROR) != UA_STATUSCODE_GOOD) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not add monitored item:"
+                                              << static_cast<QOpcUa::UaStatusCode>(results.value(0, UA_STATUSCODE_BADUNEXPECTEDERROR));
+        native->removeItem(item);
+        return false;
+    }
+
+    item->values.push_back(value);
+    native->m_valueItems.insert(value, item);
+    value->d_func()->setParameters(item->revisedParameters);
+
+    // Poll for the initial value instead of waiting for the next timer tick
+    updatePublishSubscriptionRequests();
+    return true;
+}
+
+void Open62541AsyncBackend::removeMonitoredValue(QOpen62541Subscription *subscription, QOpcUaMonitoredValue *value)
+{
+    if (ownedItem(subscription, value))
+        releaseValue(subscription->m_native, value);
+}
+
+bool Open62541AsyncBackend::addMonitoredEvent(QOpen62541Subscription *subscription, QOpcUaMonitoredEvent *event,
+                                              QString nodeId, QOpcUaEventFilter filter)
+{
+    QOpen62541NativeSubscription *native = subscription->m_native;
+    if (!m_uaclient || !native)
+        return false;
+
+    QOpen62541MonitoredItem *item = native->addItem(nodeId);
+    item->event = event;
+    item->eventFilter = filter;
+
+    QVector<UA_StatusCode> results;
+    createMonitoredItems(native, {item}, &results);
+    if (results.value(0, UA_STATUSCODE_BADUNEXPECTEDERROR) != UA_STATUSCODE_GOOD) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not add event monitored item:"
+                                              << static_cast<QOpcUa::UaStatusCode>(results.value(0, UA_STATUSCODE_BADUNEXPECTEDERROR));
+        native->removeItem(item);
+        return false;
+    }
+
+    native->m_eventItems.insert(event, item);
+    event->d_func()->m_filter = filter;
+    return true;
+}
+
+void Open62541AsyncBackend::removeMonitoredEvent(QOpen62541Subscription *subscription, QOpcUaMonitoredEvent *event)
+{
+    QOpen62541NativeSubscription *native = subscription->m_native;
+    if (native && native->m_eventItems.contains(event) && event->d_func()->m_subscription == subscription->m_qsubscription)
+        releaseEvent(native, event);
+}
+
+QOpcUa::UaStatusCode Open62541AsyncBackend::modifyMonitoredValues(QOpen62541Subscription *subscription,
+                                                                  QVector<QOpcUaMonitoredValue *> values,
+                                                                  QOpcUaMonitoringParameters parameters,
+                                                                  QVector<QOpcUa::UaStatusCode> *results)
+{
+    QVector<QOpcUa::UaStatusCode> itemResults(values.size(), QOpcUa::UaStatusCode::BadMonitoredItemIdInvalid);
+    if (!m_uaclient) {
+        if (results)
+            results->fill(QOpcUa::UaStatusCode::BadServerNotConnected, values.size());
+        return QOpcUa::UaStatusCode::BadServerNotConnected;
+    }
+
+    const QVector<QOpen62541MonitoredItem *> items = exclusiveItems(subscription, values, &itemResults);
+    QVector<int> known;
+    for (int i = 0; i < items.size(); ++i) {
+        if (items.at(i))
+            known.push_back(i);
+    }
+
+    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::BadNothingToDo;
+    if (!known.isEmpty()) {
+        UA_ModifyMonitoredItemsRequest req;
+        UA_ModifyMonitoredItemsRequest_init(&req);
+        req.subscriptionId = subscription->m_native->m_subscriptionId;
+        req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+        req.itemsToModify = static_cast<UA_MonitoredItemModifyRequest *>(
+                    UA_Array_new(known.size(), &UA_TYPES[UA_TYPES_MONITOREDITEMMODIFYREQUEST]));
+        req.itemsToModifySize = known.size();
+        for (int i = 0; i < known.size(); ++i) {
+            const QOpen62541MonitoredItem *item = items.at(known.at(i));
+            req.itemsToModify[i].monitoredItemId = item->monitoredItemId;
+            toUaMonitoringParameters(parameters, item->clientHandle, &req.itemsToModify[i].requestedParameters);
+        }
+
+        UA_ModifyMonitoredItemsResponse res;
+        UA_ModifyMonitoredItemsResponse_init(&res);
+        __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_MODIFYMONITOREDITEMSREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_MODIFYMONITOREDITEMSRESPONSE]);
+
+        serviceResult = static_cast<QOpcUa::UaStatusCode>(res.responseHeader.serviceResult);
+        for (int i = 0; i < known.size(); ++i) {
+            QOpcUa::UaStatusCode &itemResult = itemResults[known.at(i)];
+            if (serviceResult != QOpcUa::UaStatusCode::Good) {
+                itemResult = serviceResult;
+            } else if (size_t(i) >= res.resultsSize) {
+                itemResult = QOpcUa::UaStatusCode::BadUnexpectedError;
+            } else {
+                itemResult = static_cast<QOpcUa::UaStatusCode>(res.results[i].statusCode);
+                if (itemResult == QOpcUa::UaStatusCode::Good) {
+                    QOpen62541MonitoredItem *item = items.at(known.at(i));
+                    item->parameters = parameters;
+                    ++item->revision;
+                    setRevisedParameters(parameters, res.results[i].revisedSamplingInterval, res.results[i].revisedQueueSize,
+                                         res.results[i].filterResult, &item->revisedParameters);
+                    values.at(known.at(i))->d_func()->setParameters(item->revisedParameters);
+                }
+            }
+        }
+        if (serviceResult != QOpcUa::UaStatusCode::Good)
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "ModifyMonitoredItems failed:" << serviceResult;
+
+        UA_ModifyMonitoredItemsRequest_deleteMembers(&req);
+        UA_ModifyMonitoredItemsResponse_deleteMembers(&res);
+    }
+
+    if (results)
+        *results = itemResults;
+    return serviceResult;
+}
+
+QOpcUa::UaStatusCode Open62541AsyncBackend::setMonitoringMode(QOpen62541Subscription *subscription,
+                                                              QVector<QOpcUaMonitoredValue *> values,
+                                                              QOpcUa::MonitoringMode mode, QVector<QOpcUa::UaStatusCode> *results)
+{
+    QVector<QOpcUa::UaStatusCode> itemResults(values.size(), QOpcUa::UaStatusCode::BadMonitoredItemIdInvalid);
+    if (!m_uaclient) {
+        if (results)
+            results->fill(QOpcUa::UaStatusCode::BadServerNotConnected, values.size());
+        return QOpcUa::UaStatusCode::BadServerNotConnected;
+    }
+
+    // Values sharing an item with others get an item of their own first
+    const QVector<QOpen62541MonitoredItem *> items = exclusiveItems(subscription, values, &itemResults);
+    QVector<int> known;
+    QVector<UA_UInt32> monitoredItemIds;
+    for (int i = 0; i < items.size(); ++i) {
+        if (items.at(i)) {
+            known.push_back(i);
+            monitoredItemIds.push_back(items.at(i)->monitoredItemId);
+            items.at(i)->exclusive = true;
+        }
+    }
+
+    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::BadNothingToDo;
+    if (!known.isEmpty()) {
+        UA_SetMonitoringModeRequest req;
+        UA_SetMonitoringModeRequest_init(&req);
+        req.subscriptionId = subscription->m_native->m_subscriptionId;
+        req.monitoringMode = static_cast<UA_MonitoringMode>(mode);
+        Open62541Utils::borrowArray(&req.monitoredItemIdsSize, &req.monitoredItemIds, monitoredItemIds);
+
+        UA_SetMonitoringModeResponse res;
+        UA_SetMonitoringModeResponse_init(&res);
+        __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_SETMONITORINGMODEREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_SETMONITORINGMODERESPONSE]);
+
+        QVector<QOpcUa::UaStatusCode> serviceResults;
+        serviceResult = copyOperationResults(res.responseHeader, res.results, res.resultsSize,
+                                             monitoredItemIds.size(), &serviceResults);
+        scatterResults(known, serviceResults, &itemResults);
+        if (serviceResult != QOpcUa::UaStatusCode::Good)
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "SetMonitoringMode failed:" << serviceResult;
+        for (int i = 0; i < known.size() && i < serviceResults.size(); ++i) {
+            if (serviceResults.at(i) == QOpcUa::UaStatusCode::Good)
+                items.at(known.at(i))->monitoringMode = mode;
+        }
+
+        UA_SetMonitoringModeResponse_deleteMembers(&res);
+    }
+
+    if (results)
+        *results = itemResults;
+    return serviceResult;
+}
+
+QOpcUa::UaStatusCode Open62541AsyncBackend::setTriggering(QOpen62541Subscription *subscription, QOpcUaMonitoredValue *trigger,
+                                                          QVector<QOpcUaMonitoredValue *> linksToAdd,
+                                                          QVector<QOpcUaMonitoredValue *> linksToRemove,
+                                                          QVector<QOpcUa::UaStatusCode> *addResults,
+                                                          QVector<QOpcUa::UaStatusCode> *removeResults)
+{
+    QVector<QOpcUa::UaStatusCode> addItemResults(linksToAdd.size(), QOpcUa::UaStatusCode::BadMonitoredItemIdInvalid);
+    QVector<QOpcUa::UaStatusCode> removeItemResults(linksToRemove.size(), QOpcUa::UaStatusCode::BadMonitoredItemIdInvalid);
+    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::BadNothingToDo;
+
+    QVector<QOpcUa::UaStatusCode> triggerResult(1, QOpcUa::UaStatusCode::BadMonitoredItemIdInvalid);
+    QOpen62541MonitoredItem *triggerItem = nullptr;
+    if (!m_uaclient)
+        serviceResult = QOpcUa::UaStatusCode::BadServerNotConnected;
+    else
+        triggerItem = exclusiveItems(subscription, {trigger}, &triggerResult).first();
+
+    if (m_uaclient && !triggerItem)
+        serviceResult = triggerResult.first();
+
+    if (triggerItem) {
+        triggerItem->exclusive = true;
+        const QVector<QOpen62541MonitoredItem *> addItems = exclusiveItems(subscription, linksToAdd, &addItemResults);
+        const QVector<QOpen62541MonitoredItem *> removeItems = exclusiveItems(subscription, linksToRemove, &removeItemResults);
+
+        QVector<int> knownAdd;
+        QVector<UA_UInt32> addIds;
+        for (int i = 0; i < addItems.size(); ++i) {
+            if (addItems.at(i)) {
+                knownAdd.push_back(i);
+                addIds.push_back(addItems.at(i)->monitoredItemId);
+                addItems.at(i)->exclusive = true;
+            }
+        }
+        QVector<int> knownRemove;
+        QVector<UA_UInt32> removeIds;
+        for (int i = 0; i < removeItems.size(); ++i) {
+            if (removeItems.at(i)) {
+                knownRemove.push_back(i);
+                removeIds.push_back(removeItems.at(i)->monitoredItemId);
+            }
+        }
+
+        if (!addIds.isEmpty() || !removeIds.isEmpty()) {
+            UA_SetTriggeringRequest req;
+            UA_SetTriggeringRequest_init(&req);
+            req.subscriptionId = subscription->m_native->m_subscriptionId;
+            req.triggeringItemId = triggerItem->monitoredItemId;
+            Open62541Utils::borrowArray(&req.linksToAddSize, &req.linksToAdd, addIds);
+            Open62541Utils::borrowArray(&req.linksToRemoveSize, &req.linksToRemove, removeIds);
+
+            UA_SetTriggeringResponse res;
+            UA_SetTriggeringResponse_init(&res);
+            __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_SETTRIGGERINGREQUEST],
+                                &res, &UA_TYPES[UA_TYPES_SETTRIGGERINGRESPONSE]);
+
+            QVector<QOpcUa::UaStatusCode> serviceResults;
+            copyOperationResults(res.responseHeader, res.addResults, res.addResultsSize, addIds.size(), &serviceResults);
+            scatterResults(knownAdd, serviceResults, &addItemResults);
+            serviceResult = copyOperationResults(res.responseHeader, res.removeResults, res.removeResultsSize,
+                                                 removeIds.size(), &serviceResults);
+            scatterResults(knownRemove, serviceResults, &removeItemResults);
+            if (serviceResult != QOpcUa::UaStatusCode::Good)
+                qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "SetTriggering failed:" << serviceResult;
+
+            // The links are kept with the trigger, so they can be restored with the items. The
+            // new revision makes the hot standby recreate the trigger with the current links.
+            ++triggerItem->revision;
+            for (int index : qAsConst(knownAdd)) {
+                const UA_UInt32 handle = addItems.at(index)->clientHandle;
+                if (addItemResults.at(index) == QOpcUa::UaStatusCode::Good && !triggerItem->triggeredItems.contains(handle))
+                    triggerItem->triggeredItems.push_back(handle);
+            }
+            for (int index : qAsConst(knownRemove)) {
+                if (removeItemResults.at(index) == QOpcUa::UaStatusCode::Good)
+                    triggerItem->triggeredItems.removeAll(removeItems.at(index)->clientHandle);
+            }
+
+            UA_SetTriggeringResponse_deleteMembers(&res);
+        }
+    }
+
+    if (!triggerItem) {
+        addItemResults.fill(serviceResult);
+        removeItemResults.fill(serviceResult);
+    }
+    if (addResults)
+        *addResults = addItemResults;
+    if (removeResults)
+        *removeResults = removeItemResults;
+    return serviceResult;
+}
+
+QOpen62541NativeSubscription *Open62541AsyncBackend::findNativeSubscription(const QOpcUaSubscriptionParameters &parameters) const
+{
+    for (QOpen62541NativeSubscription *native : m_subscriptions) {
+        if (sameParameters(native->m_requestedParameters, parameters))
+            return native;
+    }
+    for (QOpen62541NativeSubscription *native : m_detachedSubscriptions) {
+        if (sameParameters(native->m_requestedParameters, parameters))
+            return native;
+    }
+    return nullptr;
+}
+
+// Returns a native subscription with the requested parameters, creating it if there is
+// none yet. Every call must be balanced with a call to releaseNativeSubscription().
+QOpen62541NativeSubscription *Open62541AsyncBackend::acquireNativeSubscription(const QOpcUaSubscriptionParameters &parameters,
+                                                                                UA_StatusCode *status)
+{
+    if (!m_uaclient) {
+        if (status)
+            *status = UA_STATUSCODE_BADSERVERNOTCONNECTED;
+        return nullptr;
+    }
+
+    QOpen62541NativeSubscription *native = findNativeSubscription(parameters);
+    if (!native) {
+        native = new QOpen62541NativeSubscription(parameters);
+        const UA_StatusCode ret = createNativeSubscription(native);
+        if (status)
+            *status = ret;
+        if (ret != UA_STATUSCODE_GOOD) {
+            delete native;
+            return nullptr;
+        }
+    }
+
+    ++native->m_refCount;
+    return native;
+}
+
+void Open62541AsyncBackend::releaseNativeSubscription(QOpen62541NativeSubscription *native)
+{
+    if (--native->m_refCount > 0)
         return;
+
+    removeStandbySubscription(native);
+    UA_UInt32 subscriptionId = native->m_subscriptionId;
+    if (m_uaclient) {
+        UA_DeleteSubscriptionsRequest req;
+        UA_DeleteSubscriptionsRequest_init(&req);
+        Open62541Utils::borrowArray(&req.subscriptionIdsSize, &req.subscriptionIds, &subscriptionId);
+
+        UA_DeleteSubscriptionsResponse res;
+        UA_DeleteSubscriptionsResponse_init(&res);
+        __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_DELETESUBSCRIPTIONSREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_DELETESUBSCRIPTIONSRESPONSE]);
+
+        UA_StatusCode ret = res.responseHeader.serviceResult;
+        if (ret == UA_STATUSCODE_GOOD && res.resultsSize == 1)
+            ret = res.results[0];
+        if (ret != UA_STATUSCODE_GOOD)
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "QOpcUa::Open62541: Could not remove subscription";
+        UA_DeleteSubscriptionsResponse_deleteMembers(&res);
     }
 
-    if (!m_subscriptionTimer) {
-        m_subscriptionTimer = new QTimer(this);
-        m_subscriptionTimer->setInterval(5000);
-        QObject::connect(m_subscriptionTimer, &QTimer::timeout,
-                         this, &Open62541AsyncBackend::updatePublishSubscriptionRequests);
+    m_subscriptions.remove(subscriptionId);
+    m_detachedSubscriptions.removeOne(native);
+    for (auto it = m_pendingAcknowledgements.begin(); it != m_pendingAcknowledgements.end();) {
+        if (it->subscriptionId == subscriptionId)
+            it = m_pendingAcknowledgements.erase(it);
+        else
+            ++it;
     }
-    emit stateAndOrErrorChanged(QOpcUaClient::Connected, QOpcUaClient::NoError);
+    delete native;
+    updatePublishTimer();
 }
 
-void Open62541AsyncBackend::disconnectFromEndpoint()
+UA_StatusCode Open62541AsyncBackend::createNativeSubscription(QOpen62541NativeSubscription *native)
 {
-    UA_StatusCode ret = UA_Client_disconnect(m_uaclient);
+    const QOpcUaSubscriptionParameters &parameters = native->m_requestedParameters;
+    UA_CreateSubscriptionRequest req;
+    UA_CreateSubscriptionRequest_init(&req);
+    req.requestedPublishingInterval = parameters.publishingInterval;
+    req.requestedLifetimeCount = parameters.lifetimeCount;
+    req.requestedMaxKeepAliveCount = parameters.maxKeepAliveCount;
+    req.maxNotificationsPerPublish = parameters.maxNotificationsPerPublish;
+    req.publishingEnabled = true;
+    req.priority = parameters.priority;
+
+    UA_CreateSubscriptionResponse res;
+    UA_CreateSubscriptionResponse_init(&res);
+    __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_CREATESUBSCRIPTIONREQUEST],
+                        &res, &UA_TYPES[UA_TYPES_CREATESUBSCRIPTIONRESPONSE]);
+
+    const UA_StatusCode ret = res.responseHeader.serviceResult;
     if (ret != UA_STATUSCODE_GOOD) {
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541, "Open62541: Failed to disconnect.");
-        // Fall through intentionally
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not create subscription:" << static_cast<QOpcUa::UaStatusCode>(ret);
+    } else {
+        native->m_subscriptionId = res.subscriptionId;
+        native->m_parameters = parameters;
+        native->m_parameters.publishingInterval = res.revisedPublishingInterval;
+        native->m_parameters.lifetimeCount = res.revisedLifetimeCount;
+        native->m_parameters.maxKeepAliveCount = res.revisedMaxKeepAliveCount;
+        m_subscriptions.insert(res.subscriptionId, native);
+        updatePublishTimer();
     }
 
-    UA_Client_delete(m_uaclient);
-    m_uaclient = nullptr;
-    m_subscriptionTimer->stop();
-    emit stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::NoError);
+    UA_CreateSubscriptionResponse_deleteMembers(&res);
+    return ret;
+}
+
+// Creates all items in a single CreateMonitoredItems call and stores the monitored
+// item ids and revised parameters. results receives one status code per item.
+void Open62541AsyncBackend::createMonitoredItems(QOpen62541NativeSubscription *native,
+                                                 const QVector<QOpen62541MonitoredItem *> &items,
+                                                 QVector<UA_StatusCode> *results)
+{
+    results->clear();
+    if (items.isEmpty())
+        return;
+    if (!m_uaclient) {
+        results->fill(UA_STATUSCODE_BADSERVERNOTCONNECTED, items.size());
+        return;
+    }
+
+    UA_CreateMonitoredItemsRequest req;
+    UA_CreateMonitoredItemsRequest_init(&req);
+    req.subscriptionId = native->m_subscriptionId;
+    req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+    req.itemsToCreate = static_cast<UA_MonitoredItemCreateRequest *>(
+                UA_Array_new(items.size(), &UA_TYPES[UA_TYPES_MONITOREDITEMCREATEREQUEST]));
+    req.itemsToCreateSize = items.size();
+    for (int i = 0; i < items.size(); ++i)
+        toUaItemCreateRequest(items.at(i), &req.itemsToCreate[i]);
+
+    UA_CreateMonitoredItemsResponse res;
+    UA_CreateMonitoredItemsResponse_init(&res);
+    __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_CREATEMONITOREDITEMSREQUEST],
+                        &res, &UA_TYPES[UA_TYPES_CREATEMONITOREDITEMSRESPONSE]);
+
+    results->reserve(items.size());
+    for (int i = 0; i < items.size(); ++i) {
+        UA_StatusCode ret = res.responseHeader.serviceResult;
+        if (ret == UA_STATUSCODE_GOOD)
+            ret = size_t(i) < res.resultsSize ? res.results[i].statusCode : UA_STATUSCODE_BADUNEXPECTEDERROR;
+        results->push_back(ret);
+        if (ret != UA_STATUSCODE_GOOD)
+            continue;
+
+        QOpen62541MonitoredItem *item = items.at(i);
+        item->monitoredItemId = res.results[i].monitoredItemId;
+        setRevisedParameters(item->parameters, res.results[i].revisedSamplingInterval, res.results[i].revisedQueueSize,
+                             res.results[i].filterResult, &item->revisedParameters);
+        for (QOpcUaMonitoredValue *value : qAsConst(item->values))
+            value->d_func()->setParameters(item->revisedParameters);
+    }
+
+    UA_CreateMonitoredItemsRequest_deleteMembers(&req);
+    UA_CreateMonitoredItemsResponse_deleteMembers(&res);
 }
 
-void Open62541AsyncBackend::updatePublishSubscriptionRequests() const
+UA_StatusCode Open62541AsyncBackend::deleteMonitoredItem(UA_UInt32 subscriptionId, UA_UInt32 monitoredItemId)
 {
-    if (m_uaclient)
-        UA_Client_Subscriptions_manuallySendPublishRequest(m_uaclient);
+    if (!m_uaclient)
+        return UA_STATUSCODE_BADSERVERNOTCONNECTED;
+
+    UA_DeleteMonitoredItemsRequest req;
+    UA_DeleteMonitoredItemsRequest_init(&req);
+    req.subscriptionId = subscriptionId;
+    Open62541Utils::borrowArray(&req.monitoredItemIdsSize, &req.monitoredItemIds, &monitoredItemId);
+
+    UA_DeleteMonitoredItemsResponse res;
+    UA_DeleteMonitoredItemsResponse_init(&res);
+    __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_DELETEMONITOREDITEMSREQUEST],
+                        &res, &UA_TYPES[UA_TYPES_DELETEMONITOREDITEMSRESPONSE]);
+
+    UA_StatusCode ret = res.responseHeader.serviceResult;
+    if (ret == UA_STATUSCODE_GOOD && res.resultsSize == 1)
+        ret = res.results[0];
+    UA_DeleteMonitoredItemsResponse_deleteMembers(&res);
+    return ret;
 }
 
-void Open62541AsyncBackend::activateSubscriptionTimer(int timeout)
+// Adds the links of the triggering item with the id triggeringItemId in the session of client.
+// linkIds are the monitored item ids of the linked items in the same session.
+UA_StatusCode Open62541AsyncBackend::addTriggeringLinks(UA_Client *client, UA_UInt32 subscriptionId,
+                                                        UA_UInt32 triggeringItemId, QVector<UA_UInt32> linkIds)
 {
-    // ### TODO: Check all available subscriptions and their timeout value
-    // Get minimum value
-    if (timeout <= 0)
-        return;
+    UA_SetTriggeringRequest req;
+    UA_SetTriggeringRequest_init(&req);
+    req.subscriptionId = subscriptionId;
+    req.triggeringItemId = triggeringItemId;
+    Open62541Utils::borrowArray(&req.linksToAddSize, &req.linksToAdd, linkIds);
 
-    m_subscriptionIntervals.insert(timeout);
+    UA_SetTriggeringResponse res;
+    UA_SetTriggeringResponse_init(&res);
+    __UA_Client_Service(client, &req, &UA_TYPES[UA_TYPES_SETTRIGGERINGREQUEST],
+                        &res, &UA_TYPES[UA_TYPES_SETTRIGGERINGRESPONSE]);
+
+    UA_StatusCode ret = res.responseHeader.serviceResult;
+    for (size_t i = 0; ret == UA_STATUSCODE_GOOD && i < res.addResultsSize; ++i)
+        ret = res.addResults[i];
+    UA_SetTriggeringResponse_deleteMembers(&res);
+    return ret;
+}
 
-    int minInterval = timeout;
-    for (auto it : m_subscriptionIntervals) {
-        if (it < minInterval)
-            minInterval = it;
+// Sets the stored triggering links again in which one of items takes part, after
+// these items have been created anew in native
+void Open62541AsyncBackend::restoreTriggeringLinks(QOpen62541NativeSubscription *native,
+                                                   const QVector<QOpen62541MonitoredItem *> &items)
+{
+    QHash<UA_UInt32, UA_UInt32> monitoredItemIds;
+    for (const QOpen62541MonitoredItem *item : qAsConst(native->m_items)) {
+        if (item->monitoredItemId)
+            monitoredItemIds.insert(item->clientHandle, item->monitoredItemId);
     }
-    // Update subscriptionTimer timeout
-    m_subscriptionTimer->setInterval(minInterval);
-    // Start / Stop timer
-    m_subscriptionTimer->start();
+    QSet<UA_UInt32> created;
+    for (const QOpen62541MonitoredItem *item : items)
+        created.insert(item->clientHandle);
+
+    restoreTriggeringLinks(m_uaclient, native->m_subscriptionId, native, monitoredItemIds, created);
 }
 
-void Open62541AsyncBackend::removeSubscriptionTimer(int timeout)
+// Sets the triggering links of native in the session of client in which one of the items with
+// the client handles in created takes part. monitoredItemIds maps the client handles to the
+// monitored item ids in that session, the hot standby session has ids of its own.
+void Open62541AsyncBackend::restoreTriggeringLinks(UA_Client *client, UA_UInt32 subscriptionId,
+                                                   const QOpen62541NativeSubscription *native,
+                                                   const QHash<UA_UInt32, UA_UInt32> &monitoredItemIds,
+                                                   const QSet<UA_UInt32> &created)
 {
-    if (!m_subscriptionIntervals.remove(timeout))
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Trying to remove non-existent interval.";
-    if (m_subscriptionIntervals.isEmpty())
-        m_subscriptionTimer->stop();
+    for (const QOpen62541MonitoredItem *item : native->m_items) {
+        const UA_UInt32 triggeringItemId = monitoredItemIds.value(item->clientHandle, 0);
+        if (!triggeringItemId || item->triggeredItems.isEmpty())
+            continue;
+
+        QVector<UA_UInt32> linkIds;
+        for (UA_UInt32 handle : item->triggeredItems) {
+            const UA_UInt32 linkId = monitoredItemIds.value(handle, 0);
+            if (linkId && (created.contains(item->clientHandle) || created.contains(handle)))
+                linkIds.push_back(linkId);
+        }
+        if (linkIds.isEmpty())
+            continue;
+
+        const UA_StatusCode ret = addTriggeringLinks(client, subscriptionId, triggeringItemId, linkIds);
+        if (ret != UA_STATUSCODE_GOOD)
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not restore the triggering links of node" << item->nodeId
+                                                  << static_cast<QOpcUa::UaStatusCode>(ret);
+    }
+}
+
+// Drops the reference of value to its monitored item, the item is deleted with its last value
+void Open62541AsyncBackend::releaseValue(QOpen62541NativeSubscription *native, QOpcUaMonitoredValue *value)
+{
+    QOpen62541MonitoredItem *item = native->m_valueItems.take(value);
+    if (!item)
+        return;
+
+    item->values.removeOne(value);
+    if (!item->values.isEmpty())
+        return;
+
+    // Items which could not be created again after a reconnect do not exist on the server
+    if (item->monitoredItemId && deleteMonitoredItem(native->m_subscriptionId, item->monitoredItemId) != UA_STATUSCODE_GOOD)
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not remove monitored value from subscription:" << item->monitoredItemId;
+    native->removeItem(item);
+}
+
+void Open62541AsyncBackend::releaseEvent(QOpen62541NativeSubscription *native, QOpcUaMonitoredEvent *event)
+{
+    QOpen62541MonitoredItem *item = native->m_eventItems.value(event, nullptr);
+    if (!item)
+        return;
+
+    if (item->monitoredItemId && deleteMonitoredItem(native->m_subscriptionId, item->monitoredItemId) != UA_STATUSCODE_GOOD)
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not remove monitored event from subscription:" << item->monitoredItemId;
+    native->removeItem(item);
+}
+
+QOpen62541MonitoredItem *Open62541AsyncBackend::ownedItem(QOpen62541Subscription *subscription, QOpcUaMonitoredValue *value) const
+{
+    if (!subscription->m_native || !value || value->d_func()->m_subscription != subscription->m_qsubscription)
+        return nullptr;
+    return subscription->m_native->m_valueItems.value(value, nullptr);
+}
+
+// Returns the monitored item of each value in values. Values which share their item with
+// other values are moved to a new item first, so the item can be changed without affecting
+// the others. The entry is nullptr and results contains the error for failed values.
+QVector<QOpen62541MonitoredItem *> Open62541AsyncBackend::exclusiveItems(QOpen62541Subscription *subscription,
+                                                                         const QVector<QOpcUaMonitoredValue *> &values,
+                                                                         QVector<QOpcUa::UaStatusCode> *results)
+{
+    QOpen62541NativeSubscription *native = subscription->m_native;
+    QVector<QOpen62541MonitoredItem *> items(values.size(), nullptr);
+    QVector<int> shared;
+    for (int i = 0; i < values.size(); ++i) {
+        QOpen62541MonitoredItem *item = ownedItem(subscription, values.at(i));
+        if (!item)
+            (*results)[i] = QOpcUa::UaStatusCode::BadMonitoredItemIdInvalid;
+        else if (item->values.size() == 1)
+            items[i] = item;
+        else
+            shared.push_back(i);
+    }
+    if (shared.isEmpty())
+        return items;
+
+    QVector<QOpen62541MonitoredItem *> created;
+    created.reserve(shared.size());
+    for (int index : qAsConst(shared)) {
+        const QOpen62541MonitoredItem *oldItem = native->m_valueItems.value(values.at(index));
+        QOpen62541MonitoredItem *item = native->addItem(oldItem->nodeId);
+        item->parameters = oldItem->parameters;
+        created.push_back(item);
+    }
+
+    QVector<UA_StatusCode> createResults;
+    createMonitoredItems(native, created, &createResults);
+
+    for (int i = 0; i < shared.size(); ++i) {
+        const int index = shared.at(i);
+        QOpcUaMonitoredValue *value = values.at(index);
+        QOpen62541MonitoredItem *item = created.at(i);
+        if (createResults.at(i) != UA_STATUSCODE_GOOD) {
+            (*results)[index] = static_cast<QOpcUa::UaStatusCode>(createResults.at(i));
+            native->removeItem(item);
+            continue;
+        }
+
+        QOpen62541MonitoredItem *oldItem = native->m_valueItems.value(value);
+        item->lastValue = oldItem->lastValue;
+        item->hasValue = oldItem->hasValue;
+        // Moves the reference, deletes the old item on the server if it was the last one
+        releaseValue(native, value);
+        item->values.push_back(value);
+        native->m_valueItems.insert(value, item);
+        value->d_func()->setParameters(item->revisedParameters);
+        items[index] = item;
+    }
+    return items;
+}
+
+// Moves all monitored values and events of subscription from one native subscription to another.
+// Monitoring mode, triggering links and exclusiveness are carried over. If an item can not be
+// created in to, the items created so far are deleted again and nothing is moved.
+UA_StatusCode Open62541AsyncBackend::moveItems(QOpen62541Subscription *subscription, QOpen62541NativeSubscription *from,
+                                               QOpen62541NativeSubscription *to)
+{
+    QVector<QOpcUaMonitoredValue *> values;
+    for (auto it = from->m_valueItems.constBegin(); it != from->m_valueItems.constEnd(); ++it) {
+        if (it.key()->d_func()->m_subscription == subscription->m_qsubscription)
+            values.push_back(it.key());
+    }
+    QVector<QOpcUaMonitoredEvent *> events;
+    for (auto it = from->m_eventItems.constBegin(); it != from->m_eventItems.constEnd(); ++it) {
+        if (it.key()->d_func()->m_subscription == subscription->m_qsubscription)
+            events.push_back(it.key());
+    }
+
+    QVector<QOpen62541MonitoredItem *> created;
+    // Keyed by the client handle of the item in from
+    QHash<UA_UInt32, QOpen62541MonitoredItem *> movedItems;
+    QHash<QOpcUaMonitoredValue *, QOpen62541MonitoredItem *> targets;
+    QHash<QOpcUaMonitoredEvent *, QOpen62541MonitoredItem *> eventTargets;
+    for (QOpcUaMonitoredValue *value : qAsConst(values)) {
+        const QOpen62541MonitoredItem *oldItem = from->m_valueItems.value(value);
+        QOpen62541MonitoredItem *item = movedItems.value(oldItem->clientHandle, nullptr);
+        if (!item && !oldItem->exclusive)
+            item = to->findShareableItem(oldItem->nodeId, oldItem->parameters);
+        if (!item) {
+            item = to->addItem(oldItem->nodeId);
+            item->parameters = oldItem->parameters;
+            item->exclusive = oldItem->exclusive;
+            item->monitoringMode = oldItem->monitoringMode;
+            created.push_back(item);
+        }
+        movedItems.insert(oldItem->clientHandle, item);
+        targets.insert(value, item);
+    }
+    for (QOpcUaMonitoredEvent *event : qAsConst(events)) {
+        const QOpen62541MonitoredItem *oldItem = from->m_eventItems.value(event);
+        QOpen62541MonitoredItem *item = to->addItem(oldItem->nodeId);
+        item->event = event;
+        item->eventFilter = oldItem->eventFilter;
+        item->monitoringMode = oldItem->monitoringMode;
+        eventTargets.insert(event, item);
+        created.push_back(item);
+    }
+
+    QVector<UA_StatusCode> createResults;
+    createMonitoredItems(to, created, &createResults);
+    UA_StatusCode ret = UA_STATUSCODE_GOOD;
+    for (int i = 0; i < created.size() && ret == UA_STATUSCODE_GOOD; ++i) {
+        if (createResults.at(i) != UA_STATUSCODE_GOOD) {
+            ret = createResults.at(i);
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not move monitored item for node" << created.at(i)->nodeId
+                                                  << static_cast<QOpcUa::UaStatusCode>(ret);
+        }
+    }
+    if (ret != UA_STATUSCODE_GOOD) {
+        for (int i = 0; i < created.size(); ++i) {
+            if (createResults.at(i) == UA_STATUSCODE_GOOD)
+                deleteMonitoredItem(to->m_subscriptionId, created.at(i)->monitoredItemId);
+            to->removeItem(created.at(i));
+        }
+        return ret;
+    }
+
+    for (auto it = movedItems.constBegin(); it != movedItems.constEnd(); ++it) {
+        const QOpen62541MonitoredItem *oldItem = from->m_items.value(it.key());
+        for (UA_UInt32 handle : oldItem->triggeredItems) {
+            if (const QOpen62541MonitoredItem *linked = movedItems.value(handle, nullptr))
+                it.value()->triggeredItems.push_back(linked->clientHandle);
+        }
+    }
+    restoreTriggeringLinks(to, created);
+
+    for (QOpcUaMonitoredValue *value : qAsConst(values)) {
+        releaseValue(from, value);
+        QOpen62541MonitoredItem *item = targets.value(value);
+        item->values.push_back(value);
+        to->m_valueItems.insert(value, item);
+        value->d_func()->setParameters(item->revisedParameters);
+    }
+    for (QOpcUaMonitoredEvent *event : qAsConst(events)) {
+        releaseEvent(from, event);
+        to->m_eventItems.insert(event, eventTargets.value(event));
+    }
+    return UA_STATUSCODE_GOOD;
+}
+
+void Open62541AsyncBackend::connectToEndpoint(const QUrl &url)
+{
+    connectToAnyEndpoint({url});
+}
+
+void Open62541AsyncBackend::connectToAnyEndpoint(QVector<QUrl> urls)
+{
+    // Selecting the server and connecting to it share one deadline
+    const QDeadlineTimer deadline(connectTimeout());
+    const int selected = selectEndpoint(urls, deadline);
+    if (connectCanceled()) {
+        emit stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::NoError);
+        return;
+    }
+    if (selected < 0) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "None of the servers" << urls << "answered within" << connectTimeout() << "ms";
+        emit stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::UnknownError);
+        return;
+    }
+    if (urls.size() > 1)
+        emit endpointSelected(urls.at(selected));
+
+    m_uaclient = UA_Client_new(UA_ClientConfig_default);
+    m_endpointUrl = urls.at(selected);
+    m_candidateUrls = urls;
+    m_reconnectAttempts = 0;
+    UA_StatusCode ret = deadline.hasExpired() ? UA_STATUSCODE_BADTIMEOUT
+                                              : connectClient(m_uaclient, m_endpointUrl, int(qMax<qint64>(1, deadline.remainingTime())));
+
+    if (ret != UA_STATUSCODE_GOOD) {
+        UA_Client_delete(m_uaclient);
+        m_uaclient = nullptr;
+        QOpcUaClient::ClientError error = ret == UA_STATUSCODE_BADUSERACCESSDENIED ? QOpcUaClient::AccessDenied : QOpcUaClient::UnknownError;
+        if (connectCanceled())
+            error = QOpcUaClient::NoError;
+        emit m_clientImpl->stateAndOrErrorChanged(QOpcUaClient::Disconnected, error);
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541, "Open62541: Failed to connect.");
+        return;
+    }
+
+    if (connectCanceled()) {
+        UA_Client_disconnect(m_uaclient);
+        UA_Client_delete(m_uaclient);
+        m_uaclient = nullptr;
+        emit stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::NoError);
+        return;
+    }
+
+    if (!m_subscriptionTimer) {
+        m_subscriptionTimer = new QTimer(this);
+        m_subscriptionTimer->setInterval(5000);
+        QObject::connect(m_subscriptionTimer, &QTimer::timeout,
+                         this, &Open62541AsyncBackend::updatePublishSubscriptionRequests);
+        m_reconnectTimer = new QTimer(this);
+        m_reconnectTimer->setSingleShot(true);
+        QObject::connect(m_reconnectTimer, &QTimer::timeout, this, &Open62541AsyncBackend::retryConnection);
+        m_standbyTimer = new QTimer(this);
+        m_standbyTimer->setInterval(StandbyInterval);
+        QObject::connect(m_standbyTimer, &QTimer::timeout, this, &Open62541AsyncBackend::updateStandby);
+    }
+    m_standbyTimer->start();
+    restoreDetachedSubscriptions();
+    emit stateAndOrErrorChanged(QOpcUaClient::Connected, QOpcUaClient::NoError);
+}
+
+UA_StatusCode Open62541AsyncBackend::connectClient(UA_Client *client, const QUrl &url, int timeout)
+{
+    // The timeout only applies to the connect, later requests use the default timeout
+    UA_ClientConfig *config = UA_Client_getConfig(client);
+    config->timeout = timeout;
+
+    UA_StatusCode ret;
+    if (url.userName().length()) {
+        QUrl temp = url;
+        const QString userName = temp.userName();
+        const QString password = temp.password();
+        temp.setPassword(QString());
+        temp.setUserName(QString());
+        ret = UA_Client_connect_username(client, temp.toString().toUtf8().constData(), userName.toUtf8().constData(), password.toUtf8().constData());
+    } else {
+        ret = UA_Client_connect(client, url.toString().toUtf8().constData());
+    }
+
+    config->timeout = UA_ClientConfig_default.timeout;
+    return ret;
+}
+
+int Open62541AsyncBackend::connectTimeout() const
+{
+    const int timeout = m_clientImpl->m_connectTimeout.load();
+    return timeout > 0 ? timeout : int(UA_ClientConfig_default.timeout);
+}
+
+bool Open62541AsyncBackend::connectCanceled() const
+{
+    return m_clientImpl->m_connectCanceled.load() != 0;
+}
+
+// The outcome of the GetEndpoints requests, it is shared with the probes because
+// they may still be running when the connect has moved on to the selected server.
+struct QOpen62541EndpointProbe
+{
+    QMutex mutex;
+    QWaitCondition answered;
+    int pending = 0;
+    int selected = -1;
+};
+
+class QOpen62541EndpointProbeTask : public QRunnable
+{
+public:
+    QOpen62541EndpointProbeTask(const QSharedPointer<QOpen62541EndpointProbe> &probe, int index,
+                                const QByteArray &url, int timeout)
+        : m_probe(probe)
+        , m_index(index)
+        , m_url(url)
+        , m_timeout(timeout)
+    {}
+
+    void run() override
+    {
+        UA_ClientConfig config = UA_ClientConfig_default;
+        config.timeout = m_timeout;
+        UA_Client *client = UA_Client_new(config);
+
+        size_t endpointsSize = 0;
+        UA_EndpointDescription *endpoints = nullptr;
+        const UA_StatusCode ret = UA_Client_getEndpoints(client, m_url.constData(), &endpointsSize, &endpoints);
+        UA_Array_delete(endpoints, endpointsSize, &UA_TYPES[UA_TYPES_ENDPOINTDESCRIPTION]);
+        UA_Client_delete(client);
+
+        QMutexLocker locker(&m_probe->mutex);
+        --m_probe->pending;
+        if (ret == UA_STATUSCODE_GOOD && endpointsSize > 0 && m_probe->selected < 0)
+            m_probe->selected = m_index;
+        m_probe->answered.wakeAll();
+    }
+
+private:
+    QSharedPointer<QOpen62541EndpointProbe> m_probe;
+    int m_index;
+    QByteArray m_url;
+    int m_timeout;
+};
+
+// Asks all candidates for their endpoints in parallel and returns the index of the
+// first one which answered, or -1 if none answered before the deadline.
+int Open62541AsyncBackend::selectEndpoint(const QVector<QUrl> &urls, const QDeadlineTimer &deadline)
+{
+    if (urls.size() == 1)
+        return 0;
+
+    const int timeout = int(deadline.remainingTime());
+    QSharedPointer<QOpen62541EndpointProbe> probe(new QOpen62541EndpointProbe);
+    probe->pending = urls.size();
+    m_probePool->setMaxThreadCount(qMax(m_probePool->maxThreadCount(), urls.size()));
+    for (int i = 0; i < urls.size(); ++i) {
+        const QByteArray url = urls.at(i).toString(QUrl::RemoveUserInfo).toUtf8();
+        m_probePool->start(new QOpen62541EndpointProbeTask(probe, i, url, timeout));
+    }
+
+    // Wake up regularly to notice a canceled connect
+    QMutexLocker locker(&probe->mutex);
+    while (probe->selected < 0 && probe->pending > 0 && !deadline.hasExpired() && !connectCanceled())
+        probe->answered.wait(&probe->mutex, qMin<qint64>(50, deadline.remainingTime()));
+    return probe->selected;
+}
+
+bool Open62541AsyncBackend::typedArrays() const
+{
+    return m_clientImpl->m_arrayRepresentation.load() == QOpcUaClient::TypedVector;
+}
+
+QSharedPointer<const QOpen62541TypeDictionary> Open62541AsyncBackend::typeDictionary()
+{
+    if (!m_typeDictionaryLoaded) {
+        m_typeDictionaryLoaded = true;
+        m_typeDictionary = loadTypeDictionary();
+    }
+    return m_typeDictionary;
+}
+
+// Browses the references of all nodes with one request, the results are in the order of nodes
+static UA_BrowseResponse browseReferences(UA_Client *client, const QVector<UA_NodeId> &nodes, UA_UInt32 referenceType,
+                                          UA_BrowseDirection direction)
+{
+    UA_BrowseResponse response;
+    UA_BrowseResponse_init(&response);
+    if (nodes.isEmpty())
+        return response;
+
+    QVector<UA_BrowseDescription> descriptions(nodes.size());
+    for (int i = 0; i < nodes.size(); ++i) {
+        UA_BrowseDescription_init(&descriptions[i]);
+        descriptions[i].nodeId = nodes.at(i);
+        descriptions[i].referenceTypeId = UA_NODEID_NUMERIC(0, referenceType);
+        descriptions[i].browseDirection = direction;
+        descriptions[i].includeSubtypes = true;
+    }
+    UA_BrowseRequest request;
+    UA_BrowseRequest_init(&request);
+    Open62541Utils::borrowArray(&request.nodesToBrowseSize, &request.nodesToBrowse, descriptions);
+    return UA_Client_Service_browse(client, request);
+}
+
+// Reads the value attribute of all nodes with one request
+static UA_ReadResponse readValues(UA_Client *client, const QVector<UA_NodeId> &nodes)
+{
+    UA_ReadResponse response;
+    UA_ReadResponse_init(&response);
+    if (nodes.isEmpty())
+        return response;
+
+    QVector<UA_ReadValueId> valueIds(nodes.size());
+    for (int i = 0; i < nodes.size(); ++i) {
+        UA_ReadValueId_init(&valueIds[i]);
+        valueIds[i].nodeId = nodes.at(i);
+        valueIds[i].attributeId = UA_ATTRIBUTEID_VALUE;
+    }
+    UA_ReadRequest request;
+    UA_ReadRequest_init(&request);
+    Open62541Utils::borrowArray(&request.nodesToReadSize, &request.nodesToRead, valueIds);
+    return UA_Client_Service_read(client, request);
+}
+
+static bool hasScalarValue(const UA_ReadResponse &response, size_t index, const UA_DataType *type)
+{
+    return index < response.resultsSize && response.results[index].hasValue
+            && response.results[index].value.type == type && UA_Variant_isScalar(&response.results[index].value);
+}
+
+// Reads the OPC binary type dictionaries of the server and maps the encoding nodes of their
+// structures to the compiled decoders. Needs five service calls, all node ids are borrowed
+// from the responses which are kept until the end.
+QSharedPointer<const QOpen62541TypeDictionary> Open62541AsyncBackend::loadTypeDictionary()
+{
+    QSharedPointer<QOpen62541TypeDictionary> types(new QOpen62541TypeDictionary);
+
+    const QVector<UA_NodeId> typeSystem = { UA_NODEID_NUMERIC(0, UA_NS0ID_OPCBINARYSCHEMA_TYPESYSTEM) };
+    UA_BrowseResponse dictionaryRefs = browseReferences(m_uaclient, typeSystem, UA_NS0ID_HASCOMPONENT,
+                                                        UA_BROWSEDIRECTION_FORWARD);
+    QVector<UA_NodeId> dictionaries;
+    if (dictionaryRefs.resultsSize == 1) {
+        const UA_BrowseResult &result = dictionaryRefs.results[0];
+        for (size_t i = 0; i < result.referencesSize; ++i)
+            dictionaries.append(result.references[i].nodeId.nodeId);
+    }
+
+    UA_ReadResponse dictionaryValues = readValues(m_uaclient, dictionaries);
+    UA_BrowseResponse descriptionRefs = browseReferences(m_uaclient, dictionaries, UA_NS0ID_HASCOMPONENT,
+                                                         UA_BROWSEDIRECTION_FORWARD);
+
+    // Each data type description names a structure in the dictionary it belongs to
+    QVector<UA_NodeId> descriptions;
+    QVector<QString> descriptionNamespaces;
+    for (int i = 0; i < dictionaries.size(); ++i) {
+        if (!hasScalarValue(dictionaryValues, i, &UA_TYPES[UA_TYPES_BYTESTRING]))
+            continue;
+        const UA_ByteString *xml = static_cast<const UA_ByteString *>(dictionaryValues.results[i].value.data);
+        const QString targetNamespace = types->addDictionary(
+                    QByteArray::fromRawData(reinterpret_cast<const char *>(xml->data), static_cast<int>(xml->length)));
+        if (targetNamespace.isNull() || size_t(i) >= descriptionRefs.resultsSize)
+            continue;
+        const UA_BrowseResult &result = descriptionRefs.results[i];
+        for (size_t j = 0; j < result.referencesSize; ++j) {
+            descriptions.append(result.references[j].nodeId.nodeId);
+            descriptionNamespaces.append(targetNamespace);
+        }
+    }
+
+    UA_ReadResponse names = readValues(m_uaclient, descriptions);
+    UA_BrowseResponse encodingRefs = browseReferences(m_uaclient, descriptions, UA_NS0ID_HASDESCRIPTION,
+                                                      UA_BROWSEDIRECTION_INVERSE);
+    for (int i = 0; i < descriptions.size(); ++i) {
+        if (!hasScalarValue(names, i, &UA_TYPES[UA_TYPES_STRING]) || size_t(i) >= encodingRefs.resultsSize)
+            continue;
+        const QString name = QOpen62541ValueConverter::toQString(*static_cast<const UA_String *>(names.results[i].value.data));
+        const UA_BrowseResult &result = encodingRefs.results[i];
+        for (size_t j = 0; j < result.referencesSize; ++j)
+            types->addEncoding(result.references[j].nodeId.nodeId, descriptionNamespaces.at(i), name);
+    }
+    types->compile();
+
+    UA_BrowseResponse_deleteMembers(&encodingRefs);
+    UA_ReadResponse_deleteMembers(&names);
+    UA_BrowseResponse_deleteMembers(&descriptionRefs);
+    UA_ReadResponse_deleteMembers(&dictionaryValues);
+    UA_BrowseResponse_deleteMembers(&dictionaryRefs);
+
+    if (types->isEmpty())
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "The server does not provide a type dictionary for its structures";
+    return types;
+}
+
+// Prepare requests of one event loop iteration are resolved together by resolveMethodArguments()
+void Open62541AsyncBackend::prepareMethod(QString methodId)
+{
+    const auto it = m_methodArguments.constFind(methodId);
+    if (it != m_methodArguments.constEnd()) {
+        emit methodPrepared(methodId, QOpcUa::UaStatusCode::Good, it->inputArguments, it->outputArguments);
+        return;
+    }
+
+    if (m_pendingMethods.contains(methodId))
+        return;
+    if (m_pendingMethods.isEmpty())
+        QMetaObject::invokeMethod(this, [this]() { resolveMethodArguments(); }, Qt::QueuedConnection);
+    m_pendingMethods.push_back(methodId);
+}
+
+// Reads the argument declarations of an InputArguments or OutputArguments property. The
+// Argument structures are usually decoded within extension objects, scalars may be unwrapped.
+static bool toMethodArguments(const UA_Variant &value, QVector<QOpcUaMethodArgument> *target)
+{
+    if (!value.type)
+        return true;
+
+    const size_t count = UA_Variant_isScalar(&value) ? 1 : value.arrayLength;
+    target->reserve(static_cast<int>(count));
+    for (size_t i = 0; i < count; ++i) {
+        const UA_Argument *argument = nullptr;
+        if (value.type == &UA_TYPES[UA_TYPES_ARGUMENT]) {
+            argument = static_cast<const UA_Argument *>(value.data) + i;
+        } else if (value.type == &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]) {
+            const UA_ExtensionObject *object = static_cast<const UA_ExtensionObject *>(value.data) + i;
+            if ((object->encoding == UA_EXTENSIONOBJECT_DECODED || object->encoding == UA_EXTENSIONOBJECT_DECODED_NODELETE)
+                    && object->content.decoded.type == &UA_TYPES[UA_TYPES_ARGUMENT])
+                argument = static_cast<const UA_Argument *>(object->content.decoded.data);
+        }
+        if (!argument)
+            return false;
+
+        QOpcUaMethodArgument declaration;
+        declaration.name = QOpen62541ValueConverter::toQString(argument->name);
+        declaration.type = QOpen62541ValueConverter::dataTypeToQOpcUaType(argument->dataType);
+        declaration.valueRank = argument->valueRank;
+        for (size_t j = 0; j < argument->arrayDimensionsSize; ++j)
+            declaration.arrayDimensions.push_back(argument->arrayDimensions[j]);
+        target->push_back(declaration);
+    }
+    return true;
+}
+
+// Resolves the arguments of all pending methods with one browse for the properties of the
+// methods and one read of their InputArguments and OutputArguments. Methods without these
+// properties have no arguments.
+void Open62541AsyncBackend::resolveMethodArguments()
+{
+    const QStringList methods = m_pendingMethods;
+    m_pendingMethods.clear();
+
+    if (!m_uaclient) {
+        for (const QString &methodId : methods) {
+            emit methodPrepared(methodId, QOpcUa::UaStatusCode::BadServerNotConnected,
+                                QVector<QOpcUaMethodArgument>(), QVector<QOpcUaMethodArgument>());
+        }
+        return;
+    }
+
+    QVector<UA_NodeId> methodNodes;
+    methodNodes.reserve(methods.size());
+    for (const QString &methodId : methods)
+        methodNodes.push_back(Open62541Utils::nodeIdFromQString(methodId));
+
+    UA_BrowseResponse propertyRefs = browseReferences(m_uaclient, methodNodes, UA_NS0ID_HASPROPERTY,
+                                                      UA_BROWSEDIRECTION_FORWARD);
+    QVector<UA_StatusCode> results(methods.size(), propertyRefs.responseHeader.serviceResult);
+
+    // The property node ids are borrowed from the browse response
+    QVector<UA_NodeId> properties;
+    QVector<QVector<QOpcUaMethodArgument> *> targets;
+    QVector<int> propertyMethods;
+    QVector<MethodArguments> arguments(methods.size());
+    for (int i = 0; i < methods.size(); ++i) {
+        if (results.at(i) != UA_STATUSCODE_GOOD)
+            continue;
+        if (size_t(i) >= propertyRefs.resultsSize) {
+            results[i] = UA_STATUSCODE_BADUNEXPECTEDERROR;
+            continue;
+        }
+        const UA_BrowseResult &result = propertyRefs.results[i];
+        results[i] = result.statusCode;
+        for (size_t j = 0; j < result.referencesSize; ++j) {
+            const UA_QualifiedName &browseName = result.references[j].browseName;
+            if (browseName.namespaceIndex != 0)
+                continue;
+            const QString name = QOpen62541ValueConverter::toQString(browseName.name);
+            if (name == QLatin1String("InputArguments"))
+                targets.push_back(&arguments[i].inputArguments);
+            else if (name == QLatin1String("OutputArguments"))
+                targets.push_back(&arguments[i].outputArguments);
+            else
+                continue;
+            properties.push_back(result.references[j].nodeId.nodeId);
+            propertyMethods.push_back(i);
+        }
+    }
+
+    UA_ReadResponse values = readValues(m_uaclient, properties);
+    for (int i = 0; i < properties.size(); ++i) {
+        UA_StatusCode ret = values.responseHeader.serviceResult;
+        if (ret == UA_STATUSCODE_GOOD && size_t(i) >= values.resultsSize)
+            ret = UA_STATUSCODE_BADUNEXPECTEDERROR;
+        else if (ret == UA_STATUSCODE_GOOD && values.results[i].hasStatus)
+            ret = values.results[i].status;
+        if (ret == UA_STATUSCODE_GOOD && !toMethodArguments(values.results[i].value, targets.at(i)))
+            ret = UA_STATUSCODE_BADTYPEMISMATCH;
+        UA_StatusCode &methodResult = results[propertyMethods.at(i)];
+        if (methodResult == UA_STATUSCODE_GOOD)
+            methodResult = ret;
+    }
+
+    for (int i = 0; i < methods.size(); ++i) {
+        if (results.at(i) == UA_STATUSCODE_GOOD) {
+            m_methodArguments.insert(methods.at(i), arguments.at(i));
+            emit methodPrepared(methods.at(i), QOpcUa::UaStatusCode::Good,
+                                arguments.at(i).inputArguments, arguments.at(i).outputArguments);
+        } else {
+            emit methodPrepared(methods.at(i), static_cast<QOpcUa::UaStatusCode>(results.at(i)),
+                                QVector<QOpcUaMethodArgument>(), QVector<QOpcUaMethodArgument>());
+        }
+    }
+
+    checkConnection(propertyRefs.responseHeader.serviceResult);
+    UA_ReadResponse_deleteMembers(&values);
+    UA_BrowseResponse_deleteMembers(&propertyRefs);
+    for (UA_NodeId &nodeId : methodNodes)
+        UA_NodeId_deleteMembers(&nodeId);
+}
+
+void Open62541AsyncBackend::disconnectFromEndpoint()
+{
+    // A canceled connect has already been reported
+    if (!m_uaclient)
+        return;
+
+    UA_StatusCode ret = UA_Client_disconnect(m_uaclient);
+    if (ret != UA_STATUSCODE_GOOD) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541, "Open62541: Failed to disconnect.");
+        // Fall through intentionally
+    }
+
+    closeSession();
+    emit stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::NoError);
+}
+
+// Releases everything which belongs to the current session. The native subscriptions are
+// kept for the QOpcUaSubscriptions using them, but their server side ids are gone with the
+// session. They are detached until the next connect creates them again.
+void Open62541AsyncBackend::closeSession()
+{
+    UA_Client_delete(m_uaclient);
+    m_uaclient = nullptr;
+    m_pendingAcknowledgements.clear();
+    m_typeDictionary.reset();
+    m_typeDictionaryLoaded = false;
+    m_maximumMethodsPerCallLoaded = false;
+    m_methodArguments.clear();
+    m_stringCache.clear();
+    m_subscriptionTimer->stop();
+    m_reconnectTimer->stop();
+    m_standbyTimer->stop();
+    closeStandby();
+
+    for (QOpen62541NativeSubscription *native : qAsConst(m_subscriptions)) {
+        native->m_subscriptionId = 0;
+        native->m_lastSequenceNumber = 0;
+        m_detachedSubscriptions.push_back(native);
+    }
+    m_subscriptions.clear();
+}
+
+// Recreates the native subscriptions detached by closeSession() in the new session.
+// Subscriptions which could not be created stay detached for the next attempt.
+void Open62541AsyncBackend::restoreDetachedSubscriptions()
+{
+    const QVector<QOpen62541NativeSubscription *> detached = m_detachedSubscriptions;
+    m_detachedSubscriptions.clear();
+    for (QOpen62541NativeSubscription *native : detached)
+        recreateSubscription(native);
+    updatePublishTimer();
+}
+
+void Open62541AsyncBackend::updatePublishSubscriptionRequests()
+{
+    if (!m_uaclient || m_subscriptions.isEmpty())
+        return;
+
+    // Each publish response carries the notifications of a single subscription,
+    // send at least one request per subscription and drain the server side queue.
+    int remaining = m_subscriptions.size();
+    bool moreNotifications = false;
+    while (remaining-- > 0 || moreNotifications) {
+        UA_PublishRequest req;
+        UA_PublishRequest_init(&req);
+        Open62541Utils::borrowArray(&req.subscriptionAcknowledgementsSize, &req.subscriptionAcknowledgements, m_pendingAcknowledgements);
+
+        UA_PublishResponse res;
+        UA_PublishResponse_init(&res);
+        __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_PUBLISHREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_PUBLISHRESPONSE]);
+
+        const UA_StatusCode serviceResult = res.responseHeader.serviceResult;
+        if (serviceResult != UA_STATUSCODE_GOOD) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Publish failed:" << static_cast<QOpcUa::UaStatusCode>(serviceResult);
+            UA_PublishResponse_deleteMembers(&res);
+            if (isConnectionError(serviceResult))
+                handleConnectionLost();
+            return;
+        }
+        m_pendingAcknowledgements.clear();
+
+        QOpen62541NativeSubscription *native = m_subscriptions.value(res.subscriptionId, nullptr);
+        if (native)
+            handleNotificationMessage(native, res.notificationMessage);
+
+        moreNotifications = res.moreNotifications;
+        UA_PublishResponse_deleteMembers(&res);
+    }
+
+    // Close the aggregation windows of values which did not change in this cycle
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (const QOpen62541NativeSubscription *native : qAsConst(m_subscriptions)) {
+        for (auto it = native->m_valueItems.constBegin(); it != native->m_valueItems.constEnd(); ++it)
+            it.key()->d_func()->flushAggregation(now);
+    }
+}
+
+// Returns true if a data change or event of the message contains a structure which has to be decoded
+static bool hasEncodedStructure(const UA_NotificationMessage &message)
+{
+    for (size_t i = 0; i < message.notificationDataSize; ++i) {
+        const UA_ExtensionObject &data = message.notificationData[i];
+        if (data.encoding != UA_EXTENSIONOBJECT_DECODED && data.encoding != UA_EXTENSIONOBJECT_DECODED_NODELETE)
+            continue;
+
+        if (data.content.decoded.type == &UA_TYPES[UA_TYPES_DATACHANGENOTIFICATION]) {
+            const UA_DataChangeNotification *notification = static_cast<const UA_DataChangeNotification *>(data.content.decoded.data);
+            for (size_t j = 0; j < notification->monitoredItemsSize; ++j) {
+                if (QOpen62541ValueConverter::hasEncodedStructure(notification->monitoredItems[j].value.value))
+                    return true;
+            }
+        } else if (data.content.decoded.type == &UA_TYPES[UA_TYPES_EVENTNOTIFICATIONLIST]) {
+            const UA_EventNotificationList *notification = static_cast<const UA_EventNotificationList *>(data.content.decoded.data);
+            for (size_t j = 0; j < notification->eventsSize; ++j) {
+                for (size_t k = 0; k < notification->events[j].eventFieldsSize; ++k) {
+                    if (QOpen62541ValueConverter::hasEncodedStructure(notification->events[j].eventFields[k]))
+                        return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void Open62541AsyncBackend::handleNotificationMessage(QOpen62541NativeSubscription *native,
+                                                      const UA_NotificationMessage &message)
+{
+    // Structures are decoded with the type dictionary of the server, it is loaded on first use
+    if (!m_typeDictionaryLoaded && hasEncodedStructure(message))
+        typeDictionary();
+    m_stringCache.setCapacity(m_clientImpl->m_stringCacheSize.load());
+    native->processNotificationMessage(message, typedArrays(), m_typeDictionary.data(),
+                                       m_stringCache.capacity() ? &m_stringCache : nullptr);
+
+    // Keep alive messages do not consume a sequence number and must not be acknowledged
+    if (message.notificationDataSize > 0) {
+        native->m_lastSequenceNumber = message.sequenceNumber;
+        UA_SubscriptionAcknowledgement ack;
+        ack.subscriptionId = native->m_subscriptionId;
+        ack.sequenceNumber = message.sequenceNumber;
+        m_pendingAcknowledgements.push_back(ack);
+    }
+}
+
+// Exponential backoff, a random part of the delay is cut off so clients which
+// lost the connection at the same time do not reconnect in lockstep.
+static int reconnectDelay(const QOpcUaReconnectPolicy &policy, int attempt)
+{
+    const double maximumDelay = qMax(policy.initialDelay, policy.maximumDelay);
+    double delay = qMax(0, policy.initialDelay) * std::pow(qMax(1.0, policy.backoffFactor), attempt);
+    delay = qMin(delay, maximumDelay);
+    delay *= 1.0 - qBound(0.0, policy.jitter, 1.0) * QRandomGenerator::global()->generateDouble();
+    return int(delay);
+}
+
+// Called when a service failed because the connection to the server is gone. Without
+// a reconnect policy a single attempt is made at once, otherwise the attempts are
+// scheduled on the reconnect timer and the client is Reconnecting in the meantime.
+void Open62541AsyncBackend::handleConnectionLost()
+{
+    if (m_reconnectTimer->isActive())
+        return;
+
+    qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Connection lost, trying to recover" << m_subscriptions.size() << "subscriptions";
+    m_subscriptionTimer->stop();
+    m_reconnectAttempts = 0;
+
+    if (m_standbyClient && failover())
+        return;
+
+    const QOpcUaReconnectPolicy policy = m_clientImpl->reconnectPolicy();
+    if (!policy.enabled) {
+        if (reconnect())
+            updatePublishTimer();
+        else
+            closeLostConnection();
+        return;
+    }
+
+    emit stateAndOrErrorChanged(QOpcUaClient::Reconnecting, QOpcUaClient::NoError);
+    m_reconnectTimer->start(reconnectDelay(policy, 0));
+}
+
+// Services outside of the publish cycle only detect a lost connection if a reconnect policy is set
+void Open62541AsyncBackend::checkConnection(UA_StatusCode serviceResult)
+{
+    if (isConnectionError(serviceResult) && m_clientImpl->reconnectPolicy().enabled)
+        handleConnectionLost();
+}
+
+void Open62541AsyncBackend::retryConnection()
+{
+    ++m_reconnectAttempts;
+    if (reconnect()) {
+        m_reconnectAttempts = 0;
+        updatePublishTimer();
+        emit stateAndOrErrorChanged(QOpcUaClient::Connected, QOpcUaClient::NoError);
+        return;
+    }
+
+    const QOpcUaReconnectPolicy policy = m_clientImpl->reconnectPolicy();
+    if (!policy.enabled || (policy.maximumAttempts > 0 && m_reconnectAttempts >= policy.maximumAttempts)) {
+        closeLostConnection();
+        return;
+    }
+    m_reconnectTimer->start(reconnectDelay(policy, m_reconnectAttempts));
+}
+
+bool Open62541AsyncBackend::reconnect()
+{
+    // UA_Client_connect opens a new secure channel and reactivates the existing session
+    // of the client on it. A new session is only created if the server has discarded it.
+    const UA_StatusCode ret = connectClient(m_uaclient, m_endpointUrl, connectTimeout());
+    if (ret != UA_STATUSCODE_GOOD) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Reconnect failed:" << static_cast<QOpcUa::UaStatusCode>(ret);
+        return false;
+    }
+
+    recoverSubscriptions();
+    return true;
+}
+
+// Gives up on a lost connection after the reconnect policy has been exhausted
+void Open62541AsyncBackend::closeLostConnection()
+{
+    closeSession();
+    emit stateAndOrErrorChanged(QOpcUaClient::Disconnected, QOpcUaClient::UnknownError);
+}
+
+// Restores the subscriptions after the session has been reactivated or recreated.
+// Subscriptions which did not survive in the session are transferred, missed
+// notifications are fetched with Republish. Only subscriptions which can not be
+// transferred are recreated.
+void Open62541AsyncBackend::recoverSubscriptions()
+{
+    // The acknowledgements of the lost publish request are resent after the recovery
+    const QVector<UA_SubscriptionAcknowledgement> acknowledgements = m_pendingAcknowledgements;
+    m_pendingAcknowledgements.clear();
+
+    QVector<QOpen62541NativeSubscription *> lost;
+    for (QOpen62541NativeSubscription *native : qAsConst(m_subscriptions)) {
+        if (republish(native, MaximumRetransmissions) == UA_STATUSCODE_BADSUBSCRIPTIONIDINVALID)
+            lost.push_back(native);
+    }
+
+    if (!lost.isEmpty()) {
+        QVector<UA_UInt32> ids;
+        ids.reserve(lost.size());
+        for (const QOpen62541NativeSubscription *native : qAsConst(lost))
+            ids.push_back(native->m_subscriptionId);
+
+        UA_TransferSubscriptionsRequest req;
+        UA_TransferSubscriptionsRequest_init(&req);
+        Open62541Utils::borrowArray(&req.subscriptionIdsSize, &req.subscriptionIds, ids);
+        req.sendInitialValues = false;
+
+        UA_TransferSubscriptionsResponse res;
+        UA_TransferSubscriptionsResponse_init(&res);
+        __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_TRANSFERSUBSCRIPTIONSREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_TRANSFERSUBSCRIPTIONSRESPONSE]);
+
+        for (int i = 0; i < lost.size(); ++i) {
+            UA_StatusCode result = res.responseHeader.serviceResult;
+            if (result == UA_STATUSCODE_GOOD)
+                result = size_t(i) < res.resultsSize ? res.results[i].statusCode : UA_STATUSCODE_BADUNEXPECTEDERROR;
+
+            if (result == UA_STATUSCODE_GOOD) {
+                // The transfer result lists the sequence numbers which are still available
+                const size_t available = res.results[i].availableSequenceNumbersSize;
+                republish(lost.at(i), available ? int(qMin<size_t>(available, MaximumRetransmissions)) : 0);
+            } else {
+                qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not transfer subscription" << lost.at(i)->m_subscriptionId
+                                                      << static_cast<QOpcUa::UaStatusCode>(result) << "recreating it";
+                recreateSubscription(lost.at(i));
+            }
+        }
+        UA_TransferSubscriptionsResponse_deleteMembers(&res);
+    }
+
+    // Items and subscriptions which could not be created after an earlier loss
+    for (QOpen62541NativeSubscription *native : qAsConst(m_subscriptions))
+        createPendingItems(native);
+    restoreDetachedSubscriptions();
+
+    for (const UA_SubscriptionAcknowledgement &ack : acknowledgements) {
+        if (m_subscriptions.contains(ack.subscriptionId))
+            m_pendingAcknowledgements.push_back(ack);
+    }
+}
+
+// Fetches up to maximumMessages notifications sent after the last processed sequence
+// number from the retransmission queue of the server.
+UA_StatusCode Open62541AsyncBackend::republish(QOpen62541NativeSubscription *native, int maximumMessages)
+{
+    for (int i = 0; i < maximumMessages; ++i) {
+        UA_RepublishRequest req;
+        UA_RepublishRequest_init(&req);
+        req.subscriptionId = native->m_subscriptionId;
+        req.retransmitSequenceNumber = nextSequenceNumber(native->m_lastSequenceNumber);
+
+        UA_RepublishResponse res;
+        UA_RepublishResponse_init(&res);
+        __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_REPUBLISHREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_REPUBLISHRESPONSE]);
+
+        const UA_StatusCode ret = res.responseHeader.serviceResult;
+        // Only a message with the requested sequence number advances the last one, anything
+        // else would make the next request ask for the same message again
+        const bool retransmitted = ret == UA_STATUSCODE_GOOD && res.notificationMessage.notificationDataSize > 0
+                && res.notificationMessage.sequenceNumber == req.retransmitSequenceNumber;
+        if (retransmitted)
+            handleNotificationMessage(native, res.notificationMessage);
+        UA_RepublishResponse_deleteMembers(&res);
+
+        if (ret != UA_STATUSCODE_GOOD) {
+            // BadMessageNotAvailable marks the end of the retransmission queue
+            return ret == UA_STATUSCODE_BADMESSAGENOTAVAILABLE ? UA_STATUSCODE_GOOD : ret;
+        }
+        if (!retransmitted)
+            return UA_STATUSCODE_GOOD;
+    }
+    return UA_STATUSCODE_GOOD;
+}
+
+// Creates a new subscription on the server and all its monitored items in a single
+// service call. The client handles are kept, so the monitored values stay valid.
+// A subscription which can not be created is detached until the next reconnect.
+void Open62541AsyncBackend::recreateSubscription(QOpen62541NativeSubscription *native)
+{
+    m_subscriptions.remove(native->m_subscriptionId);
+    native->m_subscriptionId = 0;
+    native->m_lastSequenceNumber = 0;
+    for (QOpen62541MonitoredItem *item : qAsConst(native->m_items))
+        item->monitoredItemId = 0;
+
+    const UA_StatusCode ret = createNativeSubscription(native);
+    if (ret != UA_STATUSCODE_GOOD) {
+        for (const QOpen62541MonitoredItem *item : qAsConst(native->m_items))
+            reportItemStatus(item, ret);
+        if (!m_detachedSubscriptions.contains(native))
+            m_detachedSubscriptions.push_back(native);
+        return;
+    }
+
+    createPendingItems(native);
+}
+
+// Creates the items of native which do not exist on the server yet. Items which fail are
+// kept with monitored item id 0 and tried again on the next reconnect.
+void Open62541AsyncBackend::createPendingItems(QOpen62541NativeSubscription *native)
+{
+    QVector<QOpen62541MonitoredItem *> pending;
+    for (QOpen62541MonitoredItem *item : qAsConst(native->m_items)) {
+        if (!item->monitoredItemId)
+            pending.push_back(item);
+    }
+    if (pending.isEmpty())
+        return;
+
+    QVector<UA_StatusCode> results;
+    createMonitoredItems(native, pending, &results);
+    for (int i = 0; i < pending.size(); ++i) {
+        reportItemStatus(pending.at(i), results.at(i));
+        if (results.at(i) != UA_STATUSCODE_GOOD)
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not recreate monitored item for node" << pending.at(i)->nodeId
+                                                  << static_cast<QOpcUa::UaStatusCode>(results.at(i));
+    }
+    restoreTriggeringLinks(native, pending);
+}
+
+// Keeps the hot standby session in sync with the subscriptions of the current session
+void Open62541AsyncBackend::updateStandby()
+{
+    if (!m_uaclient || m_reconnectTimer->isActive())
+        return;
+
+    if (!m_clientImpl->m_hotStandby.load()) {
+        closeStandby();
+        return;
+    }
+
+    if (!m_standbyClient && !connectStandby())
+        return;
+
+    keepStandbyAlive();
+    if (!m_standbyClient)
+        return;
+
+    for (QOpen62541NativeSubscription *native : qAsConst(m_subscriptions))
+        syncStandbySubscription(native, &m_standbySubscriptions[native]);
+    reportStandby(m_standbyUrl);
+}
+
+// The other candidates of connectToAnyEndpoint() and the servers of a non-transparent
+// redundant server set. The set lists application URIs which are resolved with FindServers.
+QVector<QUrl> Open62541AsyncBackend::standbyCandidates()
+{
+    QVector<QUrl> candidates;
+    for (const QUrl &url : qAsConst(m_candidateUrls)) {
+        if (url != m_endpointUrl)
+            candidates.push_back(url);
+    }
+
+    UA_Variant serverUris;
+    UA_Variant_init(&serverUris);
+    UA_StatusCode ret = UA_Client_readValueAttribute(m_uaclient, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERREDUNDANCY_SERVERURIARRAY),
+                                                     &serverUris);
+    if (ret != UA_STATUSCODE_GOOD || serverUris.type != &UA_TYPES[UA_TYPES_STRING] || !serverUris.arrayLength) {
+        UA_Variant_deleteMembers(&serverUris);
+        return candidates;
+    }
+
+    // FindServers is sent on a connection of its own, the session of the client is not touched
+    UA_ClientConfig config = UA_ClientConfig_default;
+    config.timeout = connectTimeout();
+    UA_Client *discoveryClient = UA_Client_new(config);
+    size_t serversSize = 0;
+    UA_ApplicationDescription *servers = nullptr;
+    ret = UA_Client_findServers(discoveryClient, m_endpointUrl.toString(QUrl::RemoveUserInfo).toUtf8().constData(),
+                                serverUris.arrayLength, static_cast<UA_String *>(serverUris.data), 0, nullptr,
+                                &serversSize, &servers);
+    if (ret == UA_STATUSCODE_GOOD) {
+        for (size_t i = 0; i < serversSize; ++i) {
+            for (size_t j = 0; j < servers[i].discoveryUrlsSize; ++j) {
+                QUrl url(QOpen62541ValueConverter::toQString(servers[i].discoveryUrls[j]));
+                url.setUserName(m_endpointUrl.userName());
+                url.setPassword(m_endpointUrl.password());
+                if (url.scheme() == QLatin1String("opc.tcp") && url != m_endpointUrl && !candidates.contains(url))
+                    candidates.push_back(url);
+            }
+        }
+    } else {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not resolve the redundant servers:" << static_cast<QOpcUa::UaStatusCode>(ret);
+    }
+    UA_Array_delete(servers, serversSize, &UA_TYPES[UA_TYPES_APPLICATIONDESCRIPTION]);
+    UA_Client_delete(discoveryClient);
+    UA_Variant_deleteMembers(&serverUris);
+    return candidates;
+}
+
+bool Open62541AsyncBackend::connectStandby()
+{
+    if (!m_standbyRetry.hasExpired())
+        return false;
+
+    const QVector<QUrl> candidates = standbyCandidates();
+    for (const QUrl &url : candidates) {
+        UA_Client *client = UA_Client_new(UA_ClientConfig_default);
+        const UA_StatusCode ret = connectClient(client, url, connectTimeout());
+        if (ret == UA_STATUSCODE_GOOD) {
+            m_standbyClient = client;
+            m_standbyUrl = url;
+            m_standbySubscriptions.clear();
+            return true;
+        }
+        UA_Client_delete(client);
+    }
+
+    if (!candidates.isEmpty())
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "None of the" << candidates.size() << "standby servers could be reached";
+    m_standbyRetry.setRemainingTime(StandbyRetryInterval);
+    return false;
+}
+
+// Creates the subscription and the missing items on the standby server, publishing and
+// monitoring stay disabled until a failover. Items whose parameters changed are recreated.
+void Open62541AsyncBackend::syncStandbySubscription(QOpen62541NativeSubscription *native, StandbySubscription *standby)
+{
+    if (!standby->subscriptionId) {
+        const QOpcUaSubscriptionParameters &parameters = native->m_requestedParameters;
+        UA_CreateSubscriptionRequest req;
+        UA_CreateSubscriptionRequest_init(&req);
+        req.requestedPublishingInterval = parameters.publishingInterval;
+        req.requestedLifetimeCount = standbyLifetimeCount(parameters);
+        req.requestedMaxKeepAliveCount = parameters.maxKeepAliveCount;
+        req.maxNotificationsPerPublish = parameters.maxNotificationsPerPublish;
+        req.publishingEnabled = false;
+        req.priority = parameters.priority;
+
+        UA_CreateSubscriptionResponse res;
+        UA_CreateSubscriptionResponse_init(&res);
+        __UA_Client_Service(m_standbyClient, &req, &UA_TYPES[UA_TYPES_CREATESUBSCRIPTIONREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_CREATESUBSCRIPTIONRESPONSE]);
+        const UA_StatusCode ret = res.responseHeader.serviceResult;
+        if (ret == UA_STATUSCODE_GOOD)
+            standby->subscriptionId = res.subscriptionId;
+        UA_CreateSubscriptionResponse_deleteMembers(&res);
+        if (ret != UA_STATUSCODE_GOOD) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not create standby subscription:" << static_cast<QOpcUa::UaStatusCode>(ret);
+            return;
+        }
+    }
+
+    QVector<UA_UInt32> obsolete;
+    for (auto it = standby->monitoredItemIds.begin(); it != standby->monitoredItemIds.end();) {
+        const QOpen62541MonitoredItem *item = native->m_items.value(it.key(), nullptr);
+        if (item && item->revision == standby->revisions.value(it.key())) {
+            ++it;
+            continue;
+        }
+        obsolete.push_back(it.value());
+        standby->revisions.remove(it.key());
+        it = standby->monitoredItemIds.erase(it);
+    }
+
+    if (!obsolete.isEmpty()) {
+        UA_DeleteMonitoredItemsRequest req;
+        UA_DeleteMonitoredItemsRequest_init(&req);
+        req.subscriptionId = standby->subscriptionId;
+        Open62541Utils::borrowArray(&req.monitoredItemIdsSize, &req.monitoredItemIds, obsolete);
+
+        UA_DeleteMonitoredItemsResponse res;
+        UA_DeleteMonitoredItemsResponse_init(&res);
+        __UA_Client_Service(m_standbyClient, &req, &UA_TYPES[UA_TYPES_DELETEMONITOREDITEMSREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_DELETEMONITOREDITEMSRESPONSE]);
+        UA_DeleteMonitoredItemsResponse_deleteMembers(&res);
+    }
+
+    QVector<const QOpen62541MonitoredItem *> missing;
+    for (const QOpen62541MonitoredItem *item : qAsConst(native->m_items)) {
+        if (!standby->monitoredItemIds.contains(item->clientHandle))
+            missing.push_back(item);
+    }
+    if (missing.isEmpty())
+        return;
+
+    UA_CreateMonitoredItemsRequest req;
+    UA_CreateMonitoredItemsRequest_init(&req);
+    req.subscriptionId = standby->subscriptionId;
+    req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+    req.itemsToCreate = static_cast<UA_MonitoredItemCreateRequest *>(
+                UA_Array_new(missing.size(), &UA_TYPES[UA_TYPES_MONITOREDITEMCREATEREQUEST]));
+    req.itemsToCreateSize = missing.size();
+    for (int i = 0; i < missing.size(); ++i) {
+        toUaItemCreateRequest(missing.at(i), &req.itemsToCreate[i]);
+        req.itemsToCreate[i].monitoringMode = UA_MONITORINGMODE_DISABLED;
+    }
+
+    UA_CreateMonitoredItemsResponse res;
+    UA_CreateMonitoredItemsResponse_init(&res);
+    __UA_Client_Service(m_standbyClient, &req, &UA_TYPES[UA_TYPES_CREATEMONITOREDITEMSREQUEST],
+                        &res, &UA_TYPES[UA_TYPES_CREATEMONITOREDITEMSRESPONSE]);
+
+    QSet<UA_UInt32> created;
+    for (int i = 0; i < missing.size(); ++i) {
+        UA_StatusCode ret = res.responseHeader.serviceResult;
+        if (ret == UA_STATUSCODE_GOOD)
+            ret = size_t(i) < res.resultsSize ? res.results[i].statusCode : UA_STATUSCODE_BADUNEXPECTEDERROR;
+        if (ret != UA_STATUSCODE_GOOD) {
+            // Tried again with the next sync, the item is created after a failover if it still fails
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not mirror monitored item for node" << missing.at(i)->nodeId
+                                                  << "on the standby server" << static_cast<QOpcUa::UaStatusCode>(ret);
+            continue;
+        }
+        standby->monitoredItemIds.insert(missing.at(i)->clientHandle, res.results[i].monitoredItemId);
+        standby->revisions.insert(missing.at(i)->clientHandle, missing.at(i)->revision);
+        created.insert(missing.at(i)->clientHandle);
+    }
+
+    UA_CreateMonitoredItemsRequest_deleteMembers(&req);
+    UA_CreateMonitoredItemsResponse_deleteMembers(&res);
+
+    // The links take effect with the monitoring modes set by failover()
+    if (!created.isEmpty())
+        restoreTriggeringLinks(m_standbyClient, standby->subscriptionId, native, standby->monitoredItemIds, created);
+}
+
+void Open62541AsyncBackend::removeStandbySubscription(QOpen62541NativeSubscription *native)
+{
+    const auto it = m_standbySubscriptions.find(native);
+    if (it == m_standbySubscriptions.end())
+        return;
+
+    UA_UInt32 subscriptionId = it->subscriptionId;
+    m_standbySubscriptions.erase(it);
+    if (!m_standbyClient || !subscriptionId)
+        return;
+
+    UA_DeleteSubscriptionsRequest req;
+    UA_DeleteSubscriptionsRequest_init(&req);
+    Open62541Utils::borrowArray(&req.subscriptionIdsSize, &req.subscriptionIds, &subscriptionId);
+
+    UA_DeleteSubscriptionsResponse res;
+    UA_DeleteSubscriptionsResponse_init(&res);
+    __UA_Client_Service(m_standbyClient, &req, &UA_TYPES[UA_TYPES_DELETESUBSCRIPTIONSREQUEST],
+                        &res, &UA_TYPES[UA_TYPES_DELETESUBSCRIPTIONSRESPONSE]);
+    UA_DeleteSubscriptionsResponse_deleteMembers(&res);
+}
+
+// Publish requests would block until the next publishing cycle of the standby server, so
+// none are sent. Reading the ServiceLevel keeps the session alive and SetPublishingMode
+// resets the lifetime counters of the subscriptions, both are answered at once.
+void Open62541AsyncBackend::keepStandbyAlive()
+{
+    UA_Variant serviceLevel;
+    UA_Variant_init(&serviceLevel);
+    UA_StatusCode ret = UA_Client_readValueAttribute(m_standbyClient, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVICELEVEL),
+                                                     &serviceLevel);
+    UA_Variant_deleteMembers(&serviceLevel);
+    if (isConnectionError(ret)) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Lost the standby session on" << m_standbyUrl.toString(QUrl::RemoveUserInfo);
+        closeStandby();
+        return;
+    }
+
+    QVector<QOpen62541NativeSubscription *> natives;
+    QVector<UA_UInt32> standbyIds;
+    for (auto it = m_standbySubscriptions.cbegin(); it != m_standbySubscriptions.cend(); ++it) {
+        if (it->subscriptionId) {
+            natives.push_back(it.key());
+            standbyIds.push_back(it->subscriptionId);
+        }
+    }
+    if (standbyIds.isEmpty())
+        return;
+
+    UA_SetPublishingModeRequest req;
+    UA_SetPublishingModeRequest_init(&req);
+    req.publishingEnabled = false;
+    Open62541Utils::borrowArray(&req.subscriptionIdsSize, &req.subscriptionIds, standbyIds);
+
+    UA_SetPublishingModeResponse res;
+    UA_SetPublishingModeResponse_init(&res);
+    __UA_Client_Service(m_standbyClient, &req, &UA_TYPES[UA_TYPES_SETPUBLISHINGMODEREQUEST],
+                        &res, &UA_TYPES[UA_TYPES_SETPUBLISHINGMODERESPONSE]);
+    if (res.responseHeader.serviceResult == UA_STATUSCODE_GOOD) {
+        // Expired subscriptions are created again by the next sync
+        for (int i = 0; i < natives.size() && size_t(i) < res.resultsSize; ++i) {
+            if (res.results[i] == UA_STATUSCODE_BADSUBSCRIPTIONIDINVALID)
+                m_standbySubscriptions.remove(natives.at(i));
+        }
+    }
+    UA_SetPublishingModeResponse_deleteMembers(&res);
+}
+
+// Switches to the standby session after the connection to the current server has been lost.
+// Publishing is enabled for all standby subscriptions with one request, the items get the
+// monitoring mode they have in the current session. Only items the standby server did not
+// accept are created after the switch.
+bool Open62541AsyncBackend::failover()
+{
+    qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Switching to the standby server" << m_standbyUrl.toString(QUrl::RemoveUserInfo);
+
+    // Catches up on the changes since the last update of the standby, outdated items are
+    // deleted and replaced with items with the current parameters
+    for (QOpen62541NativeSubscription *native : qAsConst(m_subscriptions))
+        syncStandbySubscription(native, &m_standbySubscriptions[native]);
+
+    QVector<UA_UInt32> standbyIds;
+    for (const StandbySubscription &standby : qAsConst(m_standbySubscriptions)) {
+        if (standby.subscriptionId)
+            standbyIds.push_back(standby.subscriptionId);
+    }
+
+    if (!standbyIds.isEmpty()) {
+        UA_SetPublishingModeRequest req;
+        UA_SetPublishingModeRequest_init(&req);
+        req.publishingEnabled = true;
+        Open62541Utils::borrowArray(&req.subscriptionIdsSize, &req.subscriptionIds, standbyIds);
+
+        UA_SetPublishingModeResponse res;
+        UA_SetPublishingModeResponse_init(&res);
+        __UA_Client_Service(m_standbyClient, &req, &UA_TYPES[UA_TYPES_SETPUBLISHINGMODEREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_SETPUBLISHINGMODERESPONSE]);
+        const UA_StatusCode ret = res.responseHeader.serviceResult;
+        UA_SetPublishingModeResponse_deleteMembers(&res);
+        if (ret != UA_STATUSCODE_GOOD) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not enable the standby subscriptions:" << static_cast<QOpcUa::UaStatusCode>(ret);
+            closeStandby();
+            return false;
+        }
+    }
+
+    emit stateAndOrErrorChanged(QOpcUaClient::Reconnecting, QOpcUaClient::NoError);
+
+    UA_Client_delete(m_uaclient);
+    m_uaclient = m_standbyClient;
+    m_standbyClient = nullptr;
+    m_endpointUrl = m_standbyUrl;
+    m_standbyUrl.clear();
+    reportStandby(QUrl());
+    m_pendingAcknowledgements.clear();
+    // The type dictionary and the namespace indexes are not necessarily the same
+    m_typeDictionary.reset();
+    m_typeDictionaryLoaded = false;
+    m_maximumMethodsPerCallLoaded = false;
+    m_methodArguments.clear();
+
+    const QVector<QOpen62541NativeSubscription *> natives = m_subscriptions.values().toVector();
+    m_subscriptions.clear();
+    QVector<QOpen62541NativeSubscription *> notMirrored;
+    for (QOpen62541NativeSubscription *native : natives) {
+        const StandbySubscription standby = m_standbySubscriptions.take(native);
+        if (!standby.subscriptionId) {
+            notMirrored.push_back(native);
+            continue;
+        }
+
+        native->m_subscriptionId = standby.subscriptionId;
+        native->m_lastSequenceNumber = 0;
+        m_subscriptions.insert(native->m_subscriptionId, native);
+
+        // Keyed by the monitoring mode, the items which are not disabled on the standby server
+        QHash<int, QVector<QOpen62541MonitoredItem *>> modeItems;
+        for (QOpen62541MonitoredItem *item : qAsConst(native->m_items)) {
+            const UA_UInt32 standbyItemId = standby.monitoredItemIds.value(item->clientHandle, 0);
+            if (!standbyItemId || standby.revisions.value(item->clientHandle) != item->revision) {
+                // The id belongs to the lost server, the item is created by createPendingItems()
+                item->monitoredItemId = 0;
+                continue;
+            }
+            item->monitoredItemId = standbyItemId;
+            if (item->monitoringMode == QOpcUa::MonitoringMode::Disabled)
+                reportItemStatus(item, UA_STATUSCODE_GOOD);
+            else
+                modeItems[static_cast<int>(item->monitoringMode)].push_back(item);
+        }
+
+        for (auto it = modeItems.cbegin(); it != modeItems.cend(); ++it) {
+            QVector<UA_UInt32> ids;
+            for (const QOpen62541MonitoredItem *item : it.value())
+                ids.push_back(item->monitoredItemId);
+
+            UA_SetMonitoringModeRequest req;
+            UA_SetMonitoringModeRequest_init(&req);
+            req.subscriptionId = native->m_subscriptionId;
+            req.monitoringMode = static_cast<UA_MonitoringMode>(it.key());
+            Open62541Utils::borrowArray(&req.monitoredItemIdsSize, &req.monitoredItemIds, ids);
+
+            UA_SetMonitoringModeResponse res;
+            UA_SetMonitoringModeResponse_init(&res);
+            __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_SETMONITORINGMODEREQUEST],
+                                &res, &UA_TYPES[UA_TYPES_SETMONITORINGMODERESPONSE]);
+
+            // Items which stay disabled do not deliver anything, their monitors are told so
+            QVector<QOpcUa::UaStatusCode> results;
+            const QOpcUa::UaStatusCode serviceResult = copyOperationResults(res.responseHeader, res.results, res.resultsSize,
+                                                                            ids.size(), &results);
+            if (serviceResult != QOpcUa::UaStatusCode::Good)
+                qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not enable the standby items:" << serviceResult;
+            for (int i = 0; i < it.value().size(); ++i)
+                reportItemStatus(it.value().at(i), static_cast<UA_StatusCode>(results.value(i, serviceResult)));
+            UA_SetMonitoringModeResponse_deleteMembers(&res);
+        }
+
+        // Items the standby server did not accept, failures are kept for the next reconnect
+        createPendingItems(native);
+    }
+    m_standbySubscriptions.clear();
+
+    for (QOpen62541NativeSubscription *native : qAsConst(notMirrored))
+        recreateSubscription(native);
+
+    // The standby subscriptions were created with a longer lifetime
+    for (QOpen62541NativeSubscription *native : qAsConst(m_subscriptions)) {
+        const QOpcUaSubscriptionParameters &parameters = native->m_requestedParameters;
+        UA_ModifySubscriptionRequest req;
+        UA_ModifySubscriptionRequest_init(&req);
+        req.subscriptionId = native->m_subscriptionId;
+        req.requestedPublishingInterval = parameters.publishingInterval;
+        req.requestedLifetimeCount = parameters.lifetimeCount;
+        req.requestedMaxKeepAliveCount = parameters.maxKeepAliveCount;
+        req.maxNotificationsPerPublish = parameters.maxNotificationsPerPublish;
+        req.priority = parameters.priority;
+
+        UA_ModifySubscriptionResponse res;
+        UA_ModifySubscriptionResponse_init(&res);
+        __UA_Client_Service(m_uaclient, &req, &UA_TYPES[UA_TYPES_MODIFYSUBSCRIPTIONREQUEST],
+                            &res, &UA_TYPES[UA_TYPES_MODIFYSUBSCRIPTIONRESPONSE]);
+        if (res.responseHeader.serviceResult == UA_STATUSCODE_GOOD) {
+            native->m_parameters = parameters;
+            native->m_parameters.publishingInterval = res.revisedPublishingInterval;
+            native->m_parameters.lifetimeCount = res.revisedLifetimeCount;
+            native->m_parameters.maxKeepAliveCount = res.revisedMaxKeepAliveCount;
+        }
+        UA_ModifySubscriptionResponse_deleteMembers(&res);
+    }
+
+    // The lost server becomes a standby candidate again once it is back
+    m_standbyRetry.setRemainingTime(StandbyInterval);
+    emit endpointSelected(m_endpointUrl);
+    emit stateAndOrErrorChanged(QOpcUaClient::Connected, QOpcUaClient::NoError);
+    updatePublishTimer();
+    return true;
+}
+
+void Open62541AsyncBackend::closeStandby()
+{
+    m_standbySubscriptions.clear();
+    if (!m_standbyClient)
+        return;
+
+    // Closing the session deletes the standby subscriptions on the server
+    UA_Client_disconnect(m_standbyClient);
+    UA_Client_delete(m_standbyClient);
+    m_standbyClient = nullptr;
+    m_standbyUrl.clear();
+    reportStandby(QUrl());
+}
+
+void Open62541AsyncBackend::reportStandby(const QUrl &url)
+{
+    if (url == m_reportedStandbyUrl)
+        return;
+    m_reportedStandbyUrl = url;
+    emit standbyChanged(url);
+}
+
+void Open62541AsyncBackend::updatePublishTimer()
+{
+    if (!m_subscriptionTimer || m_reconnectTimer->isActive())
+        return;
+
+    if (m_subscriptions.isEmpty()) {
+        m_subscriptionTimer->stop();
+        return;
+    }
+
+    double minInterval = std::numeric_limits<double>::max();
+    for (const QOpen62541NativeSubscription *native : qAsConst(m_subscriptions))
+        minInterval = qMin(minInterval, native->m_parameters.publishingInterval);
+
+    m_subscriptionTimer->setInterval(qMax(1, int(minInterval)));
+    m_subscriptionTimer->start();
 }
 
 QT_END_NAMESPACE
@@ -35,15 +35,33 @@
 ****************************************************************************/
 
 #include "qopen62541client.h"
+#include <QtOpcUa/qopcuaeventfilter.h>
+#include <QtOpcUa/qopcuamethodcall.h>
+#include <QtOpcUa/qopcuamonitoredevent.h>
+#include <QtOpcUa/qopcuamonitoredvalue.h>
+#include <QtOpcUa/qopcuamonitoringparameters.h>
+#include <QtOpcUa/qopcuasubscriptionparameters.h>
 #include <private/qopcuabackend_p.h>
+#include <private/qopcuastringcache_p.h>
 
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qset.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qtimer.h>
+#include <QtCore/qurl.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
 class QOpen62541Node;
+class QOpen62541NativeSubscription;
+class QOpen62541Subscription;
+class QOpen62541TypeDictionary;
+struct QOpen62541MonitoredItem;
 
 class Open62541AsyncBackend : public QOpcUaBackend
 {
@@ -53,26 +71,146 @@ public:
 
 public Q_SLOTS:
     void connectToEndpoint(const QUrl &url);
+    void connectToAnyEndpoint(QVector<QUrl> urls);
     void disconnectFromEndpoint();
 
     // Node functions
     QStringList childrenIds(const UA_NodeId *parentNode);
-    void readAttributes(uintptr_t handle, UA_NodeId id, QOpcUaNode::NodeAttributes attr);
+    void readAttributes(uintptr_t handle, UA_NodeId id, QOpcUaNode::NodeAttributes attr, QString indexRange);
 
-    void writeAttribute(uintptr_t handle, UA_NodeId id, QOpcUaNode::NodeAttribute attrId, QVariant value, QOpcUa::Types type);
+    void writeAttribute(uintptr_t handle, UA_NodeId id, QOpcUaNode::NodeAttribute attrId, QVariant value, QOpcUa::Types type,
+                        QString indexRange);
     void writeAttributes(uintptr_t handle, UA_NodeId id, QOpcUaNode::AttributeMap toWrite, QOpcUa::Types valueAttributeType);
+    void callMethods(quint32 requestId, QVector<QOpcUaMethodCall> calls);
+    void prepareMethod(QString methodId);
 
     // Subscription
-    UA_UInt32 createSubscription(int interval);
-    void deleteSubscription(UA_UInt32 id);
-    void updatePublishSubscriptionRequests() const;
-    void activateSubscriptionTimer(int timeout);
-    void removeSubscriptionTimer(int timeout);
+    void attachSubscription(QOpen62541Subscription *subscription);
+    void detachSubscription(QOpen62541Subscription *subscription);
+    QOpcUa::UaStatusCode modifySubscription(QOpen62541Subscription *subscription, QOpcUaSubscriptionParameters parameters);
+    bool addMonitoredValue(QOpen62541Subscription *subscription, QOpcUaMonitoredValue *value,
+                           QString nodeId, QOpcUaMonitoringParameters parameters);
+    void removeMonitoredValue(QOpen62541Subscription *subscription, QOpcUaMonitoredValue *value);
+    bool addMonitoredEvent(QOpen62541Subscription *subscription, QOpcUaMonitoredEvent *event,
+                           QString nodeId, QOpcUaEventFilter filter);
+    void removeMonitoredEvent(QOpen62541Subscription *subscription, QOpcUaMonitoredEvent *event);
+    QOpcUa::UaStatusCode modifyMonitoredValues(QOpen62541Subscription *subscription, QVector<QOpcUaMonitoredValue *> values,
+                                               QOpcUaMonitoringParameters parameters, QVector<QOpcUa::UaStatusCode> *results);
+    void updatePublishSubscriptionRequests();
+    QOpcUa::UaStatusCode setMonitoringMode(QOpen62541Subscription *subscription, QVector<QOpcUaMonitoredValue *> values,
+                                           QOpcUa::MonitoringMode mode, QVector<QOpcUa::UaStatusCode> *results);
+    QOpcUa::UaStatusCode setTriggering(QOpen62541Subscription *subscription, QOpcUaMonitoredValue *trigger,
+                                       QVector<QOpcUaMonitoredValue *> linksToAdd, QVector<QOpcUaMonitoredValue *> linksToRemove,
+                                       QVector<QOpcUa::UaStatusCode> *addResults, QVector<QOpcUa::UaStatusCode> *removeResults);
 public:
     QOpen62541Client *m_clientImpl;
     UA_Client *m_uaclient;
     QTimer *m_subscriptionTimer;
-    QSet<int> m_subscriptionIntervals;
+    QTimer *m_reconnectTimer;
+    QTimer *m_standbyTimer;
+    // Runs the GetEndpoints requests of connectToAnyEndpoint() in parallel
+    QThreadPool *m_probePool;
+    QHash<UA_UInt32, QOpen62541NativeSubscription *> m_subscriptions;
+    // Native subscriptions without a session, they are created again on the next connect
+    QVector<QOpen62541NativeSubscription *> m_detachedSubscriptions;
+    QVector<UA_SubscriptionAcknowledgement> m_pendingAcknowledgements;
+
+private:
+    UA_StatusCode connectClient(UA_Client *client, const QUrl &url, int timeout);
+    int connectTimeout() const;
+    bool connectCanceled() const;
+    int selectEndpoint(const QVector<QUrl> &urls, const QDeadlineTimer &deadline);
+    bool typedArrays() const;
+    QSharedPointer<const QOpen62541TypeDictionary> typeDictionary();
+    QSharedPointer<const QOpen62541TypeDictionary> loadTypeDictionary();
+    UA_UInt32 maximumMethodsPerCall();
+    UA_StatusCode callMethodBatch(const QVector<QOpcUaMethodCall> &calls, int first, int count,
+                                  QVector<QOpcUaMethodCallResult> *results);
+    void resolveMethodArguments();
+
+    // Native subscriptions are shared by all QOpcUaSubscriptions with equal parameters
+    QOpen62541NativeSubscription *findNativeSubscription(const QOpcUaSubscriptionParameters &parameters) const;
+    QOpen62541NativeSubscription *acquireNativeSubscription(const QOpcUaSubscriptionParameters &parameters, UA_StatusCode *status);
+    void releaseNativeSubscription(QOpen62541NativeSubscription *native);
+    UA_StatusCode createNativeSubscription(QOpen62541NativeSubscription *native);
+
+    void createMonitoredItems(QOpen62541NativeSubscription *native, const QVector<QOpen62541MonitoredItem *> &items,
+                              QVector<UA_StatusCode> *results);
+    UA_StatusCode deleteMonitoredItem(UA_UInt32 subscriptionId, UA_UInt32 monitoredItemId);
+    UA_StatusCode addTriggeringLinks(UA_Client *client, UA_UInt32 subscriptionId, UA_UInt32 triggeringItemId,
+                                     QVector<UA_UInt32> linkIds);
+    void restoreTriggeringLinks(QOpen62541NativeSubscription *native, const QVector<QOpen62541MonitoredItem *> &items);
+    void restoreTriggeringLinks(UA_Client *client, UA_UInt32 subscriptionId, const QOpen62541NativeSubscription *native,
+                                const QHash<UA_UInt32, UA_UInt32> &monitoredItemIds, const QSet<UA_UInt32> &created);
+    void releaseValue(QOpen62541NativeSubscription *native, QOpcUaMonitoredValue *value);
+    void releaseEvent(QOpen62541NativeSubscription *native, QOpcUaMonitoredEvent *event);
+    QOpen62541MonitoredItem *ownedItem(QOpen62541Subscription *subscription, QOpcUaMonitoredValue *value) const;
+    QVector<QOpen62541MonitoredItem *> exclusiveItems(QOpen62541Subscription *subscription,
+                                                      const QVector<QOpcUaMonitoredValue *> &values,
+                                                      QVector<QOpcUa::UaStatusCode> *results);
+    UA_StatusCode moveItems(QOpen62541Subscription *subscription, QOpen62541NativeSubscription *from,
+                            QOpen62541NativeSubscription *to);
+
+    void updatePublishTimer();
+    void handleNotificationMessage(QOpen62541NativeSubscription *native, const UA_NotificationMessage &message);
+    void handleConnectionLost();
+    void checkConnection(UA_StatusCode serviceResult);
+    void retryConnection();
+    bool reconnect();
+    void closeLostConnection();
+    void closeSession();
+    void restoreDetachedSubscriptions();
+    void recoverSubscriptions();
+    UA_StatusCode republish(QOpen62541NativeSubscription *native, int maximumMessages);
+    void recreateSubscription(QOpen62541NativeSubscription *native);
+    void createPendingItems(QOpen62541NativeSubscription *native);
+
+    // The mirror of a native subscription in the hot standby session
+    struct StandbySubscription
+    {
+        UA_UInt32 subscriptionId = 0;
+        // Keyed by the client handle of the item in the native subscription
+        QHash<UA_UInt32, UA_UInt32> monitoredItemIds;
+        QHash<UA_UInt32, quint32> revisions;
+    };
+
+    void updateStandby();
+    QVector<QUrl> standbyCandidates();
+    bool connectStandby();
+    void syncStandbySubscription(QOpen62541NativeSubscription *native, StandbySubscription *standby);
+    void removeStandbySubscription(QOpen62541NativeSubscription *native);
+    void keepStandbyAlive();
+    bool failover();
+    void closeStandby();
+    void reportStandby(const QUrl &url);
+
+    QUrl m_endpointUrl;
+    // The candidates passed to connectToAnyEndpoint(), the other ones may serve as standby
+    QVector<QUrl> m_candidateUrls;
+    int m_reconnectAttempts;
+    UA_Client *m_standbyClient;
+    QUrl m_standbyUrl;
+    // The standby last announced to the client, see QOpcUaClient::standbyUrl()
+    QUrl m_reportedStandbyUrl;
+    QHash<QOpen62541NativeSubscription *, StandbySubscription> m_standbySubscriptions;
+    QDeadlineTimer m_standbyRetry;
+    // Loaded when the first structure is received and kept for the session
+    QSharedPointer<const QOpen62541TypeDictionary> m_typeDictionary;
+    bool m_typeDictionaryLoaded;
+    // The InputArguments and OutputArguments of the prepared methods, kept for the session
+    struct MethodArguments
+    {
+        QVector<QOpcUaMethodArgument> inputArguments;
+        QVector<QOpcUaMethodArgument> outputArguments;
+    };
+    QHash<QString, MethodArguments> m_methodArguments;
+    // Methods to be resolved together by the next resolveMethodArguments()
+    QStringList m_pendingMethods;
+    // MaxNodesPerMethodCall of the server, 0 if there is no limit
+    UA_UInt32 m_maximumMethodsPerCall;
+    bool m_maximumMethodsPerCallLoaded;
+    // Interns the strings of notifications, see QOpcUaClient::setStringCacheSize()
+    QOpcUaStringCache m_stringCache;
 };
 
 QT_END_NAMESPACE
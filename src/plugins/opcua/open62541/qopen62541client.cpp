@@ -71,6 +71,11 @@ void QOpen62541Client::connectToEndpoint(const QUrl &url)
     QMetaObject::invokeMethod(m_backend, "connectToEndpoint", Qt::QueuedConnection, Q_ARG(QUrl, url));
 }
 
+void QOpen62541Client::connectToAnyEndpoint(const QVector<QUrl> &urls)
+{
+    QMetaObject::invokeMethod(m_backend, "connectToAnyEndpoint", Qt::QueuedConnection, Q_ARG(QVector<QUrl>, urls));
+}
+
 void QOpen62541Client::secureConnectToEndpoint(const QUrl &url)
 {
     Q_UNIMPLEMENTED();
@@ -99,6 +104,17 @@ QOpcUaSubscription *QOpen62541Client::createSubscription(quint32 interval)
     return subscription;
 }
 
+bool QOpen62541Client::callMethods(quint32 requestId, const QVector<QOpcUaMethodCall> &calls)
+{
+    return QMetaObject::invokeMethod(m_backend, "callMethods", Qt::QueuedConnection,
+                                     Q_ARG(quint32, requestId), Q_ARG(QVector<QOpcUaMethodCall>, calls));
+}
+
+void QOpen62541Client::prepareMethod(const QString &methodId)
+{
+    QMetaObject::invokeMethod(m_backend, "prepareMethod", Qt::QueuedConnection, Q_ARG(QString, methodId));
+}
+
 QString QOpen62541Client::backend() const
 {
     return QStringLiteral("open62541");
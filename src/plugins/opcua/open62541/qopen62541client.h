@@ -55,11 +55,14 @@ public:
     ~QOpen62541Client();
 
     void connectToEndpoint(const QUrl &url) override;
+    void connectToAnyEndpoint(const QVector<QUrl> &urls) override;
     void secureConnectToEndpoint(const QUrl &url) override;
     void disconnectFromEndpoint() override;
 
     QOpcUaNode *node(const QString &nodeId) override;
     QOpcUaSubscription *createSubscription(quint32 interval) override;
+    bool callMethods(quint32 requestId, const QVector<QOpcUaMethodCall> &calls) override;
+    void prepareMethod(const QString &methodId) override;
 
     QString backend() const override;
 
@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qopen62541lazyvalue.h"
+#include "qopen62541valueconverter.h"
+
+QT_BEGIN_NAMESPACE
+
+QOpen62541LazyValue::QOpen62541LazyValue(UA_Variant *value, bool typedArrays,
+                                         const QSharedPointer<const QOpen62541TypeDictionary> &types)
+    : m_value(*value)
+    , m_typedArrays(typedArrays)
+    , m_types(types)
+{
+    // The response must not delete the value anymore
+    UA_Variant_init(value);
+}
+
+QOpen62541LazyValue::~QOpen62541LazyValue()
+{
+    UA_Variant_deleteMembers(&m_value);
+}
+
+QVariant QOpen62541LazyValue::toVariant() const
+{
+    return QOpen62541ValueConverter::toQVariant(m_value, m_typedArrays, m_types.data());
+}
+
+QOpcUaVariant QOpen62541LazyValue::toOpcUaVariant() const
+{
+    return QOpen62541ValueConverter::toQOpcUaVariant(m_value);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOPEN62541LAZYVALUE_H
+#define QOPEN62541LAZYVALUE_H
+
+#include "qopen62541.h"
+#include "qopen62541typedictionary.h"
+#include <private/qopcuanodeimpl_p.h>
+
+#include <QtCore/qsharedpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+// Takes the value out of a read response, it is converted when the attribute is accessed
+class QOpen62541LazyValue : public QOpcUaLazyValue
+{
+public:
+    QOpen62541LazyValue(UA_Variant *value, bool typedArrays, const QSharedPointer<const QOpen62541TypeDictionary> &types);
+    ~QOpen62541LazyValue() override;
+
+    QVariant toVariant() const override;
+    QOpcUaVariant toOpcUaVariant() const override;
+
+private:
+    Q_DISABLE_COPY(QOpen62541LazyValue)
+
+    UA_Variant m_value;
+    bool m_typedArrays;
+    // The value may be converted after the session has ended
+    QSharedPointer<const QOpen62541TypeDictionary> m_types;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPEN62541LAZYVALUE_H
@@ -69,7 +69,8 @@ bool QOpen62541Node::readAttributes(QOpcUaNode::NodeAttributes attr)
                                      Qt::QueuedConnection,
                                      Q_ARG(uintptr_t, reinterpret_cast<uintptr_t>(this)),
                                      Q_ARG(UA_NodeId, tempId),
-                                     Q_ARG(QOpcUaNode::NodeAttributes, attr));
+                                     Q_ARG(QOpcUaNode::NodeAttributes, attr),
+                                     Q_ARG(QString, QString()));
 }
 
 QStringList QOpen62541Node::childrenIds() const
@@ -93,7 +94,8 @@ bool QOpen62541Node::writeAttribute(QOpcUaNode::NodeAttribute attribute, const Q
                                      Q_ARG(UA_NodeId, tempId),
                                      Q_ARG(QOpcUaNode::NodeAttribute, attribute),
                                      Q_ARG(QVariant, value),
-                                     Q_ARG(QOpcUa::Types, type));
+                                     Q_ARG(QOpcUa::Types, type),
+                                     Q_ARG(QString, QString()));
 }
 
 bool QOpen62541Node::writeAttributes(const QOpcUaNode::AttributeMap &toWrite, QOpcUa::Types valueAttributeType)
@@ -108,6 +110,33 @@ bool QOpen62541Node::writeAttributes(const QOpcUaNode::AttributeMap &toWrite, QO
                                      Q_ARG(QOpcUa::Types, valueAttributeType));
 }
 
+bool QOpen62541Node::readAttributeRange(QOpcUaNode::NodeAttribute attribute, const QString &indexRange)
+{
+    UA_NodeId tempId;
+    UA_NodeId_copy(&m_nodeId, &tempId);
+    return QMetaObject::invokeMethod(m_client->m_backend, "readAttributes",
+                                     Qt::QueuedConnection,
+                                     Q_ARG(uintptr_t, reinterpret_cast<uintptr_t>(this)),
+                                     Q_ARG(UA_NodeId, tempId),
+                                     Q_ARG(QOpcUaNode::NodeAttributes, attribute),
+                                     Q_ARG(QString, indexRange));
+}
+
+bool QOpen62541Node::writeAttributeRange(QOpcUaNode::NodeAttribute attribute, const QVariant &value,
+                                         const QString &indexRange, QOpcUa::Types type)
+{
+    UA_NodeId tempId;
+    UA_NodeId_copy(&m_nodeId, &tempId);
+    return QMetaObject::invokeMethod(m_client->m_backend, "writeAttribute",
+                                     Qt::QueuedConnection,
+                                     Q_ARG(uintptr_t, reinterpret_cast<uintptr_t>(this)),
+                                     Q_ARG(UA_NodeId, tempId),
+                                     Q_ARG(QOpcUaNode::NodeAttribute, attribute),
+                                     Q_ARG(QVariant, value),
+                                     Q_ARG(QOpcUa::Types, type),
+                                     Q_ARG(QString, indexRange));
+}
+
 bool QOpen62541Node::call(const QString &methodNodeId, QVector<QOpcUa::TypedVariant> *args, QVector<QVariant> *ret)
 {
     Q_UNUSED(methodNodeId);
@@ -37,6 +37,7 @@
 #include "qopen62541client.h"
 #include "qopen62541node.h"
 #include "qopen62541plugin.h"
+#include "qopen62541subscription.h"
 #include "qopen62541valueconverter.h"
 #include <QtOpcUa/qopcuaclient.h>
 
@@ -62,6 +63,11 @@ QOpen62541Plugin::QOpen62541Plugin(QObject *parent)
 {
     compileTimeEnforceEnumMappings();
     qRegisterMetaType<UA_NodeId>();
+    qRegisterMetaType<QVector<QOpcUa::UaStatusCode> *>();
+    qRegisterMetaType<QOpcUaMonitoredValue *>();
+    qRegisterMetaType<QOpcUaMonitoredEvent *>();
+    qRegisterMetaType<QVector<QOpcUaMonitoredValue *>>();
+    qRegisterMetaType<QOpen62541Subscription *>();
 }
 
 QOpen62541Plugin::~QOpen62541Plugin()
@@ -38,26 +38,368 @@
 #include "qopen62541client.h"
 #include "qopen62541node.h"
 #include "qopen62541subscription.h"
+#include "qopen62541utils.h"
 #include "qopen62541valueconverter.h"
+#include <QtOpcUa/qopcuatypedmonitoredvalue.h>
+#include <private/qopcuamonitoredevent_p.h>
 #include <private/qopcuamonitoredvalue_p.h>
 #include <private/qopcuanode_p.h>
+#include <private/qopcuasubscription_p.h>
 
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qset.h>
+
+#include <cstring>
 
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
 
-static void monitoredValueHandler(UA_UInt32 monId, UA_DataValue *value, void *context)
+QOpen62541NativeSubscription::QOpen62541NativeSubscription(const QOpcUaSubscriptionParameters &requestedParameters)
+    : m_requestedParameters(requestedParameters)
+    , m_parameters(requestedParameters)
+    , m_subscriptionId(0)
+    , m_nextClientHandle(1)
+    , m_lastSequenceNumber(0)
+    , m_refCount(0)
+{
+}
+
+QOpen62541NativeSubscription::~QOpen62541NativeSubscription()
+{
+    qDeleteAll(m_items);
+}
+
+QOpen62541MonitoredItem *QOpen62541NativeSubscription::findShareableItem(const QString &nodeId,
+                                                                         const QOpcUaMonitoringParameters &parameters) const
+{
+    // Filters can not be compared, values with a filter always get an item of their own
+    if (parameters.filter.isValid())
+        return nullptr;
+
+    for (QOpen62541MonitoredItem *item : m_items) {
+        if (item->event || item->exclusive || item->nodeId != nodeId || item->parameters.filter.isValid())
+            continue;
+        if (item->parameters.samplingInterval == parameters.samplingInterval
+                && item->parameters.queueSize == parameters.queueSize
+                && item->parameters.discardOldest == parameters.discardOldest)
+            return item;
+    }
+    return nullptr;
+}
+
+QOpen62541MonitoredItem *QOpen62541NativeSubscription::addItem(const QString &nodeId)
+{
+    QOpen62541MonitoredItem *item = new QOpen62541MonitoredItem;
+    item->clientHandle = m_nextClientHandle++;
+    item->nodeId = nodeId;
+    m_items.insert(item->clientHandle, item);
+    return item;
+}
+
+void QOpen62541NativeSubscription::removeItem(QOpen62541MonitoredItem *item)
+{
+    for (QOpcUaMonitoredValue *value : qAsConst(item->values))
+        m_valueItems.remove(value);
+    if (item->event)
+        m_eventItems.remove(item->event);
+    m_items.remove(item->clientHandle);
+    for (QOpen62541MonitoredItem *other : qAsConst(m_items))
+        other->triggeredItems.removeAll(item->clientHandle);
+    delete item;
+}
+
+void QOpen62541NativeSubscription::processNotificationMessage(const UA_NotificationMessage &message, bool typedArrays,
+                                                              const QOpen62541TypeDictionary *types,
+                                                              QOpcUaStringCache *strings)
+{
+    // Keep alive messages carry the next sequence number but do not consume it
+    if (message.notificationDataSize > 0 && m_lastSequenceNumber != 0) {
+        const UA_UInt32 expected = nextSequenceNumber(m_lastSequenceNumber);
+        if (message.sequenceNumber != expected) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Subscription" << m_subscriptionId << "skipped sequence numbers from"
+                                                  << expected << "to" << message.sequenceNumber;
+            reportSequenceGap();
+        }
+    }
+
+    for (size_t i = 0; i < message.notificationDataSize; ++i) {
+        const UA_ExtensionObject &data = message.notificationData[i];
+        if (data.encoding != UA_EXTENSIONOBJECT_DECODED && data.encoding != UA_EXTENSIONOBJECT_DECODED_NODELETE)
+            continue;
+
+        if (data.content.decoded.type == &UA_TYPES[UA_TYPES_DATACHANGENOTIFICATION]) {
+            const UA_DataChangeNotification *notification = static_cast<const UA_DataChangeNotification *>(data.content.decoded.data);
+            for (size_t j = 0; j < notification->monitoredItemsSize; ++j) {
+                const UA_MonitoredItemNotification &itemNotification = notification->monitoredItems[j];
+                QOpen62541MonitoredItem *item = m_items.value(itemNotification.clientHandle, nullptr);
+                if (!item || item->event) {
+                    qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not find object for client handle:" << itemNotification.clientHandle;
+                    continue;
+                }
+                dataChanged(item, &itemNotification.value, typedArrays, types, strings);
+            }
+        } else if (data.content.decoded.type == &UA_TYPES[UA_TYPES_EVENTNOTIFICATIONLIST]) {
+            eventsReceived(*static_cast<const UA_EventNotificationList *>(data.content.decoded.data), types, strings);
+        } else if (data.content.decoded.type == &UA_TYPES[UA_TYPES_STATUSCHANGENOTIFICATION]) {
+            const UA_StatusChangeNotification *notification = static_cast<const UA_StatusChangeNotification *>(data.content.decoded.data);
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Status of subscription" << m_subscriptionId << "changed:"
+                                                  << static_cast<QOpcUa::UaStatusCode>(notification->status);
+        }
+    }
+}
+
+// Encodes a value for the raw passthrough mode, returns a null QByteArray on failure
+static QByteArray toBinaryEncoding(const UA_Variant &variant)
 {
-    QOpen62541Subscription *subscription = static_cast<QOpen62541Subscription *>(context);
-    subscription->monitoredValueUpdated(monId, value);
+    QByteArray result(static_cast<int>(UA_calcSizeBinary(const_cast<UA_Variant *>(&variant), &UA_TYPES[UA_TYPES_VARIANT])),
+                      Qt::Uninitialized);
+
+    UA_ByteString buffer = Open62541Utils::borrowString(result);
+    size_t offset = 0;
+    if (UA_encodeBinary(&variant, &UA_TYPES[UA_TYPES_VARIANT], nullptr, nullptr, &buffer, &offset) != UA_STATUSCODE_GOOD)
+        return QByteArray();
+    return result;
+}
+
+// The Overflow bit is only valid if the InfoType bits of the status code are set to DataValue
+static bool hasOverflowBit(UA_StatusCode status)
+{
+    return (status & 0x00000C00) == 0x00000400 && (status & 0x00000080);
+}
+
+// Returns the open62541 type which has the same memory layout as the Qt type
+static const UA_DataType *layoutCompatibleType(int metaType)
+{
+    Q_STATIC_ASSERT(sizeof(UA_Boolean) == sizeof(bool));
+    Q_STATIC_ASSERT(sizeof(UA_Float) == sizeof(float));
+    Q_STATIC_ASSERT(sizeof(UA_Double) == sizeof(double));
+
+    switch (metaType) {
+    case QMetaType::Bool:
+        return &UA_TYPES[UA_TYPES_BOOLEAN];
+    case QMetaType::SChar:
+        return &UA_TYPES[UA_TYPES_SBYTE];
+    case QMetaType::UChar:
+        return &UA_TYPES[UA_TYPES_BYTE];
+    case QMetaType::Short:
+        return &UA_TYPES[UA_TYPES_INT16];
+    case QMetaType::UShort:
+        return &UA_TYPES[UA_TYPES_UINT16];
+    case QMetaType::Int:
+        return &UA_TYPES[UA_TYPES_INT32];
+    case QMetaType::UInt:
+        return &UA_TYPES[UA_TYPES_UINT32];
+    case QMetaType::LongLong:
+        return &UA_TYPES[UA_TYPES_INT64];
+    case QMetaType::ULongLong:
+        return &UA_TYPES[UA_TYPES_UINT64];
+    case QMetaType::Float:
+        return &UA_TYPES[UA_TYPES_FLOAT];
+    case QMetaType::Double:
+        return &UA_TYPES[UA_TYPES_DOUBLE];
+    default:
+        return nullptr;
+    }
+}
+
+template <typename T>
+static void triggerTypedArray(QOpcUaMonitoredValuePrivate *d, const UA_Variant &var, QOpcUa::UaStatusCode statusCode)
+{
+    QVector<T> array(int(var.arrayLength));
+    if (var.arrayLength > 0)
+        memcpy(array.data(), var.data, var.arrayLength * sizeof(T));
+    d->triggerTypedValue(&array, statusCode);
+}
+
+// Hands the value to the sink of a typed value monitor without creating a QVariant.
+// Returns false if the sink expects a different type.
+static bool triggerTypedValue(QOpcUaMonitoredValuePrivate *d, const UA_Variant &var, QOpcUa::UaStatusCode statusCode)
+{
+    const int elementType = d->m_sink->elementType();
+    if (elementType == qMetaTypeId<QOpcUaVariant>()) {
+        const QOpcUaVariant value = QOpen62541ValueConverter::toQOpcUaVariant(var);
+        if (!value.isValid())
+            return false;
+        d->triggerTypedValue(&value, statusCode);
+        return true;
+    }
+
+    const UA_DataType *type = layoutCompatibleType(elementType);
+    if (!type || var.type != type)
+        return false;
+
+    if (!d->m_sink->isArray()) {
+        if (!UA_Variant_isScalar(&var))
+            return false;
+        d->triggerTypedValue(var.data, statusCode);
+        return true;
+    }
+
+    if (UA_Variant_isScalar(&var) || var.arrayDimensionsSize > 1)
+        return false;
+
+    switch (elementType) {
+    case QMetaType::Bool:
+        triggerTypedArray<bool>(d, var, statusCode);
+        break;
+    case QMetaType::SChar:
+        triggerTypedArray<qint8>(d, var, statusCode);
+        break;
+    case QMetaType::UChar:
+        triggerTypedArray<quint8>(d, var, statusCode);
+        break;
+    case QMetaType::Short:
+        triggerTypedArray<qint16>(d, var, statusCode);
+        break;
+    case QMetaType::UShort:
+        triggerTypedArray<quint16>(d, var, statusCode);
+        break;
+    case QMetaType::Int:
+        triggerTypedArray<qint32>(d, var, statusCode);
+        break;
+    case QMetaType::UInt:
+        triggerTypedArray<quint32>(d, var, statusCode);
+        break;
+    case QMetaType::LongLong:
+        triggerTypedArray<qint64>(d, var, statusCode);
+        break;
+    case QMetaType::ULongLong:
+        triggerTypedArray<quint64>(d, var, statusCode);
+        break;
+    case QMetaType::Float:
+        triggerTypedArray<float>(d, var, statusCode);
+        break;
+    case QMetaType::Double:
+        triggerTypedArray<double>(d, var, statusCode);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+void QOpen62541NativeSubscription::dataChanged(QOpen62541MonitoredItem *item, const UA_DataValue *value, bool typedArrays,
+                                               const QOpen62541TypeDictionary *types, QOpcUaStringCache *strings)
+{
+    if (!value)
+        return;
+
+    if (value->hasStatus && hasOverflowBit(value->status)) {
+        for (QOpcUaMonitoredValue *monitoredValue : qAsConst(item->values))
+            monitoredValue->d_func()->reportOverflow();
+    }
+
+    if (!value->hasValue)
+        return;
+
+    const QOpcUa::UaStatusCode statusCode = value->hasStatus ?
+                static_cast<QOpcUa::UaStatusCode>(value->status) : QOpcUa::UaStatusCode::Good;
+
+    // Values of subscriptions in raw passthrough mode get the binary encoding and skip the conversion
+    int rawCount = 0;
+    for (QOpcUaMonitoredValue *monitoredValue : qAsConst(item->values)) {
+        if (monitoredValue->d_func()->wantsRawValue())
+            ++rawCount;
+    }
+    if (rawCount > 0) {
+        const QByteArray encodedValue = toBinaryEncoding(value->value);
+        if (encodedValue.isNull())
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not encode value for node:" << item->nodeId;
+        const QDateTime sourceTimestamp = value->hasSourceTimestamp ?
+                    QOpen62541ValueConverter::toQDateTime(&value->sourceTimestamp) : QDateTime();
+        const QDateTime serverTimestamp = value->hasServerTimestamp ?
+                    QOpen62541ValueConverter::toQDateTime(&value->serverTimestamp) : QDateTime();
+        for (QOpcUaMonitoredValue *monitoredValue : qAsConst(item->values)) {
+            QOpcUaMonitoredValuePrivate *d = monitoredValue->d_func();
+            if (!d->wantsRawValue())
+                continue;
+            if (encodedValue.isNull())
+                d->reportConversionFailure();
+            else
+                d->triggerRawValue(encodedValue, item->clientHandle, statusCode, sourceTimestamp, serverTimestamp);
+        }
+        if (rawCount == item->values.size())
+            return;
+    }
+
+    // Items of typed value monitors are never shared
+    if (item->values.size() == 1) {
+        QOpcUaMonitoredValuePrivate *d = item->values.first()->d_func();
+        if (d->m_sink && triggerTypedValue(d, value->value, statusCode))
+            return;
+    }
+
+    QVariant var = QOpen62541ValueConverter::toQVariant(value->value, typedArrays, types, strings);
+    if (!var.isValid()) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not convert value for node:" << item->nodeId;
+        for (QOpcUaMonitoredValue *monitoredValue : qAsConst(item->values))
+            monitoredValue->d_func()->reportConversionFailure();
+        return;
+    }
+
+    QOpcUaDataChangeNotification &last = item->lastValue;
+    last.value = var;
+    last.statusCode = statusCode;
+    last.sourceTimestamp = value->hasSourceTimestamp ?
+                QOpen62541ValueConverter::toQDateTime(&value->sourceTimestamp) : QDateTime();
+    last.serverTimestamp = value->hasServerTimestamp ?
+                QOpen62541ValueConverter::toQDateTime(&value->serverTimestamp) : QDateTime();
+    item->hasValue = true;
+
+    // The value is converted once and handed to every monitored value sharing the item
+    for (QOpcUaMonitoredValue *monitoredValue : qAsConst(item->values)) {
+        QOpcUaMonitoredValuePrivate *d = monitoredValue->d_func();
+        if (rawCount == 0 || !d->wantsRawValue())
+            d->triggerValueChanged(last.value, last.statusCode, last.sourceTimestamp, last.serverTimestamp);
+    }
+}
+
+// Counts the gap for each QOpcUaSubscription using this native subscription
+void QOpen62541NativeSubscription::reportSequenceGap()
+{
+    QSet<QOpcUaSubscription *> subscriptions;
+    for (auto it = m_valueItems.constBegin(); it != m_valueItems.constEnd(); ++it)
+        subscriptions.insert(it.key()->d_func()->m_subscription);
+    for (auto it = m_eventItems.constBegin(); it != m_eventItems.constEnd(); ++it)
+        subscriptions.insert(it.key()->d_func()->m_subscription);
+
+    for (QOpcUaSubscription *subscription : qAsConst(subscriptions)) {
+        if (subscription)
+            subscription->d_func()->m_counters.sequenceGaps.fetchAndAddRelaxed(1);
+    }
+}
+
+void QOpen62541NativeSubscription::eventsReceived(const UA_EventNotificationList &notification,
+                                                  const QOpen62541TypeDictionary *types,
+                                                  QOpcUaStringCache *strings)
+{
+    // Collect the events of each monitored item to deliver them with a single signal
+    QHash<UA_UInt32, QVector<QVector<QVariant>>> batches;
+    for (size_t i = 0; i < notification.eventsSize; ++i) {
+        const UA_EventFieldList &fieldList = notification.events[i];
+        QVector<QVariant> fields;
+        fields.reserve(fieldList.eventFieldsSize);
+        for (size_t j = 0; j < fieldList.eventFieldsSize; ++j)
+            fields.push_back(QOpen62541ValueConverter::toQVariant(fieldList.eventFields[j], false, types, strings));
+        batches[fieldList.clientHandle].push_back(fields);
+    }
+
+    for (auto it = batches.constBegin(); it != batches.constEnd(); ++it) {
+        QOpen62541MonitoredItem *item = m_items.value(it.key(), nullptr);
+        if (!item || !item->event) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not find event object for client handle:" << it.key();
+            continue;
+        }
+        item->event->d_func()->triggerNewEvents(it.value());
+    }
 }
 
 QOpen62541Subscription::QOpen62541Subscription(Open62541AsyncBackend *backend, quint32 interval)
-    : m_backend(backend)
-    , m_interval(interval)
-    , m_subscriptionId(0)
+    : m_qsubscription(nullptr)
+    , m_parameters(interval)
+    , m_native(nullptr)
+    , m_backend(backend)
 {
 }
 
@@ -66,102 +408,194 @@ QOpen62541Subscription::~QOpen62541Subscription()
     removeNativeSubscription();
 }
 
-QOpcUaMonitoredEvent *QOpen62541Subscription::addEvent(QOpcUaNode *node)
+QOpcUaMonitoredEvent *QOpen62541Subscription::addEvent(QOpcUaNode *node, const QOpcUaEventFilter &filter)
 {
-    Q_UNUSED(node);
-    Q_UNIMPLEMENTED();
-    return nullptr;
+    if (!ensureNativeSubscription())
+        return nullptr;
+
+    QOpcUaMonitoredEvent *monitoredEvent = new QOpcUaMonitoredEvent(node, m_qsubscription);
+
+    bool success = false;
+    QMetaObject::invokeMethod(m_backend, "addMonitoredEvent",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, success),
+                              Q_ARG(QOpen62541Subscription *, this),
+                              Q_ARG(QOpcUaMonitoredEvent *, monitoredEvent),
+                              Q_ARG(QString, node->nodeId()),
+                              Q_ARG(QOpcUaEventFilter, filter));
+    if (!success) {
+        delete monitoredEvent;
+        return nullptr;
+    }
+
+    return monitoredEvent;
 }
 
 void QOpen62541Subscription::removeEvent(QOpcUaMonitoredEvent *event)
 {
-    Q_UNUSED(event);
-    Q_UNIMPLEMENTED();
+    if (!m_native)
+        return;
+
+    QMetaObject::invokeMethod(m_backend, "removeMonitoredEvent",
+                              Qt::BlockingQueuedConnection,
+                              Q_ARG(QOpen62541Subscription *, this),
+                              Q_ARG(QOpcUaMonitoredEvent *, event));
 }
 
-QOpcUaMonitoredValue *QOpen62541Subscription::addValue(QOpcUaNode *node)
+QOpcUaMonitoredValue *QOpen62541Subscription::addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters,
+                                                      QOpcUaValueSink *sink)
 {
     if (!ensureNativeSubscription())
         return nullptr;
 
-    QOpen62541Node *open62541node = static_cast<QOpen62541Node *>(node->d_func()->m_impl.data());
-    UA_UInt32 monitoredItemId = 0;
-    UA_StatusCode ret = UA_Client_Subscriptions_addMonitoredItem(m_backend->m_uaclient, m_subscriptionId,
-                                                                 open62541node->nativeNodeId(), UA_ATTRIBUTEID_VALUE,
-                                                                 monitoredValueHandler, this, &monitoredItemId);
-    if (ret != UA_STATUSCODE_GOOD) {
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not add monitored item:" << ret;
+    QOpcUaMonitoredValue *monitoredValue = new QOpcUaMonitoredValue(node, m_qsubscription);
+    monitoredValue->d_func()->m_sink = sink;
+
+    bool success = false;
+    QMetaObject::invokeMethod(m_backend, "addMonitoredValue",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, success),
+                              Q_ARG(QOpen62541Subscription *, this),
+                              Q_ARG(QOpcUaMonitoredValue *, monitoredValue),
+                              Q_ARG(QString, node->nodeId()),
+                              Q_ARG(QOpcUaMonitoringParameters, parameters));
+    if (!success) {
+        // Do not try to remove the value from the subscription again
+        monitoredValue->d_func()->m_subscription = nullptr;
+        delete monitoredValue;
         return nullptr;
     }
 
-    QOpcUaMonitoredValue *monitoredValue = new QOpcUaMonitoredValue(node, m_qsubscription);
-    if (m_dataChangeHandles.contains(monitoredItemId)) {
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "monitoredItemId already handled:" << monitoredItemId;
-    } else {
-        m_dataChangeHandles[monitoredItemId] = monitoredValue;
+    return monitoredValue;
+}
+
+void QOpen62541Subscription::removeValue(QOpcUaMonitoredValue *monitoredValue)
+{
+    if (!m_native)
+        return;
+
+    QMetaObject::invokeMethod(m_backend, "removeMonitoredValue",
+                              Qt::BlockingQueuedConnection,
+                              Q_ARG(QOpen62541Subscription *, this),
+                              Q_ARG(QOpcUaMonitoredValue *, monitoredValue));
+}
+
+bool QOpen62541Subscription::modify(const QOpcUaSubscriptionParameters &parameters, QOpcUaSubscriptionParameters *revised)
+{
+    if (!m_native) {
+        // The native subscription is attached lazily with the new parameters
+        m_parameters = parameters;
+        if (revised)
+            *revised = m_parameters;
+        return true;
     }
 
-    // Open62541 does not support automated subscriptions, hence we need to poll for the initial
-    // value.
-    UA_Client_Subscriptions_manuallySendPublishRequest(m_backend->m_uaclient);
-    QMetaObject::invokeMethod(m_backend, "activateSubscriptionTimer", Qt::QueuedConnection, Q_ARG(int, m_interval));
+    QOpcUa::UaStatusCode result = QOpcUa::UaStatusCode::BadUnexpectedError;
+    QMetaObject::invokeMethod(m_backend, "modifySubscription",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(QOpcUa::UaStatusCode, result),
+                              Q_ARG(QOpen62541Subscription *, this),
+                              Q_ARG(QOpcUaSubscriptionParameters, parameters));
+    if (result != QOpcUa::UaStatusCode::Good)
+        return false;
 
-    return monitoredValue;
+    if (revised)
+        *revised = m_parameters;
+    return true;
 }
 
-void QOpen62541Subscription::removeValue(QOpcUaMonitoredValue *monitoredValue)
+bool QOpen62541Subscription::modifyMonitoredValues(const QVector<QOpcUaMonitoredValue *> &values,
+                                                   const QOpcUaMonitoringParameters &parameters,
+                                                   QVector<QOpcUa::UaStatusCode> *results)
 {
-    auto it = m_dataChangeHandles.begin();
-    while (it != m_dataChangeHandles.end()) {
-        if (it.value() == monitoredValue) {
-            UA_StatusCode ret = UA_Client_Subscriptions_removeMonitoredItem(m_backend->m_uaclient, m_subscriptionId, it.key());
-            if (ret != UA_STATUSCODE_GOOD) {
-                qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not remove monitored value from subscription:" << it.key();
-            }
-            m_dataChangeHandles.erase(it);
-            QMetaObject::invokeMethod(m_backend, "removeSubscriptionTimer", Qt::QueuedConnection, Q_ARG(int, m_interval));
-            break;
-        }
-        ++it;
+    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::BadNothingToDo;
+    QVector<QOpcUa::UaStatusCode> itemResults;
+    if (m_native) {
+        QMetaObject::invokeMethod(m_backend, "modifyMonitoredValues",
+                                  Qt::BlockingQueuedConnection,
+                                  Q_RETURN_ARG(QOpcUa::UaStatusCode, serviceResult),
+                                  Q_ARG(QOpen62541Subscription *, this),
+                                  Q_ARG(QVector<QOpcUaMonitoredValue *>, values),
+                                  Q_ARG(QOpcUaMonitoringParameters, parameters),
+                                  Q_ARG(QVector<QOpcUa::UaStatusCode> *, &itemResults));
     }
+    if (itemResults.size() != values.size())
+        itemResults.fill(serviceResult, values.size());
+
+    if (results)
+        *results = itemResults;
+    return serviceResult == QOpcUa::UaStatusCode::Good;
 }
 
-void QOpen62541Subscription::monitoredValueUpdated(UA_UInt32 monId, UA_DataValue *value)
+bool QOpen62541Subscription::setMonitoringMode(const QVector<QOpcUaMonitoredValue *> &values, QOpcUa::MonitoringMode mode,
+                                               QVector<QOpcUa::UaStatusCode> *results)
 {
-    auto monitoredValue = m_dataChangeHandles.find(monId);
-    if (monitoredValue == m_dataChangeHandles.end()) {
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not find object for monitoredItemId:" << monId;
-        return;
+    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::BadNothingToDo;
+    QVector<QOpcUa::UaStatusCode> itemResults;
+    if (m_native) {
+        QMetaObject::invokeMethod(m_backend, "setMonitoringMode",
+                                  Qt::BlockingQueuedConnection,
+                                  Q_RETURN_ARG(QOpcUa::UaStatusCode, serviceResult),
+                                  Q_ARG(QOpen62541Subscription *, this),
+                                  Q_ARG(QVector<QOpcUaMonitoredValue *>, values),
+                                  Q_ARG(QOpcUa::MonitoringMode, mode),
+                                  Q_ARG(QVector<QOpcUa::UaStatusCode> *, &itemResults));
     }
+    if (itemResults.size() != values.size())
+        itemResults.fill(serviceResult, values.size());
 
-    if (!value || !value->hasValue)
-        return;
+    if (results)
+        *results = itemResults;
+    return serviceResult == QOpcUa::UaStatusCode::Good;
+}
+
+bool QOpen62541Subscription::setTriggering(QOpcUaMonitoredValue *trigger, const QVector<QOpcUaMonitoredValue *> &linksToAdd,
+                                           const QVector<QOpcUaMonitoredValue *> &linksToRemove,
+                                           QVector<QOpcUa::UaStatusCode> *addResults,
+                                           QVector<QOpcUa::UaStatusCode> *removeResults)
+{
+    QOpcUa::UaStatusCode serviceResult = QOpcUa::UaStatusCode::BadNothingToDo;
+    QVector<QOpcUa::UaStatusCode> addItemResults;
+    QVector<QOpcUa::UaStatusCode> removeItemResults;
+    if (m_native) {
+        QMetaObject::invokeMethod(m_backend, "setTriggering",
+                                  Qt::BlockingQueuedConnection,
+                                  Q_RETURN_ARG(QOpcUa::UaStatusCode, serviceResult),
+                                  Q_ARG(QOpen62541Subscription *, this),
+                                  Q_ARG(QOpcUaMonitoredValue *, trigger),
+                                  Q_ARG(QVector<QOpcUaMonitoredValue *>, linksToAdd),
+                                  Q_ARG(QVector<QOpcUaMonitoredValue *>, linksToRemove),
+                                  Q_ARG(QVector<QOpcUa::UaStatusCode> *, &addItemResults),
+                                  Q_ARG(QVector<QOpcUa::UaStatusCode> *, &removeItemResults));
+    }
+    if (addItemResults.size() != linksToAdd.size())
+        addItemResults.fill(serviceResult, linksToAdd.size());
+    if (removeItemResults.size() != linksToRemove.size())
+        removeItemResults.fill(serviceResult, linksToRemove.size());
 
-    QVariant var = QOpen62541ValueConverter::toQVariant(value->value);
-    if (var.isValid())
-        (*monitoredValue)->d_func()->triggerValueChanged(var);
-    else
-        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not convert value for node:" << (*monitoredValue)->node().nodeId();
+    if (addResults)
+        *addResults = addItemResults;
+    if (removeResults)
+        *removeResults = removeItemResults;
+    return serviceResult == QOpcUa::UaStatusCode::Good;
 }
 
 bool QOpen62541Subscription::ensureNativeSubscription()
 {
-    if (m_subscriptionId == 0) {
-        QMetaObject::invokeMethod(m_backend, "createSubscription",
+    if (!m_native) {
+        QMetaObject::invokeMethod(m_backend, "attachSubscription",
                                   Qt::BlockingQueuedConnection,
-                                  Q_RETURN_ARG(UA_UInt32, m_subscriptionId),
-                                  Q_ARG(int, m_interval));
+                                  Q_ARG(QOpen62541Subscription *, this));
     }
-    return m_subscriptionId != 0;
+    return m_native != nullptr;
 }
 
 void QOpen62541Subscription::removeNativeSubscription()
 {
-    if (m_subscriptionId != 0) {
-        QMetaObject::invokeMethod(m_backend, "deleteSubscription",
+    if (m_native) {
+        QMetaObject::invokeMethod(m_backend, "detachSubscription",
                                   Qt::BlockingQueuedConnection,
-                                  Q_ARG(UA_UInt32, m_subscriptionId));
-        m_subscriptionId = 0;
+                                  Q_ARG(QOpen62541Subscription *, this));
     }
 }
 
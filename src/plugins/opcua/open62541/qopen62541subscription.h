@@ -38,41 +38,139 @@
 #define QOPEN62541SUBSCRIPTION_H
 
 #include "qopen62541.h"
+#include <QtOpcUa/qopcuadatachangenotification.h>
 #include <QtOpcUa/qopcuamonitoredevent.h>
 #include <QtOpcUa/qopcuamonitoredvalue.h>
 #include <private/qopcuasubscriptionimpl_p.h>
 
+#include <QtCore/qhash.h>
+#include <QtCore/qvector.h>
+
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 class QOpen62541Client;
+class QOpcUaStringCache;
+class QOpen62541TypeDictionary;
 class Open62541AsyncBackend;
 
+// Sequence numbers wrap around to 1, 0 is never used
+static inline UA_UInt32 nextSequenceNumber(UA_UInt32 sequenceNumber)
+{
+    return sequenceNumber == std::numeric_limits<UA_UInt32>::max() ? 1 : sequenceNumber + 1;
+}
+
+// A monitored item on the server. Monitored values with equal node id and
+// parameters share a single item, events and typed values always get an item of their own.
+struct QOpen62541MonitoredItem
+{
+    UA_UInt32 monitoredItemId;
+    UA_UInt32 clientHandle;
+    QString nodeId;
+    QOpcUaMonitoringParameters parameters;
+    QOpcUaMonitoringParameters revisedParameters;
+    QOpcUaEventFilter eventFilter;
+    QVector<QOpcUaMonitoredValue *> values;
+    QOpcUaMonitoredEvent *event;
+    // Set once the monitoring mode or triggering links have been changed for a
+    // single value, the item can not be shared anymore afterwards.
+    bool exclusive;
+    // The last data change is handed to values which join the item later
+    bool hasValue;
+    QOpcUaDataChangeNotification lastValue;
+    // Mirrored by the hot standby session, the revision changes with the parameters
+    // and the triggering links
+    QOpcUa::MonitoringMode monitoringMode;
+    quint32 revision;
+    // The client handles of the items linked to this triggering item, restored with the item
+    QVector<UA_UInt32> triggeredItems;
+
+    QOpen62541MonitoredItem()
+        : monitoredItemId(0)
+        , clientHandle(0)
+        , event(nullptr)
+        , exclusive(false)
+        , hasValue(false)
+        , monitoringMode(QOpcUa::MonitoringMode::Reporting)
+        , revision(0)
+    {}
+};
+
+// A subscription on the server, shared by all QOpen62541Subscription objects with
+// equal requested parameters. Only used on the backend thread.
+class QOpen62541NativeSubscription
+{
+public:
+    explicit QOpen62541NativeSubscription(const QOpcUaSubscriptionParameters &requestedParameters);
+    ~QOpen62541NativeSubscription();
+
+    QOpen62541MonitoredItem *findShareableItem(const QString &nodeId, const QOpcUaMonitoringParameters &parameters) const;
+    QOpen62541MonitoredItem *addItem(const QString &nodeId);
+    void removeItem(QOpen62541MonitoredItem *item);
+
+    void processNotificationMessage(const UA_NotificationMessage &message, bool typedArrays,
+                                    const QOpen62541TypeDictionary *types, QOpcUaStringCache *strings);
+
+    QOpcUaSubscriptionParameters m_requestedParameters;
+    QOpcUaSubscriptionParameters m_parameters;
+    UA_UInt32 m_subscriptionId;
+    UA_UInt32 m_nextClientHandle;
+    UA_UInt32 m_lastSequenceNumber;
+    int m_refCount;
+    QHash<UA_UInt32, QOpen62541MonitoredItem *> m_items;
+    QHash<QOpcUaMonitoredValue *, QOpen62541MonitoredItem *> m_valueItems;
+    QHash<QOpcUaMonitoredEvent *, QOpen62541MonitoredItem *> m_eventItems;
+
+private:
+    void dataChanged(QOpen62541MonitoredItem *item, const UA_DataValue *value, bool typedArrays,
+                     const QOpen62541TypeDictionary *types, QOpcUaStringCache *strings);
+    void eventsReceived(const UA_EventNotificationList &notification, const QOpen62541TypeDictionary *types,
+                        QOpcUaStringCache *strings);
+    void reportSequenceGap();
+};
+
 class QOpen62541Subscription : public QOpcUaSubscriptionImpl
 {
 public:
     explicit QOpen62541Subscription(Open62541AsyncBackend *backend, quint32 interval);
     ~QOpen62541Subscription() override;
 
-    QOpcUaMonitoredEvent *addEvent(QOpcUaNode *node) override;
+    QOpcUaMonitoredEvent *addEvent(QOpcUaNode *node, const QOpcUaEventFilter &filter) override;
     void removeEvent(QOpcUaMonitoredEvent *event) override;
 
-    QOpcUaMonitoredValue *addValue(QOpcUaNode *node) override;
+    QOpcUaMonitoredValue *addValue(QOpcUaNode *node, const QOpcUaMonitoringParameters &parameters,
+                                   QOpcUaValueSink *sink) override;
     void removeValue(QOpcUaMonitoredValue *v) override;
 
-    void monitoredValueUpdated(UA_UInt32 monId, UA_DataValue *value);
+    bool setMonitoringMode(const QVector<QOpcUaMonitoredValue *> &values, QOpcUa::MonitoringMode mode,
+                           QVector<QOpcUa::UaStatusCode> *results) override;
+    bool setTriggering(QOpcUaMonitoredValue *trigger, const QVector<QOpcUaMonitoredValue *> &linksToAdd,
+                       const QVector<QOpcUaMonitoredValue *> &linksToRemove,
+                       QVector<QOpcUa::UaStatusCode> *addResults,
+                       QVector<QOpcUa::UaStatusCode> *removeResults) override;
+
+    bool modify(const QOpcUaSubscriptionParameters &parameters, QOpcUaSubscriptionParameters *revised) override;
+    bool modifyMonitoredValues(const QVector<QOpcUaMonitoredValue *> &values, const QOpcUaMonitoringParameters &parameters,
+                               QVector<QOpcUa::UaStatusCode> *results) override;
 
     QOpcUaSubscription *m_qsubscription;
 
+    // The requested parameters until a native subscription is attached, the
+    // revised parameters of the native subscription afterwards.
+    QOpcUaSubscriptionParameters m_parameters;
+    // Owned by the backend and only modified on the backend thread
+    QOpen62541NativeSubscription *m_native;
+
 private:
     bool ensureNativeSubscription();
     void removeNativeSubscription();
     Open62541AsyncBackend *m_backend;
-    quint32 m_interval;
-    UA_UInt32 m_subscriptionId;
-    QMap<UA_UInt32, QOpcUaMonitoredValue *> m_dataChangeHandles;
-    QMap<UA_UInt32, QOpcUaMonitoredEvent *> m_eventHandles;
 };
 
 QT_END_NAMESPACE
 
+Q_DECLARE_METATYPE(QOpen62541Subscription *)
+Q_DECLARE_METATYPE(QVector<QOpcUa::UaStatusCode> *)
+
 #endif // QOPEN62541SUBSCRIPTION_H
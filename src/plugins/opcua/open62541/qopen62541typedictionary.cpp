@@ -0,0 +1,660 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopen62541typedictionary.h"
+#include "qopen62541utils.h"
+#include "qopen62541valueconverter.h"
+#include <QtOpcUa/qopcuastructuredvalue.h>
+#include <QtOpcUa/qopcuatype.h>
+
+#include <QtCore/qendian.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qset.h>
+#include <QtCore/quuid.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/qxmlstream.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
+
+static const QLatin1String binarySchemaNamespace("http://opcfoundation.org/BinarySchema/");
+static const QLatin1String uaNamespace("http://opcfoundation.org/UA/");
+
+// Nested structures deeper than this are treated as malformed
+static const int maximumDepth = 32;
+
+static QString qualifiedName(const QString &namespaceUri, const QString &name)
+{
+    return namespaceUri + QLatin1Char('#') + name;
+}
+
+static quint64 numericKey(quint16 namespaceIndex, quint32 identifier)
+{
+    return (quint64(namespaceIndex) << 32) | identifier;
+}
+
+// Reads the binary encoding of the built-in types, see OPC UA part 6, 5.2.2
+class QOpen62541TypeDictionary::Reader
+{
+public:
+    Reader(const UA_Byte *data, size_t length)
+        : m_pos(data)
+        , m_end(data + length)
+        , m_bitOffset(0)
+    {}
+
+    qint64 remaining() const { return m_end - m_pos; }
+
+    template<typename T>
+    bool read(T *value)
+    {
+        alignToByte();
+        if (remaining() < qint64(sizeof(T)))
+            return false;
+        *value = qFromLittleEndian<T>(m_pos);
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool readFloat(float *value)
+    {
+        quint32 bits;
+        if (!read(&bits))
+            return false;
+        std::memcpy(value, &bits, sizeof(bits));
+        return true;
+    }
+
+    bool readDouble(double *value)
+    {
+        quint64 bits;
+        if (!read(&bits))
+            return false;
+        std::memcpy(value, &bits, sizeof(bits));
+        return true;
+    }
+
+    // Bits are packed starting with the least significant bit of a byte
+    bool readBits(int count, qint64 *value)
+    {
+        *value = 0;
+        for (int i = 0; i < count; ++i) {
+            if (m_pos >= m_end)
+                return false;
+            if (*m_pos & (1 << m_bitOffset))
+                *value |= qint64(1) << i;
+            if (++m_bitOffset == 8) {
+                m_bitOffset = 0;
+                ++m_pos;
+            }
+        }
+        return true;
+    }
+
+    // A length of -1 is a null value
+    bool readBytes(const char **data, qint32 *length)
+    {
+        if (!read(length))
+            return false;
+        if (*length < 0) {
+            *data = nullptr;
+            return true;
+        }
+        if (remaining() < *length)
+            return false;
+        *data = reinterpret_cast<const char *>(m_pos);
+        m_pos += *length;
+        return true;
+    }
+
+    bool readString(QString *value)
+    {
+        const char *data;
+        qint32 length;
+        if (!readBytes(&data, &length))
+            return false;
+        *value = data ? QString::fromUtf8(data, length) : QString();
+        return true;
+    }
+
+    bool readByteString(QByteArray *value)
+    {
+        const char *data;
+        qint32 length;
+        if (!readBytes(&data, &length))
+            return false;
+        *value = data ? QByteArray(data, length) : QByteArray();
+        return true;
+    }
+
+    bool readGuid(QUuid *value)
+    {
+        quint32 data1;
+        quint16 data2;
+        quint16 data3;
+        if (!read(&data1) || !read(&data2) || !read(&data3) || remaining() < 8)
+            return false;
+        *value = QUuid(data1, data2, data3, m_pos[0], m_pos[1], m_pos[2], m_pos[3], m_pos[4], m_pos[5], m_pos[6], m_pos[7]);
+        m_pos += 8;
+        return true;
+    }
+
+    // The flags of an ExpandedNodeId are only accepted if expanded is set
+    bool readNodeId(QString *value, bool expanded)
+    {
+        quint8 encoding;
+        if (!read(&encoding))
+            return false;
+        if (!expanded && (encoding & 0xC0))
+            return false;
+
+        UA_NodeId id;
+        UA_NodeId_init(&id);
+        QByteArray bytes;
+        QUuid guid;
+        bool ok = true;
+        switch (encoding & 0x3F) {
+        case 0: {
+            quint8 identifier;
+            ok = read(&identifier);
+            id.identifier.numeric = identifier;
+            break;
+        }
+        case 1: {
+            quint8 namespaceIndex;
+            quint16 identifier;
+            ok = read(&namespaceIndex) && read(&identifier);
+            id.namespaceIndex = namespaceIndex;
+            id.identifier.numeric = identifier;
+            break;
+        }
+        case 2:
+            ok = read(&id.namespaceIndex) && read(&id.identifier.numeric);
+            break;
+        case 3:
+        case 5: {
+            // The identifier is borrowed from the buffer, id must not be cleaned up with deleteMembers
+            const char *data;
+            qint32 length;
+            ok = read(&id.namespaceIndex) && readBytes(&data, &length);
+            if (ok) {
+                bytes = QByteArray::fromRawData(data, qMax(length, 0));
+                id.identifierType = (encoding & 0x3F) == 3 ? UA_NODEIDTYPE_STRING : UA_NODEIDTYPE_BYTESTRING;
+                id.identifier.string.length = bytes.size();
+                id.identifier.string.data = reinterpret_cast<UA_Byte *>(const_cast<char *>(bytes.constData()));
+            }
+            break;
+        }
+        case 4:
+            ok = read(&id.namespaceIndex) && readGuid(&guid);
+            id.identifierType = UA_NODEIDTYPE_GUID;
+            break;
+        default:
+            return false;
+        }
+        if (!ok)
+            return false;
+
+        // The namespace URI and server index of an ExpandedNodeId are not part of the node id string
+        if (encoding & 0x80) {
+            QString namespaceUri;
+            if (!readString(&namespaceUri))
+                return false;
+        }
+        if (encoding & 0x40) {
+            quint32 serverIndex;
+            if (!read(&serverIndex))
+                return false;
+        }
+
+        if (id.identifierType == UA_NODEIDTYPE_GUID)
+            *value = QStringLiteral("ns=%1;g=%2").arg(id.namespaceIndex).arg(guid.toString().mid(1, 36));
+        else if (id.identifierType == UA_NODEIDTYPE_BYTESTRING)
+            *value = QStringLiteral("ns=%1;b=%2").arg(id.namespaceIndex).arg(QString::fromLatin1(bytes.toBase64()));
+        else
+            *value = Open62541Utils::nodeIdToQString(id);
+        return true;
+    }
+
+private:
+    void alignToByte()
+    {
+        if (m_bitOffset) {
+            m_bitOffset = 0;
+            ++m_pos;
+        }
+    }
+
+    const UA_Byte *m_pos;
+    const UA_Byte *m_end;
+    int m_bitOffset;
+};
+
+QOpen62541TypeDictionary::QOpen62541TypeDictionary()
+{}
+
+// Parses the StructuredType and EnumeratedType definitions of an opc:TypeDictionary and returns
+// its target namespace, or a null string on error. The types are resolved by compile() after
+// all dictionaries of the server have been added.
+QString QOpen62541TypeDictionary::addDictionary(const QByteArray &xml)
+{
+    QXmlStreamReader reader(xml);
+    QString targetNamespace;
+    QHash<QString, QString> prefixes;
+
+    // Type names are qualified with a prefix declared on the root element
+    auto resolve = [&](const QString &name) {
+        const int colon = name.indexOf(QLatin1Char(':'));
+        if (colon < 0)
+            return qualifiedName(targetNamespace, name);
+        return qualifiedName(prefixes.value(name.left(colon)), name.mid(colon + 1));
+    };
+
+    Plan *current = nullptr;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isEndElement() && reader.name() == QLatin1String("StructuredType")) {
+            current = nullptr;
+            continue;
+        }
+        if (!reader.isStartElement())
+            continue;
+
+        const QXmlStreamAttributes attributes = reader.attributes();
+        if (reader.name() == QLatin1String("TypeDictionary")) {
+            targetNamespace = attributes.value(QLatin1String("TargetNamespace")).toString();
+            for (const QXmlStreamNamespaceDeclaration &declaration : reader.namespaceDeclarations())
+                prefixes.insert(declaration.prefix().toString(), declaration.namespaceUri().toString());
+        } else if (reader.name() == QLatin1String("EnumeratedType")) {
+            const QString name = resolve(attributes.value(QLatin1String("Name")).toString());
+            const QStringRef bits = attributes.value(QLatin1String("LengthInBits"));
+            m_enumerations.insert(name, bits.isEmpty() || bits == QLatin1String("32") ? Int32 : Unsupported);
+        } else if (reader.name() == QLatin1String("StructuredType")) {
+            Plan plan;
+            plan.typeName = attributes.value(QLatin1String("Name")).toString();
+            plan.valid = false;
+            m_planIndex.insert(qualifiedName(targetNamespace, plan.typeName), m_plans.size());
+            m_plans.append(plan);
+            current = &m_plans.last();
+        } else if (reader.name() == QLatin1String("Field") && current) {
+            Field field;
+            field.name = attributes.value(QLatin1String("Name")).toString();
+            field.typeName = resolve(attributes.value(QLatin1String("TypeName")).toString());
+            field.lengthField = attributes.value(QLatin1String("LengthField")).toString();
+            field.switchField = attributes.value(QLatin1String("SwitchField")).toString();
+            field.hasSwitchValue = attributes.hasAttribute(QLatin1String("SwitchValue"));
+            const QStringRef length = attributes.value(QLatin1String("Length"));
+            field.bitLength = length.isEmpty() ? 1 : length.toInt();
+            current->fields.append(field);
+        }
+    }
+
+    if (reader.hasError()) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Could not parse type dictionary:" << reader.errorString();
+        return QString();
+    }
+    return targetNamespace;
+}
+
+void QOpen62541TypeDictionary::addEncoding(const UA_NodeId &encodingId, const QString &namespaceUri, const QString &typeName)
+{
+    const int plan = m_planIndex.value(qualifiedName(namespaceUri, typeName), -1);
+    if (plan < 0)
+        return;
+
+    const Encoding encoding = { plan, Open62541Utils::nodeIdToQString(encodingId) };
+    if (encodingId.identifierType == UA_NODEIDTYPE_NUMERIC)
+        m_numericEncodings.insert(numericKey(encodingId.namespaceIndex, encodingId.identifier.numeric), encoding);
+    else if (!encoding.encodingId.isEmpty())
+        m_encodings.insert(encoding.encodingId, encoding);
+}
+
+QOpen62541TypeDictionary::Kind QOpen62541TypeDictionary::resolveKind(const QString &typeName, int *structure) const
+{
+    static const QHash<QString, Kind> builtinTypes = {
+        { QStringLiteral("Boolean"), Boolean }, { QStringLiteral("SByte"), SByte }, { QStringLiteral("Byte"), Byte },
+        { QStringLiteral("Int16"), Int16 }, { QStringLiteral("UInt16"), UInt16 }, { QStringLiteral("Int32"), Int32 },
+        { QStringLiteral("UInt32"), UInt32 }, { QStringLiteral("Int64"), Int64 }, { QStringLiteral("UInt64"), UInt64 },
+        { QStringLiteral("Float"), Float }, { QStringLiteral("Double"), Double }, { QStringLiteral("String"), String },
+        { QStringLiteral("CharArray"), String }, { QStringLiteral("XmlElement"), String },
+        { QStringLiteral("ByteString"), ByteString }, { QStringLiteral("DateTime"), DateTime },
+        { QStringLiteral("Guid"), Guid }, { QStringLiteral("StatusCode"), StatusCode }, { QStringLiteral("NodeId"), NodeId },
+        { QStringLiteral("ExpandedNodeId"), ExpandedNodeId }, { QStringLiteral("LocalizedText"), LocalizedText },
+        { QStringLiteral("QualifiedName"), QualifiedName }, { QStringLiteral("Bit"), Bit }
+    };
+
+    *structure = m_planIndex.value(typeName, -1);
+    if (*structure >= 0)
+        return Structure;
+
+    const auto enumeration = m_enumerations.constFind(typeName);
+    if (enumeration != m_enumerations.constEnd())
+        return enumeration.value();
+
+    const int separator = typeName.indexOf(QLatin1Char('#'));
+    const QStringRef namespaceUri = typeName.leftRef(separator);
+    if (namespaceUri != binarySchemaNamespace && namespaceUri != uaNamespace)
+        return Unsupported;
+    return builtinTypes.value(typeName.mid(separator + 1), Unsupported);
+}
+
+// Translates the field definitions into decode steps. Fields which hold the length
+// of an array or enable an optional field are read as integers and are not part of the value.
+void QOpen62541TypeDictionary::compile()
+{
+    for (Plan &plan : m_plans) {
+        QSet<QString> controlFields;
+        for (const Field &field : qAsConst(plan.fields)) {
+            if (!field.lengthField.isEmpty())
+                controlFields.insert(field.lengthField);
+            if (!field.switchField.isEmpty())
+                controlFields.insert(field.switchField);
+        }
+
+        QHash<QString, int> stepIndex;
+        plan.steps.clear();
+        plan.fieldNames.clear();
+        plan.valid = true;
+        for (const Field &field : qAsConst(plan.fields)) {
+            Step step;
+            step.kind = resolveKind(field.typeName, &step.structure);
+            step.lengthStep = field.lengthField.isEmpty() ? -1 : stepIndex.value(field.lengthField, -2);
+            step.switchStep = field.switchField.isEmpty() ? -1 : stepIndex.value(field.switchField, -2);
+            step.bitLength = field.bitLength;
+            step.output = -1;
+
+            if (step.kind == Unsupported || step.lengthStep == -2 || step.switchStep == -2 || field.hasSwitchValue) {
+                plan.valid = false;
+                break;
+            }
+            if (controlFields.contains(field.name)) {
+                if (step.kind > Int64 && step.kind != Bit) {
+                    plan.valid = false;
+                    break;
+                }
+            } else if (step.kind != Bit) {
+                step.output = plan.fieldNames.size();
+                plan.fieldNames.append(field.name);
+            }
+            stepIndex.insert(field.name, plan.steps.size());
+            plan.steps.append(step);
+        }
+
+        if (!plan.valid)
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Structure" << plan.typeName << "uses unsupported field types and can't be decoded";
+    }
+}
+
+bool QOpen62541TypeDictionary::isEmpty() const
+{
+    return m_numericEncodings.isEmpty() && m_encodings.isEmpty();
+}
+
+const QOpen62541TypeDictionary::Encoding *QOpen62541TypeDictionary::findEncoding(const UA_NodeId &encodingId) const
+{
+    if (encodingId.identifierType == UA_NODEIDTYPE_NUMERIC) {
+        const auto it = m_numericEncodings.constFind(numericKey(encodingId.namespaceIndex, encodingId.identifier.numeric));
+        return it != m_numericEncodings.constEnd() ? &it.value() : nullptr;
+    }
+    const auto it = m_encodings.constFind(Open62541Utils::nodeIdToQString(encodingId));
+    return it != m_encodings.constEnd() ? &it.value() : nullptr;
+}
+
+// Returns an invalid QVariant if the structure is unknown or the body is malformed
+QVariant QOpen62541TypeDictionary::decode(const UA_ExtensionObject &object) const
+{
+    if (object.encoding != UA_EXTENSIONOBJECT_ENCODED_BYTESTRING)
+        return QVariant();
+
+    const Encoding *encoding = findEncoding(object.content.encoded.typeId);
+    if (!encoding)
+        return QVariant();
+
+    Reader reader(object.content.encoded.body.data, object.content.encoded.body.length);
+    QVariant result;
+    if (!decodeStructure(encoding->plan, &reader, 0, encoding->encodingId, &result))
+        return QVariant();
+    return result;
+}
+
+bool QOpen62541TypeDictionary::decodeStructure(int planIndex, Reader *reader, int depth, const QString &encodingId,
+                                               QVariant *result) const
+{
+    const Plan &plan = m_plans.at(planIndex);
+    if (!plan.valid || depth > maximumDepth)
+        return false;
+
+    QVarLengthArray<qint64, 32> integers(plan.steps.size());
+    QVector<QVariant> fields(plan.fieldNames.size());
+    for (int i = 0; i < plan.steps.size(); ++i) {
+        const Step &step = plan.steps.at(i);
+        integers[i] = 0;
+
+        // An optional field which is not present
+        if (step.switchStep >= 0 && integers[step.switchStep] == 0)
+            continue;
+
+        if (step.output < 0) {
+            if (step.kind == Bit) {
+                if (!reader->readBits(step.bitLength, &integers[i]))
+                    return false;
+                continue;
+            }
+            QVariant value;
+            if (!decodeValue(step, reader, depth, &value))
+                return false;
+            integers[i] = value.toLongLong();
+            continue;
+        }
+
+        if (step.lengthStep < 0) {
+            if (!decodeValue(step, reader, depth, &fields[step.output]))
+                return false;
+            continue;
+        }
+
+        // Every element needs at least one byte, a larger length is malformed
+        const qint64 length = integers[step.lengthStep];
+        if (length > reader->remaining())
+            return false;
+        QVariantList list;
+        list.reserve(int(qMax<qint64>(length, 0)));
+        for (qint64 j = 0; j < length; ++j) {
+            QVariant element;
+            if (!decodeValue(step, reader, depth, &element))
+                return false;
+            list.append(element);
+        }
+        fields[step.output] = list;
+    }
+
+    *result = QVariant::fromValue(QOpcUaStructuredValue(plan.typeName, encodingId, plan.fieldNames, fields));
+    return true;
+}
+
+bool QOpen62541TypeDictionary::decodeValue(const Step &step, Reader *reader, int depth, QVariant *result) const
+{
+    switch (step.kind) {
+    case Boolean: {
+        quint8 value;
+        if (!reader->read(&value))
+            return false;
+        *result = value != 0;
+        return true;
+    }
+    case SByte: {
+        qint8 value;
+        if (!reader->read(&value))
+            return false;
+        *result = QVariant::fromValue(value);
+        return true;
+    }
+    case Byte: {
+        quint8 value;
+        if (!reader->read(&value))
+            return false;
+        *result = QVariant::fromValue(value);
+        return true;
+    }
+    case Int16: {
+        qint16 value;
+        if (!reader->read(&value))
+            return false;
+        *result = QVariant::fromValue(value);
+        return true;
+    }
+    case UInt16: {
+        quint16 value;
+        if (!reader->read(&value))
+            return false;
+        *result = QVariant::fromValue(value);
+        return true;
+    }
+    case Int32: {
+        qint32 value;
+        if (!reader->read(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case UInt32:
+    case StatusCode: {
+        quint32 value;
+        if (!reader->read(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case Int64: {
+        qint64 value;
+        if (!reader->read(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case UInt64: {
+        quint64 value;
+        if (!reader->read(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case Float: {
+        float value;
+        if (!reader->readFloat(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case Double: {
+        double value;
+        if (!reader->readDouble(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case String: {
+        QString value;
+        if (!reader->readString(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case ByteString: {
+        QByteArray value;
+        if (!reader->readByteString(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case DateTime: {
+        qint64 ticks;
+        if (!reader->read(&ticks))
+            return false;
+        const UA_DateTime value = ticks;
+        *result = QOpen62541ValueConverter::toQDateTime(&value);
+        return true;
+    }
+    case Guid: {
+        QUuid value;
+        if (!reader->readGuid(&value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case NodeId:
+    case ExpandedNodeId: {
+        QString value;
+        if (!reader->readNodeId(&value, step.kind == ExpandedNodeId))
+            return false;
+        *result = value;
+        return true;
+    }
+    case LocalizedText: {
+        quint8 mask;
+        QOpcUa::QLocalizedText value;
+        if (!reader->read(&mask) || ((mask & 0x01) && !reader->readString(&value.locale))
+                || ((mask & 0x02) && !reader->readString(&value.text)))
+            return false;
+        *result = QVariant::fromValue(value);
+        return true;
+    }
+    case QualifiedName: {
+        QOpcUa::QQualifiedName value;
+        if (!reader->read(&value.namespaceIndex) || !reader->readString(&value.name))
+            return false;
+        *result = QVariant::fromValue(value);
+        return true;
+    }
+    case Structure:
+        return decodeStructure(step.structure, reader, depth + 1, QString(), result);
+    case Bit: {
+        qint64 value;
+        if (!reader->readBits(step.bitLength, &value))
+            return false;
+        *result = value;
+        return true;
+    }
+    case Unsupported:
+        break;
+    }
+    return false;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QOPEN62541TYPEDICTIONARY_H
+#define QOPEN62541TYPEDICTIONARY_H
+
+#include "qopen62541.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+// Decoders for the structured DataTypes of a server, compiled from its OPC binary type dictionaries.
+// The dictionary is built once per session on the backend thread and is not modified afterwards,
+// so values can be decoded on any thread.
+class QOpen62541TypeDictionary
+{
+public:
+    QOpen62541TypeDictionary();
+
+    QString addDictionary(const QByteArray &xml);
+    void addEncoding(const UA_NodeId &encodingId, const QString &namespaceUri, const QString &typeName);
+    void compile();
+
+    bool isEmpty() const;
+    QVariant decode(const UA_ExtensionObject &object) const;
+
+private:
+    enum Kind : quint8 {
+        Boolean, SByte, Byte, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double,
+        String, ByteString, DateTime, Guid, StatusCode, NodeId, ExpandedNodeId, LocalizedText,
+        QualifiedName, Structure, Bit, Unsupported
+    };
+
+    struct Field
+    {
+        QString name;
+        QString typeName; // Qualified with the namespace of the type
+        QString lengthField;
+        QString switchField;
+        int bitLength;
+        bool hasSwitchValue;
+    };
+
+    // One field of a compiled plan
+    struct Step
+    {
+        Kind kind;
+        int structure;  // Plan of a nested structure
+        int lengthStep; // Step holding the length of an array, -1 for scalars
+        int switchStep; // Step enabling an optional field, -1 if the field is always present
+        int bitLength;
+        int output;     // Index in the decoded fields, -1 for lengths and switches
+    };
+
+    struct Plan
+    {
+        QString typeName;
+        QStringList fieldNames;
+        QVector<Field> fields;
+        QVector<Step> steps;
+        bool valid;
+    };
+
+    struct Encoding
+    {
+        int plan;
+        QString encodingId;
+    };
+
+    class Reader;
+
+    Kind resolveKind(const QString &typeName, int *structure) const;
+    const Encoding *findEncoding(const UA_NodeId &encodingId) const;
+    bool decodeStructure(int planIndex, Reader *reader, int depth, const QString &encodingId, QVariant *result) const;
+    bool decodeValue(const Step &step, Reader *reader, int depth, QVariant *result) const;
+
+    QVector<Plan> m_plans;
+    QHash<QString, int> m_planIndex;
+    QHash<QString, Kind> m_enumerations;
+    // Most encodings have a numeric node id, it is looked up without creating a string
+    QHash<quint64, Encoding> m_numericEncodings;
+    QHash<QString, Encoding> m_encodings;
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPEN62541TYPEDICTIONARY_H
@@ -39,13 +39,41 @@
 
 #include "qopen62541.h"
 
+#include <QtCore/qbytearray.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
 namespace Open62541Utils {
     UA_NodeId nodeIdFromQString(const QString &name);
     QString nodeIdToQString(UA_NodeId id);
+
+    // Points a member of an open62541 structure at memory owned by the caller. A structure
+    // filled by these functions, or holding shallow copies of node ids, only borrows that
+    // memory: it must not be cleaned up with deleteMembers, and the memory must stay valid
+    // until the service call or encoding using the structure has returned.
+    template <typename T>
+    inline void borrowArray(size_t *size, T **array, QVector<T> &data)
+    {
+        *size = data.size();
+        *array = data.data();
+    }
+
+    template <typename T>
+    inline void borrowArray(size_t *size, T **array, T *value)
+    {
+        *size = 1;
+        *array = value;
+    }
+
+    inline UA_String borrowString(QByteArray &data)
+    {
+        UA_String result;
+        result.length = data.size();
+        result.data = reinterpret_cast<UA_Byte *>(data.data());
+        return result;
+    }
 }
 
 QT_END_NAMESPACE
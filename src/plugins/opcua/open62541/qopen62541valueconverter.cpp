@@ -35,14 +35,22 @@
 ****************************************************************************/
 
 #include "qopen62541.h"
+#include "qopen62541typedictionary.h"
 #include "qopen62541utils.h"
 #include "qopen62541valueconverter.h"
+#include <QtOpcUa/qopcuamultidimensionalarray.h>
+#include <private/qopcuaarraykernels_p.h>
+#include <private/qopcuastringcache_p.h>
+#include <private/qopcuatypemapping_p.h>
 
 #include <QtCore/qdatetime.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/quuid.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/qvector.h>
 
 #include <cstring>
+#include <type_traits>
 
 QT_BEGIN_NAMESPACE
 
@@ -50,54 +58,221 @@ Q_DECLARE_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541)
 
 namespace QOpen62541ValueConverter {
 
+// Temporary request structures come from the arena if there is one, from the open62541 heap otherwise
+static void *newArray(size_t count, const UA_DataType *type, QOpen62541Arena *arena)
+{
+    return arena ? arena->allocateArray(count, type) : UA_Array_new(count, type);
+}
+
+static void *newScalar(const UA_DataType *type, QOpen62541Arena *arena)
+{
+    return arena ? arena->allocate(type->memSize) : UA_new(type);
+}
+
+static UA_ByteString copyBytes(const char *data, size_t length, QOpen62541Arena *arena)
+{
+    if (arena)
+        return arena->byteString(data, length);
+
+    UA_ByteString result;
+    UA_ByteString_init(&result);
+    if (length == 0) {
+        result.data = static_cast<UA_Byte *>(UA_EMPTY_ARRAY_SENTINEL);
+        return result;
+    }
+    result.data = static_cast<UA_Byte *>(UA_malloc(length));
+    if (result.data) {
+        std::memcpy(result.data, data, length);
+        result.length = length;
+    }
+    return result;
+}
+
+// The Qt and open62541 representation of every type, the converters are generated from these
+template<QOpcUa::Types> struct TypeTraits;
+
+#define Q_OPEN62541_TYPE_TRAITS(TYPE, QTTYPE, UATYPE) \
+    template<> struct TypeTraits<QOpcUa::TYPE> \
+    { \
+        typedef QTTYPE QtType; \
+        typedef UATYPE UaType; \
+    };
+
+Q_OPEN62541_TYPE_TRAITS(Boolean, bool, UA_Boolean)
+Q_OPEN62541_TYPE_TRAITS(Int32, qint32, UA_Int32)
+Q_OPEN62541_TYPE_TRAITS(UInt32, quint32, UA_UInt32)
+Q_OPEN62541_TYPE_TRAITS(Double, double, UA_Double)
+Q_OPEN62541_TYPE_TRAITS(Float, float, UA_Float)
+Q_OPEN62541_TYPE_TRAITS(String, QString, UA_String)
+Q_OPEN62541_TYPE_TRAITS(LocalizedText, QOpcUa::QLocalizedText, UA_LocalizedText)
+Q_OPEN62541_TYPE_TRAITS(DateTime, QDateTime, UA_DateTime)
+Q_OPEN62541_TYPE_TRAITS(UInt16, quint16, UA_UInt16)
+Q_OPEN62541_TYPE_TRAITS(Int16, qint16, UA_Int16)
+Q_OPEN62541_TYPE_TRAITS(UInt64, quint64, UA_UInt64)
+Q_OPEN62541_TYPE_TRAITS(Int64, qint64, UA_Int64)
+Q_OPEN62541_TYPE_TRAITS(Byte, quint8, UA_Byte)
+Q_OPEN62541_TYPE_TRAITS(SByte, qint8, UA_SByte)
+Q_OPEN62541_TYPE_TRAITS(ByteString, QByteArray, UA_ByteString)
+Q_OPEN62541_TYPE_TRAITS(XmlElement, QString, UA_XmlElement)
+Q_OPEN62541_TYPE_TRAITS(NodeId, QString, UA_NodeId)
+Q_OPEN62541_TYPE_TRAITS(Guid, QUuid, UA_Guid)
+Q_OPEN62541_TYPE_TRAITS(QualifiedName, QOpcUa::QQualifiedName, UA_QualifiedName)
+Q_OPEN62541_TYPE_TRAITS(StatusCode, QOpcUa::UaStatusCode, UA_StatusCode)
+
+#undef Q_OPEN62541_TYPE_TRAITS
+
+// Index into UA_TYPES, ordered like QOpcUa::Types
+static constexpr int uaTypeIndices[QOpcUaTypeMapping::TypeCount] = {
+    UA_TYPES_BOOLEAN,
+    UA_TYPES_INT32,
+    UA_TYPES_UINT32,
+    UA_TYPES_DOUBLE,
+    UA_TYPES_FLOAT,
+    UA_TYPES_STRING,
+    UA_TYPES_LOCALIZEDTEXT,
+    UA_TYPES_DATETIME,
+    UA_TYPES_UINT16,
+    UA_TYPES_INT16,
+    UA_TYPES_UINT64,
+    UA_TYPES_INT64,
+    UA_TYPES_BYTE,
+    UA_TYPES_SBYTE,
+    UA_TYPES_BYTESTRING,
+    UA_TYPES_XMLELEMENT,
+    UA_TYPES_NODEID,
+    UA_TYPES_GUID,
+    UA_TYPES_QUALIFIEDNAME,
+    UA_TYPES_STATUSCODE
+};
+
+static constexpr auto uaTypeIndexTable =
+        QOpcUaTypeMapping::inverseTable<QOpcUaTypeMapping::maximumValue(uaTypeIndices) + 1>(uaTypeIndices);
+
+// Numeric types have the same layout in Qt and open62541 and can be copied as a whole
+template<QOpcUa::Types T>
+struct IsContiguous : std::integral_constant<bool, std::is_arithmetic<typename TypeTraits<T>::QtType>::value> {};
+
+typedef UA_Variant (*FromQVariantFunction)(const QVariant &, const UA_DataType *, QOpen62541Arena *);
+typedef QVariant (*ToQVariantFunction)(const UA_Variant &, QOpcUaStringCache *);
+typedef QOpcUaVariant (*ToQOpcUaVariantFunction)(const UA_Variant &);
+
+template<QOpcUa::Types T>
+struct FromQVariantEntry
+{
+    static UA_Variant convert(const QVariant &value, const UA_DataType *type, QOpen62541Arena *arena)
+    {
+        return arrayFromQVariant<typename TypeTraits<T>::UaType, typename TypeTraits<T>::QtType>(value, type, arena);
+    }
+};
+
+template<QOpcUa::Types T, bool = IsContiguous<T>::value>
+struct FromQVectorEntryImpl
+{
+    static UA_Variant convert(const QVariant &value, const UA_DataType *type, QOpen62541Arena *arena)
+    {
+        return arrayFromQVector<typename TypeTraits<T>::UaType, typename TypeTraits<T>::QtType>(value, type, arena);
+    }
+};
+
+template<QOpcUa::Types T>
+struct FromQVectorEntryImpl<T, false>
+{
+    static UA_Variant convert(const QVariant &, const UA_DataType *, QOpen62541Arena *)
+    {
+        UA_Variant open62541value;
+        UA_Variant_init(&open62541value);
+        return open62541value;
+    }
+};
+
+template<QOpcUa::Types T>
+struct FromQVectorEntry : FromQVectorEntryImpl<T> {};
+
+static constexpr auto fromQVariantTable =
+        QOpcUaTypeMapping::dispatchTable<FromQVariantEntry, FromQVariantFunction>();
+static constexpr auto fromQVectorTable =
+        QOpcUaTypeMapping::dispatchTable<FromQVectorEntry, FromQVariantFunction>();
+
 QOpcUa::Types qvariantTypeToQOpcUaType(QMetaType::Type type)
 {
-    switch (type) {
-    case QMetaType::Bool:
+    return QOpcUaTypeMapping::fromMetaType(type);
+}
+
+// Returns the element type of a numeric QVector which can be copied to an open62541 array as a whole
+static QOpcUa::Types vectorElementType(int userType)
+{
+    if (userType == qMetaTypeId<QVector<bool>>())
         return QOpcUa::Boolean;
-    case QMetaType::UChar:
-        return QOpcUa::Byte;
-    case QMetaType::Char:
+    if (userType == qMetaTypeId<QVector<qint8>>())
         return QOpcUa::SByte;
-    case QMetaType::UShort:
-        return QOpcUa::UInt16;
-    case QMetaType::Short:
+    if (userType == qMetaTypeId<QVector<quint8>>())
+        return QOpcUa::Byte;
+    if (userType == qMetaTypeId<QVector<qint16>>())
         return QOpcUa::Int16;
-    case QMetaType::Int:
+    if (userType == qMetaTypeId<QVector<quint16>>())
+        return QOpcUa::UInt16;
+    if (userType == qMetaTypeId<QVector<qint32>>())
         return QOpcUa::Int32;
-    case QMetaType::UInt:
+    if (userType == qMetaTypeId<QVector<quint32>>())
         return QOpcUa::UInt32;
-    case QMetaType::ULongLong:
-        return QOpcUa::UInt64;
-    case QMetaType::LongLong:
+    if (userType == qMetaTypeId<QVector<qint64>>())
         return QOpcUa::Int64;
-    case QMetaType::Double:
-        return QOpcUa::Double;
-    case QMetaType::Float:
+    if (userType == qMetaTypeId<QVector<quint64>>())
+        return QOpcUa::UInt64;
+    if (userType == qMetaTypeId<QVector<float>>())
         return QOpcUa::Float;
-    case QMetaType::QString:
-        return QOpcUa::String;
-    //return QOpcUa::LocalizedText;  // TODO: unclear
-    case QMetaType::QDateTime:
-        return QOpcUa::DateTime;
-    case QMetaType::QByteArray:
-        return QOpcUa::ByteString;
-    case QMetaType::QUuid:
-        return QOpcUa::Guid;
-    //return QOpcUa::XmlElement;
-    //return QOpcUa::NodeId;
-    default:
-        break;
-    }
-
+    if (userType == qMetaTypeId<QVector<double>>())
+        return QOpcUa::Double;
     return QOpcUa::Undefined;
 }
 
-UA_Variant toOpen62541Variant(const QVariant &value, QOpcUa::Types type)
+static UA_Variant vectorToOpen62541Variant(const QVariant &value, QOpcUa::Types vectorType, QOpen62541Arena *arena)
+{
+    return fromQVectorTable.at(vectorType)(value, toDataType(vectorType), arena);
+}
+
+UA_Variant toOpen62541Variant(const QVariant &value, QOpcUa::Types type, QOpen62541Arena *arena)
 {
     UA_Variant open62541value;
     UA_Variant_init(&open62541value);
 
+    if (value.userType() == qMetaTypeId<QOpcUaMultiDimensionalArray>()) {
+        const QOpcUaMultiDimensionalArray array = value.value<QOpcUaMultiDimensionalArray>().compacted();
+        if (!array.isValid()) {
+            qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Invalid multi-dimensional array";
+            return open62541value;
+        }
+        open62541value = toOpen62541Variant(array.data(), type, arena);
+        if (UA_Variant_isScalar(&open62541value) || !open62541value.type)
+            return open62541value;
+        const QVector<quint32> dimensions = array.dimensions();
+        open62541value.arrayDimensions = static_cast<UA_UInt32 *>(newArray(dimensions.size(), &UA_TYPES[UA_TYPES_UINT32], arena));
+        open62541value.arrayDimensionsSize = dimensions.size();
+        std::memcpy(open62541value.arrayDimensions, dimensions.constData(), dimensions.size() * sizeof(UA_UInt32));
+        return open62541value;
+    }
+
+    const QOpcUa::Types vectorType = vectorElementType(value.userType());
+    if (vectorType != QOpcUa::Undefined) {
+        if (type == QOpcUa::Undefined || type == vectorType)
+            return vectorToOpen62541Variant(value, vectorType, arena);
+        if (vectorType == QOpcUa::Float && type == QOpcUa::Double) {
+            const QVector<float> vector = value.value<QVector<float>>();
+            UA_Double *arr = static_cast<UA_Double *>(newArray(vector.size(), &UA_TYPES[UA_TYPES_DOUBLE], arena));
+            QOpcUaArrayKernels::floatToDouble(vector.constData(), arr, vector.size());
+            UA_Variant_setArray(&open62541value, arr, vector.size(), &UA_TYPES[UA_TYPES_DOUBLE]);
+            return open62541value;
+        }
+        if (vectorType == QOpcUa::Double && type == QOpcUa::Float) {
+            const QVector<double> vector = value.value<QVector<double>>();
+            UA_Float *arr = static_cast<UA_Float *>(newArray(vector.size(), &UA_TYPES[UA_TYPES_FLOAT], arena));
+            QOpcUaArrayKernels::doubleToFloat(vector.constData(), arr, vector.size());
+            UA_Variant_setArray(&open62541value, arr, vector.size(), &UA_TYPES[UA_TYPES_FLOAT]);
+            return open62541value;
+        }
+        // A different element type was requested, convert element by element
+        return toOpen62541Variant(value.toList(), type, arena);
+    }
 
     if (value.type() == QVariant::List && value.toList().size() == 0)
         return open62541value;
@@ -106,179 +281,200 @@ UA_Variant toOpen62541Variant(const QVariant &value, QOpcUa::Types type)
     QOpcUa::Types valueType = type == QOpcUa::Undefined ?
                 qvariantTypeToQOpcUaType(static_cast<QMetaType::Type>(temp.type())) : type;
 
-    const UA_DataType *dt = toDataType(valueType);
-
-    switch (valueType) {
-    case QOpcUa::Boolean:
-        return arrayFromQVariant<UA_Boolean, bool>(value, dt);
-    case QOpcUa::SByte:
-        return arrayFromQVariant<UA_SByte, char>(value, dt);
-    case QOpcUa::Byte:
-        return arrayFromQVariant<UA_Byte, uchar>(value, dt);
-    case QOpcUa::Int16:
-        return arrayFromQVariant<UA_Int16, qint16>(value, dt);
-    case QOpcUa::UInt16:
-        return arrayFromQVariant<UA_UInt16, quint16>(value, dt);
-    case QOpcUa::Int32:
-        return arrayFromQVariant<UA_Int32, qint32>(value, dt);
-    case QOpcUa::UInt32:
-        return arrayFromQVariant<UA_UInt32, quint32>(value, dt);
-    case QOpcUa::Int64:
-        return arrayFromQVariant<UA_Int64, int64_t>(value, dt);
-    case QOpcUa::UInt64:
-        return arrayFromQVariant<UA_UInt64, uint64_t>(value, dt);
-    case QOpcUa::Float:
-        return arrayFromQVariant<UA_Float, float>(value, dt);
-    case QOpcUa::Double:
-        return arrayFromQVariant<UA_Double, double>(value, dt);
-    case QOpcUa::DateTime:
-        return arrayFromQVariant<UA_DateTime, QDateTime>(value, dt);
-    case QOpcUa::String:
-        return arrayFromQVariant<UA_String, QString>(value, dt);
-    case QOpcUa::LocalizedText:
-        return arrayFromQVariant<UA_LocalizedText, QOpcUa::QLocalizedText>(value, dt);
-    case QOpcUa::ByteString:
-        return arrayFromQVariant<UA_ByteString, QByteArray>(value, dt);
-    case QOpcUa::NodeId:
-        return arrayFromQVariant<UA_NodeId, QString>(value, dt);
-    case QOpcUa::Guid:
-        return arrayFromQVariant<UA_Guid, QUuid>(value, dt);
-    case QOpcUa::XmlElement:
-        return arrayFromQVariant<UA_XmlElement, QString>(value, dt);
-    case QOpcUa::QualifiedName:
-        return arrayFromQVariant<UA_QualifiedName, QOpcUa::QQualifiedName>(value, dt);
-    case QOpcUa::StatusCode:
-        return arrayFromQVariant<UA_StatusCode, QOpcUa::UaStatusCode>(value, dt);
-    default:
+    const FromQVariantFunction convert = fromQVariantTable.at(valueType);
+    if (!convert) {
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Variant conversion to Open62541 for typeIndex" << type << " not implemented";
+        return open62541value;
     }
 
-    return open62541value;
+    return convert(value, toDataType(valueType), arena);
 }
 
-QVariant toQVariant(const UA_Variant &value)
-{
-    switch (value.type->typeIndex) {
-    case UA_TYPES_BOOLEAN:
-        return arrayToQVariant<bool, UA_Boolean>(value, QMetaType::Bool);
-    case UA_TYPES_SBYTE:
-        return arrayToQVariant<signed char, UA_SByte>(value, QMetaType::SChar);
-    case UA_TYPES_BYTE:
-        return arrayToQVariant<uchar, UA_Byte>(value, QMetaType::UChar);
-    case UA_TYPES_INT16:
-        return arrayToQVariant<qint16, UA_Int16>(value, QMetaType::Short);
-    case UA_TYPES_UINT16:
-        return arrayToQVariant<quint16, UA_UInt16>(value, QMetaType::UShort);
-    case UA_TYPES_INT32:
-        return arrayToQVariant<qint32, UA_Int32>(value, QMetaType::Int);
-    case UA_TYPES_UINT32:
-        return arrayToQVariant<quint32, UA_UInt32>(value, QMetaType::UInt);
-    case UA_TYPES_INT64:
-        return arrayToQVariant<int64_t, UA_Int64>(value, QMetaType::LongLong);
-    case UA_TYPES_UINT64:
-        return arrayToQVariant<uint64_t, UA_UInt64>(value, QMetaType::ULongLong);
-    case UA_TYPES_FLOAT:
-        return arrayToQVariant<float, UA_Float>(value, QMetaType::Float);
-    case UA_TYPES_DOUBLE:
-        return arrayToQVariant<double, UA_Double>(value, QMetaType::Double);
-    case UA_TYPES_STRING:
-        return arrayToQVariant<QString, UA_String>(value, QMetaType::QString);
-    case UA_TYPES_BYTESTRING:
-        return arrayToQVariant<QByteArray, UA_ByteString>(value, QMetaType::QByteArray);
-    case UA_TYPES_LOCALIZEDTEXT:
-        return arrayToQVariant<QOpcUa::QLocalizedText, UA_LocalizedText>(value, QMetaType::QString);
-    case UA_TYPES_NODEID:
-        return arrayToQVariant<QString, UA_NodeId>(value, QMetaType::QString);
-    case UA_TYPES_DATETIME:
-        return arrayToQVariant<QDateTime, UA_DateTime>(value, QMetaType::QDateTime);
-    case UA_TYPES_GUID:
-        return arrayToQVariant<QUuid, UA_Guid>(value, QMetaType::QUuid);
-    case UA_TYPES_XMLELEMENT:
-        return arrayToQVariant<QString, UA_XmlElement>(value, QMetaType::QString);
-    case UA_TYPES_QUALIFIEDNAME:
-        return arrayToQVariant<QOpcUa::QQualifiedName, UA_QualifiedName>(value);
-    case UA_TYPES_STATUSCODE:
-        return arrayToQVariant<QOpcUa::UaStatusCode, UA_StatusCode>(value, QMetaType::UInt);
-    default:
+// The timestamps of an array are converted in one pass, only the QDateTime construction remains per element
+static QVariant dateTimeArrayToQVariant(const UA_Variant &var)
+{
+    if (var.arrayLength <= 1)
+        return arrayToQVariant<QDateTime, UA_DateTime>(var, QMetaType::QDateTime);
+
+    QVarLengthArray<qint64, 64> msecs(static_cast<int>(var.arrayLength));
+    QOpcUaArrayKernels::ticksToMSecs(static_cast<const qint64 *>(var.data), msecs.data(), msecs.size());
+
+    QVariantList list;
+    list.reserve(msecs.size());
+    for (qint64 msec : qAsConst(msecs))
+        list.append(QDateTime::fromMSecsSinceEpoch(msec));
+    return list;
+}
+
+template<QOpcUa::Types T>
+struct ToQVariantEntry
+{
+    static QVariant convert(const UA_Variant &value, QOpcUaStringCache *strings)
+    {
+        return arrayToQVariant<typename TypeTraits<T>::QtType, typename TypeTraits<T>::UaType>(
+                    value, static_cast<QMetaType::Type>(QOpcUaTypeMapping::toMetaType(T)), strings);
+    }
+};
+
+template<>
+struct ToQVariantEntry<QOpcUa::DateTime>
+{
+    static QVariant convert(const UA_Variant &value, QOpcUaStringCache *)
+    {
+        return dateTimeArrayToQVariant(value);
+    }
+};
+
+// Non numeric arrays are always returned as QVariantList, an invalid QVariant signals the fallback
+template<QOpcUa::Types T, bool = IsContiguous<T>::value>
+struct ToQVectorEntryImpl
+{
+    static QVariant convert(const UA_Variant &value, QOpcUaStringCache *)
+    {
+        return arrayToQVector<typename TypeTraits<T>::QtType, typename TypeTraits<T>::UaType>(value);
+    }
+};
+
+template<QOpcUa::Types T>
+struct ToQVectorEntryImpl<T, false>
+{
+    static QVariant convert(const UA_Variant &, QOpcUaStringCache *)
+    {
+        return QVariant();
+    }
+};
+
+template<QOpcUa::Types T>
+struct ToQVectorEntry : ToQVectorEntryImpl<T> {};
+
+template<>
+struct ToQVectorEntry<QOpcUa::Boolean>
+{
+    static QVariant convert(const UA_Variant &value, QOpcUaStringCache *)
+    {
+        QVector<bool> vector(static_cast<int>(value.arrayLength));
+        QOpcUaArrayKernels::unpackBooleans(static_cast<const quint8 *>(value.data), vector.data(), vector.size());
+        return QVariant::fromValue(vector);
+    }
+};
+
+static constexpr auto toQVariantTable =
+        QOpcUaTypeMapping::dispatchTable<ToQVariantEntry, ToQVariantFunction>();
+static constexpr auto toQVectorTable =
+        QOpcUaTypeMapping::dispatchTable<ToQVectorEntry, ToQVariantFunction>();
+
+// Custom structures are decoded with the type dictionary of the server
+static QVariant structuresToQVariant(const UA_Variant &value, const QOpen62541TypeDictionary *types)
+{
+    if (!types) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Variant conversion from Open62541 for structures requires the type dictionary";
+        return QVariant();
+    }
+
+    const UA_ExtensionObject *objects = static_cast<const UA_ExtensionObject *>(value.data);
+    if (UA_Variant_isScalar(&value))
+        return types->decode(objects[0]);
+
+    QVariantList list;
+    list.reserve(static_cast<int>(value.arrayLength));
+    for (size_t i = 0; i < value.arrayLength; ++i) {
+        const QVariant structure = types->decode(objects[i]);
+        if (!structure.isValid())
+            return QVariant();
+        list.append(structure);
+    }
+    return list;
+}
+
+bool hasEncodedStructure(const UA_Variant &value)
+{
+    if (value.type != &UA_TYPES[UA_TYPES_EXTENSIONOBJECT])
+        return false;
+
+    const UA_ExtensionObject *objects = static_cast<const UA_ExtensionObject *>(value.data);
+    const size_t count = UA_Variant_isScalar(&value) ? 1 : value.arrayLength;
+    for (size_t i = 0; i < count; ++i) {
+        if (objects[i].encoding == UA_EXTENSIONOBJECT_ENCODED_BYTESTRING)
+            return true;
+    }
+    return false;
+}
+
+QVariant toQVariant(const UA_Variant &value, bool typedArrays, const QOpen62541TypeDictionary *types,
+                    QOpcUaStringCache *strings)
+{
+    if (value.arrayDimensionsSize > 1) {
+        // Convert the elements without the dimensions, numeric types end up in one contiguous QVector
+        UA_Variant flat = value;
+        flat.arrayDimensionsSize = 0;
+        flat.arrayDimensions = nullptr;
+        QVariant data = toQVariant(flat, true, types, strings);
+        if (data.type() != QVariant::List && vectorElementType(data.userType()) == QOpcUa::Undefined)
+            data = QVariantList({data}); // A single element which has been converted to a scalar
+
+        QVector<quint32> dimensions;
+        dimensions.reserve(static_cast<int>(value.arrayDimensionsSize));
+        for (size_t i = 0; i < value.arrayDimensionsSize; ++i)
+            dimensions.append(value.arrayDimensions[i]);
+        return QVariant::fromValue(QOpcUaMultiDimensionalArray(data, dimensions));
+    }
+
+    if (value.type == &UA_TYPES[UA_TYPES_EXTENSIONOBJECT])
+        return structuresToQVariant(value, types);
+
+    const QOpcUa::Types type = uaTypeIndexTable.at(value.type->typeIndex);
+    if (type == QOpcUa::Undefined) {
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Variant conversion from Open62541 for typeIndex" << value.type->typeIndex << " not implemented";
         return QVariant();
     }
+
+    if (typedArrays && !UA_Variant_isScalar(&value)) {
+        const QVariant vector = toQVectorTable.at(type)(value, strings);
+        if (vector.isValid())
+            return vector;
+    }
+
+    return toQVariantTable.at(type)(value, strings);
 }
 
 QOpcUa::Types toQOpcUaVariantType(quint8 typeIndex)
 {
-    switch (typeIndex) {
-    case UA_TYPES_BOOLEAN:
-        return QOpcUa::Boolean;
-    case UA_TYPES_SBYTE:
-        return QOpcUa::SByte;
-    case UA_TYPES_BYTE:
-        return QOpcUa::Byte;
-    case UA_TYPES_INT16:
-        return QOpcUa::Int16;
-    case UA_TYPES_UINT16:
-        return QOpcUa::UInt16;
-    case UA_TYPES_INT32:
-        return QOpcUa::Int32;
-    case UA_TYPES_UINT32:
-        return QOpcUa::UInt32;
-    case UA_TYPES_INT64:
-        return QOpcUa::Int64;
-    case UA_TYPES_UINT64:
-        return QOpcUa::UInt64;
-    default:
+    const QOpcUa::Types type = uaTypeIndexTable.at(typeIndex);
+    if (type == QOpcUa::Undefined)
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Variant conversion to Qt type " << typeIndex << " not implemented";
+    return type;
+}
+
+// Maps the DataType of a declaration, e.g. of a method argument, to the type of its values
+QOpcUa::Types dataTypeToQOpcUaType(const UA_NodeId &dataType)
+{
+    if (dataType.namespaceIndex != 0 || dataType.identifierType != UA_NODEIDTYPE_NUMERIC)
         return QOpcUa::Undefined;
+
+    switch (dataType.identifier.numeric) {
+    // Subtypes of builtin types which are common in declarations
+    case UA_NS0ID_DURATION:
+        return QOpcUa::Double;
+    case UA_NS0ID_UTCTIME:
+        return QOpcUa::DateTime;
+    case UA_NS0ID_LOCALEID:
+        return QOpcUa::String;
+    case UA_NS0ID_INTEGERID:
+    case UA_NS0ID_COUNTER:
+        return QOpcUa::UInt32;
+    default:
+        // The node ids of the builtin data types are their builtin type ids
+        return QOpcUaTypeMapping::fromBuiltinTypeId(static_cast<int>(dataType.identifier.numeric));
     }
 }
 
 const UA_DataType *toDataType(QOpcUa::Types valueType)
 {
-    switch (valueType) {
-    case QOpcUa::Boolean:
-        return &UA_TYPES[UA_TYPES_BOOLEAN];
-    case QOpcUa::Int32:
-        return &UA_TYPES[UA_TYPES_INT32];
-    case QOpcUa::UInt32:
-        return &UA_TYPES[UA_TYPES_UINT32];
-    case QOpcUa::Double:
-        return &UA_TYPES[UA_TYPES_DOUBLE];
-    case QOpcUa::Float:
-        return &UA_TYPES[UA_TYPES_FLOAT];
-    case QOpcUa::String:
-        return &UA_TYPES[UA_TYPES_STRING];
-    case QOpcUa::LocalizedText:
-        return &UA_TYPES[UA_TYPES_LOCALIZEDTEXT];
-    case QOpcUa::DateTime:
-        return &UA_TYPES[UA_TYPES_DATETIME];
-    case QOpcUa::UInt16:
-        return &UA_TYPES[UA_TYPES_UINT16];
-    case QOpcUa::Int16:
-        return &UA_TYPES[UA_TYPES_INT16];
-    case QOpcUa::UInt64:
-        return &UA_TYPES[UA_TYPES_UINT64];
-    case QOpcUa::Int64:
-        return &UA_TYPES[UA_TYPES_INT64];
-    case QOpcUa::Byte:
-        return &UA_TYPES[UA_TYPES_BYTE];
-    case QOpcUa::SByte:
-        return &UA_TYPES[UA_TYPES_SBYTE];
-    case QOpcUa::ByteString:
-        return &UA_TYPES[UA_TYPES_BYTESTRING];
-    case QOpcUa::XmlElement:
-        return &UA_TYPES[UA_TYPES_XMLELEMENT];
-    case QOpcUa::NodeId:
-        return &UA_TYPES[UA_TYPES_NODEID];
-    case QOpcUa::Guid:
-        return &UA_TYPES[UA_TYPES_GUID];
-    case QOpcUa::QualifiedName:
-        return &UA_TYPES[UA_TYPES_QUALIFIEDNAME];
-    case QOpcUa::StatusCode:
-        return &UA_TYPES[UA_TYPES_STATUSCODE];
-    default:
+    if (static_cast<quint32>(valueType) >= static_cast<quint32>(QOpcUaTypeMapping::TypeCount)) {
         qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Trying to convert undefined type:" << valueType;
         return nullptr;
     }
+    return &UA_TYPES[uaTypeIndices[valueType]];
 }
 
 QString toQString(UA_String value)
@@ -287,21 +483,23 @@ QString toQString(UA_String value)
 }
 
 template<typename TARGETTYPE, typename UATYPE>
-QVariant scalarToQVariant(UATYPE *data, QMetaType::Type type)
+QVariant scalarToQVariant(UATYPE *data, QMetaType::Type type, QOpcUaStringCache *)
 {
     return QVariant(type, reinterpret_cast<TARGETTYPE *>(data));
 }
 
 template<>
-QVariant scalarToQVariant<QString, UA_String>(UA_String *data, QMetaType::Type type)
+QVariant scalarToQVariant<QString, UA_String>(UA_String *data, QMetaType::Type type, QOpcUaStringCache *strings)
 {
     Q_UNUSED(type)
     UA_String *uaStr = static_cast<UA_String *>(data);
-    return QVariant(QString::fromUtf8(reinterpret_cast<char *>(uaStr->data), uaStr->length));
+    const char *utf8 = reinterpret_cast<const char *>(uaStr->data);
+    const int length = static_cast<int>(uaStr->length);
+    return QVariant(strings ? strings->fromUtf8(utf8, length) : QString::fromUtf8(utf8, length));
 }
 
 template<>
-QVariant scalarToQVariant<QByteArray, UA_ByteString>(UA_ByteString *data, QMetaType::Type type)
+QVariant scalarToQVariant<QByteArray, UA_ByteString>(UA_ByteString *data, QMetaType::Type type, QOpcUaStringCache *)
 {
     Q_UNUSED(type)
     UA_ByteString *uaBs = static_cast<UA_ByteString *>(data);
@@ -309,18 +507,19 @@ QVariant scalarToQVariant<QByteArray, UA_ByteString>(UA_ByteString *data, QMetaT
 }
 
 template<>
-QVariant scalarToQVariant<QOpcUa::QLocalizedText, UA_LocalizedText>(UA_LocalizedText *data, QMetaType::Type type)
+QVariant scalarToQVariant<QOpcUa::QLocalizedText, UA_LocalizedText>(UA_LocalizedText *data, QMetaType::Type type,
+                                                                    QOpcUaStringCache *strings)
 {
     Q_UNUSED(type)
 
     QOpcUa::QLocalizedText lt;
-    lt.locale = scalarToQVariant<QString, UA_String>(&(data->locale), QMetaType::Type::QString).toString();
-    lt.text = scalarToQVariant<QString, UA_String>(&(data->text), QMetaType::Type::QString).toString();
+    lt.locale = scalarToQVariant<QString, UA_String>(&(data->locale), QMetaType::Type::QString, strings).toString();
+    lt.text = scalarToQVariant<QString, UA_String>(&(data->text), QMetaType::Type::QString, strings).toString();
     return QVariant::fromValue(lt);
 }
 
 template<>
-QVariant scalarToQVariant<QString, UA_NodeId>(UA_NodeId *data, QMetaType::Type type)
+QVariant scalarToQVariant<QString, UA_NodeId>(UA_NodeId *data, QMetaType::Type type, QOpcUaStringCache *)
 {
     Q_UNUSED(type)
     UA_NodeId *uan = static_cast<UA_NodeId *>(data);
@@ -328,14 +527,14 @@ QVariant scalarToQVariant<QString, UA_NodeId>(UA_NodeId *data, QMetaType::Type t
 }
 
 template<>
-QVariant scalarToQVariant<QDateTime, UA_DateTime>(UA_DateTime *data, QMetaType::Type type)
+QVariant scalarToQVariant<QDateTime, UA_DateTime>(UA_DateTime *data, QMetaType::Type type, QOpcUaStringCache *)
 {
     Q_UNUSED(type)
     return QVariant(QDateTime::fromMSecsSinceEpoch(*static_cast<UA_DateTime *>(data) * UA_DATETIME_TO_MSEC));
 }
 
 template<>
-QVariant scalarToQVariant<QUuid, UA_Guid>(UA_Guid *data, QMetaType::Type type)
+QVariant scalarToQVariant<QUuid, UA_Guid>(UA_Guid *data, QMetaType::Type type, QOpcUaStringCache *)
 {
     Q_UNUSED(type)
     return QUuid(data->data1, data->data2, data->data3, data->data4[0], data->data4[1], data->data4[2],
@@ -343,88 +542,197 @@ QVariant scalarToQVariant<QUuid, UA_Guid>(UA_Guid *data, QMetaType::Type type)
 }
 
 template<>
-QVariant scalarToQVariant<QOpcUa::QQualifiedName, UA_QualifiedName>(UA_QualifiedName *data, QMetaType::Type type)
+QVariant scalarToQVariant<QOpcUa::QQualifiedName, UA_QualifiedName>(UA_QualifiedName *data, QMetaType::Type type,
+                                                                    QOpcUaStringCache *strings)
 {
     Q_UNUSED(type);
     QOpcUa::QQualifiedName temp;
     temp.namespaceIndex = data->namespaceIndex;
-    temp.name = scalarToQVariant<QString, UA_String>(&(data->name), QMetaType::Type::QString).toString();
+    temp.name = scalarToQVariant<QString, UA_String>(&(data->name), QMetaType::Type::QString, strings).toString();
     return QVariant::fromValue(temp);
 }
 
 template<typename TARGETTYPE, typename UATYPE>
-QVariant arrayToQVariant(const UA_Variant &var, QMetaType::Type type)
+QVariant arrayToQVariant(const UA_Variant &var, QMetaType::Type type, QOpcUaStringCache *strings)
 {
     if (var.arrayLength > 1) {
         QVariantList list;
         for (size_t i = 0; i < var.arrayLength; ++i) {
             UATYPE *temp = static_cast<UATYPE *>(var.data);
-            list.append(scalarToQVariant<TARGETTYPE, UATYPE>(&temp[i], type));
+            list.append(scalarToQVariant<TARGETTYPE, UATYPE>(&temp[i], type, strings));
         }
         return list;
     }
     UATYPE *temp = static_cast<UATYPE *>(var.data);
-    return scalarToQVariant<TARGETTYPE, UATYPE>(temp, type);
+    return scalarToQVariant<TARGETTYPE, UATYPE>(temp, type, strings);
+}
+
+// Numeric types have the same layout in open62541 and Qt, the whole array is copied at once
+template<typename TARGETTYPE, typename UATYPE>
+QVariant arrayToQVector(const UA_Variant &var)
+{
+    Q_STATIC_ASSERT(sizeof(TARGETTYPE) == sizeof(UATYPE));
+    QVector<TARGETTYPE> vector(static_cast<int>(var.arrayLength));
+    if (var.arrayLength > 0)
+        std::memcpy(vector.data(), var.data, var.arrayLength * sizeof(UATYPE));
+    return QVariant::fromValue(vector);
+}
+
+// Builds the scalar with an explicit type, QString is stored for several types
+template<typename QTTYPE>
+static QOpcUaVariant makeScalar(const QTTYPE &value, QOpcUa::Types)
+{
+    return QOpcUaVariant(value);
+}
+
+static QOpcUaVariant makeScalar(const QString &value, QOpcUa::Types type)
+{
+    return QOpcUaVariant(value, type);
+}
+
+template<QOpcUa::Types T, bool = IsContiguous<T>::value>
+struct ToQOpcUaVariantEntryImpl
+{
+    typedef typename TypeTraits<T>::QtType QtType;
+    typedef typename TypeTraits<T>::UaType UaType;
+
+    static QOpcUaVariant convert(const UA_Variant &value)
+    {
+        Q_STATIC_ASSERT(sizeof(QtType) == sizeof(UaType));
+        if (UA_Variant_isScalar(&value))
+            return QOpcUaVariant(*static_cast<const QtType *>(value.data));
+
+        QVector<QtType> vector(static_cast<int>(value.arrayLength));
+        if (value.arrayLength > 0)
+            std::memcpy(vector.data(), value.data, value.arrayLength * sizeof(UaType));
+        return QOpcUaVariant(vector);
+    }
+};
+
+// The elements are converted one by one, these types need an allocation per element anyway
+template<QOpcUa::Types T>
+struct ToQOpcUaVariantEntryImpl<T, false>
+{
+    typedef typename TypeTraits<T>::QtType QtType;
+    typedef typename TypeTraits<T>::UaType UaType;
+
+    static QtType element(UaType *data)
+    {
+        return scalarToQVariant<QtType, UaType>(data, static_cast<QMetaType::Type>(QOpcUaTypeMapping::toMetaType(T)))
+                .template value<QtType>();
+    }
+
+    static QOpcUaVariant convert(const UA_Variant &value)
+    {
+        UaType *data = static_cast<UaType *>(value.data);
+        if (UA_Variant_isScalar(&value))
+            return makeScalar(element(data), T);
+
+        QVector<QtType> vector;
+        vector.reserve(static_cast<int>(value.arrayLength));
+        for (size_t i = 0; i < value.arrayLength; ++i)
+            vector.append(element(&data[i]));
+        return QOpcUaVariant(vector, T);
+    }
+};
+
+template<QOpcUa::Types T>
+struct ToQOpcUaVariantEntry : ToQOpcUaVariantEntryImpl<T> {};
+
+template<>
+struct ToQOpcUaVariantEntry<QOpcUa::StatusCode>
+{
+    static QOpcUaVariant convert(const UA_Variant &value)
+    {
+        const UA_StatusCode *data = static_cast<const UA_StatusCode *>(value.data);
+        if (UA_Variant_isScalar(&value))
+            return QOpcUaVariant(static_cast<QOpcUa::UaStatusCode>(*data));
+
+        QVector<QOpcUa::UaStatusCode> vector;
+        vector.reserve(static_cast<int>(value.arrayLength));
+        for (size_t i = 0; i < value.arrayLength; ++i)
+            vector.append(static_cast<QOpcUa::UaStatusCode>(data[i]));
+        return QOpcUaVariant(vector);
+    }
+};
+
+static constexpr auto toQOpcUaVariantTable =
+        QOpcUaTypeMapping::dispatchTable<ToQOpcUaVariantEntry, ToQOpcUaVariantFunction>();
+
+// Arrays with several dimensions are returned with their elements in one flat array
+QOpcUaVariant toQOpcUaVariant(const UA_Variant &value)
+{
+    if (UA_Variant_isEmpty(&value))
+        return QOpcUaVariant();
+
+    const QOpcUa::Types type = uaTypeIndexTable.at(value.type->typeIndex);
+    if (type == QOpcUa::Undefined) {
+        qCWarning(QT_OPCUA_PLUGINS_OPEN62541) << "Variant conversion from Open62541 for typeIndex" << value.type->typeIndex << " not implemented";
+        return QOpcUaVariant();
+    }
+    return toQOpcUaVariantTable.at(type)(value);
 }
 
 template<typename TARGETTYPE, typename QTTYPE>
-void scalarFromQVariant(const QVariant &var, TARGETTYPE *ptr)
+void scalarFromQVariant(const QVariant &var, TARGETTYPE *ptr, QOpen62541Arena *arena)
 {
+    Q_UNUSED(arena);
     *ptr = static_cast<TARGETTYPE>(var.value<QTTYPE>());
 }
 
 template<>
-void scalarFromQVariant<UA_DateTime, QDateTime>(const QVariant &var, UA_DateTime *ptr)
+void scalarFromQVariant<UA_DateTime, QDateTime>(const QVariant &var, UA_DateTime *ptr, QOpen62541Arena *arena)
 {
+    Q_UNUSED(arena);
     *ptr = UA_MSEC_TO_DATETIME * var.toDateTime().toMSecsSinceEpoch();
 }
 
 template<>
-void scalarFromQVariant<UA_String, QString>(const QVariant &var, UA_String *ptr)
+void scalarFromQVariant<UA_String, QString>(const QVariant &var, UA_String *ptr, QOpen62541Arena *arena)
 {
-    UA_String tmpValue = UA_String_fromChars(var.toString().toUtf8().constData());
-    UA_String_copy(&tmpValue, ptr);
-    UA_String_deleteMembers(&tmpValue);
+    const QByteArray utf8 = var.toString().toUtf8();
+    *ptr = copyBytes(utf8.constData(), utf8.size(), arena);
 }
 
 template<>
-void scalarFromQVariant<UA_LocalizedText, QOpcUa::QLocalizedText>(const QVariant &var, UA_LocalizedText *ptr)
+void scalarFromQVariant<UA_LocalizedText, QOpcUa::QLocalizedText>(const QVariant &var, UA_LocalizedText *ptr, QOpen62541Arena *arena)
 {
     QOpcUa::QLocalizedText lt = var.value<QOpcUa::QLocalizedText>();
-    scalarFromQVariant<UA_String, QString>(lt.locale, &(ptr->locale));
-    scalarFromQVariant<UA_String, QString>(lt.text, &(ptr->text));
+    scalarFromQVariant<UA_String, QString>(lt.locale, &(ptr->locale), arena);
+    scalarFromQVariant<UA_String, QString>(lt.text, &(ptr->text), arena);
 }
 
 template<>
-void scalarFromQVariant<UA_ByteString, QByteArray>(const QVariant &var, UA_ByteString *ptr)
+void scalarFromQVariant<UA_ByteString, QByteArray>(const QVariant &var, UA_ByteString *ptr, QOpen62541Arena *arena)
 {
-    QByteArray arr = var.toByteArray();
-    UA_ByteString tmpValue;
-    UA_ByteString_init(&tmpValue);
-    tmpValue.length = arr.length();
-    tmpValue.data = reinterpret_cast<UA_Byte *>(arr.data());
-    UA_ByteString_copy(&tmpValue, ptr);
+    const QByteArray arr = var.toByteArray();
+    *ptr = copyBytes(arr.constData(), arr.size(), arena);
 }
 
 template<>
-void scalarFromQVariant<UA_NodeId, QString>(const QVariant &var, UA_NodeId *ptr)
+void scalarFromQVariant<UA_NodeId, QString>(const QVariant &var, UA_NodeId *ptr, QOpen62541Arena *arena)
 {
-    UA_NodeId tmpValue = Open62541Utils::nodeIdFromQString(var.toString());
-    UA_NodeId_copy(&tmpValue, ptr);
-    UA_NodeId_deleteMembers(&tmpValue);
+    // The parsed node id already owns its identifier, it only has to be moved into the arena
+    *ptr = Open62541Utils::nodeIdFromQString(var.toString());
+    if (arena && (ptr->identifierType == UA_NODEIDTYPE_STRING || ptr->identifierType == UA_NODEIDTYPE_BYTESTRING)) {
+        UA_ByteString heapIdentifier = ptr->identifier.byteString;
+        ptr->identifier.byteString = arena->byteString(reinterpret_cast<const char *>(heapIdentifier.data), heapIdentifier.length);
+        UA_ByteString_deleteMembers(&heapIdentifier);
+    }
 }
 
 template<>
-void scalarFromQVariant<UA_QualifiedName, QOpcUa::QQualifiedName>(const QVariant &var, UA_QualifiedName *ptr)
+void scalarFromQVariant<UA_QualifiedName, QOpcUa::QQualifiedName>(const QVariant &var, UA_QualifiedName *ptr, QOpen62541Arena *arena)
 {
     QOpcUa::QQualifiedName temp = var.value<QOpcUa::QQualifiedName>();
     ptr->namespaceIndex = temp.namespaceIndex;
-    scalarFromQVariant<UA_String, QString>(temp.name, &(ptr->name));
+    scalarFromQVariant<UA_String, QString>(temp.name, &(ptr->name), arena);
 }
 
 template<>
-void scalarFromQVariant<UA_Guid, QUuid>(const QVariant &var, UA_Guid *ptr)
+void scalarFromQVariant<UA_Guid, QUuid>(const QVariant &var, UA_Guid *ptr, QOpen62541Arena *arena)
 {
+    Q_UNUSED(arena);
     const QUuid uuid = var.toUuid();
     ptr->data1 = uuid.data1;
     ptr->data2 = uuid.data2;
@@ -433,7 +741,7 @@ void scalarFromQVariant<UA_Guid, QUuid>(const QVariant &var, UA_Guid *ptr)
 }
 
 template<typename TARGETTYPE, typename QTTYPE>
-UA_Variant arrayFromQVariant(const QVariant &var, const UA_DataType *type)
+UA_Variant arrayFromQVariant(const QVariant &var, const UA_DataType *type, QOpen62541Arena *arena)
 {
     UA_Variant open62541value;
     UA_Variant_init(&open62541value);
@@ -443,21 +751,50 @@ UA_Variant arrayFromQVariant(const QVariant &var, const UA_DataType *type)
         if (list.isEmpty())
             return open62541value;
 
-        TARGETTYPE *arr = static_cast<TARGETTYPE *>(UA_Array_new(list.size(), type));
+        TARGETTYPE *arr = static_cast<TARGETTYPE *>(newArray(list.size(), type, arena));
 
         for (int i = 0; i < list.size(); ++i)
-            scalarFromQVariant<TARGETTYPE, QTTYPE>(list[i], &arr[i]);
+            scalarFromQVariant<TARGETTYPE, QTTYPE>(list[i], &arr[i], arena);
 
         UA_Variant_setArray(&open62541value, arr, list.size(), type);
         return open62541value;
     }
 
-    TARGETTYPE *temp = static_cast<TARGETTYPE *>(UA_new(type));
-    scalarFromQVariant<TARGETTYPE, QTTYPE>(var, temp);
+    TARGETTYPE *temp = static_cast<TARGETTYPE *>(newScalar(type, arena));
+    scalarFromQVariant<TARGETTYPE, QTTYPE>(var, temp, arena);
     UA_Variant_setScalar(&open62541value, temp, type);
     return open62541value;
 }
 
+template<typename TARGETTYPE, typename QTTYPE>
+UA_Variant arrayFromQVector(const QVariant &var, const UA_DataType *type, QOpen62541Arena *arena)
+{
+    Q_STATIC_ASSERT(sizeof(TARGETTYPE) == sizeof(QTTYPE));
+    UA_Variant open62541value;
+    UA_Variant_init(&open62541value);
+
+    const QVector<QTTYPE> vector = var.value<QVector<QTTYPE>>();
+    TARGETTYPE *arr = static_cast<TARGETTYPE *>(newArray(vector.size(), type, arena));
+    if (!vector.isEmpty())
+        std::memcpy(arr, vector.constData(), vector.size() * sizeof(TARGETTYPE));
+
+    UA_Variant_setArray(&open62541value, arr, vector.size(), type);
+    return open62541value;
+}
+
+QDateTime toQDateTime(const UA_DateTime *dt)
+{
+    return scalarToQVariant<QDateTime, UA_DateTime>(const_cast<UA_DateTime *>(dt)).toDateTime();
+}
+
+UA_DateTime toUaDateTime(const QDateTime &dt)
+{
+    UA_DateTime result = 0;
+    if (dt.isValid())
+        scalarFromQVariant<UA_DateTime, QDateTime>(QVariant(dt), &result);
+    return result;
+}
+
 }
 
 QT_END_NAMESPACE
@@ -38,13 +38,19 @@
 #define QOPEN62541VALUECONVERTER_H
 
 #include "qopen62541.h"
+#include "qopen62541arena.h"
 #include <QtOpcUa/qopcuanode.h>
 #include <QtOpcUa/qopcuatype.h>
+#include <QtOpcUa/qopcuavariant.h>
 
+#include <QtCore/qdatetime.h>
 #include <QtCore/qvariant.h>
 
 QT_BEGIN_NAMESPACE
 
+class QOpcUaStringCache;
+class QOpen62541TypeDictionary;
+
 namespace QOpen62541ValueConverter {
     QOpcUa::Types qvariantTypeToQOpcUaType(QVariant::Type type);
 
@@ -53,25 +59,37 @@ namespace QOpen62541ValueConverter {
         return static_cast<UA_AttributeId>(std::log2(static_cast<std::underlying_type<QOpcUaNode::NodeAttribute>::type>(attr)) + 1);
     }
 
-    UA_Variant toOpen62541Variant(const QVariant&, QOpcUa::Types);
-    QVariant toQVariant(const UA_Variant&);
+    UA_Variant toOpen62541Variant(const QVariant&, QOpcUa::Types, QOpen62541Arena *arena = nullptr);
+    QVariant toQVariant(const UA_Variant&, bool typedArrays = false, const QOpen62541TypeDictionary *types = nullptr,
+                        QOpcUaStringCache *strings = nullptr);
+    bool hasEncodedStructure(const UA_Variant &value);
+    QOpcUaVariant toQOpcUaVariant(const UA_Variant&);
     QOpcUa::Types toQOpcUaVariantType(quint8 typeIndex);
+    QOpcUa::Types dataTypeToQOpcUaType(const UA_NodeId &dataType);
     const UA_DataType *toDataType(QOpcUa::Types valueType);
     QOpcUa::Types qvariantTypeToQOpcUaType(QMetaType::Type type);
 
     QString toQString(UA_String value);
+    QDateTime toQDateTime(const UA_DateTime *dt);
+    UA_DateTime toUaDateTime(const QDateTime &dt);
+
+    template<typename TARGETTYPE, typename UATYPE>
+    QVariant scalarToQVariant(UATYPE *data, QMetaType::Type type = QMetaType::UnknownType, QOpcUaStringCache *strings = nullptr);
 
     template<typename TARGETTYPE, typename UATYPE>
-    QVariant scalarToQVariant(UATYPE *data, QMetaType::Type type = QMetaType::UnknownType);
+    QVariant arrayToQVariant(const UA_Variant &var, QMetaType::Type type = QMetaType::UnknownType, QOpcUaStringCache *strings = nullptr);
 
     template<typename TARGETTYPE, typename UATYPE>
-    QVariant arrayToQVariant(const UA_Variant &var, QMetaType::Type type = QMetaType::UnknownType);
+    QVariant arrayToQVector(const UA_Variant &var);
+
+    template<typename TARGETTYPE, typename QTTYPE>
+    void scalarFromQVariant(const QVariant &var, TARGETTYPE *ptr, QOpen62541Arena *arena = nullptr);
 
     template<typename TARGETTYPE, typename QTTYPE>
-    void scalarFromQVariant(const QVariant &var, TARGETTYPE *ptr);
+    UA_Variant arrayFromQVariant(const QVariant &var, const UA_DataType *type, QOpen62541Arena *arena = nullptr);
 
     template<typename TARGETTYPE, typename QTTYPE>
-    UA_Variant arrayFromQVariant(const QVariant &var, const UA_DataType *type);
+    UA_Variant arrayFromQVector(const QVariant &var, const UA_DataType *type, QOpen62541Arena *arena = nullptr);
 }
 
 QT_END_NAMESPACE
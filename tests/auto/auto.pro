@@ -1,2 +1,8 @@
 TEMPLATE = subdirs
-SUBDIRS +=  qopcuaclient
+SUBDIRS +=  qopcuaclient \
+    qopcuaarraykernels \
+    qopcuastringcache
+
+qtConfig(open62541) {
+    SUBDIRS += qopen62541lazyvalue
+}
@@ -0,0 +1,7 @@
+TARGET = tst_qopcuaarraykernels
+
+QT += testlib opcua-private
+CONFIG += testcase
+
+SOURCES += \
+    tst_qopcuaarraykernels.cpp
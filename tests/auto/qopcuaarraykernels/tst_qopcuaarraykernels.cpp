@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtOpcUa/private/qopcuaarraykernels_p.h>
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QVector>
+#include <QtTest/QtTest>
+
+#include <limits>
+
+// Longer than the widest vector plus its tail, every length checks a different remainder
+static const int MaximumLength = 67;
+
+class Tst_QOpcUaArrayKernels : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void ticksToMSecs_data();
+    void ticksToMSecs();
+    void floatToDouble();
+    void doubleToFloat();
+    void unpackBooleans();
+};
+
+void Tst_QOpcUaArrayKernels::ticksToMSecs_data()
+{
+    QTest::addColumn<QVector<qint64>>("pattern");
+    QTest::addColumn<qint64>("epochTicks");
+
+    const qint64 epoch = QOpcUaArrayKernels::UnixEpochTicks;
+    // Values around multiples of the divisor catch rounding errors of the estimate
+    const QVector<qint64> nearMultiples = {0, 1, -1, 9999, 10000, 10001, -9999, -10000, -10001,
+                                           123450000, 123449999, -123450001, -123449999};
+    QTest::newRow("around zero") << nearMultiples << qint64(0);
+
+    QVector<qint64> aroundEpoch;
+    for (qint64 offset : nearMultiples)
+        aroundEpoch.push_back(epoch + offset);
+    QTest::newRow("around 1970") << aroundEpoch << epoch;
+
+    // Dates before 1970 are negative after subtracting the epoch and round towards zero
+    QTest::newRow("before 1970") << QVector<qint64>{0, 1, 5000, epoch - 1, epoch - 9999, epoch - 10000,
+                                                    epoch - 10001, epoch - 864000000001LL, epoch / 2 + 3}
+                                 << epoch;
+
+    QTest::newRow("large") << QVector<qint64>{std::numeric_limits<qint64>::max(), std::numeric_limits<qint64>::min() + 1,
+                                              std::numeric_limits<qint64>::max() - 9999, 4611686018427387903LL,
+                                              -4611686018427387905LL, 2650467743999999999LL}
+                           << qint64(0);
+
+    QVector<qint64> random;
+    QRandomGenerator generator(42);
+    for (int i = 0; i < 64; ++i)
+        random.push_back(qint64(generator.generate64() >> 1) - (std::numeric_limits<qint64>::max() / 2));
+    QTest::newRow("random") << random << qint64(0);
+}
+
+void Tst_QOpcUaArrayKernels::ticksToMSecs()
+{
+    QFETCH(QVector<qint64>, pattern);
+    QFETCH(qint64, epochTicks);
+
+    for (int length = 0; length <= MaximumLength; ++length) {
+        QVector<qint64> ticks(length);
+        for (int i = 0; i < length; ++i)
+            ticks[i] = pattern.at((i * 7 + length) % pattern.size());
+
+        QVector<qint64> msecs(length, -42);
+        QOpcUaArrayKernels::ticksToMSecs(ticks.constData(), msecs.data(), length, epochTicks);
+        for (int i = 0; i < length; ++i) {
+            const qint64 expected = (ticks.at(i) - epochTicks) / 10000;
+            if (msecs.at(i) != expected)
+                QFAIL(qPrintable(QStringLiteral("length %1, index %2: %3 ticks gave %4 instead of %5")
+                                 .arg(length).arg(i).arg(ticks.at(i)).arg(msecs.at(i)).arg(expected)));
+        }
+    }
+}
+
+void Tst_QOpcUaArrayKernels::floatToDouble()
+{
+    const float pattern[] = {0.0f, -0.0f, 1.5f, -2.25f, 3.4028235e38f, 1.17549435e-38f, 1e-45f,
+                             std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+    const int patternSize = sizeof(pattern) / sizeof(pattern[0]);
+
+    for (int length = 0; length <= MaximumLength; ++length) {
+        QVector<float> src(length);
+        for (int i = 0; i < length; ++i)
+            src[i] = pattern[(i + length) % patternSize] * (i % 3 ? 1 : -1);
+
+        QVector<double> dst(length, 42.0);
+        QOpcUaArrayKernels::floatToDouble(src.constData(), dst.data(), length);
+        for (int i = 0; i < length; ++i)
+            QVERIFY(dst.at(i) == double(src.at(i)));
+    }
+
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    double converted = 0;
+    QOpcUaArrayKernels::floatToDouble(&nan, &converted, 1);
+    QVERIFY(qIsNaN(converted));
+}
+
+void Tst_QOpcUaArrayKernels::doubleToFloat()
+{
+    const double pattern[] = {0.0, -0.0, 1.5, -2.25, 0.1, 1e300, 1e-300, 3.4028235e38,
+                              std::numeric_limits<double>::infinity()};
+    const int patternSize = sizeof(pattern) / sizeof(pattern[0]);
+
+    for (int length = 0; length <= MaximumLength; ++length) {
+        QVector<double> src(length);
+        for (int i = 0; i < length; ++i)
+            src[i] = pattern[(i + length) % patternSize] * (i % 3 ? 1 : -1);
+
+        QVector<float> dst(length, 42.0f);
+        QOpcUaArrayKernels::doubleToFloat(src.constData(), dst.data(), length);
+        for (int i = 0; i < length; ++i)
+            QVERIFY(dst.at(i) == static_cast<float>(src.at(i)));
+    }
+}
+
+void Tst_QOpcUaArrayKernels::unpackBooleans()
+{
+    for (int length = 0; length <= MaximumLength; ++length) {
+        QVector<quint8> src(length);
+        for (int i = 0; i < length; ++i)
+            src[i] = (i + length) % 3 ? quint8(i * 37 + 1) : 0;
+
+        // Any non zero byte is true, the result must be a valid bool with the value 1
+        QVector<bool> dst(length, false);
+        QOpcUaArrayKernels::unpackBooleans(src.constData(), dst.data(), length);
+        for (int i = 0; i < length; ++i) {
+            QCOMPARE(dst.at(i), src.at(i) != 0);
+            QCOMPARE(reinterpret_cast<const quint8 *>(dst.constData())[i], quint8(src.at(i) != 0));
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(Tst_QOpcUaArrayKernels)
+
+#include "tst_qopcuaarraykernels.moc"
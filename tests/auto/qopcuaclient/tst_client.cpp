@@ -39,8 +39,13 @@
 #include <QtOpcUa/QOpcUaMonitoredValue>
 #include <QtOpcUa/QOpcUaNode>
 #include <QtOpcUa/QOpcUaProvider>
+#include <QtOpcUa/qopcuamultidimensionalarray.h>
+#include <QtOpcUa/qopcuastructuredvalue.h>
+#include <QtOpcUa/qopcuatypedmonitoredvalue.h>
+#include <QtOpcUa/qopcuavariant.h>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QProcess>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QThread>
@@ -146,6 +151,16 @@ private slots:
     void secureConnectToInvalid();
     defineDataMethod(connectAndDisconnect_data)
     void connectAndDisconnect();
+    defineDataMethod(connectToAnyEndpoint_data)
+    void connectToAnyEndpoint();
+    defineDataMethod(reconnectPolicy_data)
+    void reconnectPolicy();
+    defineDataMethod(subscriptionRecovery_data)
+    void subscriptionRecovery();
+    defineDataMethod(hotStandby_data)
+    void hotStandby();
+    defineDataMethod(hotStandbyFailover_data)
+    void hotStandbyFailover();
 
     // Password
     defineDataMethod(connectInvalidPassword_data)
@@ -159,6 +174,8 @@ private slots:
     void writeInvalidNode();
     defineDataMethod(writeMultipleAttributes_data)
     void writeMultipleAttributes();
+    defineDataMethod(writeMultipleStringAttributes_data)
+    void writeMultipleStringAttributes();
 
     defineDataMethod(getRootNode_data)
     void getRootNode();
@@ -173,14 +190,42 @@ private slots:
 
     defineDataMethod(dataChangeSubscription_data)
     void dataChangeSubscription();
+    defineDataMethod(dataChangeStatistics_data)
+    void dataChangeStatistics();
+    defineDataMethod(dataChangeNotificationBuffer_data)
+    void dataChangeNotificationBuffer();
+    defineDataMethod(dataChangeRawPassthrough_data)
+    void dataChangeRawPassthrough();
+    defineDataMethod(dataChangeMonitoringMode_data)
+    void dataChangeMonitoringMode();
+    defineDataMethod(dataChangeTriggering_data)
+    void dataChangeTriggering();
+    defineDataMethod(dataChangeModify_data)
+    void dataChangeModify();
+    defineDataMethod(dataChangeAggregateFilter_data)
+    void dataChangeAggregateFilter();
+    defineDataMethod(dataChangeSharedSubscription_data)
+    void dataChangeSharedSubscription();
+    defineDataMethod(dataChangeAggregation_data)
+    void dataChangeAggregation();
+    defineDataMethod(dataChangeTypedValue_data)
+    void dataChangeTypedValue();
+    defineDataMethod(dataChangeStringCache_data)
+    void dataChangeStringCache();
     defineDataMethod(dataChangeSubscriptionInvalidNode_data)
     void dataChangeSubscriptionInvalidNode();
     defineDataMethod(methodCall_data)
     void methodCall();
+    defineDataMethod(methodCallBatch_data)
+    void methodCallBatch();
+    defineDataMethod(preparedMethod_data)
+    void preparedMethod();
     defineDataMethod(eventSubscription_data)
     void eventSubscription();
     defineDataMethod(eventSubscribeInvalidNode_data)
     void eventSubscribeInvalidNode();
+    defineDataMethod(eventFilter_data)
+    void eventFilter();
     defineDataMethod(readRange_data)
     void readRange();
     defineDataMethod(readEui_data)
@@ -195,6 +240,18 @@ private slots:
     void writeArray();
     defineDataMethod(readArray_data)
     void readArray();
+    defineDataMethod(readTypedArray_data)
+    void readTypedArray();
+    defineDataMethod(readOpcUaVariant_data)
+    void readOpcUaVariant();
+    defineDataMethod(readStructure_data)
+    void readStructure();
+    defineDataMethod(readArrayRange_data)
+    void readArrayRange();
+    defineDataMethod(writeArrayRange_data)
+    void writeArrayRange();
+    defineDataMethod(readMatrixRange_data)
+    void readMatrixRange();
     defineDataMethod(writeScalar_data)
     void writeScalar();
     defineDataMethod(readScalar_data)
@@ -209,6 +266,14 @@ private:
         return qEnvironmentVariableIsSet(env) ? qgetenv(env).constData() : def;
     }
 
+    // Connections are lost while the test server is stopped, only possible if the test started it
+    bool canRestartTestServer() const
+    {
+        return m_serverProcess.state() == QProcess::Running;
+    }
+    bool stopTestServer();
+    bool startTestServer();
+
     QString m_endpoint;
     QOpcUaProvider m_opcUa;
     QStringList m_backends;
@@ -366,6 +431,258 @@ void Tst_QOpcUaClient::connectAndDisconnect()
     OpcuaConnector connector(opcuaClient, m_endpoint);
 }
 
+void Tst_QOpcUaClient::connectToAnyEndpoint()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("Selecting a server is not supported by the freeopcua backend");
+
+    opcuaClient->setConnectTimeout(2000);
+    QCOMPARE(opcuaClient->connectTimeout(), 2000);
+
+    // The first candidate does not answer, the client has to fall back to the second one
+    opcuaClient->connectToAnyEndpoint({QUrl("opc.tcp://127.0.0.1:1"), QUrl(m_endpoint)});
+    QCOMPARE(opcuaClient->state(), QOpcUaClient::Connecting);
+    QTRY_COMPARE_WITH_TIMEOUT(opcuaClient->state(), QOpcUaClient::Connected, 5000);
+    QCOMPARE(opcuaClient->url(), QUrl(m_endpoint));
+
+    opcuaClient->disconnectFromEndpoint();
+    QTRY_COMPARE(opcuaClient->state(), QOpcUaClient::Disconnected);
+
+    // A connect which is still in progress can be canceled
+    opcuaClient->connectToAnyEndpoint({QUrl("opc.tcp://127.0.0.1:1"), QUrl("opc.tcp://127.0.0.1:2")});
+    opcuaClient->disconnectFromEndpoint();
+    QCOMPARE(opcuaClient->state(), QOpcUaClient::Closing);
+    QTRY_COMPARE_WITH_TIMEOUT(opcuaClient->state(), QOpcUaClient::Disconnected, 5000);
+
+    opcuaClient->setConnectTimeout(0);
+}
+
+void Tst_QOpcUaClient::reconnectPolicy()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    QVERIFY(!opcuaClient->reconnectPolicy().enabled);
+
+    QOpcUaReconnectPolicy policy(true);
+    policy.initialDelay = 200;
+    policy.maximumDelay = 5000;
+    policy.maximumAttempts = 3;
+    opcuaClient->setReconnectPolicy(policy);
+    QVERIFY(opcuaClient->reconnectPolicy().enabled);
+    QCOMPARE(opcuaClient->reconnectPolicy().initialDelay, 200);
+    QCOMPARE(opcuaClient->reconnectPolicy().maximumDelay, 5000);
+    QCOMPARE(opcuaClient->reconnectPolicy().maximumAttempts, 3);
+
+    // An established connection is not affected by the policy
+    {
+        OpcuaConnector connector(opcuaClient, m_endpoint);
+        QCOMPARE(opcuaClient->state(), QOpcUaClient::Connected);
+    }
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua")) {
+        opcuaClient->setReconnectPolicy(QOpcUaReconnectPolicy());
+        QSKIP("Reconnecting is not supported by the freeopcua backend");
+    }
+    if (!canRestartTestServer()) {
+        opcuaClient->setReconnectPolicy(QOpcUaReconnectPolicy());
+        QSKIP("Losing the connection requires the test server started by the test");
+    }
+
+    // Without jitter the attempts are made 200, 400 and 800 ms apart
+    policy.jitter = 0;
+    opcuaClient->setReconnectPolicy(policy);
+
+    {
+        OpcuaConnector connector(opcuaClient, m_endpoint);
+        QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+        QVERIFY(node != 0);
+
+        QSignalSpy stateSpy(opcuaClient, &QOpcUaClient::stateChanged);
+        QVERIFY(stopTestServer());
+        QElapsedTimer timer;
+        timer.start();
+        node->readAttributes(QOpcUaNode::NodeAttribute::Value);
+        QTRY_VERIFY(!stateSpy.isEmpty());
+        QCOMPARE(stateSpy.first().at(0).value<QOpcUaClient::ClientState>(), QOpcUaClient::Reconnecting);
+
+        // The client gives up after the last attempt
+        QTRY_COMPARE_WITH_TIMEOUT(opcuaClient->state(), QOpcUaClient::Disconnected, 10000);
+        QVERIFY(timer.elapsed() >= 200 + 400 + 800);
+        QCOMPARE(opcuaClient->error(), QOpcUaClient::UnknownError);
+        QVERIFY(startTestServer());
+    }
+
+    policy.maximumAttempts = 0;
+    opcuaClient->setReconnectPolicy(policy);
+
+    {
+        OpcuaConnector connector(opcuaClient, m_endpoint);
+        QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+        QVERIFY(node != 0);
+        READ_MANDATORY_VARIABLE_NODE(node);
+
+        QSignalSpy reconnectedSpy(opcuaClient, &QOpcUaClient::reconnected);
+        QSignalSpy connectedSpy(opcuaClient, &QOpcUaClient::connected);
+        QVERIFY(stopTestServer());
+        node->readAttributes(QOpcUaNode::NodeAttribute::Value);
+        QTRY_COMPARE(opcuaClient->state(), QOpcUaClient::Reconnecting);
+        QVERIFY(startTestServer());
+
+        QTRY_COMPARE_WITH_TIMEOUT(reconnectedSpy.size(), 1, 15000);
+        QCOMPARE(connectedSpy.size(), 0);
+        QCOMPARE(opcuaClient->state(), QOpcUaClient::Connected);
+        QCOMPARE(opcuaClient->url(), QUrl(m_endpoint));
+
+        // The node created before the connection loss is still usable
+        READ_MANDATORY_VARIABLE_NODE(node);
+    }
+
+    opcuaClient->setReconnectPolicy(QOpcUaReconnectPolicy());
+    QVERIFY(!opcuaClient->reconnectPolicy().enabled);
+}
+
+void Tst_QOpcUaClient::hotStandby()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    QVERIFY(!opcuaClient->hotStandby());
+    opcuaClient->setHotStandby(true);
+    QVERIFY(opcuaClient->hotStandby());
+
+    // The test server is not part of a redundant set, the client stays on the primary session
+    {
+        OpcuaConnector connector(opcuaClient, m_endpoint);
+        QCOMPARE(opcuaClient->state(), QOpcUaClient::Connected);
+        QTest::qWait(100);
+        QCOMPARE(opcuaClient->url(), QUrl(m_endpoint));
+    }
+
+    opcuaClient->setHotStandby(false);
+    QVERIFY(!opcuaClient->hotStandby());
+}
+
+void Tst_QOpcUaClient::hotStandbyFailover()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("Hot standby is not supported by the freeopcua backend");
+    if (!canRestartTestServer())
+        QSKIP("Losing the connection requires the test server started by the test");
+
+    // A second instance of the test server serves as the other server of the redundant pair
+    QProcess standbyServer;
+    standbyServer.start(m_serverProcess.program(), {QLatin1String("43345")});
+    QVERIFY2(standbyServer.waitForStarted(), qPrintable(standbyServer.errorString()));
+    QTest::qWait(2000);
+    QUrl standbyEndpoint(m_endpoint);
+    standbyEndpoint.setPort(43345);
+
+    opcuaClient->setHotStandby(true);
+    opcuaClient->connectToAnyEndpoint({QUrl(m_endpoint), standbyEndpoint});
+    QTRY_COMPARE_WITH_TIMEOUT(opcuaClient->state(), QOpcUaClient::Connected, 5000);
+    const bool primaryIsTestServer = opcuaClient->url() == QUrl(m_endpoint);
+    const QUrl failoverEndpoint = primaryIsTestServer ? standbyEndpoint : QUrl(m_endpoint);
+
+    {
+        QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+        QVERIFY(node != 0);
+        QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+        QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data()));
+        QVERIFY(monitoredValue != nullptr);
+        QSignalSpy valueSpy(monitoredValue.data(), &QOpcUaMonitoredValue::valueChanged);
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(23)), QOpcUa::Types::Double);
+        QTRY_VERIFY(!valueSpy.isEmpty() && valueSpy.last().at(0).toDouble() == double(23));
+
+        // Wait until the standby session mirrors the subscription
+        QTRY_COMPARE_WITH_TIMEOUT(opcuaClient->standbyUrl(), failoverEndpoint, 15000);
+
+        // An item added after the last update of the standby is mirrored on the failover
+        QScopedPointer<QOpcUaNode> doubleNode(opcuaClient->node("ns=2;s=Demo.Static.Scalar.Double"));
+        QVERIFY(doubleNode != 0);
+        QScopedPointer<QOpcUaMonitoredValue> doubleValue(subscription->addValue(doubleNode.data()));
+        QVERIFY(doubleValue != nullptr);
+        QSignalSpy doubleSpy(doubleValue.data(), &QOpcUaMonitoredValue::valueChanged);
+
+        QSignalSpy reconnectedSpy(opcuaClient, &QOpcUaClient::reconnected);
+        if (primaryIsTestServer) {
+            QVERIFY(stopTestServer());
+        } else {
+            standbyServer.kill();
+            QVERIFY(standbyServer.waitForFinished(2000));
+        }
+
+        QTRY_COMPARE_WITH_TIMEOUT(reconnectedSpy.size(), 1, 10000);
+        QCOMPARE(opcuaClient->state(), QOpcUaClient::Connected);
+        QCOMPARE(opcuaClient->url(), failoverEndpoint);
+        QCOMPARE(opcuaClient->standbyUrl(), QUrl());
+
+        // Both monitored values report the changes on the standby server
+        valueSpy.clear();
+        doubleSpy.clear();
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(42)), QOpcUa::Types::Double);
+        WRITE_VALUE_ATTRIBUTE(doubleNode, QVariant(double(7)), QOpcUa::Types::Double);
+        QTRY_VERIFY(!valueSpy.isEmpty() && valueSpy.last().at(0).toDouble() == double(42));
+        QTRY_VERIFY(!doubleSpy.isEmpty() && doubleSpy.last().at(0).toDouble() == double(7));
+    }
+
+    opcuaClient->disconnectFromEndpoint();
+    QTRY_COMPARE(opcuaClient->state(), QOpcUaClient::Disconnected);
+    opcuaClient->setHotStandby(false);
+
+    if (primaryIsTestServer)
+        QVERIFY(startTestServer());
+    standbyServer.kill();
+    standbyServer.waitForFinished(2000);
+}
+
+void Tst_QOpcUaClient::subscriptionRecovery()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("Recovering subscriptions is not supported by the freeopcua backend");
+    if (!canRestartTestServer())
+        QSKIP("Losing the connection requires the test server started by the test");
+
+    QOpcUaReconnectPolicy policy(true);
+    policy.initialDelay = 200;
+    policy.maximumDelay = 1000;
+    opcuaClient->setReconnectPolicy(policy);
+
+    {
+        OpcuaConnector connector(opcuaClient, m_endpoint);
+
+        QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+        QVERIFY(node != 0);
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+        QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+        QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data()));
+        QVERIFY(monitoredValue != nullptr);
+        QSignalSpy valueSpy(monitoredValue.data(), &QOpcUaMonitoredValue::valueChanged);
+
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(23)), QOpcUa::Types::Double);
+        QTRY_VERIFY(!valueSpy.isEmpty() && valueSpy.last().at(0).toDouble() == double(23));
+
+        // The restarted server knows neither the session nor the subscription, it is recreated
+        QSignalSpy reconnectedSpy(opcuaClient, &QOpcUaClient::reconnected);
+        QVERIFY(stopTestServer());
+        QVERIFY(startTestServer());
+        QTRY_COMPARE_WITH_TIMEOUT(reconnectedSpy.size(), 1, 15000);
+        QCOMPARE(opcuaClient->state(), QOpcUaClient::Connected);
+
+        // The monitored value created before the connection loss still delivers values
+        valueSpy.clear();
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(42)), QOpcUa::Types::Double);
+        QTRY_VERIFY(!valueSpy.isEmpty() && valueSpy.last().at(0).toDouble() == double(42));
+    }
+
+    opcuaClient->setReconnectPolicy(QOpcUaReconnectPolicy());
+}
+
 void Tst_QOpcUaClient::connectInvalidPassword()
 {
     QFETCH(QOpcUaClient *, opcuaClient);
@@ -494,6 +811,61 @@ void Tst_QOpcUaClient::writeMultipleAttributes()
     QVERIFY(node->attribute(QOpcUaNode::NodeAttribute::Value) == double(23.5));
 }
 
+void Tst_QOpcUaClient::writeMultipleStringAttributes()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node("ns=2;s=Demo.Static.Arrays.String"));
+    QVERIFY(node != 0);
+
+    // Several kilobytes of strings with multi byte characters, among them one string too
+    // large to share a block with others
+    QVariantList strings;
+    for (int i = 0; i < 40; ++i)
+        strings.append(QStringLiteral("String %1 \u00e4\u20ac ").arg(i).repeated(i % 8 + 1));
+    strings.append(QString(3000, QLatin1Char('x')));
+    strings.append(QString());
+
+    QOpcUaNode::AttributeMap map;
+    map[QOpcUaNode::NodeAttribute::Value] = strings;
+    map[QOpcUaNode::NodeAttribute::DisplayName] = QVariant::fromValue(QOpcUa::QLocalizedText(QStringLiteral("en"), QStringLiteral("NewDisplayName")));
+    map[QOpcUaNode::NodeAttribute::Description] = QVariant::fromValue(QOpcUa::QLocalizedText(QStringLiteral("en"), QStringLiteral("NewDescription")));
+
+    QSignalSpy writeSpy(node.data(), &QOpcUaNode::attributeWritten);
+    QVERIFY(node->writeAttributes(map, QOpcUa::Types::String));
+    QTRY_COMPARE(writeSpy.size(), 3);
+
+    // All attributes are answered, only the value is writable
+    QSet<int> written;
+    for (const QList<QVariant> &arguments : qAsConst(writeSpy))
+        written.insert(int(arguments.at(0).value<QOpcUaNode::NodeAttribute>()));
+    QCOMPARE(written.size(), 3);
+    QCOMPARE(node->attributeError(QOpcUaNode::NodeAttribute::Value), QOpcUa::UaStatusCode::Good);
+
+    READ_MANDATORY_VARIABLE_NODE(node);
+    const QVariantList result = node->attribute(QOpcUaNode::NodeAttribute::Value).toList();
+    QCOMPARE(result.size(), strings.size());
+    for (int i = 0; i < strings.size(); ++i)
+        QCOMPARE(result.at(i).toString(), strings.at(i).toString());
+
+    // A scalar string next to another attribute in the same request
+    QScopedPointer<QOpcUaNode> scalarNode(opcuaClient->node("ns=2;s=Demo.Static.Scalar.String"));
+    QVERIFY(scalarNode != 0);
+    const QString longString = QStringLiteral("\u00c4rger \u00fcber \u00d6l ").repeated(200);
+    map.clear();
+    map[QOpcUaNode::NodeAttribute::Value] = longString;
+    map[QOpcUaNode::NodeAttribute::DisplayName] = QVariant::fromValue(QOpcUa::QLocalizedText(QStringLiteral("en"), QStringLiteral("NewDisplayName")));
+
+    QSignalSpy scalarWriteSpy(scalarNode.data(), &QOpcUaNode::attributeWritten);
+    QVERIFY(scalarNode->writeAttributes(map, QOpcUa::Types::String));
+    QTRY_COMPARE(scalarWriteSpy.size(), 2);
+    QCOMPARE(scalarNode->attributeError(QOpcUaNode::NodeAttribute::Value), QOpcUa::UaStatusCode::Good);
+
+    READ_MANDATORY_VARIABLE_NODE(scalarNode);
+    QCOMPARE(scalarNode->attribute(QOpcUaNode::NodeAttribute::Value).toString(), longString);
+}
+
 void Tst_QOpcUaClient::getRootNode()
 {
     QFETCH(QOpcUaClient *, opcuaClient);
@@ -583,6 +955,430 @@ void Tst_QOpcUaClient::dataChangeSubscription()
     QCOMPARE(valueSpy.at(0).at(0).toDouble(), double(42));
 }
 
+void Tst_QOpcUaClient::dataChangeStatistics()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("Queue overflows are not reported by the freeopcua backend");
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    // Publishing is much slower than sampling, so the queue of the item overflows between two
+    // publish responses. Servers only set the overflow bit for queues larger than one value.
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(2000));
+    // The buffer is never drained, everything after the first notification is dropped
+    QVERIFY(subscription->enableNotificationBuffer(1));
+    QOpcUaMonitoringParameters parameters(10, 2);
+    parameters.discardOldest = true;
+    QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data(), parameters));
+    QVERIFY(monitoredValue != nullptr);
+    const QOpcUaMonitoringStatistics initial = monitoredValue->statistics();
+
+    for (int i = 1; i <= 10; ++i) {
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(i)), QOpcUa::Types::Double);
+        // Gives the server the time to sample each value
+        QTest::qWait(30);
+    }
+
+    QTRY_VERIFY_WITH_TIMEOUT(monitoredValue->statistics().overflows > initial.overflows, 10000);
+    QTRY_VERIFY_WITH_TIMEOUT(subscription->notificationBufferOverflows() > 0, 5000);
+    const QOpcUaMonitoringStatistics valueStatistics = monitoredValue->statistics();
+    QVERIFY(valueStatistics.notifications > initial.notifications);
+    QCOMPARE(valueStatistics.conversionFailures, quint64(0));
+
+    const QOpcUaMonitoringStatistics subscriptionStatistics = subscription->statistics();
+    QVERIFY(subscriptionStatistics.notifications >= valueStatistics.notifications);
+    QVERIFY(subscriptionStatistics.overflows >= valueStatistics.overflows);
+    QCOMPARE(subscriptionStatistics.sequenceGaps, quint64(0));
+}
+
+void Tst_QOpcUaClient::dataChangeNotificationBuffer()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QAtomicInt wakeUps;
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QVERIFY(subscription->enableNotificationBuffer(16, [&wakeUps]() { wakeUps.ref(); }));
+    QVERIFY(!subscription->enableNotificationBuffer(16));
+    QVERIFY(subscription->hasNotificationBuffer());
+
+    QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data()));
+    QVERIFY(monitoredValue != nullptr);
+    QSignalSpy valueSpy(monitoredValue.data(), &QOpcUaMonitoredValue::valueChanged);
+
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(42)), QOpcUa::Types::Double);
+
+    QVector<QOpcUaDataChangeNotification> notifications;
+    QTRY_VERIFY(subscription->takeNotifications(&notifications) > 0
+                && notifications.last().value.toDouble() == double(42));
+    QVERIFY(wakeUps.load() > 0);
+    QCOMPARE(notifications.last().monitoredValue, monitoredValue.data());
+    QCOMPARE(notifications.last().statusCode, QOpcUa::UaStatusCode::Good);
+    QCOMPARE(subscription->notificationBufferOverflows(), quint64(0));
+    QCOMPARE(valueSpy.count(), 0);
+}
+
+void Tst_QOpcUaClient::dataChangeRawPassthrough()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("Raw passthrough is not supported by the freeopcua backend");
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QVERIFY(subscription->enableNotificationBuffer(16));
+    subscription->setRawPassthrough(true);
+    QVERIFY(subscription->isRawPassthrough());
+
+    QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data()));
+    QVERIFY(monitoredValue != nullptr);
+
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(42)), QOpcUa::Types::Double);
+
+    // A Variant containing a Double is encoded as the type id 11 followed by the IEEE 754 value
+    double expected = 42;
+    QByteArray encodedDouble(1, char(11));
+    encodedDouble.append(reinterpret_cast<const char *>(&expected), sizeof(expected));
+
+    QVector<QOpcUaDataChangeNotification> notifications;
+    QTRY_VERIFY(subscription->takeNotifications(&notifications) > 0
+                && notifications.last().encodedValue == encodedDouble);
+    QCOMPARE(notifications.last().monitoredValue, monitoredValue.data());
+    QVERIFY(!notifications.last().value.isValid());
+    QVERIFY(notifications.last().clientHandle != 0);
+}
+
+void Tst_QOpcUaClient::dataChangeMonitoringMode()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("SetMonitoringMode is not supported by the freeopcua backend");
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data()));
+    QVERIFY(monitoredValue != nullptr);
+
+    QVector<QOpcUa::UaStatusCode> results;
+    QVERIFY(subscription->setMonitoringMode({monitoredValue.data()}, QOpcUa::MonitoringMode::Disabled, &results));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0), QOpcUa::UaStatusCode::Good);
+
+    QSignalSpy valueSpy(monitoredValue.data(), &QOpcUaMonitoredValue::valueChanged);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(23)), QOpcUa::Types::Double);
+    QVERIFY(!valueSpy.wait(500));
+
+    QVERIFY(subscription->setMonitoringMode({monitoredValue.data()}, QOpcUa::MonitoringMode::Reporting, &results));
+    QCOMPARE(results.at(0), QOpcUa::UaStatusCode::Good);
+    QTRY_VERIFY(valueSpy.count() > 0);
+    QCOMPARE(valueSpy.last().at(0).toDouble(), double(23));
+}
+
+void Tst_QOpcUaClient::dataChangeTriggering()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("SetTriggering is not supported by the freeopcua backend");
+
+    QScopedPointer<QOpcUaNode> triggerNode(opcuaClient->node(readWriteNode));
+    QVERIFY(triggerNode != 0);
+    QScopedPointer<QOpcUaNode> linkedNode(opcuaClient->node("ns=2;s=Demo.Static.Scalar.Double"));
+    QVERIFY(linkedNode != 0);
+    WRITE_VALUE_ATTRIBUTE(triggerNode, QVariant(double(0)), QOpcUa::Types::Double);
+    WRITE_VALUE_ATTRIBUTE(linkedNode, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QScopedPointer<QOpcUaMonitoredValue> trigger(subscription->addValue(triggerNode.data()));
+    QVERIFY(trigger != nullptr);
+    QScopedPointer<QOpcUaMonitoredValue> linked(subscription->addValue(linkedNode.data()));
+    QVERIFY(linked != nullptr);
+
+    // A sampled item only reports when its trigger reports
+    QVector<QOpcUa::UaStatusCode> results;
+    QVERIFY(subscription->setMonitoringMode({linked.data()}, QOpcUa::MonitoringMode::Sampling, &results));
+    QCOMPARE(results.at(0), QOpcUa::UaStatusCode::Good);
+
+    QVector<QOpcUa::UaStatusCode> addResults;
+    if (!subscription->setTriggering(trigger.data(), {linked.data()}, {}, &addResults)
+            && addResults.value(0) == QOpcUa::UaStatusCode::BadServiceUnsupported)
+        QSKIP("SetTriggering is not supported by the test server");
+    QCOMPARE(addResults.size(), 1);
+    QCOMPARE(addResults.at(0), QOpcUa::UaStatusCode::Good);
+
+    QSignalSpy triggerSpy(trigger.data(), &QOpcUaMonitoredValue::valueChanged);
+    QSignalSpy linkedSpy(linked.data(), &QOpcUaMonitoredValue::valueChanged);
+    WRITE_VALUE_ATTRIBUTE(linkedNode, QVariant(double(17)), QOpcUa::Types::Double);
+    QVERIFY(!linkedSpy.wait(500));
+
+    WRITE_VALUE_ATTRIBUTE(triggerNode, QVariant(double(1)), QOpcUa::Types::Double);
+    QTRY_VERIFY(triggerSpy.count() > 0);
+    QTRY_VERIFY(linkedSpy.count() > 0);
+    QCOMPARE(linkedSpy.last().at(0).toDouble(), double(17));
+
+    // Without the link the trigger reports alone
+    QVector<QOpcUa::UaStatusCode> removeResults;
+    QVERIFY(subscription->setTriggering(trigger.data(), {}, {linked.data()}, nullptr, &removeResults));
+    QCOMPARE(removeResults.size(), 1);
+    QCOMPARE(removeResults.at(0), QOpcUa::UaStatusCode::Good);
+
+    triggerSpy.clear();
+    linkedSpy.clear();
+    WRITE_VALUE_ATTRIBUTE(linkedNode, QVariant(double(18)), QOpcUa::Types::Double);
+    WRITE_VALUE_ATTRIBUTE(triggerNode, QVariant(double(2)), QOpcUa::Types::Double);
+    QTRY_VERIFY(triggerSpy.count() > 0);
+    QVERIFY(!linkedSpy.wait(500));
+}
+
+void Tst_QOpcUaClient::dataChangeModify()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("ModifySubscription and ModifyMonitoredItems are not supported by the freeopcua backend");
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QOpcUaMonitoringParameters monitoringParameters(100, 5);
+    QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data(), monitoringParameters));
+    QVERIFY(monitoredValue != nullptr);
+    QVERIFY(monitoredValue->monitoringParameters().queueSize >= 1);
+
+    QOpcUaSubscriptionParameters subscriptionParameters(200);
+    QVERIFY(subscription->modify(subscriptionParameters));
+    QVERIFY(subscription->parameters().publishingInterval > 0);
+
+    monitoringParameters.samplingInterval = 200;
+    monitoringParameters.filter = QVariant::fromValue(QOpcUaMonitoringParameters::DataChangeFilter(
+                                                          QOpcUaMonitoringParameters::DataChangeTrigger::StatusValue,
+                                                          QOpcUaMonitoringParameters::DeadbandType::Absolute, 10));
+    QVector<QOpcUa::UaStatusCode> results;
+    QVERIFY(subscription->modifyMonitoredValues({monitoredValue.data()}, monitoringParameters, &results));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0), QOpcUa::UaStatusCode::Good);
+
+    QSignalSpy valueSpy(monitoredValue.data(), &QOpcUaMonitoredValue::valueChanged);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(23)), QOpcUa::Types::Double);
+    QTRY_VERIFY(valueSpy.count() > 0);
+    QCOMPARE(valueSpy.last().at(0).toDouble(), double(23));
+}
+
+void Tst_QOpcUaClient::dataChangeAggregateFilter()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("ModifyMonitoredItems is not supported by the freeopcua backend");
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QOpcUaMonitoringParameters monitoringParameters(100);
+    QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data(), monitoringParameters));
+    QVERIFY(monitoredValue != nullptr);
+    QVERIFY(!monitoredValue->monitoringParameters().filterResult.isValid());
+
+    // Average over one second
+    monitoringParameters.filter = QVariant::fromValue(QOpcUaMonitoringParameters::AggregateFilter(
+                                                          QStringLiteral("ns=0;i=2342"), 1000));
+    QVector<QOpcUa::UaStatusCode> results;
+    subscription->modifyMonitoredValues({monitoredValue.data()}, monitoringParameters, &results);
+    QCOMPARE(results.size(), 1);
+
+    if (results.at(0) != QOpcUa::UaStatusCode::Good) {
+        // Aggregates are optional, a server without them rejects the filter and keeps the item
+        QVERIFY(results.at(0) == QOpcUa::UaStatusCode::BadMonitoredItemFilterUnsupported
+                || results.at(0) == QOpcUa::UaStatusCode::BadFilterNotAllowed
+                || results.at(0) == QOpcUa::UaStatusCode::BadAggregateNotSupported);
+        QVERIFY(!monitoredValue->monitoringParameters().filter.isValid());
+        QVERIFY(!monitoredValue->monitoringParameters().filterResult.isValid());
+
+        QSignalSpy valueSpy(monitoredValue.data(), &QOpcUaMonitoredValue::valueChanged);
+        WRITE_VALUE_ATTRIBUTE(node, QVariant(double(23)), QOpcUa::Types::Double);
+        QTRY_VERIFY(valueSpy.count() > 0);
+        QCOMPARE(valueSpy.last().at(0).toDouble(), double(23));
+        return;
+    }
+
+    const QVariant filterResult = monitoredValue->monitoringParameters().filterResult;
+    QCOMPARE(filterResult.userType(), qMetaTypeId<QOpcUaMonitoringParameters::AggregateFilterResult>());
+    QVERIFY(filterResult.value<QOpcUaMonitoringParameters::AggregateFilterResult>().revisedProcessingInterval > 0);
+
+    // The revised parameters are also returned for an item created with the filter
+    QScopedPointer<QOpcUaMonitoredValue> createdValue(subscription->addValue(node.data(), monitoringParameters));
+    QVERIFY(createdValue != nullptr);
+    const QVariant createdResult = createdValue->monitoringParameters().filterResult;
+    QCOMPARE(createdResult.userType(), qMetaTypeId<QOpcUaMonitoringParameters::AggregateFilterResult>());
+    QVERIFY(createdResult.value<QOpcUaMonitoringParameters::AggregateFilterResult>().revisedProcessingInterval > 0);
+}
+
+void Tst_QOpcUaClient::dataChangeSharedSubscription()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QScopedPointer<QOpcUaSubscription> first(opcuaClient->createSubscription(100));
+    QScopedPointer<QOpcUaSubscription> second(opcuaClient->createSubscription(100));
+    QScopedPointer<QOpcUaMonitoredValue> firstValue(first->addValue(node.data()));
+    QVERIFY(firstValue != nullptr);
+    QSignalSpy firstSpy(firstValue.data(), &QOpcUaMonitoredValue::valueChanged);
+    QTRY_VERIFY(firstSpy.count() > 0);
+
+    // The second value joins after the initial value has been delivered
+    QScopedPointer<QOpcUaMonitoredValue> secondValue(second->addValue(node.data()));
+    QVERIFY(secondValue != nullptr);
+    QSignalSpy secondSpy(secondValue.data(), &QOpcUaMonitoredValue::valueChanged);
+    QTRY_VERIFY(secondSpy.count() > 0);
+    QCOMPARE(secondSpy.last().at(0).toDouble(), double(0));
+
+    secondSpy.clear();
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(42)), QOpcUa::Types::Double);
+    QTRY_VERIFY(firstSpy.count() > 1 && firstSpy.last().at(0).toDouble() == double(42));
+    QTRY_VERIFY(secondSpy.count() > 0 && secondSpy.last().at(0).toDouble() == double(42));
+
+    // Removing one value must not stop the other
+    firstValue.reset();
+    first.reset();
+    secondSpy.clear();
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(43)), QOpcUa::Types::Double);
+    QTRY_VERIFY(secondSpy.count() > 0 && secondSpy.last().at(0).toDouble() == double(43));
+}
+
+void Tst_QOpcUaClient::dataChangeAggregation()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("The freeopcua backend only closes aggregation windows when a data change arrives");
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data()));
+    QVERIFY(monitoredValue != nullptr);
+
+    QSignalSpy valueSpy(monitoredValue.data(), &QOpcUaMonitoredValue::valueChanged);
+    QTRY_VERIFY(valueSpy.count() > 0 || monitoredValue->statistics().notifications > 0);
+    valueSpy.clear();
+
+    monitoredValue->setAggregationWindow(QOpcUaAggregationWindow(QOpcUaAggregationWindow::Type::Tumbling, 500));
+    QCOMPARE(monitoredValue->aggregationWindow().type, QOpcUaAggregationWindow::Type::Tumbling);
+    QSignalSpy aggregateSpy(monitoredValue.data(), &QOpcUaMonitoredValue::aggregateChanged);
+
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(10)), QOpcUa::Types::Double);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(20)), QOpcUa::Types::Double);
+    QTRY_VERIFY(aggregateSpy.count() > 0
+                && aggregateSpy.last().at(0).value<QOpcUaAggregateValue>().last.toDouble() == double(20));
+
+    const QOpcUaAggregateValue aggregate = aggregateSpy.last().at(0).value<QOpcUaAggregateValue>();
+    QVERIFY(aggregate.count > 0);
+    QVERIFY(aggregate.minimum <= aggregate.average && aggregate.average <= aggregate.maximum);
+    QCOMPARE(aggregate.maximum, double(20));
+    QVERIFY(aggregate.windowStart < aggregate.windowEnd);
+    QCOMPARE(valueSpy.count(), 0);
+
+    monitoredValue->setAggregationWindow(QOpcUaAggregationWindow());
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(30)), QOpcUa::Types::Double);
+    QTRY_VERIFY(valueSpy.count() > 0);
+    QCOMPARE(valueSpy.last().at(0).toDouble(), double(30));
+}
+
+void Tst_QOpcUaClient::dataChangeTypedValue()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node(readWriteNode));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(0)), QOpcUa::Types::Double);
+
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QObject context;
+    double received = -1;
+    int callCount = 0;
+    QOpcUaTypedMonitoredValue<double> typedValue(subscription.data(), node.data(), &context,
+                                                 [&](double value, QOpcUa::UaStatusCode statusCode) {
+        QCOMPARE(statusCode, QOpcUa::UaStatusCode::Good);
+        received = value;
+        ++callCount;
+    });
+    QVERIFY(typedValue.isValid());
+    QTRY_COMPARE(received, double(0));
+
+    WRITE_VALUE_ATTRIBUTE(node, QVariant(double(42)), QOpcUa::Types::Double);
+    QTRY_COMPARE(received, double(42));
+    QVERIFY(callCount >= 2);
+    QVERIFY(typedValue.monitoredValue()->statistics().notifications >= 2);
+}
+
+void Tst_QOpcUaClient::dataChangeStringCache()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QCOMPARE(opcuaClient->stringCacheSize(), 0);
+    opcuaClient->setStringCacheSize(2);
+    QCOMPARE(opcuaClient->stringCacheSize(), 2);
+
+    QScopedPointer<QOpcUaNode> node(opcuaClient->node("ns=2;s=Demo.Static.Scalar.String"));
+    QVERIFY(node != 0);
+    WRITE_VALUE_ATTRIBUTE(node, QStringLiteral("Idle"), QOpcUa::Types::String);
+
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+    QScopedPointer<QOpcUaMonitoredValue> monitoredValue(subscription->addValue(node.data()));
+    QVERIFY(monitoredValue != nullptr);
+    QSignalSpy valueSpy(monitoredValue.data(), &QOpcUaMonitoredValue::valueChanged);
+    QTRY_VERIFY(valueSpy.count() > 0);
+    QCOMPARE(valueSpy.last().at(0).toString(), QStringLiteral("Idle"));
+
+    // More distinct values than entries, the least recently used one is evicted and decoded again
+    const QStringList states = {QStringLiteral("Running"), QStringLiteral("Stopped"),
+                                QStringLiteral("Idle"), QStringLiteral("Running")};
+    for (const QString &state : states) {
+        valueSpy.clear();
+        WRITE_VALUE_ATTRIBUTE(node, state, QOpcUa::Types::String);
+        QTRY_VERIFY(valueSpy.count() > 0);
+        QCOMPARE(valueSpy.last().at(0).toString(), state);
+    }
+
+    opcuaClient->setStringCacheSize(0);
+}
+
 void Tst_QOpcUaClient::dataChangeSubscriptionInvalidNode()
 {
     QFETCH(QOpcUaClient *, opcuaClient);
@@ -618,6 +1414,81 @@ void Tst_QOpcUaClient::methodCall()
     QVERIFY(ret[0].type() == QVariant::Double && ret[0].value<double>() == 16);
 }
 
+void Tst_QOpcUaClient::methodCallBatch()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("Batched method calls are not supported by the freeopcua backend");
+
+    const QVector<QOpcUaMethodCall> calls = {
+        QOpcUaMethodCall("ns=3;s=TestFolder", "ns=0;s=IDoNotExist"),
+        QOpcUaMethodCall("ns=3;s=TestFolder", "ns=3;s=IDoNotExistEither",
+                         {QOpcUa::TypedVariant(double(4), QOpcUa::Double)})
+    };
+
+    // Not connected
+    QCOMPARE(opcuaClient->callMethods(calls), 0u);
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+    QCOMPARE(opcuaClient->callMethods(QVector<QOpcUaMethodCall>()), 0u);
+
+    QSignalSpy spy(opcuaClient, &QOpcUaClient::methodsCalled);
+    const quint32 first = opcuaClient->callMethods(calls);
+    const quint32 second = opcuaClient->callMethods(calls);
+    QVERIFY(first != 0);
+    QVERIFY(second != first);
+
+    // The requests are answered in order with one result per call
+    QTRY_COMPARE(spy.size(), 2);
+    QCOMPARE(spy.at(0).at(0).value<quint32>(), first);
+    QCOMPARE(spy.at(1).at(0).value<quint32>(), second);
+    QCOMPARE(spy.at(0).at(2).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+    const QVector<QOpcUaMethodCallResult> results = spy.at(0).at(1).value<QVector<QOpcUaMethodCallResult>>();
+    QCOMPARE(results.size(), calls.size());
+    for (const QOpcUaMethodCallResult &result : results) {
+        QVERIFY(result.statusCode != QOpcUa::UaStatusCode::Good);
+        QVERIFY(result.outputArguments.isEmpty());
+    }
+}
+
+void Tst_QOpcUaClient::preparedMethod()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+
+    QVERIFY(opcuaClient->prepareMethod("ns=3;s=TestFolder", "ns=3;s=Test.Method.Multiply") == nullptr);
+
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    // Both methods are resolved with the same requests
+    QScopedPointer<QOpcUaPreparedMethod> unknown(opcuaClient->prepareMethod("ns=3;s=TestFolder", "ns=0;s=IDoNotExist"));
+    QScopedPointer<QOpcUaPreparedMethod> other(opcuaClient->prepareMethod("ns=3;s=TestFolder", "ns=3;s=IDoNotExistEither"));
+    QVERIFY(unknown != nullptr);
+    QVERIFY(other != nullptr);
+    QCOMPARE(unknown->objectId(), QStringLiteral("ns=3;s=TestFolder"));
+    QCOMPARE(unknown->methodId(), QStringLiteral("ns=0;s=IDoNotExist"));
+
+    // The result is reported from the event loop, connecting after prepareMethod() is safe.
+    // This also holds for freeopcua which rejects every method.
+    QSignalSpy unknownSpy(unknown.data(), &QOpcUaPreparedMethod::prepared);
+    QSignalSpy otherSpy(other.data(), &QOpcUaPreparedMethod::prepared);
+    QCOMPARE(unknownSpy.size(), 0);
+    QVERIFY(!unknown->isPrepared());
+    QTRY_COMPARE(unknownSpy.size(), 1);
+    QTRY_COMPARE(otherSpy.size(), 1);
+    QVERIFY(!unknown->isPrepared());
+    QVERIFY(unknown->statusCode() != QOpcUa::UaStatusCode::Good);
+    QVERIFY(unknown->inputArguments().isEmpty());
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QCOMPARE(unknown->statusCode(), QOpcUa::UaStatusCode::BadNotSupported);
+
+    // An unprepared method derives the argument types from the values
+    const QOpcUaMethodCall call = unknown->methodCall({double(4), QString("test")});
+    QCOMPARE(call.arguments.size(), 2);
+    QCOMPARE(call.arguments.at(0).second, QOpcUa::Undefined);
+    QCOMPARE(call.methodId, unknown->methodId());
+}
+
 void Tst_QOpcUaClient::eventSubscription()
 {
     QFETCH(QOpcUaClient *, opcuaClient);
@@ -668,6 +1539,78 @@ void Tst_QOpcUaClient::eventSubscribeInvalidNode()
     QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
     QOpcUaMonitoredEvent *monitoredEvent = subscription->addEvent(noEventNode.data());
     QVERIFY(monitoredEvent == 0);
+
+    QOpcUaEventFilter filter({QOpcUaSimpleAttributeOperand(QStringLiteral("Severity"))},
+                             {QOpcUaContentFilterElement(QOpcUaContentFilterElement::FilterOperator::GreaterThan,
+                                                         {QVariant::fromValue(QOpcUaSimpleAttributeOperand(QStringLiteral("Severity"))),
+                                                          QVariant::fromValue(QOpcUa::TypedVariant(500, QOpcUa::UInt16))})});
+    monitoredEvent = subscription->addEvent(noEventNode.data(), filter);
+    QVERIFY(monitoredEvent == 0);
+}
+
+void Tst_QOpcUaClient::eventFilter()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> serverNode(opcuaClient->node("ns=0;i=2253"));
+    QVERIFY(serverNode != 0);
+    QScopedPointer<QOpcUaSubscription> subscription(opcuaClient->createSubscription(100));
+
+    const QOpcUaEventFilter selectOnly({QOpcUaSimpleAttributeOperand(QStringLiteral("Severity")),
+                                        QOpcUaSimpleAttributeOperand(QStringLiteral("Message")),
+                                        QOpcUaSimpleAttributeOperand(QStringLiteral("SourceName"))});
+    QOpcUaEventFilter highSeverity = selectOnly;
+    highSeverity.whereClause.push_back(QOpcUaContentFilterElement(QOpcUaContentFilterElement::FilterOperator::GreaterThan,
+                                                                  {QVariant::fromValue(QOpcUaSimpleAttributeOperand(QStringLiteral("Severity"))),
+                                                                   QVariant::fromValue(QOpcUa::TypedVariant(500, QOpcUa::UInt16))}));
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua")) {
+        // The where clause must not be ignored silently
+        QScopedPointer<QOpcUaMonitoredEvent> rejected(subscription->addEvent(serverNode.data(), highSeverity));
+        QVERIFY(rejected == nullptr);
+        return;
+    }
+
+    // The test server only emits events if open62541 was built with event support
+    QScopedPointer<QOpcUaNode> eventsNode(opcuaClient->node("ns=3;s=TestNode.Events"));
+    QVERIFY(eventsNode != 0);
+    QSignalSpy readSpy(eventsNode.data(), &QOpcUaNode::readFinished);
+    eventsNode->readAttributes(QOpcUaNode::NodeAttribute::Value);
+    QVERIFY(readSpy.wait());
+    if (!QOpcUa::isSuccessStatus(eventsNode->attributeError(QOpcUaNode::NodeAttribute::Value)))
+        QSKIP("The test server does not emit events");
+
+    // The fields of each event follow the order of the select clauses
+    QScopedPointer<QOpcUaMonitoredEvent> allEvents(subscription->addEvent(serverNode.data(), selectOnly));
+    QVERIFY(allEvents != nullptr);
+
+    QScopedPointer<QOpcUaMonitoredEvent> filteredEvents(subscription->addEvent(serverNode.data(), highSeverity));
+    QVERIFY(filteredEvents != nullptr);
+
+    QSignalSpy allSpy(allEvents.data(), &QOpcUaMonitoredEvent::newEvent);
+    QSignalSpy filteredSpy(filteredEvents.data(), &QOpcUaMonitoredEvent::newEvent);
+    QTRY_VERIFY_WITH_TIMEOUT(allSpy.size() >= 6 && filteredSpy.size() >= 3, 5000);
+
+    QSet<uint> severities;
+    for (const QList<QVariant> &arguments : qAsConst(allSpy)) {
+        const QVector<QVariant> fields = arguments.at(0).toList().toVector();
+        QCOMPARE(fields.size(), 3);
+        const uint severity = fields.at(0).toUInt();
+        QVERIFY(severity == 100 || severity == 900);
+        severities.insert(severity);
+        QCOMPARE(fields.at(1).value<QOpcUa::QLocalizedText>().text, QStringLiteral("Test event %1").arg(severity));
+        QCOMPARE(fields.at(2).toString(), QStringLiteral("TestServer"));
+    }
+    QCOMPARE(severities.size(), 2);
+
+    // Only the events matching the where clause are delivered
+    for (const QList<QVariant> &arguments : qAsConst(filteredSpy)) {
+        const QVector<QVariant> fields = arguments.at(0).toList().toVector();
+        QCOMPARE(fields.size(), 3);
+        QCOMPARE(fields.at(0).toUInt(), 900u);
+        QCOMPARE(fields.at(1).value<QOpcUa::QLocalizedText>().text, QStringLiteral("Test event 900"));
+    }
 }
 
 void Tst_QOpcUaClient::readRange()
@@ -1208,6 +2151,186 @@ void Tst_QOpcUaClient::readArray()
     QCOMPARE(xmlElementArray.toList()[2].toString(), xmlElements[2]);
 }
 
+void Tst_QOpcUaClient::readTypedArray()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("Typed arrays are not supported by the freeopcua backend");
+
+    opcuaClient->setArrayRepresentation(QOpcUaClient::TypedVector);
+    QCOMPARE(opcuaClient->arrayRepresentation(), QOpcUaClient::TypedVector);
+
+    QScopedPointer<QOpcUaNode> doubleArrayNode(opcuaClient->node("ns=2;s=Demo.Static.Arrays.Double"));
+    QVERIFY(doubleArrayNode != 0);
+    READ_MANDATORY_VARIABLE_NODE(doubleArrayNode);
+    QVariant doubleArray = doubleArrayNode->attribute(QOpcUaNode::NodeAttribute::Value);
+    QCOMPARE(doubleArray.userType(), qMetaTypeId<QVector<double>>());
+    const QVector<double> doubles = doubleArray.value<QVector<double>>();
+    QCOMPARE(doubles, QVector<double>({23.5, 23.6, 23.7}));
+
+    // Writing the vector back must not change the values
+    WRITE_VALUE_ATTRIBUTE(doubleArrayNode, doubleArray, QOpcUa::Double);
+    READ_MANDATORY_VARIABLE_NODE(doubleArrayNode);
+    QCOMPARE(doubleArrayNode->attribute(QOpcUaNode::NodeAttribute::Value).value<QVector<double>>(), doubles);
+
+    // Non numeric arrays are still returned as a list
+    QScopedPointer<QOpcUaNode> stringArrayNode(opcuaClient->node("ns=2;s=Demo.Static.Arrays.String"));
+    QVERIFY(stringArrayNode != 0);
+    READ_MANDATORY_VARIABLE_NODE(stringArrayNode);
+    QVERIFY(stringArrayNode->attribute(QOpcUaNode::NodeAttribute::Value).type() == QVariant::List);
+
+    opcuaClient->setArrayRepresentation(QOpcUaClient::VariantList);
+}
+
+void Tst_QOpcUaClient::readOpcUaVariant()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> doubleNode(opcuaClient->node("ns=2;s=Demo.Static.Scalar.Double"));
+    QVERIFY(doubleNode != 0);
+    QSignalSpy resultSpy(doubleNode.data(), &QOpcUaNode::attributeWritten);
+    doubleNode->writeAttribute(QOpcUaNode::NodeAttribute::Value, QOpcUaVariant(42.0));
+    resultSpy.wait();
+    QCOMPARE(resultSpy.size(), 1);
+    QCOMPARE(resultSpy.at(0).at(1).value<QOpcUa::UaStatusCode>(), QOpcUa::UaStatusCode::Good);
+
+    READ_MANDATORY_VARIABLE_NODE(doubleNode);
+    const QOpcUaVariant value = doubleNode->typedAttribute(QOpcUaNode::NodeAttribute::Value);
+    QCOMPARE(value, QOpcUaVariant(42.0));
+    QCOMPARE(value.value<double>(), 42.0);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("The freeopcua backend returns StatusCode values as UInt32");
+
+    // StatusCode keeps its type although it is a UInt32 in QVariant
+    QScopedPointer<QOpcUaNode> statusCodeArrayNode(opcuaClient->node("ns=2;s=Demo.Static.Arrays.StatusCode"));
+    QVERIFY(statusCodeArrayNode != 0);
+    READ_MANDATORY_VARIABLE_NODE(statusCodeArrayNode);
+    const QOpcUaVariant statusCodes = statusCodeArrayNode->typedAttribute(QOpcUaNode::NodeAttribute::Value);
+    QCOMPARE(statusCodes.type(), QOpcUa::StatusCode);
+    QVERIFY(statusCodes.isArray());
+    QCOMPARE(statusCodes.array<QOpcUa::UaStatusCode>(), QVector<QOpcUa::UaStatusCode>({QOpcUa::UaStatusCode::Good,
+                                                                                       QOpcUa::UaStatusCode::BadUnexpectedError,
+                                                                                       QOpcUa::UaStatusCode::BadInternalError}));
+}
+
+void Tst_QOpcUaClient::readStructure()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    if (opcuaClient->backend() == QLatin1String("freeopcua"))
+        QSKIP("Structures are not supported by the freeopcua backend");
+
+    QScopedPointer<QOpcUaNode> vectorNode(opcuaClient->node("ns=2;s=Demo.Static.Scalar.Vector"));
+    QVERIFY(vectorNode != 0);
+    READ_MANDATORY_VARIABLE_NODE(vectorNode);
+    const QVariant value = vectorNode->attribute(QOpcUaNode::NodeAttribute::Value);
+    QCOMPARE(value.userType(), qMetaTypeId<QOpcUaStructuredValue>());
+
+    const QOpcUaStructuredValue vector = value.value<QOpcUaStructuredValue>();
+    QVERIFY(vector.isValid());
+    QCOMPARE(vector.typeName(), QStringLiteral("Vector"));
+    QCOMPARE(vector.fieldNames(), QStringList({QStringLiteral("X"), QStringLiteral("Y"), QStringLiteral("Z")}));
+    for (int i = 0; i < vector.fieldCount(); ++i)
+        QCOMPARE(vector.field(i).type(), QVariant::Double);
+}
+
+void Tst_QOpcUaClient::readArrayRange()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> doubleArrayNode(opcuaClient->node("ns=2;s=Demo.Static.Arrays.Double"));
+    QVERIFY(doubleArrayNode != 0);
+
+    QSignalSpy readFinishedSpy(doubleArrayNode.data(), &QOpcUaNode::readFinished);
+    QVERIFY(doubleArrayNode->readAttributeRange(QOpcUaNode::NodeAttribute::Value, QStringLiteral("1:2")));
+    readFinishedSpy.wait();
+    QCOMPARE(readFinishedSpy.count(), 1);
+    QCOMPARE(doubleArrayNode->attributeError(QOpcUaNode::NodeAttribute::Value), QOpcUa::UaStatusCode::Good);
+    const QVariantList doubleArray = doubleArrayNode->attribute(QOpcUaNode::NodeAttribute::Value).toList();
+    QCOMPARE(doubleArray.size(), 2);
+    QCOMPARE(doubleArray.at(0).toDouble(), double(23.6));
+    QCOMPARE(doubleArray.at(1).toDouble(), double(23.7));
+
+    // A 2x3 matrix and a strided view of its second and third column
+    QOpcUaMultiDimensionalArray matrix(QVariant::fromValue(QVector<double>({1, 2, 3, 4, 5, 6})), {2, 3});
+    QVERIFY(matrix.isValid());
+    QVERIFY(matrix.isContiguous());
+    QCOMPARE(matrix.strides(), QVector<quint32>({3, 1}));
+    QCOMPARE(matrix.value({1, 2}).toDouble(), 6.0);
+
+    const QVector<QOpcUaMultiDimensionalArray::Range> columns({qMakePair(0u, 1u), qMakePair(1u, 2u)});
+    QCOMPARE(QOpcUaMultiDimensionalArray::indexRange(columns), QStringLiteral("0:1,1:2"));
+    const QOpcUaMultiDimensionalArray view = matrix.slice(columns);
+    QVERIFY(view.isValid());
+    QVERIFY(!view.isContiguous());
+    QCOMPARE(view.dimensions(), QVector<quint32>({2, 2}));
+    QCOMPARE(view.value({1, 0}).toDouble(), 5.0);
+    QCOMPARE(view.compacted().data().value<QVector<double>>(), QVector<double>({2, 3, 5, 6}));
+}
+
+void Tst_QOpcUaClient::writeArrayRange()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    QScopedPointer<QOpcUaNode> arrayNode(opcuaClient->node("ns=3;s=TestNode.RangeArray"));
+    QVERIFY(arrayNode != 0);
+    WRITE_VALUE_ATTRIBUTE(arrayNode, QVariantList({0.0, 1.0, 2.0, 3.0, 4.0, 5.0}), QOpcUa::Double);
+
+    QSignalSpy writeSpy(arrayNode.data(), &QOpcUaNode::attributeWritten);
+    QVERIFY(arrayNode->writeAttributeRange(QOpcUaNode::NodeAttribute::Value, QVariantList({20.5, 30.5}),
+                                           QStringLiteral("2:3"), QOpcUa::Double));
+    writeSpy.wait();
+    QCOMPARE(writeSpy.size(), 1);
+    QCOMPARE(writeSpy.at(0).at(0).value<QOpcUaNode::NodeAttribute>(), QOpcUaNode::NodeAttribute::Value);
+    QCOMPARE(writeSpy.at(0).at(1).toUInt(), (uint)0);
+
+    // Read back a range that overlaps both written and untouched elements
+    QSignalSpy readFinishedSpy(arrayNode.data(), &QOpcUaNode::readFinished);
+    QVERIFY(arrayNode->readAttributeRange(QOpcUaNode::NodeAttribute::Value, QStringLiteral("1:4")));
+    readFinishedSpy.wait();
+    QCOMPARE(readFinishedSpy.count(), 1);
+    QCOMPARE(arrayNode->attributeError(QOpcUaNode::NodeAttribute::Value), QOpcUa::UaStatusCode::Good);
+    const QVariantList values = arrayNode->attribute(QOpcUaNode::NodeAttribute::Value).toList();
+    QCOMPARE(values.size(), 4);
+    QCOMPARE(values.at(0).toDouble(), 1.0);
+    QCOMPARE(values.at(1).toDouble(), 20.5);
+    QCOMPARE(values.at(2).toDouble(), 30.5);
+    QCOMPARE(values.at(3).toDouble(), 4.0);
+}
+
+void Tst_QOpcUaClient::readMatrixRange()
+{
+    QFETCH(QOpcUaClient *, opcuaClient);
+    OpcuaConnector connector(opcuaClient, m_endpoint);
+
+    // The server node is the 2x3 matrix {{1, 2, 3}, {4, 5, 6}}
+    QScopedPointer<QOpcUaNode> matrixNode(opcuaClient->node("ns=3;s=TestNode.Matrix"));
+    QVERIFY(matrixNode != 0);
+
+    QSignalSpy readFinishedSpy(matrixNode.data(), &QOpcUaNode::readFinished);
+    QVERIFY(matrixNode->readAttributeRange(QOpcUaNode::NodeAttribute::Value, QStringLiteral("0:1,1:2")));
+    readFinishedSpy.wait();
+    QCOMPARE(readFinishedSpy.count(), 1);
+    QCOMPARE(matrixNode->attributeError(QOpcUaNode::NodeAttribute::Value), QOpcUa::UaStatusCode::Good);
+
+    const QVariant value = matrixNode->attribute(QOpcUaNode::NodeAttribute::Value);
+    QCOMPARE(value.userType(), qMetaTypeId<QOpcUaMultiDimensionalArray>());
+    const QOpcUaMultiDimensionalArray matrix = value.value<QOpcUaMultiDimensionalArray>();
+    QVERIFY(matrix.isValid());
+    QCOMPARE(matrix.dimensions(), QVector<quint32>({2, 2}));
+    QCOMPARE(matrix.value({0, 0}).toDouble(), 2.0);
+    QCOMPARE(matrix.value({0, 1}).toDouble(), 3.0);
+    QCOMPARE(matrix.value({1, 0}).toDouble(), 5.0);
+    QCOMPARE(matrix.value({1, 1}).toDouble(), 6.0);
+}
+
 void Tst_QOpcUaClient::writeScalar()
 {
     QFETCH(QOpcUaClient *, opcuaClient);
@@ -1530,6 +2653,22 @@ void Tst_QOpcUaClient::stringCharset()
     QVERIFY(result.toList()[1].value<QOpcUa::QLocalizedText>() == lt2);
 }
 
+bool Tst_QOpcUaClient::stopTestServer()
+{
+    m_serverProcess.kill();
+    return m_serverProcess.waitForFinished(2000);
+}
+
+bool Tst_QOpcUaClient::startTestServer()
+{
+    m_serverProcess.start(m_serverProcess.program());
+    if (!m_serverProcess.waitForStarted())
+        return false;
+    // Let the server come up
+    QTest::qWait(2000);
+    return true;
+}
+
 void Tst_QOpcUaClient::cleanupTestCase()
 {
     if (m_serverProcess.state() == QProcess::Running) {
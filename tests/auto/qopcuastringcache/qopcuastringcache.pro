@@ -0,0 +1,7 @@
+TARGET = tst_qopcuastringcache
+
+QT += testlib opcua-private
+CONFIG += testcase
+
+SOURCES += \
+    tst_qopcuastringcache.cpp
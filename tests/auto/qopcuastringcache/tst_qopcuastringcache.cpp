@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtOpcUa/private/qopcuastringcache_p.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+
+class Tst_QOpcUaStringCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void interning();
+    void size();
+    void evictsLeastRecentlyUsed();
+    void longStringsBypassCache();
+    void disabled();
+
+private:
+    static QString fromUtf8(QOpcUaStringCache *cache, const QByteArray &utf8)
+    {
+        return cache->fromUtf8(utf8.constData(), utf8.size());
+    }
+};
+
+void Tst_QOpcUaStringCache::interning()
+{
+    QOpcUaStringCache cache(4);
+
+    // Two decodes of equal bytes from different buffers share one QString
+    const QByteArray first("Temperature");
+    const QByteArray second("Temperature");
+    const QString a = fromUtf8(&cache, first);
+    const QString b = fromUtf8(&cache, second);
+    QCOMPARE(a, QStringLiteral("Temperature"));
+    QCOMPARE(b, a);
+    QVERIFY(b.isSharedWith(a));
+
+    const QString other = fromUtf8(&cache, QByteArray("Pressure"));
+    QCOMPARE(other, QStringLiteral("Pressure"));
+    QVERIFY(!other.isSharedWith(a));
+
+    // Non ASCII values are decoded as UTF-8
+    const QString umlaut = fromUtf8(&cache, QByteArray("Gr\xc3\xb6\xc3\x9f" "e"));
+    QCOMPARE(umlaut, QString::fromUtf8("Gr\xc3\xb6\xc3\x9f" "e"));
+}
+
+void Tst_QOpcUaStringCache::size()
+{
+    QOpcUaStringCache cache(8);
+    QCOMPARE(cache.capacity(), 8);
+    QCOMPARE(cache.size(), 0);
+
+    fromUtf8(&cache, QByteArray("a"));
+    fromUtf8(&cache, QByteArray("b"));
+    fromUtf8(&cache, QByteArray("a"));
+    QCOMPARE(cache.size(), 2);
+
+    // The empty string is a value of its own
+    fromUtf8(&cache, QByteArray());
+    QCOMPARE(cache.size(), 3);
+
+    cache.clear();
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.capacity(), 8);
+}
+
+void Tst_QOpcUaStringCache::evictsLeastRecentlyUsed()
+{
+    QOpcUaStringCache cache(3);
+    const QString a = fromUtf8(&cache, QByteArray("a"));
+    const QString b = fromUtf8(&cache, QByteArray("b"));
+    const QString c = fromUtf8(&cache, QByteArray("c"));
+    QCOMPARE(cache.size(), 3);
+
+    // Using a makes b the least recently used entry, which the fourth string replaces
+    QVERIFY(fromUtf8(&cache, QByteArray("a")).isSharedWith(a));
+    fromUtf8(&cache, QByteArray("d"));
+    QCOMPARE(cache.size(), 3);
+
+    QVERIFY(fromUtf8(&cache, QByteArray("a")).isSharedWith(a));
+    QVERIFY(fromUtf8(&cache, QByteArray("c")).isSharedWith(c));
+    const QString newB = fromUtf8(&cache, QByteArray("b"));
+    QCOMPARE(newB, b);
+    QVERIFY(!newB.isSharedWith(b));
+    QCOMPARE(cache.size(), 3);
+
+    // Shrinking drops the least recently used entries first, a is the oldest one now
+    cache.setCapacity(2);
+    QCOMPARE(cache.size(), 2);
+    QVERIFY(fromUtf8(&cache, QByteArray("b")).isSharedWith(newB));
+    QVERIFY(fromUtf8(&cache, QByteArray("c")).isSharedWith(c));
+    QVERIFY(!fromUtf8(&cache, QByteArray("a")).isSharedWith(a));
+}
+
+void Tst_QOpcUaStringCache::longStringsBypassCache()
+{
+    QOpcUaStringCache cache(4);
+    const QByteArray utf8(QOpcUaStringCache::MaximumStringSize + 1, 'x');
+    const QString first = fromUtf8(&cache, utf8);
+    const QString second = fromUtf8(&cache, utf8);
+    QCOMPARE(first, QString::fromUtf8(utf8));
+    QCOMPARE(second, first);
+    QVERIFY(!second.isSharedWith(first));
+    QCOMPARE(cache.size(), 0);
+}
+
+void Tst_QOpcUaStringCache::disabled()
+{
+    QOpcUaStringCache cache;
+    QCOMPARE(cache.capacity(), 0);
+    const QString first = fromUtf8(&cache, QByteArray("a"));
+    QVERIFY(!fromUtf8(&cache, QByteArray("a")).isSharedWith(first));
+    QCOMPARE(cache.size(), 0);
+
+    // A capacity of 0 empties an enabled cache
+    cache.setCapacity(2);
+    fromUtf8(&cache, QByteArray("a"));
+    QCOMPARE(cache.size(), 1);
+    cache.setCapacity(0);
+    QCOMPARE(cache.size(), 0);
+}
+
+QTEST_APPLESS_MAIN(Tst_QOpcUaStringCache)
+
+#include "tst_qopcuastringcache.moc"
@@ -0,0 +1,17 @@
+TARGET = tst_qopen62541lazyvalue
+
+QT += testlib opcua-private
+CONFIG += testcase
+
+QMAKE_USE_PRIVATE += open62541
+
+INCLUDEPATH += \
+               $$PWD/../../../src/plugins/opcua/open62541
+
+SOURCES += \
+    tst_qopen62541lazyvalue.cpp \
+    $$PWD/../../../src/plugins/opcua/open62541/qopen62541arena.cpp \
+    $$PWD/../../../src/plugins/opcua/open62541/qopen62541lazyvalue.cpp \
+    $$PWD/../../../src/plugins/opcua/open62541/qopen62541typedictionary.cpp \
+    $$PWD/../../../src/plugins/opcua/open62541/qopen62541utils.cpp \
+    $$PWD/../../../src/plugins/opcua/open62541/qopen62541valueconverter.cpp
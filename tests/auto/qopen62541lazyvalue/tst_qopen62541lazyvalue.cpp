@@ -0,0 +1,188 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 basysKom GmbH, opensource@basyskom.com
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtOpcUa module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qopen62541lazyvalue.h"
+
+#include <QtOpcUa/QOpcUaNode>
+#include <QtOpcUa/private/qopcuanodeimpl_p.h>
+
+#include <QtCore/QLoggingCategory>
+#include <QtTest/QtTest>
+
+// The value converter is included from the open62541 plugin, its warnings are logged using
+// qt.opcua.lazyvaluetest instead of qt.opcua.plugins.open62541
+Q_LOGGING_CATEGORY(QT_OPCUA_PLUGINS_OPEN62541, "qt.opcua.lazyvaluetest")
+
+// Counts the conversions done by the wrapped open62541 value
+class CountingLazyValue : public QOpen62541LazyValue
+{
+public:
+    CountingLazyValue(UA_Variant *value, int *conversions)
+        : QOpen62541LazyValue(value, false, QSharedPointer<const QOpen62541TypeDictionary>())
+        , m_conversions(conversions)
+    {}
+
+    QVariant toVariant() const override
+    {
+        ++*m_conversions;
+        return QOpen62541LazyValue::toVariant();
+    }
+
+private:
+    int *m_conversions;
+};
+
+// Hands read results to a QOpcUaNode without a backend
+class FakeNodeImpl : public QOpcUaNodeImpl
+{
+public:
+    void deliver(const QVector<QOpcUaReadResult> &results)
+    {
+        emit attributesRead(results, QOpcUa::UaStatusCode::Good);
+    }
+
+    bool readAttributes(QOpcUaNode::NodeAttributes) override { return false; }
+    QStringList childrenIds() const override { return QStringList(); }
+    QString nodeId() const override { return QStringLiteral("ns=1;s=Fake"); }
+    bool writeAttribute(QOpcUaNode::NodeAttribute, const QVariant &, QOpcUa::Types) override { return false; }
+    bool writeAttributes(const QOpcUaNode::AttributeMap &, QOpcUa::Types) override { return false; }
+    bool readAttributeRange(QOpcUaNode::NodeAttribute, const QString &) override { return false; }
+    bool writeAttributeRange(QOpcUaNode::NodeAttribute, const QVariant &, const QString &, QOpcUa::Types) override { return false; }
+    QPair<double, double> readEuRange() const override { return QPair<double, double>(); }
+    QPair<QString, QString> readEui() const override { return QPair<QString, QString>(); }
+    bool call(const QString &, QVector<QOpcUa::TypedVariant> *, QVector<QVariant> *) override { return false; }
+};
+
+class Tst_QOpen62541LazyValue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void takesOwnership();
+    void convertsOnFirstAccess();
+    void typedAttributeSkipsVariant();
+
+private:
+    static UA_Variant doubleArray(const QVector<double> &values)
+    {
+        UA_Variant variant;
+        UA_Variant_init(&variant);
+        UA_Variant_setArrayCopy(&variant, values.constData(), values.size(), &UA_TYPES[UA_TYPES_DOUBLE]);
+        return variant;
+    }
+
+    static QOpcUaReadResult readResult(QOpcUaNode::NodeAttribute attribute, QOpcUaLazyValue *value)
+    {
+        QOpcUaReadResult result;
+        result.attributeId = attribute;
+        result.statusCode = QOpcUa::UaStatusCode::Good;
+        result.lazyValue.reset(value);
+        return result;
+    }
+};
+
+void Tst_QOpen62541LazyValue::takesOwnership()
+{
+    UA_Variant variant = doubleArray({1.5, 2.5});
+    int conversions = 0;
+    CountingLazyValue value(&variant, &conversions);
+
+    // The response keeps nothing to delete and nothing has been converted yet
+    QVERIFY(UA_Variant_isEmpty(&variant));
+    QCOMPARE(variant.arrayLength, size_t(0));
+    QCOMPARE(conversions, 0);
+
+    const QVariantList list = value.toVariant().toList();
+    QCOMPARE(conversions, 1);
+    QCOMPARE(list.size(), 2);
+    QCOMPARE(list.at(0).toDouble(), 1.5);
+    QCOMPARE(list.at(1).toDouble(), 2.5);
+}
+
+void Tst_QOpen62541LazyValue::convertsOnFirstAccess()
+{
+    FakeNodeImpl *impl = new FakeNodeImpl;
+    QOpcUaNode node(impl, nullptr);
+
+    int valueConversions = 0;
+    int descriptionConversions = 0;
+    UA_Variant value = doubleArray({1, 2, 3});
+    UA_Variant description = doubleArray({4});
+
+    impl->deliver({readResult(QOpcUaNode::NodeAttribute::Value, new CountingLazyValue(&value, &valueConversions)),
+                   readResult(QOpcUaNode::NodeAttribute::Description,
+                              new CountingLazyValue(&description, &descriptionConversions))});
+
+    // Nothing is converted until an attribute is accessed
+    QCOMPARE(valueConversions, 0);
+    QCOMPARE(descriptionConversions, 0);
+    QCOMPARE(node.attributeError(QOpcUaNode::NodeAttribute::Value), QOpcUa::UaStatusCode::Good);
+    QCOMPARE(valueConversions, 0);
+
+    const QVariantList first = node.attribute(QOpcUaNode::NodeAttribute::Value).toList();
+    QCOMPARE(valueConversions, 1);
+    QCOMPARE(first.size(), 3);
+    QCOMPARE(first.at(2).toDouble(), 3.0);
+
+    // The converted value is kept, later accesses do not convert again
+    const QVariantList second = node.attribute(QOpcUaNode::NodeAttribute::Value).toList();
+    QCOMPARE(valueConversions, 1);
+    QCOMPARE(second, first);
+
+    // Attributes which are never accessed are never converted
+    QCOMPARE(descriptionConversions, 0);
+}
+
+void Tst_QOpen62541LazyValue::typedAttributeSkipsVariant()
+{
+    FakeNodeImpl *impl = new FakeNodeImpl;
+    QOpcUaNode node(impl, nullptr);
+
+    int conversions = 0;
+    UA_Variant value = doubleArray({7, 8});
+    impl->deliver({readResult(QOpcUaNode::NodeAttribute::Value, new CountingLazyValue(&value, &conversions))});
+
+    const QOpcUaVariant variant = node.typedAttribute(QOpcUaNode::NodeAttribute::Value);
+    QCOMPARE(variant.type(), QOpcUa::Types::Double);
+    QCOMPARE(conversions, 0);
+
+    QCOMPARE(node.attribute(QOpcUaNode::NodeAttribute::Value).toList().size(), 2);
+    QCOMPARE(conversions, 1);
+}
+
+QTEST_APPLESS_MAIN(Tst_QOpen62541LazyValue)
+
+#include "tst_qopen62541lazyvalue.moc"
@@ -46,8 +46,12 @@ int main(int argc, char **argv)
 {
     QCoreApplication app(argc, argv);
 
+    // A second instance for the redundancy tests listens on the port passed as argument
+    const QStringList arguments = app.arguments();
+    const quint16 port = arguments.size() > 1 ? arguments.at(1).toUShort() : 43344;
+
     TestServer server;
-    if (!server.init()) {
+    if (!server.init(port)) {
         qCritical() << "Could not initialize server.";
         return -1;
     }
@@ -71,6 +75,9 @@ int main(int argc, char **argv)
     const UA_NodeId testFolder = server.addFolder("ns=3;s=TestFolder", "TestFolder");
 
     server.addVariable<UA_Double, double, UA_TYPES_DOUBLE>(testFolder, "ns=3;s=TestNode.ReadWrite", "ReadWriteTest", 0.1);
+    // Index range reads and writes
+    server.addDoubleArray(testFolder, "ns=3;s=TestNode.RangeArray", "RangeArrayTest", {0, 1, 2, 3, 4, 5}, {6});
+    server.addDoubleArray(testFolder, "ns=3;s=TestNode.Matrix", "MatrixTest", {1, 2, 3, 4, 5, 6}, {2, 3});
 
 //    // TODO: Create Event
 //    // TODO: Server side methods
@@ -144,6 +151,23 @@ int main(int argc, char **argv)
     });
     tickTimer.start();
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+    // Events of the server object alternate between a low and a high severity.
+    // The variable tells the tests that events are available.
+    server.addVariable<UA_Boolean, bool, UA_TYPES_BOOLEAN>(testFolder, "ns=3;s=TestNode.Events", "EventsTest", true);
+
+    QTimer eventTimer;
+    eventTimer.setInterval(100);
+    int eventCount = 0;
+    QObject::connect(&eventTimer, &QTimer::timeout, [&server, &eventCount](){
+        const quint16 severity = eventCount++ % 2 ? 900 : 100;
+        UA_StatusCode ret = server.triggerEvent(severity, QStringLiteral("Test event %1").arg(severity));
+        if (ret != UA_STATUSCODE_GOOD)
+            qWarning() << "Open62541 Server: Could not trigger event:" << ret;
+    });
+    eventTimer.start();
+#endif
+
 
     return app.exec();
 }
@@ -61,9 +61,9 @@ TestServer::~TestServer()
     UA_ServerConfig_delete(m_config);
 }
 
-bool TestServer::init()
+bool TestServer::init(quint16 port)
 {
-    m_config = UA_ServerConfig_new_minimal(43344, NULL);
+    m_config = UA_ServerConfig_new_minimal(port, NULL);
     if (!m_config)
         return false;
 
@@ -155,6 +155,83 @@ UA_NodeId TestServer::addObject(const UA_NodeId &parentFolder, int namespaceInde
     return resultNode;
 }
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+// Emits a BaseEventType event with the server object as source
+UA_StatusCode TestServer::triggerEvent(quint16 severity, const QString &message)
+{
+    UA_NodeId eventNode;
+    UA_StatusCode result = UA_Server_createEvent(m_server, UA_NODEID_NUMERIC(0, UA_NS0ID_BASEEVENTTYPE), &eventNode);
+    if (result != UA_STATUSCODE_GOOD)
+        return result;
+
+    UA_UInt16 eventSeverity = severity;
+    UA_QualifiedName name = UA_QUALIFIEDNAME_ALLOC(0, "Severity");
+    UA_Server_writeObjectProperty_scalar(m_server, eventNode, name, &eventSeverity, &UA_TYPES[UA_TYPES_UINT16]);
+    UA_QualifiedName_deleteMembers(&name);
+
+    UA_LocalizedText eventMessage = UA_LOCALIZEDTEXT_ALLOC("en_US", message.toUtf8().constData());
+    name = UA_QUALIFIEDNAME_ALLOC(0, "Message");
+    UA_Server_writeObjectProperty_scalar(m_server, eventNode, name, &eventMessage, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
+    UA_QualifiedName_deleteMembers(&name);
+    UA_LocalizedText_deleteMembers(&eventMessage);
+
+    UA_String sourceName = UA_STRING_ALLOC("TestServer");
+    name = UA_QUALIFIEDNAME_ALLOC(0, "SourceName");
+    UA_Server_writeObjectProperty_scalar(m_server, eventNode, name, &sourceName, &UA_TYPES[UA_TYPES_STRING]);
+    UA_QualifiedName_deleteMembers(&name);
+    UA_String_deleteMembers(&sourceName);
+
+    UA_DateTime time = UA_DateTime_now();
+    name = UA_QUALIFIEDNAME_ALLOC(0, "Time");
+    UA_Server_writeObjectProperty_scalar(m_server, eventNode, name, &time, &UA_TYPES[UA_TYPES_DATETIME]);
+    UA_QualifiedName_deleteMembers(&name);
+
+    return UA_Server_triggerEvent(m_server, eventNode, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER), NULL, true);
+}
+#endif
+
+// values are in row-major order, dimensions with more than one entry make a matrix
+UA_NodeId TestServer::addDoubleArray(const UA_NodeId &folder, const QString &variableNode, const QString &description,
+                                     const QVector<double> &values, const QVector<quint32> &dimensions)
+{
+    UA_NodeId variableNodeId = Open62541Utils::nodeIdFromQString(variableNode);
+
+    UA_VariableAttributes attr = UA_VariableAttributes_default;
+    UA_Variant_setArrayCopy(&attr.value, values.constData(), values.size(), &UA_TYPES[UA_TYPES_DOUBLE]);
+    UA_Array_copy(dimensions.constData(), dimensions.size(), reinterpret_cast<void **>(&attr.value.arrayDimensions),
+                  &UA_TYPES[UA_TYPES_UINT32]);
+    attr.value.arrayDimensionsSize = dimensions.size();
+    UA_Array_copy(dimensions.constData(), dimensions.size(), reinterpret_cast<void **>(&attr.arrayDimensions),
+                  &UA_TYPES[UA_TYPES_UINT32]);
+    attr.arrayDimensionsSize = dimensions.size();
+    attr.valueRank = dimensions.size();
+    attr.description = UA_LOCALIZEDTEXT_ALLOC("en_US", description.toUtf8().constData());
+    attr.displayName = UA_LOCALIZEDTEXT_ALLOC("en_US", variableNode.toUtf8().constData());
+    attr.dataType = UA_TYPES[UA_TYPES_DOUBLE].typeId;
+    attr.accessLevel = UA_ACCESSLEVELMASK_READ | UA_ACCESSLEVELMASK_WRITE;
+
+    UA_QualifiedName variableName;
+    variableName.namespaceIndex = variableNodeId.namespaceIndex;
+    UA_String_copy(&variableNodeId.identifier.string, &variableName.name);
+
+    UA_NodeId resultId;
+    UA_StatusCode result = UA_Server_addVariableNode(m_server,
+                                                     variableNodeId,
+                                                     folder,
+                                                     UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
+                                                     variableName,
+                                                     UA_NODEID_NULL,
+                                                     attr,
+                                                     NULL,
+                                                     &resultId);
+
+    if (result != UA_STATUSCODE_GOOD) {
+        qWarning() << "Could not add variable:" << result;
+        return UA_NODEID_NULL;
+    }
+    return resultId;
+}
+
 template <typename UA_TYPE_VALUE, typename QTYPE, int UA_TYPE_IDENTIFIER>
 UA_NodeId TestServer::addVariable(const UA_NodeId &folder, const QString &variableNode,
                                   const QString &description, QTYPE value)
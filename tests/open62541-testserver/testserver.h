@@ -43,6 +43,7 @@
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
 #include <QtCore/QVariant>
+#include <QtCore/QVector>
 
 class TestServer : public QObject
 {
@@ -50,14 +51,19 @@ class TestServer : public QObject
 public:
     explicit TestServer(QObject *parent = nullptr);
     ~TestServer();
-    bool init();
+    bool init(quint16 port = 43344);
 
     int registerNamespace(const QString &ns);
     UA_NodeId addFolder(const QString &nodeString, const QString &displayName, const QString &description = QString());
     UA_NodeId addObject(const UA_NodeId &folderId, int namespaceIndex, const QString &objectName = QString());
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+    UA_StatusCode triggerEvent(quint16 severity, const QString &message);
+#endif
 
     template <typename UA_TYPE_VALUE, typename QTYPE, int UA_TYPE_IDENTIFIER>
     UA_NodeId addVariable(const UA_NodeId &folder, const QString &variableNode, const QString &description, QTYPE value);
+    UA_NodeId addDoubleArray(const UA_NodeId &folder, const QString &variableNode, const QString &description,
+                             const QVector<double> &values, const QVector<quint32> &dimensions);
 
     UA_ServerConfig *m_config{nullptr};
     UA_Server *m_server{nullptr};